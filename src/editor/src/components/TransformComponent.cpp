@@ -20,6 +20,10 @@ namespace fgl::engine::components
 					model_instance->flagUpdate();
 				}
 			}
+			else if constexpr ( std::same_as< T0, BVHUpdateTarget > )
+			{
+				to_update.update( m_transform.mat4() );
+			}
 		};
 
 		for ( auto& to_update : m_updatables )
@@ -117,7 +117,8 @@ namespace fgl::engine::filesystem
 		{
 			m_file_texture->drawImGuiButton( { DESIRED_SIZE, DESIRED_SIZE } );
 
-			auto tex { getTextureStore().load( info.m_path ) };
+			// Decoded in the background, The button shows it once it is ready
+			auto tex { getTextureStore().loadAsync( info.m_path ) };
 
 			// Add the texture
 			m_file_textures.insert( std::make_pair( info.m_path, std::move( tex ) ) );
@@ -8,6 +8,7 @@
 #include "engine/flags.hpp"
 #include "engine/math/literals/size.hpp"
 #include "engine/memory/buffers/BufferHandle.hpp"
+#include "engine/systems/prerender/CullingSystem.hpp"
 #include "memory/buffers/BufferHandle.hpp"
 #include "safe_include.hpp"
 
@@ -128,10 +129,25 @@ namespace fgl::engine::gui
 		ImGui::Begin( "Stats" );
 
 		ImGui::Text( "FPS: %0.1f", static_cast< double >( ImGui::GetIO().Framerate ) );
-		const auto& [ verts_drawn, models_draw, instance_count ] { profiling::getCounters() };
+		const auto& [ verts_drawn, models_draw, instance_count, culled, visible ] { profiling::getCounters() };
 		ImGui::Text( "Models drawn: %zu", models_draw );
 		ImGui::Text( "Verts drawn: %zu", verts_drawn );
 		ImGui::Text( "Draw instances: %zu", instance_count );
+		ImGui::Text( "Primitives visible: %zu", visible );
+		ImGui::Text( "Primitives culled: %zu", culled );
+
+		if ( ImGui::CollapsingHeader( "Culling" ) )
+		{
+			ImGui::Checkbox( "Instance merging", &instanceMergingEnabled() );
+			ImGui::Checkbox( "Occlusion culling", &occlusionCullingEnabled() );
+			ImGui::Checkbox( "Cluster culling", &clusterCullingEnabled() );
+		}
+
+		if ( ImGui::CollapsingHeader( "Level of detail" ) )
+		{
+			// Pixels of error allowed on screen. 0 always draws the full detail level
+			ImGui::SliderFloat( "Error threshold (px)", &lodErrorThreshold(), 0.0f, 16.0f, "%.1f" );
+		}
 
 		if ( ImGui::CollapsingHeader( "Memory" ) )
 		{
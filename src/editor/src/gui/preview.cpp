@@ -54,7 +54,7 @@ namespace fgl::engine::gui
 
 								obj->addComponent( std::move( component ) );
 
-								info.m_game_objects.emplace_back( std::move( obj ) );
+								info.m_game_objects.add( std::move( obj ) );
 
 								break;
 							}
@@ -69,7 +69,7 @@ namespace fgl::engine::gui
 
 								for ( auto& obj : objs )
 								{
-									info.m_game_objects.emplace_back( std::move( obj ) );
+									info.m_game_objects.add( std::move( obj ) );
 								}
 							}
 					}
@@ -91,7 +91,7 @@ int main()
 					{}
 				}
 
-				engine_ctx.m_game_objects.emplace_back( std::move( obj ) );
+				engine_ctx.m_game_objects.add( std::move( obj ) );
 			}
 		}
 
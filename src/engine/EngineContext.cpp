@@ -16,10 +16,13 @@
 #include "camera/GBufferRenderer.hpp"
 #include "debug/timing/FlameGraph.hpp"
 #include "engine/assets/model/builders/SceneBuilder.hpp"
+#include "engine/assets/stores.hpp"
 #include "engine/assets/transfer/TransferManager.hpp"
 #include "engine/flags.hpp"
 #include "engine/math/Average.hpp"
 #include "engine/math/literals/size.hpp"
+#include "engine/rendering/devices/Device.hpp"
+#include "memory/DefferedCleanup.hpp"
 #include "memory/buffers/BufferHandle.hpp"
 
 namespace fgl::engine
@@ -27,9 +30,25 @@ namespace fgl::engine
 	constexpr float MAX_DELTA_TIME { 0.5 };
 	inline static EngineContext* instance { nullptr };
 
+	PerFrameArray< std::unique_ptr< HostSingleT< DrawCounts > > > createDrawCounts( memory::Buffer& buffer )
+	{
+		PerFrameArray< std::unique_ptr< HostSingleT< DrawCounts > > > counts {};
+
+		for ( auto& count : counts )
+		{
+			count = std::make_unique< HostSingleT< DrawCounts > >( buffer );
+
+			DrawCounts zero {};
+			*count = zero;
+		}
+
+		return counts;
+	}
+
 	PerFrameArray< std::unique_ptr< descriptors::DescriptorSet > > createDrawCommandsDescriptors(
 		PerFrameArray< DeviceVector< vk::DrawIndexedIndirectCommand > >& gpu_draw_commands,
-		PerFrameArray< DeviceVector< InstanceRenderInfo > >& per_vertex_info )
+		PerFrameArray< DeviceVector< InstanceRenderInfo > >& per_vertex_info,
+		PerFrameArray< std::unique_ptr< HostSingleT< DrawCounts > > >& draw_counts )
 	{
 		PerFrameArray< std::unique_ptr< descriptors::DescriptorSet > > descriptors {};
 
@@ -41,6 +60,7 @@ namespace fgl::engine
 
 			descriptor->bindStorageBuffer( 0, command_buffer );
 			descriptor->bindStorageBuffer( 1, per_vertex_buffer );
+			descriptor->bindStorageBuffer( 2, *draw_counts[ i ] );
 			descriptor->update();
 			descriptor->setName( "Command Buffer + Vertex Buffer" );
 
@@ -54,12 +74,15 @@ namespace fgl::engine
 	  m_ubo_buffer_pool( 1_MiB, vk::BufferUsageFlagBits::eUniformBuffer, vk::MemoryPropertyFlagBits::eHostVisible ),
 	  m_draw_parameter_pool(
 		  4_MiB,
-		  vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eStorageBuffer,
+		  vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eStorageBuffer
+			  | vk::BufferUsageFlagBits::eTransferDst,
 		  vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eHostVisible ),
 	  m_gpu_draw_commands(
 		  constructPerFrame< DeviceVector< vk::DrawIndexedIndirectCommand > >( m_draw_parameter_pool ) ),
+	  m_gpu_draw_counts( createDrawCounts( m_draw_parameter_pool ) ),
 	  m_per_vertex_infos( m_model_buffers.m_generated_instance_info ),
-	  m_gpu_draw_cmds_desc( createDrawCommandsDescriptors( m_gpu_draw_commands, m_per_vertex_infos ) ),
+	  m_gpu_draw_cmds_desc(
+		  createDrawCommandsDescriptors( m_gpu_draw_commands, m_per_vertex_infos, m_gpu_draw_counts ) ),
 	  m_delta_time( 0.0 )
 	{
 		ZoneScoped;
@@ -136,9 +159,20 @@ namespace fgl::engine
 			// Begin by getting every single instance ready.
 			DeviceVector< PrimitiveInstanceInfo >& instances { m_model_buffers.m_primitive_instances.vec() };
 
-			m_gpu_draw_commands[ in_flight_idx ].resize( instances.size() );
+			// Every instance could be drawn with either index type, So each batch needs room for all of them.
+			// Compacted batches also have room for the meshlets of the visible instances
+			const std::uint32_t batch_size {
+				instances.size() + ( Device::getInstance().supportsDrawIndirectCount() ? CLUSTER_COMMAND_BUDGET : 0 )
+			};
+
+			m_gpu_draw_commands[ in_flight_idx ].resize( batch_size * INDEX_BATCH_COUNT );
 			m_model_buffers.m_generated_instance_info[ in_flight_idx ].resize( instances.size() );
 
+			m_game_object_bvh.update( m_game_objects );
+
+			// The fence for this frame index was waited on by beginFrame, So it's texture feedback can be read
+			m_texture_streamer.update( in_flight_idx );
+
 			FrameInfo frame_info { in_flight_idx,
 				                   present_idx,
 				                   m_delta_time,
@@ -150,7 +184,9 @@ namespace fgl::engine
 				                   *m_model_buffers.m_instances_desc,
 				                   *m_gpu_draw_cmds_desc[ in_flight_idx ],
 				                   m_gpu_draw_commands[ in_flight_idx ],
+				                   *m_gpu_draw_counts[ in_flight_idx ],
 				                   m_game_objects,
+				                   m_game_object_bvh,
 				                   this->m_renderer.getSwapChain() };
 
 			{
@@ -194,6 +230,7 @@ namespace fgl::engine
 
 		//Trash handling
 		descriptors::deleteQueuedDescriptors();
+		memory::processDeferredDeletes();
 	}
 
 	void EngineContext::finishFrame()
@@ -232,6 +269,7 @@ namespace fgl::engine
 		// m_game_objects_root.clear();
 
 		descriptors::deleteQueuedDescriptors();
+		memory::clearDeferredDeletes();
 
 		log::info( "Performing {} destruction hooks", m_destruction_hooks.size() );
 
@@ -251,6 +289,16 @@ namespace fgl::engine
 
 	void EngineContext::handleTransfers()
 	{
+		// Compact the geometry buffers a bit each frame, Otherwise loading and unloading scenes will keep growing them.
+		for ( memory::Buffer* buffer : { &m_model_buffers.m_vertex_buffer, &m_model_buffers.m_index_buffer } )
+		{
+			if ( ( *buffer )->fragmentation() > memory::DEFRAGMENT_THRESHOLD )
+				( *buffer )->defragment( memory::DEFRAGMENT_BYTE_BUDGET );
+		}
+
+		// Textures decoded since the last frame queue their uploads here, So they are part of this submit
+		getTextureStore().processLoads();
+
 		memory::TransferManager::getInstance().submitNow();
 	}
 
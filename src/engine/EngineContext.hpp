@@ -9,8 +9,11 @@
 #include "assets/model/Model.hpp"
 #include "camera/CameraManager.hpp"
 #include "clock.hpp"
+#include "engine/assets/texture/TextureStreamer.hpp"
 #include "engine/assets/transfer/TransferManager.hpp"
+#include "engine/gameobjects/GameObjectBVH.hpp"
 #include "engine/math/literals/size.hpp"
+#include "engine/memory/buffers/HostSingleT.hpp"
 #include "engine/rendering/Renderer.hpp"
 #include "scene/World.hpp"
 #include "systems/composition/GuiSystem.hpp"
@@ -72,13 +75,21 @@ namespace fgl::engine
 
 	  public:
 
-		std::vector< std::shared_ptr< GameObject > > m_game_objects {};
+		GameObjectList m_game_objects {};
+
+		//! Spatial queries over m_game_objects. Brought up to date at the start of every frame
+		GameObjectBVH m_game_object_bvh {};
 
 		ModelGPUBuffers m_model_buffers {};
 
+		//! Streams the finer levels of textures in and out, See getTextureStreamer
+		TextureStreamer m_texture_streamer {};
+
 	  private:
 
 		PerFrameArray< DeviceVector< vk::DrawIndexedIndirectCommand > > m_gpu_draw_commands;
+		//! Number of commands in each batch of m_gpu_draw_commands written by the culling pass
+		PerFrameArray< std::unique_ptr< HostSingleT< DrawCounts > > > m_gpu_draw_counts;
 		//TODO: Outright remove this. Or the one in model buffers.
 		PerFrameArray< DeviceVector< InstanceRenderInfo > >& m_per_vertex_infos;
 		PerFrameArray< std::unique_ptr< descriptors::DescriptorSet > > m_gpu_draw_cmds_desc;
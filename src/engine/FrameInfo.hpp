@@ -10,8 +10,11 @@
 // clang-format on
 
 #include "descriptors/Descriptor.hpp"
+#include "assets/model/IndexBufferSuballocation.hpp"
 #include "descriptors/DescriptorSetLayout.hpp"
 #include "gameobjects/GameObject.hpp"
+#include "gameobjects/GameObjectBVH.hpp"
+#include "memory/buffers/HostSingleT.hpp"
 #include "memory/buffers/vector/DeviceVector.hpp"
 #include "primitives/Frustum.hpp"
 #include "rendering/CommandBuffers.hpp"
@@ -86,7 +89,6 @@ namespace fgl::engine
 		std::vector< std::weak_ptr< Camera > >& m_camera_list;
 
 		// descriptors::DescriptorSet& global_descriptor_set;
-		// OctTreeNode& game_objects;
 		TracyVkCtx tracy_ctx;
 
 		descriptors::DescriptorSet& m_primitives_desc;
@@ -94,9 +96,17 @@ namespace fgl::engine
 		descriptors::DescriptorSet& m_command_buffer_desc;
 		// out for rendering process
 
-		//! Populated commands buffer by the culling pass
+		//! Populated commands buffer by the culling pass. Split into INDEX_BATCH_COUNT ranges of commandsPerBatch()
 		DeviceVector< vk::DrawIndexedIndirectCommand >& m_commands;
-		std::vector< std::shared_ptr< GameObject > >& m_game_objects;
+		//! Number of commands in each batch of m_commands. Only written if the culling pass is compacting the commands
+		HostSingleT< DrawCounts >& m_draw_count;
+
+		//! Size of each IndexBatch range in m_commands. The number of primitive instances, Plus CLUSTER_COMMAND_BUDGET if
+		//! the commands are compacted
+		std::uint32_t commandsPerBatch() const { return m_commands.size() / INDEX_BATCH_COUNT; }
+		GameObjectList& m_game_objects;
+		//! Ray, frustum and box queries over m_game_objects
+		GameObjectBVH& m_game_object_bvh;
 
 		// descriptors::DescriptorSet& gui_input_descriptor;
 
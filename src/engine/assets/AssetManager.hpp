@@ -6,9 +6,15 @@
 
 #include <tracy/Tracy.hpp>
 
+#include <chrono>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
+#include "engine/debug/logging/logging.hpp"
+
 namespace fgl::engine
 {
 
@@ -36,6 +42,20 @@ namespace fgl::engine
 		} -> std::same_as< typename T::UIDKeyT >;
 	};
 
+	/**
+	 * @brief Concept for ensuring T can be loaded in the background by @ref AssetStore::loadAsync
+	 * @details T::beginLoad returns the item right away, In a placeholder state, With the future of the background work.
+	 * T::finishLoad is given the result of that work on the main thread.
+	 */
+	template < typename T, typename... TArgs >
+	concept can_load_async = can_extract_key< T, TArgs... > && requires( TArgs&&... args ) {
+		typename T::PreparedT;
+		{
+			T::beginLoad( std::declval< std::remove_reference_t< TArgs > >()... )
+		} -> std::same_as< std::pair< std::shared_ptr< T >, std::future< typename T::PreparedT > > >;
+		T::finishLoad( std::declval< const std::shared_ptr< T >& >(), std::declval< typename T::PreparedT >() );
+	};
+
 	/**
 	 * @brief Object store to keep track of assets.
 	 * @tparam T Type to store T must define a `extractKey` method in T with the same parameters as the construction
@@ -43,6 +63,7 @@ namespace fgl::engine
 	 * T must:
 	 * - Define UIDKeyT type inside of T.
 	 * - Define and implement extractKey functions for each constructor used in load. (See can_extract_key)
+	 * - Define PreparedT, beginLoad and finishLoad to be used with loadAsync. (See can_load_async)
 	 */
 	template < typename T >
 	class AssetStore
@@ -56,6 +77,9 @@ namespace fgl::engine
 		std::unordered_map< KeyT, std::weak_ptr< T > > m_active_map {};
 		std::mutex m_map_mtx {};
 
+		//! Loads started by loadAsync, By key. Returns true once the item was finished, Or it expired before that
+		std::unordered_map< KeyT, std::move_only_function< bool() > > m_in_flight {};
+
 	  public:
 
 		/**
@@ -93,6 +117,76 @@ namespace fgl::engine
 
 			return s_ptr;
 		}
+
+		/**
+		 * @brief Same as load, But the item is returned before the expensive part of loading it is done
+		 * @details The work runs in the background without holding the store lock. Requests for a key that is still
+		 * in flight return the same item instead of starting the work again. The item is finished by processLoads.
+		 * @returns shared pointer to T, In it's placeholder state until finished
+		 */
+		template < typename... T_Args >
+			requires can_load_async< T, T_Args... >
+		std::shared_ptr< T > loadAsync( T_Args&&... args )
+		{
+			ZoneScoped;
+			const auto key { T::extractKey( std::forward< T_Args >( args )... ) };
+
+			std::lock_guard guard { m_map_mtx };
+
+			if ( auto itter = m_active_map.find( key ); itter != m_active_map.end() )
+			{
+				if ( std::weak_ptr< T >& item = itter->second; !item.expired() )
+				{
+					return item.lock();
+				}
+
+				m_active_map.erase( itter );
+			}
+
+			auto [ s_ptr, future ] = T::beginLoad( std::forward< T_Args >( args )... );
+
+			m_active_map.insert( std::make_pair( key, s_ptr ) );
+
+			// Replaces the job of an item that expired while in flight, It's result is no longer wanted
+			m_in_flight.insert_or_assign(
+				key,
+				[ w_ptr = std::weak_ptr< T >( s_ptr ), future = std::move( future ) ]() mutable -> bool
+				{
+					if ( future.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ) return false;
+
+					const std::shared_ptr< T > item { w_ptr.lock() };
+
+					try
+					{
+						auto prepared { future.get() };
+						if ( item ) T::finishLoad( item, std::move( prepared ) );
+					}
+					catch ( const std::exception& e )
+					{
+						// The item is left in it's placeholder state
+						log::error( "Failed to load asset in the background: {}", e.what() );
+					}
+
+					return true;
+				} );
+
+			return s_ptr;
+		}
+
+		//! Finishes every item from loadAsync whose background work is done. Must be called from the main thread
+		void processLoads()
+		{
+			ZoneScoped;
+			std::lock_guard guard { m_map_mtx };
+
+			for ( auto itter = m_in_flight.begin(); itter != m_in_flight.end(); )
+			{
+				if ( auto& [ key, finish ] = *itter; finish() )
+					itter = m_in_flight.erase( itter );
+				else
+					++itter;
+			}
+		}
 	};
 
 } // namespace fgl::engine
@@ -188,7 +188,7 @@ namespace fgl::engine
 		const vk::ImageLayout old_layout, const vk::ImageLayout new_layout, const vk::ImageAspectFlags aspect )
 	{
 		assert( m_handle->m_name.empty() == false && "Image name not assigned" );
-		const vk::ImageSubresourceRange subresource { aspect, 0, 1, 0, 1 };
+		const vk::ImageSubresourceRange subresource { aspect, 0, m_handle->mipLevels(), 0, 1 };
 
 		const vk::ImageMemoryBarrier barrier { transitionTo( old_layout, new_layout, subresource ) };
 
@@ -209,8 +209,9 @@ namespace fgl::engine
 		const vk::Format format,
 		const vk::ImageUsageFlags usage,
 		const vk::ImageLayout inital_layout,
-		const vk::ImageLayout final_layout ) :
-	  m_handle( std::make_shared< ImageHandle >( extent, format, usage, inital_layout, final_layout ) ),
+		const vk::ImageLayout final_layout,
+		const std::uint32_t mip_levels ) :
+	  m_handle( std::make_shared< ImageHandle >( extent, format, usage, inital_layout, final_layout, mip_levels ) ),
 	  m_extent( extent )
 	{}
 
@@ -226,6 +227,11 @@ namespace fgl::engine
 		return m_handle->getVkImage();
 	}
 
+	std::uint32_t Image::mipLevels() const
+	{
+		return m_handle->mipLevels();
+	}
+
 	Image& Image::operator=( Image&& other ) noexcept
 	{
 		m_handle = std::move( other.m_handle );
@@ -44,7 +44,8 @@ namespace fgl::engine
 			vk::Format format,
 			vk::ImageUsageFlags usage,
 			vk::ImageLayout inital_layout,
-			vk::ImageLayout final_layout );
+			vk::ImageLayout final_layout,
+			std::uint32_t mip_levels = 1 );
 
 		Image( const Image& other ) : m_handle( other.m_handle ), m_extent( other.m_extent ) {}
 
@@ -60,6 +61,8 @@ namespace fgl::engine
 
 		[[nodiscard]] const vk::Extent2D& getExtent() const { return m_extent; }
 
+		[[nodiscard]] std::uint32_t mipLevels() const;
+
 		[[nodiscard]] std::shared_ptr< ImageView > getView( Sampler sampler = {});
 
 		[[nodiscard]] vk::ImageMemoryBarrier transitionTo(
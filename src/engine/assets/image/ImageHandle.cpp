@@ -25,7 +25,8 @@ namespace fgl::engine
 		const vk::Extent2D extent,
 		const vk::Format format,
 		const vk::ImageLayout inital_layout,
-		const vk::ImageUsageFlags usage )
+		const vk::ImageUsageFlags usage,
+		const std::uint32_t mip_levels )
 	{
 		vk::ImageCreateInfo image_info {};
 
@@ -35,7 +36,7 @@ namespace fgl::engine
 		image_info.extent.height = extent.height;
 		image_info.extent.depth = 1;
 
-		image_info.mipLevels = 1;
+		image_info.mipLevels = mip_levels;
 		image_info.arrayLayers = 1;
 		image_info.format = format;
 		image_info.tiling = vk::ImageTiling::eOptimal;
@@ -55,13 +56,15 @@ namespace fgl::engine
 		const vk::Format format,
 		const vk::ImageUsageFlags usage,
 		const vk::ImageLayout inital_layout,
-		const vk::ImageLayout final_layout ) :
+		const vk::ImageLayout final_layout,
+		const std::uint32_t mip_levels ) :
 	  m_extent( extent ),
 	  m_format( format ),
 	  m_usage( usage ),
+	  m_mip_levels( mip_levels ),
 	  m_initial_layout( inital_layout ),
 	  m_final_layout( final_layout ),
-	  m_image( createImage( extent, format, inital_layout, usage ) ),
+	  m_image( createImage( extent, format, inital_layout, usage, mip_levels ) ),
 	  m_staged( true )
 	{
 		assert( std::holds_alternative< vk::raii::Image >( m_image ) );
@@ -69,6 +72,7 @@ namespace fgl::engine
 
 		assert( m_extent.width > 0 );
 		assert( m_extent.height > 0 );
+		assert( m_mip_levels > 0 );
 
 		ZoneScoped;
 		//Allocate memory for image
@@ -25,6 +25,7 @@ namespace fgl::engine
 		vk::Extent2D m_extent;
 		vk::Format m_format;
 		vk::ImageUsageFlags m_usage;
+		std::uint32_t m_mip_levels { 1 };
 
 		vk::ImageLayout m_initial_layout { vk::ImageLayout::eUndefined };
 		vk::ImageLayout m_final_layout { vk::ImageLayout::eUndefined };
@@ -50,7 +51,8 @@ namespace fgl::engine
 			vk::Format format,
 			vk::ImageUsageFlags usage,
 			vk::ImageLayout inital_layout,
-			vk::ImageLayout final_layout );
+			vk::ImageLayout final_layout,
+			std::uint32_t mip_levels = 1 );
 
 		void setName( std::string str );
 
@@ -62,6 +64,8 @@ namespace fgl::engine
 
 		vk::Extent2D extent() const { return m_extent; }
 
+		std::uint32_t mipLevels() const { return m_mip_levels; }
+
 		bool ready() const { return m_staged; }
 
 		void setReady( const bool value ) { m_staged = value; }
@@ -72,12 +76,12 @@ namespace fgl::engine
 
 			if ( m_usage & vk::ImageUsageFlagBits::eColorAttachment ) flags |= vk::ImageAspectFlagBits::eColor;
 
-			//TODO: This is likely wrong since not all sampled images will be a color.
-			// Should look into the various image flags and figure out a better pattern here
-			if ( m_usage & vk::ImageUsageFlagBits::eSampled ) flags |= vk::ImageAspectFlagBits::eColor;
-
 			if ( m_usage & vk::ImageUsageFlagBits::eDepthStencilAttachment )
 				flags |= ( vk::ImageAspectFlagBits::eDepth );
+			//TODO: This is likely wrong since not all sampled images will be a color.
+			// Should look into the various image flags and figure out a better pattern here
+			else if ( m_usage & vk::ImageUsageFlagBits::eSampled )
+				flags |= vk::ImageAspectFlagBits::eColor;
 
 			return flags;
 		}
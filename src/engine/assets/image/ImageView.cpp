@@ -17,7 +17,7 @@ namespace fgl::engine
 		info.subresourceRange.aspectMask = img->aspectMask();
 
 		info.subresourceRange.baseMipLevel = 0;
-		info.subresourceRange.levelCount = 1;
+		info.subresourceRange.levelCount = img->mipLevels();
 		info.subresourceRange.baseArrayLayer = 0;
 		info.subresourceRange.layerCount = 1;
 
@@ -0,0 +1,197 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "MipChain.hpp"
+
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+
+#include "engine/FGL_DEFINES.hpp"
+
+namespace fgl::engine
+{
+
+	std::uint32_t mipLevelCount( const vk::Extent2D extent )
+	{
+		const std::uint32_t largest { std::max( extent.width, extent.height ) };
+		if ( largest == 0 ) return 0;
+
+		return static_cast< std::uint32_t >( std::bit_width( largest ) );
+	}
+
+	vk::Extent2D mipExtent( const vk::Extent2D extent, const std::uint32_t level )
+	{
+		return { std::max( extent.width >> level, 1u ), std::max( extent.height >> level, 1u ) };
+	}
+
+	vk::DeviceSize mipLevelSize( const vk::Extent2D extent, const std::uint32_t level, const vk::Format format )
+	{
+		const vk::Extent2D level_extent { mipExtent( extent, level ) };
+		const auto block_extent { vk::blockExtent( format ) };
+
+		const vk::DeviceSize blocks_x { ( level_extent.width + block_extent[ 0 ] - 1 ) / block_extent[ 0 ] };
+		const vk::DeviceSize blocks_y { ( level_extent.height + block_extent[ 1 ] - 1 ) / block_extent[ 1 ] };
+
+		return blocks_x * blocks_y * vk::blockSize( format );
+	}
+
+	std::vector< vk::DeviceSize >
+		mipOffsets( const vk::Extent2D extent, const std::uint32_t levels, const vk::Format format )
+	{
+		std::vector< vk::DeviceSize > offsets {};
+		offsets.reserve( levels + 1 );
+
+		vk::DeviceSize offset { 0 };
+
+		for ( std::uint32_t level = 0; level < levels; ++level )
+		{
+			offsets.emplace_back( offset );
+			offset += mipLevelSize( extent, level, format );
+		}
+
+		offsets.emplace_back( offset );
+
+		return offsets;
+	}
+
+	//! Averages each 2x2 block of the source level into a texel of the destination level
+	static void downsample(
+		const std::uint8_t* const src,
+		const vk::Extent2D src_extent,
+		std::uint8_t* const dst,
+		const vk::Extent2D dst_extent )
+	{
+		for ( std::uint32_t y = 0; y < dst_extent.height; ++y )
+		{
+			// Odd sizes have no second row or column for the last texel, So it repeats the last one instead
+			const std::uint32_t y0 { std::min( y * 2, src_extent.height - 1 ) };
+			const std::uint32_t y1 { std::min( y * 2 + 1, src_extent.height - 1 ) };
+
+			const std::uint8_t* const row0 { src + static_cast< std::size_t >( y0 ) * src_extent.width * 4 };
+			const std::uint8_t* const row1 { src + static_cast< std::size_t >( y1 ) * src_extent.width * 4 };
+			std::uint8_t* const out { dst + static_cast< std::size_t >( y ) * dst_extent.width * 4 };
+
+			// Only the columns with a full 2x2 block, Written so the compiler can vectorize it
+			const std::uint32_t full_columns { std::min( dst_extent.width, src_extent.width / 2 ) };
+
+			for ( std::uint32_t i = 0; i < full_columns * 4; ++i )
+			{
+				const std::uint32_t channel { i % 4 };
+				const std::uint32_t x0 { ( i - channel ) * 2 + channel };
+
+				const std::uint32_t sum { static_cast< std::uint32_t >( row0[ x0 ] ) + row0[ x0 + 4 ] + row1[ x0 ]
+					                      + row1[ x0 + 4 ] };
+
+				out[ i ] = static_cast< std::uint8_t >( ( sum + 2 ) / 4 );
+			}
+
+			for ( std::uint32_t x = full_columns; x < dst_extent.width; ++x )
+			{
+				const std::uint32_t x0 { std::min( x * 2, src_extent.width - 1 ) * 4 };
+				const std::uint32_t x1 { std::min( x * 2 + 1, src_extent.width - 1 ) * 4 };
+
+				for ( std::uint32_t channel = 0; channel < 4; ++channel )
+				{
+					const std::uint32_t sum { static_cast< std::uint32_t >( row0[ x0 + channel ] ) + row0[ x1 + channel ]
+						                      + row1[ x0 + channel ] + row1[ x1 + channel ] };
+
+					out[ x * 4 + channel ] = static_cast< std::uint8_t >( ( sum + 2 ) / 4 );
+				}
+			}
+		}
+	}
+
+	//! Linear intensity of each sRGB encoded byte
+	static std::array< float, 256 > makeSrgbToLinearTable()
+	{
+		std::array< float, 256 > table {};
+
+		for ( std::size_t i = 0; i < table.size(); ++i )
+		{
+			const float c { static_cast< float >( i ) / 255.0f };
+			table[ i ] = c <= 0.04045f ? c / 12.92f : std::pow( ( c + 0.055f ) / 1.055f, 2.4f );
+		}
+
+		return table;
+	}
+
+	static std::uint8_t linearToSrgb( const float linear )
+	{
+		const float c { linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow( linear, 1.0f / 2.4f ) - 0.055f };
+		return static_cast< std::uint8_t >( std::clamp( c, 0.0f, 1.0f ) * 255.0f + 0.5f );
+	}
+
+	//! Same as downsample, But the color channels are averaged after decoding them from sRGB
+	static void downsampleSrgb(
+		const std::uint8_t* const src,
+		const vk::Extent2D src_extent,
+		std::uint8_t* const dst,
+		const vk::Extent2D dst_extent )
+	{
+		static const std::array< float, 256 > to_linear { makeSrgbToLinearTable() };
+
+		for ( std::uint32_t y = 0; y < dst_extent.height; ++y )
+		{
+			const std::uint32_t y0 { std::min( y * 2, src_extent.height - 1 ) };
+			const std::uint32_t y1 { std::min( y * 2 + 1, src_extent.height - 1 ) };
+
+			const std::uint8_t* const row0 { src + static_cast< std::size_t >( y0 ) * src_extent.width * 4 };
+			const std::uint8_t* const row1 { src + static_cast< std::size_t >( y1 ) * src_extent.width * 4 };
+			std::uint8_t* const out { dst + static_cast< std::size_t >( y ) * dst_extent.width * 4 };
+
+			for ( std::uint32_t x = 0; x < dst_extent.width; ++x )
+			{
+				const std::uint32_t x0 { std::min( x * 2, src_extent.width - 1 ) * 4 };
+				const std::uint32_t x1 { std::min( x * 2 + 1, src_extent.width - 1 ) * 4 };
+
+				for ( std::uint32_t channel = 0; channel < 3; ++channel )
+				{
+					const float sum { to_linear[ row0[ x0 + channel ] ] + to_linear[ row0[ x1 + channel ] ]
+						              + to_linear[ row1[ x0 + channel ] ] + to_linear[ row1[ x1 + channel ] ] };
+
+					out[ x * 4 + channel ] = linearToSrgb( sum * 0.25f );
+				}
+
+				const std::uint32_t alpha_sum { static_cast< std::uint32_t >( row0[ x0 + 3 ] ) + row0[ x1 + 3 ]
+					                            + row1[ x0 + 3 ] + row1[ x1 + 3 ] };
+
+				out[ x * 4 + 3 ] = static_cast< std::uint8_t >( ( alpha_sum + 2 ) / 4 );
+			}
+		}
+	}
+
+	std::uint32_t generateMipChain( std::vector< std::byte >& pixels, const vk::Extent2D extent, const bool srgb )
+	{
+		ZoneScoped;
+
+		const std::uint32_t levels { mipLevelCount( extent ) };
+
+		FGL_ASSERT(
+			pixels.size() == mipLevelSize( extent, 0, vk::Format::eR8G8B8A8Unorm ),
+			"Pixels must be exactly the first level of an RGBA8 image" );
+
+		const std::vector< vk::DeviceSize > offsets { mipOffsets( extent, levels, vk::Format::eR8G8B8A8Unorm ) };
+		pixels.resize( offsets.back() );
+
+		auto* const data { reinterpret_cast< std::uint8_t* >( pixels.data() ) };
+
+		const auto filter { srgb ? &downsampleSrgb : &downsample };
+
+		for ( std::uint32_t level = 1; level < levels; ++level )
+		{
+			filter(
+				data + offsets[ level - 1 ],
+				mipExtent( extent, level - 1 ),
+				data + offsets[ level ],
+				mipExtent( extent, level ) );
+		}
+
+		return levels;
+	}
+
+} // namespace fgl::engine
@@ -0,0 +1,39 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace fgl::engine
+{
+
+	//! Number of levels in a full mip chain for the extent, Down to and including 1x1
+	std::uint32_t mipLevelCount( vk::Extent2D extent );
+
+	//! Extent of a level in the mip chain. Each level is half the size of the last, Rounded down to at least 1
+	vk::Extent2D mipExtent( vk::Extent2D extent, std::uint32_t level );
+
+	//! Size in bytes of a level. Block compressed formats round the level up to whole blocks
+	vk::DeviceSize mipLevelSize( vk::Extent2D extent, std::uint32_t level, vk::Format format );
+
+	/**
+	 * @brief Offset of each level within a tightly packed mip chain, Largest level first
+	 * @return One offset per level, Followed by the size of the whole chain
+	 */
+	std::vector< vk::DeviceSize > mipOffsets( vk::Extent2D extent, std::uint32_t levels, vk::Format format );
+
+	/**
+	 * @brief Appends the full mip chain to the RGBA8 pixels of the first level
+	 * @details Each level is downsampled from the one before it with a 2x2 box filter. Odd edges repeat their last texel
+	 * When srgb is set the color channels are averaged as linear intensities, So the smaller levels do not darken.
+	 * Alpha is always averaged as is
+	 * @return Number of levels now in pixels, Including the first
+	 */
+	std::uint32_t generateMipChain( std::vector< std::byte >& pixels, vk::Extent2D extent, bool srgb );
+
+} // namespace fgl::engine
@@ -4,32 +4,32 @@
 
 #include "Sampler.hpp"
 
+#include <tracy/Tracy.hpp>
 #include <vulkan/vulkan.hpp>
 
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
 #include "engine/debug/logging/logging.hpp"
 #include "engine/rendering/devices/Device.hpp"
+#include "engine/utils.hpp"
 
 namespace fgl::engine
 {
 
-	vk::raii::Sampler createSampler(
-		const vk::Filter min_filter,
-		const vk::Filter mag_filter,
-		const vk::SamplerMipmapMode mipmode,
-		const vk::SamplerAddressMode sampler_wrap_u,
-		const vk::SamplerAddressMode sampler_wrap_v,
-		const vk::SamplerAddressMode sampler_wrap_w )
+	vk::raii::Sampler createSampler( const SamplerState& state )
 	{
 		vk::SamplerCreateInfo info;
 
-		info.magFilter = mag_filter;
-		info.minFilter = min_filter;
+		info.magFilter = state.m_mag_filter;
+		info.minFilter = state.m_min_filter;
 
-		info.mipmapMode = mipmode;
+		info.mipmapMode = state.m_mipmap_mode;
 
-		info.addressModeU = sampler_wrap_u;
-		info.addressModeV = sampler_wrap_v;
-		info.addressModeW = sampler_wrap_w;
+		info.addressModeU = state.m_wrap_u;
+		info.addressModeV = state.m_wrap_v;
+		info.addressModeW = state.m_wrap_w;
 
 		if ( info.addressModeU == vk::SamplerAddressMode::eClampToBorder
 		     || info.addressModeV == vk::SamplerAddressMode::eClampToBorder
@@ -38,14 +38,46 @@ namespace fgl::engine
 			info.borderColor = vk::BorderColor::eFloatOpaqueWhite;
 		}
 
-		info.minLod = -1000;
-		info.maxLod = 1000;
+		info.minLod = state.m_min_lod;
+		info.maxLod = state.m_max_lod;
 
-		info.maxAnisotropy = 1.0f;
+		info.anisotropyEnable = state.m_max_anisotropy > 1.0f ? VK_TRUE : VK_FALSE;
+		info.maxAnisotropy = state.m_max_anisotropy;
 
 		return Device::getInstance()->createSampler( info );
 	}
 
+	//! Vulkan samplers that are alive, By their state. Drivers limit how many samplers can exist at once
+	static std::unordered_map< SamplerState, std::weak_ptr< const vk::raii::Sampler > > sampler_cache {};
+	static std::mutex sampler_cache_mtx {};
+
+	static std::shared_ptr< const vk::raii::Sampler > acquireSampler( SamplerState state )
+	{
+		ZoneScoped;
+		// Anisotropy past the device limit is the same sampler as the limit itself
+		state.m_max_anisotropy = std::clamp(
+			state.m_max_anisotropy, 1.0f, Device::getInstance().m_properties.limits.maxSamplerAnisotropy );
+
+		std::lock_guard guard { sampler_cache_mtx };
+
+		if ( const auto itter = sampler_cache.find( state ); itter != sampler_cache.end() )
+		{
+			if ( auto sampler = itter->second.lock() ) return sampler;
+		}
+
+		// Samplers are only created when a state is first used or all of it's users are gone, So this is rare enough
+		// to drop every expired state here instead of keeping them until shutdown
+		std::erase_if( sampler_cache, []( const auto& entry ) { return entry.second.expired(); } );
+
+		auto sampler { std::make_shared< const vk::raii::Sampler >( createSampler( state ) ) };
+		sampler_cache.insert_or_assign( state, sampler );
+
+		return sampler;
+	}
+
+	Sampler::Sampler( const SamplerState& state ) : m_sampler( acquireSampler( state ) )
+	{}
+
 	Sampler::Sampler(
 		const vk::Filter min_filter,
 		const vk::Filter mag_filter,
@@ -53,7 +85,12 @@ namespace fgl::engine
 		const vk::SamplerAddressMode sampler_wrap_u,
 		const vk::SamplerAddressMode sampler_wrap_v,
 		const vk::SamplerAddressMode sampler_wrap_w ) :
-	  m_sampler( createSampler( min_filter, mag_filter, mipmap_mode, sampler_wrap_u, sampler_wrap_v, sampler_wrap_w ) )
+	  Sampler( SamplerState { .m_min_filter = min_filter,
+		                      .m_mag_filter = mag_filter,
+		                      .m_mipmap_mode = mipmap_mode,
+		                      .m_wrap_u = sampler_wrap_u,
+		                      .m_wrap_v = sampler_wrap_v,
+		                      .m_wrap_w = sampler_wrap_w } )
 	{}
 
 	namespace gl
@@ -68,6 +105,12 @@ namespace fgl::engine
 					return vk::Filter::eNearest;
 				case GL_LINEAR:
 					return vk::Filter::eLinear;
+				case GL_NEAREST_MIPMAP_NEAREST:
+					[[fallthrough]];
+				case GL_NEAREST_MIPMAP_LINEAR:
+					return vk::Filter::eNearest;
+				case GL_LINEAR_MIPMAP_NEAREST:
+					[[fallthrough]];
 				case GL_LINEAR_MIPMAP_LINEAR:
 					return vk::Filter::eLinear;
 			}
@@ -75,6 +118,22 @@ namespace fgl::engine
 			FGL_UNREACHABLE();
 		}
 
+		//! The mipmap half of an opengl minification filter. Filters without one blend between levels
+		vk::SamplerMipmapMode mipmapModeToVk( const int value )
+		{
+			switch ( value )
+			{
+				default:
+					return vk::SamplerMipmapMode::eLinear;
+				case GL_NEAREST_MIPMAP_NEAREST:
+					[[fallthrough]];
+				case GL_LINEAR_MIPMAP_NEAREST:
+					return vk::SamplerMipmapMode::eNearest;
+			}
+
+			FGL_UNREACHABLE();
+		}
+
 		vk::SamplerAddressMode wrappingToVk( const int val )
 		{
 			switch ( val )
@@ -106,34 +165,46 @@ namespace fgl::engine
 	 * @param wrapt y wrap
 	 */
 	Sampler::Sampler( const int min_filter, const int mag_filter, const int wraps, const int wrapt ) :
-	  Sampler(
-		  gl::filterToVk( min_filter ),
-		  gl::filterToVk( mag_filter ),
-		  vk::SamplerMipmapMode::eLinear,
-		  gl::wrappingToVk( wraps ),
-		  gl::wrappingToVk( wrapt ) )
+	  Sampler( SamplerState {
+		  .m_min_filter = gl::filterToVk( min_filter ),
+		  .m_mag_filter = gl::filterToVk( mag_filter ),
+		  .m_mipmap_mode = gl::mipmapModeToVk( min_filter ),
+		  .m_wrap_u = gl::wrappingToVk( wraps ),
+		  .m_wrap_v = gl::wrappingToVk( wrapt ),
+		  .m_wrap_w = gl::wrappingToVk( wrapt ),
+		  // Anisotropy only makes sense on top of linear filtering, Nearest filtered textures want their hard edges
+		  .m_max_anisotropy = gl::filterToVk( min_filter ) == vk::Filter::eLinear ? MATERIAL_MAX_ANISOTROPY : 1.0f,
+	  } )
 	{}
 
-	Sampler::Sampler( Sampler&& other ) noexcept : m_sampler( std::move( other.m_sampler ) )
-	{
-		other.m_sampler = VK_NULL_HANDLE;
-	}
-
-	Sampler& Sampler::operator=( Sampler&& other ) noexcept
-	{
-		m_sampler = std::move( other.m_sampler );
-		other.m_sampler = VK_NULL_HANDLE;
-		return *this;
-	}
-
 	void Sampler::setName( const std::string& str ) const
 	{
 		vk::DebugUtilsObjectNameInfoEXT info {};
 		info.objectType = vk::ObjectType::eSampler;
 		info.pObjectName = str.c_str();
-		info.setObjectHandle( reinterpret_cast< std::uint64_t >( static_cast< VkSampler >( *m_sampler ) ) );
+		info.setObjectHandle( reinterpret_cast< std::uint64_t >( static_cast< VkSampler >( **m_sampler ) ) );
 
 		Device::getInstance().setDebugUtilsObjectName( info );
 	}
 
 } // namespace fgl::engine
+
+namespace std
+{
+	std::size_t hash< fgl::engine::SamplerState >::operator()( const fgl::engine::SamplerState& state ) const
+	{
+		std::size_t seed { 0 };
+		fgl::engine::hashCombine(
+			seed,
+			state.m_min_filter,
+			state.m_mag_filter,
+			state.m_mipmap_mode,
+			state.m_wrap_u,
+			state.m_wrap_v,
+			state.m_wrap_w,
+			state.m_max_anisotropy,
+			state.m_min_lod,
+			state.m_max_lod );
+		return seed;
+	}
+} // namespace std
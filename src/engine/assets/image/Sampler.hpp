@@ -7,26 +7,51 @@
 #include <vulkan/vulkan.hpp>
 #include <vulkan/vulkan_raii.hpp>
 
+#include <memory>
+
 #include "engine/FGL_DEFINES.hpp"
 
 namespace fgl::engine
 {
 
+	//! Anisotropy used for material textures. Clamped to what the device supports
+	constexpr float MATERIAL_MAX_ANISOTROPY { 16.0f };
+
+	//! Everything a sampler is created with. Samplers with the same state share a single vulkan sampler
+	struct SamplerState
+	{
+		vk::Filter m_min_filter { vk::Filter::eLinear };
+		vk::Filter m_mag_filter { vk::Filter::eLinear };
+		vk::SamplerMipmapMode m_mipmap_mode { vk::SamplerMipmapMode::eLinear };
+
+		vk::SamplerAddressMode m_wrap_u { vk::SamplerAddressMode::eClampToBorder };
+		vk::SamplerAddressMode m_wrap_v { vk::SamplerAddressMode::eClampToBorder };
+		vk::SamplerAddressMode m_wrap_w { vk::SamplerAddressMode::eClampToBorder };
+
+		//! 1 disables anisotropic filtering
+		float m_max_anisotropy { 1.0f };
+
+		//! Textures carry their full mip chain, So every level the view has is allowed by default
+		float m_min_lod { 0.0f };
+		float m_max_lod { VK_LOD_CLAMP_NONE };
+
+		bool operator==( const SamplerState& other ) const = default;
+	};
+
 	class Sampler
 	{
-		vk::raii::Sampler m_sampler;
+		//! Shared by every Sampler with the same state, The last one destroys it
+		std::shared_ptr< const vk::raii::Sampler > m_sampler;
 
 	  public:
 
-		FGL_DELETE_COPY( Sampler )
+		//! Copies share the vulkan sampler
+		Sampler( const Sampler& other ) = default;
+		Sampler& operator=( const Sampler& other ) = default;
 
-		Sampler() :
-		  Sampler(
-			  vk::Filter::eLinear,
-			  vk::Filter::eLinear,
-			  vk::SamplerMipmapMode::eLinear,
-			  vk::SamplerAddressMode::eClampToBorder )
-		{}
+		Sampler() : Sampler( SamplerState {} ) {}
+
+		explicit Sampler( const SamplerState& state );
 
 		Sampler(
 			vk::Filter min_filter,
@@ -53,20 +78,31 @@ namespace fgl::engine
 		  Sampler( min_filter, mag_filter, mipmap_mode, sampler_wrap_u, sampler_wrap_u, sampler_wrap_u )
 		{}
 
-		//TODO: This should be moved to favor a single sampler when possible, Making a duplicate sampler is not required.
-		//TODO: Singleton
+		//! Sampler from the opengl values used by gltf. Linear filtering also uses MATERIAL_MAX_ANISOTROPY
 		Sampler( int min_filter, int mag_filter, int wraps, int wrapt );
 
-		VkSampler operator*() const { return *m_sampler; }
+		VkSampler operator*() const { return m_sampler ? **m_sampler : VK_NULL_HANDLE; }
 
-		Sampler( Sampler&& other ) noexcept;
-		Sampler& operator=( Sampler&& ) noexcept;
+		Sampler( Sampler&& other ) noexcept = default;
+		Sampler& operator=( Sampler&& ) noexcept = default;
 
 		~Sampler() {}
 
-		const vk::raii::Sampler& getVkSampler() const { return m_sampler; }
+		const vk::raii::Sampler& getVkSampler() const { return *m_sampler; }
 
+		//! Names the shared vulkan sampler, So the last name given to any Sampler of the same state is used
 		void setName( const std::string& str ) const;
 	};
 
-} // namespace fgl::engine
\ No newline at end of file
+} // namespace fgl::engine
+
+namespace std
+{
+
+	template <>
+	struct hash< fgl::engine::SamplerState >
+	{
+		std::size_t operator()( const fgl::engine::SamplerState& state ) const;
+	};
+
+} // namespace std
@@ -57,11 +57,8 @@ namespace fgl::engine
 	{
 		Sampler sampler {};
 
-		std::shared_ptr< Texture > texture { getTextureStore().load( "assets/invalid.png", std::move( sampler ) ) };
-
-		//Prepare the texture into the global system
-		Texture::getDescriptorSet().bindTexture( 0, texture );
-		Texture::getDescriptorSet().update();
+		// Bound into the global system by the texture store, With the placeholder until it is decoded
+		std::shared_ptr< Texture > texture { getTextureStore().loadAsync( "assets/invalid.png", std::move( sampler ) ) };
 
 		if ( !this->m_pbr.m_color_tex ) this->m_pbr.m_color_tex = texture;
 	}
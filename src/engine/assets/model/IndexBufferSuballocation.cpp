@@ -0,0 +1,59 @@
+//
+// Created by kj16209 on 10/17/26.
+//
+
+#include "IndexBufferSuballocation.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "engine/assets/transfer/TransferManager.hpp"
+
+namespace fgl::engine
+{
+
+	static IndexBatch selectBatch( const std::span< const std::uint32_t > indicies )
+	{
+		if ( indicies.empty() ) return INDEX_BATCH_32;
+
+		const auto max_index { std::ranges::max( indicies ) };
+
+		return max_index <= std::numeric_limits< std::uint16_t >::max() ? INDEX_BATCH_16 : INDEX_BATCH_32;
+	}
+
+	static std::uint32_t strideOf( const IndexBatch batch )
+	{
+		return batch == INDEX_BATCH_16 ? sizeof( std::uint16_t ) : sizeof( std::uint32_t );
+	}
+
+	IndexBufferSuballocation::
+		IndexBufferSuballocation( memory::Buffer& buffer, const std::span< const std::uint32_t > indicies ) :
+	  IndexBufferSuballocation( buffer, indicies, selectBatch( indicies ) )
+	{}
+
+	IndexBufferSuballocation::IndexBufferSuballocation(
+		memory::Buffer& buffer, const std::span< const std::uint32_t > indicies, const IndexBatch batch ) :
+	  BufferVector( buffer, static_cast< std::uint32_t >( indicies.size() ), strideOf( batch ) ),
+	  m_batch( batch )
+	{
+		if ( indicies.empty() ) return;
+
+		auto& transfer_manager { memory::TransferManager::getInstance() };
+
+		if ( m_batch == INDEX_BATCH_32 )
+		{
+			transfer_manager.copyToVector< std::byte, IndexBufferSuballocation >( std::as_bytes( indicies ), *this );
+			return;
+		}
+
+		std::vector< std::uint16_t > narrowed( indicies.size() );
+		std::ranges::transform(
+			indicies, narrowed.begin(), []( const std::uint32_t index ) { return static_cast< std::uint16_t >( index ); } );
+
+		transfer_manager.copyToVector<
+			std::byte,
+			IndexBufferSuballocation >( std::as_bytes( std::span< const std::uint16_t >( narrowed ) ), *this );
+	}
+
+} // namespace fgl::engine
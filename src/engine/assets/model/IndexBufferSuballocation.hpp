@@ -0,0 +1,62 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "engine/FGL_DEFINES.hpp"
+#include "engine/memory/buffers/vector/BufferVector.hpp"
+#include "engine/memory/buffers/vector/concepts.hpp"
+
+namespace fgl::engine
+{
+
+	/**
+	 * @brief Draws are split into a batch per index type, Since the index type is bound for the entire draw.
+	 * Each batch has it's own range of the draw commands, And it's own draw count
+	 */
+	enum IndexBatch : std::uint32_t
+	{
+		INDEX_BATCH_32 = 0,
+		INDEX_BATCH_16 = 1,
+		INDEX_BATCH_COUNT = 2
+	};
+
+	//! Number of draw commands written by the culling pass for each IndexBatch
+	using DrawCounts = std::array< std::uint32_t, INDEX_BATCH_COUNT >;
+
+	constexpr vk::IndexType indexTypeOf( const IndexBatch batch )
+	{
+		return batch == INDEX_BATCH_16 ? vk::IndexType::eUint16 : vk::IndexType::eUint32;
+	}
+
+	//! Index data of a primitive. Stored as 16 bit indicies if every index fits, Halving it's size
+	class IndexBufferSuballocation final : public memory::BufferVector, public memory::DeviceVectorBase
+	{
+		IndexBatch m_batch;
+
+		IndexBufferSuballocation( memory::Buffer& buffer, std::span< const std::uint32_t > indicies, IndexBatch batch );
+
+	  public:
+
+		//! The indicies are staged as raw bytes, Already narrowed to the stride
+		using Type = std::byte;
+
+		IndexBufferSuballocation( memory::Buffer& buffer, std::span< const std::uint32_t > indicies );
+
+		FGL_DELETE_DEFAULT_CTOR( IndexBufferSuballocation );
+		FGL_DELETE_COPY( IndexBufferSuballocation );
+		FGL_DEFAULT_MOVE( IndexBufferSuballocation );
+
+		IndexBatch batch() const { return m_batch; }
+
+		vk::IndexType indexType() const { return indexTypeOf( m_batch ); }
+	};
+
+} // namespace fgl::engine
@@ -5,11 +5,14 @@
 #include "Model.hpp"
 
 #include <cassert>
+#include <cstring>
 
 #include "EngineContext.hpp"
 #include "ModelInstance.hpp"
 #include "builders/ModelBuilder.hpp"
 #include "builders/SceneBuilder.hpp"
+#include "engine/assets/transfer/TransferManager.hpp"
+#include "engine/memory/DefferedCleanup.hpp"
 
 namespace fgl::engine
 {
@@ -40,6 +43,8 @@ namespace fgl::engine
 		  vk::MemoryPropertyFlagBits::eDeviceLocal ),
 	  m_generated_instance_info( constructPerFrame< DeviceVector< InstanceRenderInfo > >( m_vertex_buffer ) ),
 	  m_primitive_info( m_long_buffer ),
+	  m_meshlets( m_long_buffer, MAX_MESHLETS ),
+	  m_meshlet_ranges( MAX_MESHLETS ),
 	  m_primitive_instances( m_short_buffer ),
 	  m_model_instances( m_short_buffer )
 	{
@@ -48,6 +53,7 @@ namespace fgl::engine
 
 		m_primitives_desc = PRIMITIVE_SET.create();
 		m_primitives_desc->bindStorageBuffer( 0, m_primitive_info );
+		m_primitives_desc->bindStorageBuffer( 1, m_meshlets );
 		m_primitives_desc->update();
 		m_primitives_desc->setName( "Primitives" );
 
@@ -58,6 +64,50 @@ namespace fgl::engine
 		m_instances_desc->setName( "Instances, Primitive + Models" );
 	}
 
+	std::shared_ptr< PrimitiveMeshletAllocation > ModelGPUBuffers::
+		addMeshlets( const std::span< const PrimitiveMeshlet > meshlets )
+	{
+		if ( meshlets.empty() ) return nullptr;
+
+		const auto first { m_meshlet_ranges.allocate( meshlets.size() ) };
+
+		if ( !first )
+		{
+			// The primitive can still be culled as a whole
+			log::warn( "Out of space for meshlets, {} of {} are in use", m_meshlet_ranges.used(), MAX_MESHLETS );
+			return nullptr;
+		}
+
+		const PrimitiveMeshletRange range { static_cast< std::uint32_t >( *first ),
+			                                static_cast< std::uint32_t >( meshlets.size() ) };
+
+		auto& transfer_manager { memory::TransferManager::getInstance() };
+		const auto bytes { std::as_bytes( meshlets ) };
+		const vk::DeviceSize dst_offset { vk::DeviceSize( range.m_first ) * sizeof( PrimitiveMeshlet ) };
+
+		if ( auto write = transfer_manager.reserveWrite( m_meshlets, bytes.size(), dst_offset ) )
+		{
+			std::memcpy( write->data().data(), bytes.data(), bytes.size() );
+			transfer_manager.commit( std::move( *write ) );
+		}
+		else
+		{
+			transfer_manager.copyToVector(
+				std::vector< std::byte >( bytes.begin(), bytes.end() ), m_meshlets, bytes.size(), dst_offset );
+		}
+
+		return std::make_shared< PrimitiveMeshletAllocation >( range );
+	}
+
+	void ModelGPUBuffers::freeMeshlets( const PrimitiveMeshletRange range )
+	{
+		if ( range.m_count == 0 ) return;
+
+		// The culling pass of a frame in flight could still read the range, So it can not be rewritten until it's done
+		memory::deferredDelete(
+			std::shared_ptr< void >( nullptr, [ this, range ]( void* ) { m_meshlet_ranges.free( range.m_first ); } ) );
+	}
+
 	OrientedBoundingBox< CoordinateSpace::Model > Model::buildBoundingBox( const std::vector< Primitive >& primitives )
 	{
 		ZoneScoped;
@@ -84,7 +134,9 @@ namespace fgl::engine
 	Model::Model( std::vector< Primitive >&& primitives, const std::string& name ) :
 	  m_name( name ),
 	  m_primitives( std::forward< std::vector< Primitive > >( primitives ) )
-	{}
+	{
+		if ( !m_primitives.empty() ) m_bounding_box = buildBoundingBox( m_primitives );
+	}
 
 	std::shared_ptr< ModelInstance > Model::createInstance()
 	{
@@ -92,7 +144,6 @@ namespace fgl::engine
 
 		auto& buffers { getModelBuffers() };
 
-		std::vector< PrimitiveInstanceInfoIndex > primitive_instances {};
 
 		WorldTransform transform {};
 		transform.translation = Coordinate< CoordinateSpace::World >( glm::vec3( 0.0, 0.0, 0.0 ) );
@@ -103,6 +154,9 @@ namespace fgl::engine
 
 		ModelInstanceInfoIndex model_instance { buffers.m_model_instances.acquire( model_info ) };
 
+		std::vector< PrimitiveInstanceInfo > instance_infos {};
+		instance_infos.reserve( m_primitives.size() );
+
 		for ( auto& primitive : m_primitives )
 		{
 			const auto render_info { primitive.renderInstanceInfo() };
@@ -112,9 +166,14 @@ namespace fgl::engine
 			instance_info.m_model_info = model_instance.idx();
 			instance_info.m_material = primitive.default_material->getID();
 
-			primitive_instances.emplace_back( buffers.m_primitive_instances.acquire( instance_info ) );
+			instance_infos.emplace_back( instance_info );
 		}
 
+		// Acquired as a batch, So the vector grows at most once per model
+		std::vector< PrimitiveInstanceInfoIndex > primitive_instances {
+			buffers.m_primitive_instances.acquire( std::span< const PrimitiveInstanceInfo >( instance_infos ) )
+		};
+
 		return std::make_shared<
 			ModelInstance >( std::move( primitive_instances ), std::move( model_instance ), this->shared_from_this() );
 	}
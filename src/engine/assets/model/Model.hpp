@@ -18,6 +18,7 @@
 #include "assets/material/Material.hpp"
 #include "descriptors/Descriptor.hpp"
 #include "descriptors/DescriptorSetLayout.hpp"
+#include "memory/allocators/TLSFAllocator.hpp"
 #include "memory/buffers/vector/IndexedVector.hpp"
 #include "primitives/boxes/OrientedBoundingBox.hpp"
 #include "rendering/PresentSwapChain.hpp"
@@ -48,7 +49,15 @@ namespace fgl::engine
 		                                                       vk::DescriptorType::eStorageBuffer,
 		                                                       vk::ShaderStageFlagBits::eCompute };
 
-	inline static descriptors::DescriptorSetLayout PRIMITIVE_SET { 0, RENDER_INFO_DESCRIPTOR };
+	// Meshlets of every primitive, See PrimitiveRenderInfo::m_first_meshlet
+	constexpr descriptors::Descriptor MESHLET_DESCRIPTOR { 1,
+		                                                   vk::DescriptorType::eStorageBuffer,
+		                                                   vk::ShaderStageFlagBits::eCompute };
+
+	//! Meshlets every primitive combined can have. The vector is never reallocated, So it is only bound once
+	constexpr std::uint32_t MAX_MESHLETS { 131072 };
+
+	inline static descriptors::DescriptorSetLayout PRIMITIVE_SET { 0, RENDER_INFO_DESCRIPTOR, MESHLET_DESCRIPTOR };
 
 	// Contains the information for each primitive (material ID, ect)
 	constexpr descriptors::Descriptor PRIMITIVE_INSTANCE_DESCRIPTOR { 0,
@@ -73,13 +82,28 @@ namespace fgl::engine
 		                                                     vk::DescriptorType::eStorageBuffer,
 		                                                     vk::ShaderStageFlagBits::eCompute };
 
-	inline static descriptors::DescriptorSetLayout COMMANDS_SET { 2, COMMANDS_DESCRIPTOR, VERTEX_INSTANCE_INFO };
+	// Number of commands written when the culling pass compacts the commands
+	constexpr descriptors::Descriptor DRAW_COUNT_DESCRIPTOR { 2,
+		                                                      vk::DescriptorType::eStorageBuffer,
+		                                                      vk::ShaderStageFlagBits::eCompute };
+
+	//! Commands each index batch has room for on top of one per primitive instance, Used for the meshlets of visible
+	//! instances. Only reserved if the commands are compacted, See CullingSystem
+	constexpr std::uint32_t CLUSTER_COMMAND_BUDGET { 8192 };
+
+	inline static descriptors::DescriptorSetLayout COMMANDS_SET { 2,
+		                                                          COMMANDS_DESCRIPTOR,
+		                                                          VERTEX_INSTANCE_INFO,
+		                                                          DRAW_COUNT_DESCRIPTOR };
 
 	struct InstanceRenderInfo
 	{
 		alignas( 4 * 4 ) glm::mat4x4 m_model_matrix;
 		// alignas( 4 * 4 ) glm::mat4x4 m_normal_matrix;
 		MaterialID m_material_id;
+		//! Render bounds of the primitive, Used to dequantize PackedModelVertex positions
+		alignas( 4 * 4 ) glm::vec3 m_bounds_center;
+		alignas( 4 * 4 ) glm::vec3 m_bounds_extent;
 
 		// This struct is purely for vulkan and type info.
 		FGL_DELETE_ALL_RO5( InstanceRenderInfo );
@@ -91,8 +115,11 @@ namespace fgl::engine
 	static_assert( offsetof( InstanceRenderInfo, m_material_id ) == 64 );
 	static_assert( sizeof( MaterialID ) == 4 );
 
+	static_assert( offsetof( InstanceRenderInfo, m_bounds_center ) == 80 );
+	static_assert( offsetof( InstanceRenderInfo, m_bounds_extent ) == 96 );
+
 	// Padding check
-	static_assert( sizeof( InstanceRenderInfo ) == ( 64 * 1 ) + ( 4 * 4 ) );
+	static_assert( sizeof( InstanceRenderInfo ) == ( 64 * 1 ) + ( 4 * 4 ) * 3 );
 
 	struct ModelGPUBuffers
 	{
@@ -109,6 +136,10 @@ namespace fgl::engine
 
 		//! contains the core primitive info, like vertex and index offsets and counts
 		IndexedVector< PrimitiveRenderInfo > m_primitive_info;
+		//! Meshlets of every primitive, Each primitive's being contiguous. Sized to MAX_MESHLETS up front
+		DeviceVector< PrimitiveMeshlet > m_meshlets;
+		//! Free and used ranges of m_meshlets, In meshlets rather than bytes
+		memory::TLSFAllocator m_meshlet_ranges;
 		//! contains a list of all rendered primitives
 		IndexedVector< PrimitiveInstanceInfo > m_primitive_instances;
 		//! Contains a list of all models
@@ -118,6 +149,12 @@ namespace fgl::engine
 		std::shared_ptr< descriptors::DescriptorSet > m_instances_desc;
 
 		ModelGPUBuffers();
+
+		//! Copies the meshlets of a primitive into a free range. Returns nullptr if there are none or no range is free
+		std::shared_ptr< PrimitiveMeshletAllocation > addMeshlets( std::span< const PrimitiveMeshlet > meshlets );
+
+		//! Returns the range once any frames in flight that could be culling with it have finished
+		void freeMeshlets( PrimitiveMeshletRange range );
 	};
 
 	class Model final : public AssetInterface< Model >, public std::enable_shared_from_this< Model >
@@ -130,6 +167,9 @@ namespace fgl::engine
 
 		std::vector< Primitive > m_primitives {};
 
+		//! Bounds of every primitive, In model space
+		OrientedBoundingBox< CoordinateSpace::Model > m_bounding_box {};
+
 		friend class components::ModelComponent;
 
 	  public:
@@ -148,6 +188,8 @@ namespace fgl::engine
 
 		const std::string& getName() const { return m_name; }
 
+		const OrientedBoundingBox< CoordinateSpace::Model >& getBoundingBox() const { return m_bounding_box; }
+
 		std::shared_ptr< ModelInstance > createInstance();
 
 		Model( const Model& model ) = delete;
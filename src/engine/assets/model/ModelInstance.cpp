@@ -32,6 +32,7 @@ namespace fgl::engine
 		// info.m_normal_matrix = glm::transpose( glm::inverse( info.m_model_matrix ) );
 
 		m_model_instance.update( info );
+		m_matrix = info.m_model_matrix;
 
 		m_updated = true;
 	}
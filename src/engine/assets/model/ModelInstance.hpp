@@ -26,6 +26,9 @@ namespace fgl::engine
 		ModelInstanceInfoIndex m_model_instance;
 		std::vector< PrimitiveInstanceInfoIndex > m_primitive_instances;
 
+		//! Last matrix given to setTransform
+		glm::mat4 m_matrix { glm::mat4( constants::DEFAULT_MODEL_SCALE ) };
+
 		//! True if the last frame changed this instance in any way
 		bool m_updated { false };
 
@@ -44,6 +47,10 @@ namespace fgl::engine
 		bool acquireNeedsUpdate();
 
 		void setTransform( const WorldTransform& transform );
+
+		const glm::mat4& getMatrix() const { return m_matrix; }
+
+		const std::shared_ptr< Model >& getModel() const { return m_model; }
 	};
 
 } // namespace fgl::engine
\ No newline at end of file
@@ -49,6 +49,13 @@ namespace fgl::engine
 		builder.add< decltype( ModelVertex::m_uv ), offsetof( ModelVertex, m_uv ) >( 0 );
 #pragma GCC diagnostic pop
 
+		addInstanceAttributes( builder );
+
+		return builder.get();
+	}
+
+	void addInstanceAttributes( AttributeBuilder& builder )
+	{
 		builder
 			.add< decltype( InstanceRenderInfo::m_model_matrix ), offsetof( InstanceRenderInfo, m_model_matrix ) >( 1 );
 
@@ -59,7 +66,12 @@ namespace fgl::engine
 		builder
 			.add< decltype( InstanceRenderInfo::m_material_id ), offsetof( InstanceRenderInfo, m_material_id ) >( 1 );
 
-		return builder.get();
+		builder.add<
+			decltype( InstanceRenderInfo::m_bounds_center ),
+			offsetof( InstanceRenderInfo, m_bounds_center ) >( 1 );
+		builder.add<
+			decltype( InstanceRenderInfo::m_bounds_extent ),
+			offsetof( InstanceRenderInfo, m_bounds_extent ) >( 1 );
 	}
 
 } // namespace fgl::engine
@@ -17,6 +17,7 @@
 
 namespace fgl::engine
 {
+	class AttributeBuilder;
 
 	struct ModelVertex : public SimpleVertex
 	{
@@ -38,6 +39,9 @@ namespace fgl::engine
 		bool operator==( const ModelVertex& other ) const;
 	};
 
+	//! Adds the per instance attributes (InstanceRenderInfo) of binding 1, Shared by every model vertex format
+	void addInstanceAttributes( AttributeBuilder& builder );
+
 } // namespace fgl::engine
 
 namespace std
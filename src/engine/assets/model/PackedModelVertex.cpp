@@ -0,0 +1,125 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "PackedModelVertex.hpp"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Weffc++"
+#include <glm/common.hpp>
+#include <glm/gtc/packing.hpp>
+#pragma GCC diagnostic pop
+
+#include <vulkan/vulkan.hpp>
+
+#include <limits>
+
+#include "Model.hpp"
+#include "ModelVertex.hpp"
+#include "VertexAttribute.hpp"
+
+namespace fgl::engine
+{
+	static VertexFormat active_format { VertexFormat::Full };
+
+	VertexFormat vertexFormat()
+	{
+		return active_format;
+	}
+
+	void setVertexFormat( const VertexFormat format )
+	{
+		active_format = format;
+	}
+
+	std::uint32_t vertexStride( const VertexFormat format )
+	{
+		return format == VertexFormat::Packed ? sizeof( PackedModelVertex ) : sizeof( ModelVertex );
+	}
+
+	RenderBounds renderBounds( const OrientedBoundingBox< CoordinateSpace::Model >& bounds )
+	{
+		glm::vec3 min { std::numeric_limits< float >::max() };
+		glm::vec3 max { std::numeric_limits< float >::lowest() };
+
+		for ( const auto& point : bounds.points() )
+		{
+			min = glm::min( min, point.vec() );
+			max = glm::max( max, point.vec() );
+		}
+
+		return { ( min + max ) * 0.5f, ( max - min ) * 0.5f };
+	}
+
+	static std::int16_t toSnorm16( const float value )
+	{
+		return static_cast< std::int16_t >( glm::round( glm::clamp( value, -1.0f, 1.0f ) * 32767.0f ) );
+	}
+
+	//! Maps a unit vector onto the octahedron, Then unfolds the octahedron onto a square
+	static glm::i16vec2 octahedralEncode( const glm::vec3& vec )
+	{
+		const float length { glm::abs( vec.x ) + glm::abs( vec.y ) + glm::abs( vec.z ) };
+		if ( length <= 0.0f ) return { 0, 0 };
+
+		glm::vec2 oct { vec.x / length, vec.y / length };
+
+		if ( vec.z < 0.0f )
+		{
+			const glm::vec2 folded { ( 1.0f - glm::abs( oct.y ) ) * ( oct.x >= 0.0f ? 1.0f : -1.0f ),
+				                     ( 1.0f - glm::abs( oct.x ) ) * ( oct.y >= 0.0f ? 1.0f : -1.0f ) };
+			oct = folded;
+		}
+
+		return { toSnorm16( oct.x ), toSnorm16( oct.y ) };
+	}
+
+	PackedModelVertex PackedModelVertex::
+		pack( const ModelVertex& vertex, const glm::vec3& bounds_center, const glm::vec3& bounds_extent )
+	{
+		PackedModelVertex packed {};
+
+		for ( glm::length_t i = 0; i < 3; ++i )
+		{
+			// Flat primitives have no extent on an axis, Every vertex is at the center of it
+			const float offset { bounds_extent[ i ] > 0.0f
+				                     ? ( vertex.m_position[ i ] - bounds_center[ i ] ) / bounds_extent[ i ]
+				                     : 0.0f };
+			packed.m_position[ i ] = toSnorm16( offset );
+		}
+
+		packed.m_position.w = toSnorm16( vertex.m_tangent.w < 0.0f ? -1.0f : 1.0f );
+		packed.m_normal = octahedralEncode( vertex.m_normal );
+		packed.m_tangent = octahedralEncode( glm::vec3( vertex.m_tangent ) );
+
+		const std::uint32_t uv { glm::packHalf2x16( vertex.m_uv ) };
+		packed.m_uv = { static_cast< std::uint16_t >( uv & 0xFFFF ), static_cast< std::uint16_t >( uv >> 16 ) };
+
+		return packed;
+	}
+
+	std::vector< vk::VertexInputBindingDescription > PackedModelVertex::getBindingDescriptions()
+	{
+		std::vector< vk::VertexInputBindingDescription > binding_descriptions {
+			{ 0, sizeof( PackedModelVertex ), vk::VertexInputRate::eVertex },
+			{ 1, sizeof( InstanceRenderInfo ), vk::VertexInputRate::eInstance }
+		};
+
+		return binding_descriptions;
+	}
+
+	std::vector< vk::VertexInputAttributeDescription > PackedModelVertex::getAttributeDescriptions()
+	{
+		AttributeBuilder builder {};
+
+		builder.add< offsetof( PackedModelVertex, m_position ) >( 0, vk::Format::eR16G16B16A16Snorm );
+		builder.add< offsetof( PackedModelVertex, m_normal ) >( 0, vk::Format::eR16G16Snorm );
+		builder.add< offsetof( PackedModelVertex, m_tangent ) >( 0, vk::Format::eR16G16Snorm );
+		builder.add< offsetof( PackedModelVertex, m_uv ) >( 0, vk::Format::eR16G16Sfloat );
+
+		addInstanceAttributes( builder );
+
+		return builder.get();
+	}
+
+} // namespace fgl::engine
@@ -0,0 +1,89 @@
+//
+// Created by kj16209 on 10/17/26.
+//
+
+#pragma once
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Weffc++"
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/gtc/type_precision.hpp>
+#pragma GCC diagnostic pop
+
+#include <cstdint>
+#include <vector>
+
+#include "engine/primitives/boxes/OrientedBoundingBox.hpp"
+
+namespace vk
+{
+	struct VertexInputAttributeDescription;
+	struct VertexInputBindingDescription;
+} // namespace vk
+
+namespace fgl::engine
+{
+	struct ModelVertex;
+
+	//! Layout primitives are stored in on the GPU
+	enum class VertexFormat
+	{
+		//! ModelVertex as is
+		Full,
+		//! PackedModelVertex
+		Packed
+	};
+
+	//! Format vertices are uploaded in. Defaults to VertexFormat::Full
+	VertexFormat vertexFormat();
+
+	//! Must be set before any primitive is loaded, Or any pipeline drawing primitives is created
+	void setVertexFormat( VertexFormat format );
+
+	//! Size of each vertex in the vertex buffer for the format
+	std::uint32_t vertexStride( VertexFormat format );
+
+	//! Model space AABB of a primitive, As center and half extent
+	struct RenderBounds
+	{
+		glm::vec3 m_center;
+		glm::vec3 m_extent;
+	};
+
+	//! AABB enclosing the bounding box. Used for culling, And as the range packed positions are quantized in
+	RenderBounds renderBounds( const OrientedBoundingBox< CoordinateSpace::Model >& bounds );
+
+	/**
+	 * @brief Compact version of ModelVertex, 20 bytes instead of 60.
+	 * Positions are quantized within the primitive's bounds, Which the vertex shader reads from InstanceRenderInfo.
+	 * Normals and tangents are octahedral encoded. The vertex color is dropped, As it is never set by the importers.
+	 * See shaders/model/vertex.slang for the decoding.
+	 *
+	 * Unpacked vertices are within:
+	 * - Half a quantization step of the position on each axis, Or bounds_extent / 65534
+	 * - 0.0001 radians of the normal and tangent direction
+	 * - The half float precision of the uv, 1 / 2048 of it's magnitude (1 / 4096 for uvs within [0, 1])
+	 */
+	struct PackedModelVertex
+	{
+		//! xyz: Position within the bounds (snorm16). w: Sign of the tangent (snorm16, -1 or 1)
+		glm::i16vec4 m_position;
+		//! Octahedral encoded (snorm16)
+		glm::i16vec2 m_normal;
+		//! Octahedral encoded (snorm16)
+		glm::i16vec2 m_tangent;
+		//! Half floats
+		glm::u16vec2 m_uv;
+
+		//! Bounds are the center and half extent of the primitive's render bounds. See renderBounds
+		static PackedModelVertex
+			pack( const ModelVertex& vertex, const glm::vec3& bounds_center, const glm::vec3& bounds_extent );
+
+		static std::vector< vk::VertexInputBindingDescription > getBindingDescriptions();
+		static std::vector< vk::VertexInputAttributeDescription > getAttributeDescriptions();
+	};
+
+	static_assert( sizeof( PackedModelVertex ) == 20 );
+
+} // namespace fgl::engine
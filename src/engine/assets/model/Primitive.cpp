@@ -37,32 +37,126 @@ namespace fgl::engine
 		return default_material->ready() && m_vertex_buffer.ready() && m_index_buffer.ready();
 	}
 
+	//! Fills the culling bounds of the render info. Must match the bounds the vertices were packed with
+	static void setRenderBounds( PrimitiveRenderInfo& info, const OrientedBoundingBox< CoordinateSpace::Model >& bounds )
+	{
+		const auto [ center, extent ] { renderBounds( bounds ) };
+
+		info.m_bounds_center = center;
+		info.m_bounds_extent = extent;
+	}
+
+	//! Fills the levels of detail of the render info, Offsetting them to the primitive's first index
+	static void setRenderLods(
+		PrimitiveRenderInfo& info, const std::span< const PrimitiveLod > lods, const std::uint32_t first_index )
+	{
+		FGL_ASSERT( !lods.empty() && lods.size() <= MAX_LODS, "Primitive must have between 1 and MAX_LODS lods" );
+
+		info.m_lod_count = static_cast< std::uint32_t >( lods.size() );
+
+		for ( std::size_t i = 0; i < lods.size(); ++i )
+		{
+			info.m_lods[ i ] = lods[ i ];
+			info.m_lods[ i ].m_first_index += first_index;
+		}
+	}
+
+	//! Every primitive has at least the full detail level, Covering all of it's indicies
+	static std::vector< PrimitiveLod > fullDetailLod( const IndexBufferSuballocation& index_buffer )
+	{
+		return { PrimitiveLod { 0, index_buffer.size(), 0.0f, 0 } };
+	}
+
+	PrimitiveMeshletAllocation::~PrimitiveMeshletAllocation()
+	{
+		getModelBuffers().freeMeshlets( m_range );
+	}
+
+	PrimitiveMeshletRange Primitive::meshletRange() const
+	{
+		if ( !m_meshlets ) return {};
+		return m_meshlets->range();
+	}
+
 	std::shared_ptr< PrimitiveRenderInfoIndex > Primitive::buildRenderInfo()
 	{
 		auto& buffers { getModelBuffers() };
 
 		PrimitiveRenderInfo info {};
 		info.m_first_vert = m_vertex_buffer.getOffsetCount();
-		info.m_first_index = m_index_buffer.getOffsetCount();
-		info.m_num_indicies = m_index_buffer.size();
+		info.m_index_batch = m_index_buffer.batch();
+		setRenderBounds( info, m_bounding_box );
+		setRenderLods( info, m_lods, m_index_buffer.getOffsetCount() );
+		const PrimitiveMeshletRange meshlets { meshletRange() };
+		info.m_first_meshlet = meshlets.m_first;
+		info.m_meshlet_count = meshlets.m_count;
 
 		auto ptr { std::make_shared< PrimitiveRenderInfoIndex >( buffers.m_primitive_info.acquire( info ) ) };
 		return ptr;
 	}
 
+	void Primitive::enableRelocation()
+	{
+		// Primitives are moved around (std::vector), So the callback must only capture the shared handles
+		const std::weak_ptr< memory::BufferSuballocationHandle > vertex_handle { m_vertex_buffer.getHandle() };
+		const std::weak_ptr< memory::BufferSuballocationHandle > index_handle { m_index_buffer.getHandle() };
+		const std::weak_ptr< PrimitiveRenderInfoIndex > render_info_weak { m_primitive_info };
+		const std::uint32_t vertex_stride { m_vertex_buffer.stride() };
+		const std::uint32_t index_stride { m_index_buffer.stride() };
+		const IndexBatch index_batch { m_index_buffer.batch() };
+		const OrientedBoundingBox< CoordinateSpace::Model > bounding_box { m_bounding_box };
+
+		const auto update_render_info =
+			[ vertex_handle,
+			  index_handle,
+			  render_info_weak,
+			  vertex_stride,
+			  index_stride,
+			  index_batch,
+			  bounding_box,
+			  lods = m_lods,
+			  meshlets = meshletRange() ]()
+		{
+			const auto vertex { vertex_handle.lock() };
+			const auto index { index_handle.lock() };
+			const auto render_info { render_info_weak.lock() };
+
+			if ( !vertex || !index || !render_info ) return;
+
+			PrimitiveRenderInfo info {};
+			info.m_first_vert = static_cast< std::uint32_t >( vertex->offset() / vertex_stride );
+			info.m_index_batch = index_batch;
+			setRenderBounds( info, bounding_box );
+			setRenderLods( info, lods, static_cast< std::uint32_t >( index->offset() / index_stride ) );
+			// Meshlets are relative to the first index, So they do not move with the index buffer
+			info.m_first_meshlet = meshlets.m_first;
+			info.m_meshlet_count = meshlets.m_count;
+
+			render_info->update( info );
+		};
+
+		m_vertex_buffer.getHandle()->setRelocationCallback( update_render_info );
+		m_index_buffer.getHandle()->setRelocationCallback( update_render_info );
+	}
+
 	Primitive::Primitive(
 		VertexBufferSuballocation&& vertex_buffer,
 		IndexBufferSuballocation&& index_buffer,
 		const OrientedBoundingBox< CoordinateSpace::Model >& bounding_box,
-		const PrimitiveMode mode ) noexcept :
+		const PrimitiveMode mode,
+		std::vector< PrimitiveLod >&& lods,
+		std::shared_ptr< PrimitiveMeshletAllocation >&& meshlets ) noexcept :
 	  m_vertex_buffer( std::move( vertex_buffer ) ),
 	  m_index_buffer( std::move( index_buffer ) ),
 	  m_bounding_box( bounding_box ),
 	  m_mode( mode ),
+	  m_lods( lods.empty() ? fullDetailLod( m_index_buffer ) : std::move( lods ) ),
+	  m_meshlets( std::move( meshlets ) ),
 	  default_material(),
 	  m_primitive_info( buildRenderInfo() )
 	{
 		assert( m_bounding_box.getTransform().scale != glm::vec3( 0.0f ) );
+		enableRelocation();
 	}
 
 	Primitive::Primitive(
@@ -75,10 +169,13 @@ namespace fgl::engine
 	  m_index_buffer( std::move( index_buffer ) ),
 	  m_bounding_box( bounding_box ),
 	  m_mode( mode ),
+	  m_lods( fullDetailLod( m_index_buffer ) ),
+	  m_meshlets(),
 	  default_material( material ),
 	  m_primitive_info( buildRenderInfo() )
 	{
 		assert( m_bounding_box.getTransform().scale != glm::vec3( 0.0f ) );
+		enableRelocation();
 	}
 
 	Primitive Primitive::fromVerts(
@@ -89,13 +186,35 @@ namespace fgl::engine
 		memory::Buffer& index_buffer )
 	{
 		const auto bounds { generateBoundingFromVerts( verts ) };
-		VertexBufferSuballocation vertex_buffer_suballoc { vertex_buffer,
-			                                               std::forward< std::vector< ModelVertex > >( verts ) };
 
-		IndexBufferSuballocation index_buffer_suballoc { index_buffer,
-			                                             std::forward< std::vector< std::uint32_t > >( indicies ) };
+		return fromVerts(
+			std::span< const ModelVertex >( verts ),
+			mode,
+			std::span< const std::uint32_t >( indicies ),
+			bounds,
+			vertex_buffer,
+			index_buffer );
+	}
 
-		return { std::move( vertex_buffer_suballoc ), std::move( index_buffer_suballoc ), bounds, mode };
+	Primitive Primitive::fromVerts(
+		const std::span< const ModelVertex > verts,
+		const PrimitiveMode mode,
+		const std::span< const std::uint32_t > indicies,
+		const OrientedBoundingBox< CoordinateSpace::Model >& bounds,
+		memory::Buffer& vertex_buffer,
+		memory::Buffer& index_buffer,
+		const std::span< const PrimitiveLod > lods,
+		const std::span< const PrimitiveMeshlet > meshlets )
+	{
+		VertexBufferSuballocation vertex_buffer_suballoc { vertex_buffer, verts, bounds };
+		IndexBufferSuballocation index_buffer_suballoc { index_buffer, indicies };
+
+		return { std::move( vertex_buffer_suballoc ),
+			     std::move( index_buffer_suballoc ),
+			     bounds,
+			     mode,
+			     std::vector< PrimitiveLod >( lods.begin(), lods.end() ),
+			     getModelBuffers().addMeshlets( meshlets ) };
 	}
 
 	OrientedBoundingBox< CoordinateSpace::Model > Primitive::getBoundingBox() const
@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <span>
+#include <vector>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wold-style-cast"
@@ -12,7 +15,9 @@
 #include "objectloaders/tiny_gltf.h"
 #pragma GCC diagnostic pop
 
+#include "IndexBufferSuballocation.hpp"
 #include "ModelInstanceInfo.hpp"
+#include "VertexBufferSuballocation.hpp"
 #include "assets/material/Material.hpp"
 #include "engine/memory/buffers/vector/DeviceVector.hpp"
 #include "engine/primitives/boxes/OrientedBoundingBox.hpp"
@@ -23,10 +28,6 @@ namespace fgl::engine
 	class Material;
 	class Texture;
 
-	using VertexBufferSuballocation = DeviceVector< ModelVertex >;
-
-	using IndexBufferSuballocation = DeviceVector< std::uint32_t >;
-
 	enum PrimitiveMode
 	{
 		POINTS = TINYGLTF_MODE_POINTS,
@@ -49,16 +50,99 @@ namespace fgl::engine
 		bool ready() const;
 	};
 
+	//! Maximum number of levels of detail of a primitive, Including the full detail level
+	constexpr std::uint32_t MAX_LODS { 4 };
+
+	//! Range of the primitive's indicies drawn for a level of detail
+	struct PrimitiveLod
+	{
+		//! Relative to the primitive's first index. Absolute within the index buffer in PrimitiveRenderInfo
+		std::uint32_t m_first_index;
+		std::uint32_t m_index_count;
+		//! Model space distance the level deviates from the full detail surface. 0 for the full detail level
+		float m_error;
+		std::uint32_t m_padding;
+	};
+
+	static_assert( sizeof( PrimitiveLod ) == 16 );
+
+	//! Culling bounds of a range of the full detail level's indicies. See buildMeshlets
+	struct PrimitiveMeshlet
+	{
+		//! Model space bounds
+		alignas( 4 * 4 ) glm::vec3 m_bounds_center;
+		alignas( 4 * 4 ) glm::vec3 m_bounds_extent;
+
+		//! Normal cone of the triangles, See Meshlet::m_cone_axis
+		alignas( 4 * 4 ) glm::vec3 m_cone_axis;
+		float m_cone_cutoff;
+
+		//! Relative to the primitive's first index, Like PrimitiveLod
+		std::uint32_t m_first_index;
+		std::uint32_t m_index_count;
+		std::array< std::uint32_t, 2 > m_padding;
+	};
+
+	static_assert( offsetof( PrimitiveMeshlet, m_bounds_extent ) == 16 );
+	static_assert( offsetof( PrimitiveMeshlet, m_cone_cutoff ) == 44 );
+	static_assert( offsetof( PrimitiveMeshlet, m_first_index ) == 48 );
+	static_assert( sizeof( PrimitiveMeshlet ) == 64 );
+
+	//! Range of a primitive's meshlets within ModelGPUBuffers::m_meshlets
+	struct PrimitiveMeshletRange
+	{
+		std::uint32_t m_first;
+		std::uint32_t m_count;
+	};
+
+	//! Meshlets owned by a primitive, The range is returned to ModelGPUBuffers::m_meshlets once this is destroyed
+	class PrimitiveMeshletAllocation
+	{
+		PrimitiveMeshletRange m_range;
+
+	  public:
+
+		explicit PrimitiveMeshletAllocation( const PrimitiveMeshletRange range ) : m_range( range ) {}
+
+		FGL_DELETE_COPY( PrimitiveMeshletAllocation );
+		FGL_DELETE_MOVE( PrimitiveMeshletAllocation );
+
+		~PrimitiveMeshletAllocation();
+
+		const PrimitiveMeshletRange& range() const { return m_range; }
+	};
+
 	struct PrimitiveRenderInfo
 	{
 		//! First vertex in the buffer
 		std::uint32_t m_first_vert;
-		//! First index
-		std::uint32_t m_first_index;
-		//! Number of indicies
-		std::uint32_t m_num_indicies;
+		//! IndexBatch the primitive is drawn in, Matching the type of it's indicies
+		std::uint32_t m_index_batch;
+		//! Number of valid entries in m_lods
+		std::uint32_t m_lod_count;
+		//! Number of meshlets the full detail level is split into. 0 if the primitive is only culled as a whole
+		std::uint32_t m_meshlet_count;
+
+		//! Model space bounds of the primitive. Used for culling
+		alignas( 4 * 4 ) glm::vec3 m_bounds_center;
+		alignas( 4 * 4 ) glm::vec3 m_bounds_extent;
+
+		//! Ordered from full detail to the coarsest level. The culling pass picks one per instance
+		std::array< PrimitiveLod, MAX_LODS > m_lods;
+
+		//! First of the primitive's meshlets within ModelGPUBuffers::m_meshlets
+		std::uint32_t m_first_meshlet;
+		std::array< std::uint32_t, 3 > m_padding;
 	};
 
+	static_assert( offsetof( PrimitiveRenderInfo, m_lod_count ) == 8 );
+	static_assert( offsetof( PrimitiveRenderInfo, m_meshlet_count ) == 12 );
+	static_assert( offsetof( PrimitiveRenderInfo, m_bounds_center ) == 16 );
+	static_assert( offsetof( PrimitiveRenderInfo, m_bounds_extent ) == 32 );
+	static_assert( offsetof( PrimitiveRenderInfo, m_lods ) == 48 );
+	static_assert( offsetof( PrimitiveRenderInfo, m_first_meshlet ) == 48 + sizeof( PrimitiveLod ) * MAX_LODS );
+	static_assert( sizeof( PrimitiveRenderInfo ) == 64 + sizeof( PrimitiveLod ) * MAX_LODS );
+
 	using PrimitiveRenderInfoIndex = IndexedVector< PrimitiveRenderInfo >::Index;
 
 	struct PrimitiveInstanceInfo
@@ -78,6 +162,12 @@ namespace fgl::engine
 		OrientedBoundingBox< CoordinateSpace::Model > m_bounding_box;
 		PrimitiveMode m_mode;
 
+		//! Levels of detail within m_index_buffer, The first is the full detail level
+		std::vector< PrimitiveLod > m_lods;
+
+		//! Meshlets of the full detail level, nullptr if the primitive is only culled as a whole
+		std::shared_ptr< PrimitiveMeshletAllocation > m_meshlets;
+
 		std::shared_ptr< PrimitiveRenderInfoIndex > m_primitive_info;
 
 		std::shared_ptr< Material > default_material;
@@ -89,11 +179,20 @@ namespace fgl::engine
 
 		std::shared_ptr< PrimitiveRenderInfoIndex > buildRenderInfo();
 
+		//! Range of the meshlets within ModelGPUBuffers::m_meshlets, Empty if there are none
+		PrimitiveMeshletRange meshletRange() const;
+
+		//! Allows the vertex and index buffers to be moved by defragmentation. The render info is updated when they move.
+		void enableRelocation();
+
+		//! If no levels of detail are given the entire index buffer is the only level
 		Primitive(
 			VertexBufferSuballocation&& vertex_buffer,
 			IndexBufferSuballocation&& index_buffer,
 			const OrientedBoundingBox< CoordinateSpace::Model >& bounding_box,
-			PrimitiveMode mode ) noexcept;
+			PrimitiveMode mode,
+			std::vector< PrimitiveLod >&& lods = {},
+			std::shared_ptr< PrimitiveMeshletAllocation >&& meshlets = {} ) noexcept;
 
 		Primitive(
 			VertexBufferSuballocation&& vertex_buffer,
@@ -115,6 +214,17 @@ namespace fgl::engine
 			memory::Buffer& vertex_buffer,
 			memory::Buffer& index_buffer );
 
+		//! Creates a primitive straight from already processed data, Such as a cooked mesh
+		static Primitive fromVerts(
+			std::span< const ModelVertex > verts,
+			PrimitiveMode mode,
+			std::span< const std::uint32_t > indicies,
+			const OrientedBoundingBox< CoordinateSpace::Model >& bounds,
+			memory::Buffer& vertex_buffer,
+			memory::Buffer& index_buffer,
+			std::span< const PrimitiveLod > lods = {},
+			std::span< const PrimitiveMeshlet > meshlets = {} );
+
 		OrientedBoundingBox< CoordinateSpace::Model > getBoundingBox() const;
 	};
 
@@ -82,6 +82,13 @@ namespace fgl::engine
 			}
 		}
 
+		//! Adds an attribute with an explicit format, For packed types that could map to more then one format
+		template < std::size_t offset >
+		void add( std::size_t binding, vk::Format attribute_format )
+		{
+			m_attributes.emplace_back( m_location_counter++, binding, attribute_format, offset );
+		}
+
 		[[nodiscard]] auto get() const { return m_attributes; }
 	};
 
@@ -0,0 +1,46 @@
+//
+// Created by kj16209 on 10/17/26.
+//
+
+#include "VertexBufferSuballocation.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "ModelVertex.hpp"
+#include "engine/assets/transfer/TransferManager.hpp"
+
+namespace fgl::engine
+{
+
+	VertexBufferSuballocation::VertexBufferSuballocation(
+		memory::Buffer& buffer,
+		const std::span< const ModelVertex > verts,
+		const OrientedBoundingBox< CoordinateSpace::Model >& bounds ) :
+	  BufferVector( buffer, static_cast< std::uint32_t >( verts.size() ), vertexStride( vertexFormat() ) )
+	{
+		if ( verts.empty() ) return;
+
+		auto& transfer_manager { memory::TransferManager::getInstance() };
+
+		if ( vertexFormat() == VertexFormat::Full )
+		{
+			transfer_manager.copyToVector< std::byte, VertexBufferSuballocation >( std::as_bytes( verts ), *this );
+			return;
+		}
+
+		const auto [ center, extent ] { renderBounds( bounds ) };
+
+		std::vector< PackedModelVertex > packed( verts.size() );
+		std::ranges::transform(
+			verts,
+			packed.begin(),
+			[ &center, &extent ]( const ModelVertex& vertex )
+			{ return PackedModelVertex::pack( vertex, center, extent ); } );
+
+		transfer_manager.copyToVector<
+			std::byte,
+			VertexBufferSuballocation >( std::as_bytes( std::span< const PackedModelVertex >( packed ) ), *this );
+	}
+
+} // namespace fgl::engine
@@ -0,0 +1,37 @@
+//
+// Created by kj16209 on 10/17/26.
+//
+
+#pragma once
+
+#include <span>
+
+#include "PackedModelVertex.hpp"
+#include "engine/FGL_DEFINES.hpp"
+#include "engine/memory/buffers/vector/BufferVector.hpp"
+#include "engine/memory/buffers/vector/concepts.hpp"
+#include "engine/primitives/boxes/OrientedBoundingBox.hpp"
+
+namespace fgl::engine
+{
+	struct ModelVertex;
+
+	//! Vertex data of a primitive. Stored in the active VertexFormat, Packed vertices are quantized within the bounds
+	class VertexBufferSuballocation final : public memory::BufferVector, public memory::DeviceVectorBase
+	{
+	  public:
+
+		//! The vertices are staged as raw bytes, Already converted to the active format
+		using Type = std::byte;
+
+		VertexBufferSuballocation(
+			memory::Buffer& buffer,
+			std::span< const ModelVertex > verts,
+			const OrientedBoundingBox< CoordinateSpace::Model >& bounds );
+
+		FGL_DELETE_DEFAULT_CTOR( VertexBufferSuballocation );
+		FGL_DELETE_COPY( VertexBufferSuballocation );
+		FGL_DEFAULT_MOVE( VertexBufferSuballocation );
+	};
+
+} // namespace fgl::engine
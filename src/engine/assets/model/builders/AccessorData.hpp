@@ -0,0 +1,170 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <tracy/Tracy.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+#pragma GCC diagnostic ignored "-Weffc++"
+#include "objectloaders/tiny_gltf.h"
+#pragma GCC diagnostic pop
+
+namespace fgl::engine
+{
+
+	//! Copies the elements of a GLTF accessor into a vector. Scalars are widened to T, Vectors must match T exactly
+	template < typename T >
+	std::vector< T > extractData( const tinygltf::Model& model, const tinygltf::Accessor& accessor )
+	{
+		ZoneScoped;
+		if ( accessor.sparse.isSparse )
+		{
+			//Sparse loading required
+			throw std::runtime_error( "Sparse loading not implemeneted" );
+		}
+
+		const auto& buffer_view { model.bufferViews.at( accessor.bufferView ) };
+		const auto& buffer { model.buffers.at( buffer_view.buffer ) };
+
+		std::vector< T > data {};
+		data.reserve( accessor.count );
+
+		std::uint16_t byte_count { 0 };
+		switch ( accessor.componentType )
+		{
+			default:
+				throw std::runtime_error( "Unhandled access size" );
+			case TINYGLTF_COMPONENT_TYPE_FLOAT:
+				byte_count = 32 / 8;
+				break;
+			case TINYGLTF_COMPONENT_TYPE_BYTE:
+				byte_count = 8 / 8;
+				break;
+			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+				byte_count = 32 / 8;
+				break;
+			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+				byte_count = 16 / 8;
+				break;
+		}
+
+		switch ( accessor.type )
+		{
+			default:
+				throw std::runtime_error( "Unhandled access type" );
+			case TINYGLTF_TYPE_VEC4:
+				byte_count *= 4;
+				break;
+			case TINYGLTF_TYPE_VEC3:
+				byte_count *= 3;
+				break;
+			case TINYGLTF_TYPE_VEC2:
+				byte_count *= 2;
+				break;
+			case TINYGLTF_TYPE_SCALAR:
+				byte_count *= 1;
+				break;
+		}
+
+		// Size of the type we are extracting into
+		constexpr auto T_SIZE { sizeof( T ) };
+
+		// If the type size is smaller then we need. Then we need to throw an error
+		if ( T_SIZE != byte_count )
+		{
+			// If the type is scalar type we can still safely use it without any major worries
+			if ( accessor.type == TINYGLTF_TYPE_SCALAR && T_SIZE >= byte_count )
+			{
+				// If the type is a smaller scalar then we want can still copy the data.
+				// log::warn( "Attempting to copy data of size {} into type of size {}", byte_count, T_SIZE );
+
+				if constexpr ( std::is_scalar_v< T > )
+				{
+					switch ( byte_count )
+					{
+						default:
+							throw std::runtime_error( "Unknown size" );
+						case 1:
+							for ( std::size_t i = 0; i < accessor.count; ++i )
+							{
+								std::uint8_t tmp {};
+								std::memcpy(
+									&tmp,
+									buffer.data.data() + buffer_view.byteOffset + accessor.byteOffset
+										+ ( i * byte_count ),
+									byte_count );
+								data.emplace_back( static_cast< T >( tmp ) );
+							}
+							return data;
+						case 2:
+							for ( std::size_t i = 0; i < accessor.count; ++i )
+							{
+								std::uint16_t tmp {};
+								std::memcpy(
+									&tmp,
+									buffer.data.data() + buffer_view.byteOffset + accessor.byteOffset
+										+ ( i * byte_count ),
+									byte_count );
+								data.emplace_back( static_cast< T >( tmp ) );
+							}
+							return data;
+						case 4:
+							for ( std::size_t i = 0; i < accessor.count; ++i )
+							{
+								std::uint32_t tmp {};
+								std::memcpy(
+									&tmp,
+									buffer.data.data() + buffer_view.byteOffset + accessor.byteOffset
+										+ ( i * byte_count ),
+									byte_count );
+								data.emplace_back( static_cast< T >( tmp ) );
+							}
+							return data;
+						case 8:
+							for ( std::size_t i = 0; i < accessor.count; ++i )
+							{
+								std::uint64_t tmp {};
+								std::memcpy(
+									&tmp,
+									buffer.data.data() + buffer_view.byteOffset + accessor.byteOffset
+										+ ( i * byte_count ),
+									byte_count );
+								data.emplace_back( static_cast< T >( tmp ) );
+							}
+							return data;
+					}
+				}
+				else
+				{
+					throw std::runtime_error(
+						std::format( "Tried extracting data of size {} into type of size {}", byte_count, T_SIZE ) );
+				}
+			}
+			else
+			{
+				throw std::runtime_error(
+					std::format( "Tried extracting data of size {} into type of size {}", byte_count, T_SIZE ) );
+			}
+		}
+
+		// Size matches perfectly. We can copy the data directly
+		const auto real_size { byte_count * accessor.count };
+
+		data.resize( accessor.count );
+
+		std::memcpy( data.data(), buffer.data.data() + buffer_view.byteOffset + accessor.byteOffset, real_size );
+
+		return data;
+	}
+
+} // namespace fgl::engine
@@ -0,0 +1,301 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "MeshCache.hpp"
+
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <limits>
+
+#include "engine/debug/logging/logging.hpp"
+
+namespace fgl::engine
+{
+
+	std::uint64_t hashSource( const std::span< const std::byte > data, std::uint64_t seed )
+	{
+		ZoneScoped;
+		// FNV-1a over 8 byte words. Only used to detect changes to the source files, Not for security
+		constexpr std::uint64_t PRIME { 0x100000001b3 };
+		std::uint64_t hash { seed ^ 0xcbf29ce484222325 };
+
+		std::size_t i { 0 };
+		for ( ; i + sizeof( std::uint64_t ) <= data.size(); i += sizeof( std::uint64_t ) )
+		{
+			std::uint64_t word {};
+			std::memcpy( &word, data.data() + i, sizeof( word ) );
+			hash = ( hash ^ word ) * PRIME;
+		}
+
+		for ( ; i < data.size(); ++i ) hash = ( hash ^ static_cast< std::uint64_t >( data[ i ] ) ) * PRIME;
+
+		return ( hash ^ data.size() ) * PRIME;
+	}
+
+	std::filesystem::path meshCachePath( const std::uint64_t source_hash )
+	{
+		return std::filesystem::current_path() / "cache" / "meshes" / std::format( "{:016x}.fglmesh", source_hash );
+	}
+
+	static std::uint64_t alignUp( const std::uint64_t value )
+	{
+		return ( value + MESH_CACHE_ALIGNMENT - 1 ) & ~( MESH_CACHE_ALIGNMENT - 1 );
+	}
+
+	MeshCacheWriter::MeshCacheWriter( const std::size_t mesh_count ) : m_meshes( mesh_count )
+	{}
+
+	std::uint64_t MeshCacheWriter::append( const std::span< const std::byte > bytes )
+	{
+		const std::uint64_t offset { alignUp( m_data.size() ) };
+		m_data.resize( offset + bytes.size() );
+		std::memcpy( m_data.data() + offset, bytes.data(), bytes.size() );
+		return offset;
+	}
+
+	void MeshCacheWriter::addPrimitive(
+		const int mesh_idx,
+		const std::size_t primitive_idx,
+		const std::span< const ModelVertex > verts,
+		const std::span< const std::uint32_t > indicies,
+		const std::span< const PrimitiveLod > lods,
+		const std::span< const PrimitiveMeshlet > meshlets,
+		const PrimitiveMode mode,
+		const OrientedBoundingBox< CoordinateSpace::Model >& bounds,
+		const int material,
+		const std::uint32_t flags )
+	{
+		ZoneScoped;
+		CookedPrimitive primitive {};
+		primitive.m_vertex_count = static_cast< std::uint32_t >( verts.size() );
+		primitive.m_index_count = static_cast< std::uint32_t >( indicies.size() );
+		primitive.m_mode = mode;
+		primitive.m_material = material;
+		primitive.m_flags = flags;
+
+		FGL_ASSERT( !lods.empty() && lods.size() <= MAX_LODS, "Primitive must have between 1 and MAX_LODS lods" );
+		primitive.m_lod_count = static_cast< std::uint32_t >( lods.size() );
+		std::ranges::copy( lods, primitive.m_lods.begin() );
+
+		primitive.m_meshlet_count = static_cast< std::uint32_t >( meshlets.size() );
+
+		glm::vec3 min { std::numeric_limits< float >::max() };
+		glm::vec3 max { std::numeric_limits< float >::lowest() };
+
+		for ( const auto& point : bounds.points() )
+		{
+			min = glm::min( min, point.vec() );
+			max = glm::max( max, point.vec() );
+		}
+
+		primitive.m_bounds_center = ( min + max ) * 0.5f;
+		primitive.m_bounds_extent = ( max - min ) * 0.5f;
+
+		std::lock_guard guard { m_mtx };
+
+		primitive.m_vertex_offset = append( std::as_bytes( verts ) );
+		primitive.m_index_offset = append( std::as_bytes( indicies ) );
+		primitive.m_meshlet_offset = append( std::as_bytes( meshlets ) );
+
+		auto& mesh_primitives { m_meshes.at( static_cast< std::size_t >( mesh_idx ) ) };
+		if ( mesh_primitives.size() <= primitive_idx ) mesh_primitives.resize( primitive_idx + 1 );
+		mesh_primitives[ primitive_idx ] = primitive;
+	}
+
+	void MeshCacheWriter::write( const std::filesystem::path& path, const std::uint64_t source_hash ) const
+	{
+		ZoneScoped;
+		std::lock_guard guard { m_mtx };
+
+		std::vector< CookedMesh > meshes {};
+		std::vector< CookedPrimitive > primitives {};
+		meshes.reserve( m_meshes.size() );
+
+		for ( const auto& mesh_primitives : m_meshes )
+		{
+			meshes.emplace_back(
+				static_cast< std::uint32_t >( primitives.size() ),
+				static_cast< std::uint32_t >( mesh_primitives.size() ) );
+			primitives.insert( primitives.end(), mesh_primitives.begin(), mesh_primitives.end() );
+		}
+
+		const std::uint64_t tables_size { sizeof( CookedMeshHeader ) + std::span( meshes ).size_bytes()
+			                              + std::span( primitives ).size_bytes() };
+
+		CookedMeshHeader header {};
+		header.m_magic = MESH_CACHE_MAGIC;
+		header.m_version = MESH_CACHE_VERSION;
+		header.m_source_hash = source_hash;
+		header.m_vertex_stride = sizeof( ModelVertex );
+		header.m_mesh_count = static_cast< std::uint32_t >( meshes.size() );
+		header.m_primitive_count = static_cast< std::uint32_t >( primitives.size() );
+		header.m_data_offset = alignUp( tables_size );
+		header.m_data_size = m_data.size();
+
+		std::filesystem::create_directories( path.parent_path() );
+
+		std::filesystem::path temp_path { path };
+		temp_path += ".tmp";
+
+		{
+			std::ofstream file { temp_path, std::ios::binary | std::ios::trunc };
+			if ( !file ) throw std::runtime_error( std::format( "Failed to open {} for writing", temp_path.string() ) );
+
+			const auto writeBytes = [ &file ]( const std::span< const std::byte > bytes )
+			{ file.write( reinterpret_cast< const char* >( bytes.data() ), static_cast< std::streamsize >( bytes.size() ) ); };
+
+			writeBytes( std::as_bytes( std::span( &header, 1 ) ) );
+			writeBytes( std::as_bytes( std::span( meshes ) ) );
+			writeBytes( std::as_bytes( std::span( primitives ) ) );
+
+			const std::vector< std::byte > padding( header.m_data_offset - tables_size );
+			writeBytes( padding );
+			writeBytes( m_data );
+
+			if ( !file ) throw std::runtime_error( std::format( "Failed to write {}", temp_path.string() ) );
+		}
+
+		std::filesystem::rename( temp_path, path );
+	}
+
+	MeshCache::MeshCache( filesystem::MappedFile&& file ) :
+	  m_file( std::move( file ) ),
+	  m_header( reinterpret_cast< const CookedMeshHeader* >( m_file.data().data() ) ),
+	  m_meshes(),
+	  m_primitives(),
+	  m_data()
+	{}
+
+	bool MeshCache::validate( const std::uint64_t source_hash ) const
+	{
+		const auto file_data { m_file.data() };
+
+		if ( file_data.size() < sizeof( CookedMeshHeader ) ) return false;
+
+		const CookedMeshHeader& header { *m_header };
+
+		if ( header.m_magic != MESH_CACHE_MAGIC || header.m_version != MESH_CACHE_VERSION ) return false;
+		if ( header.m_source_hash != source_hash || header.m_vertex_stride != sizeof( ModelVertex ) ) return false;
+
+		const std::uint64_t tables_size { sizeof( CookedMeshHeader )
+			                              + std::uint64_t( header.m_mesh_count ) * sizeof( CookedMesh )
+			                              + std::uint64_t( header.m_primitive_count ) * sizeof( CookedPrimitive ) };
+
+		if ( header.m_data_offset < tables_size || header.m_data_offset > file_data.size() ) return false;
+		if ( header.m_data_offset % MESH_CACHE_ALIGNMENT != 0 ) return false;
+		if ( header.m_data_size != file_data.size() - header.m_data_offset ) return false;
+
+		return true;
+	}
+
+	std::optional< MeshCache > MeshCache::open( const std::filesystem::path& path, const std::uint64_t source_hash )
+	{
+		ZoneScoped;
+		if ( !std::filesystem::exists( path ) ) return std::nullopt;
+
+		MeshCache cache { filesystem::MappedFile( path ) };
+
+		if ( !cache.validate( source_hash ) )
+		{
+			log::warn( "Ignoring outdated or invalid mesh cache {}", path.string() );
+			return std::nullopt;
+		}
+
+		const auto file_data { cache.m_file.data() };
+		const CookedMeshHeader& header { *cache.m_header };
+
+		cache.m_meshes = { reinterpret_cast< const CookedMesh* >( file_data.data() + sizeof( CookedMeshHeader ) ),
+			               header.m_mesh_count };
+		cache.m_primitives = { reinterpret_cast< const CookedPrimitive* >(
+								   file_data.data() + sizeof( CookedMeshHeader )
+								   + cache.m_meshes.size_bytes() ),
+			                   header.m_primitive_count };
+		cache.m_data = file_data.subspan( header.m_data_offset );
+
+		for ( const auto& mesh : cache.m_meshes )
+		{
+			if ( std::uint64_t( mesh.m_first_primitive ) + mesh.m_primitive_count > cache.m_primitives.size() )
+				return std::nullopt;
+		}
+
+		for ( const auto& primitive : cache.m_primitives )
+		{
+			const auto vertex_end { primitive.m_vertex_offset
+				                    + std::uint64_t( primitive.m_vertex_count ) * sizeof( ModelVertex ) };
+			const auto index_end { primitive.m_index_offset
+				                   + std::uint64_t( primitive.m_index_count ) * sizeof( std::uint32_t ) };
+
+			const auto meshlet_end { primitive.m_meshlet_offset
+				                     + std::uint64_t( primitive.m_meshlet_count ) * sizeof( PrimitiveMeshlet ) };
+
+			if ( vertex_end > cache.m_data.size() || index_end > cache.m_data.size() ) return std::nullopt;
+			if ( meshlet_end > cache.m_data.size() ) return std::nullopt;
+			if ( primitive.m_vertex_offset % MESH_CACHE_ALIGNMENT != 0 ) return std::nullopt;
+			if ( primitive.m_index_offset % MESH_CACHE_ALIGNMENT != 0 ) return std::nullopt;
+			if ( primitive.m_meshlet_offset % MESH_CACHE_ALIGNMENT != 0 ) return std::nullopt;
+
+			if ( primitive.m_lod_count == 0 || primitive.m_lod_count > MAX_LODS ) return std::nullopt;
+
+			for ( const auto& lod : lods( primitive ) )
+			{
+				if ( std::uint64_t( lod.m_first_index ) + lod.m_index_count > primitive.m_index_count )
+					return std::nullopt;
+			}
+
+			// Every level of detail shares the vertices, So this covers all of them
+			if ( std::ranges::any_of(
+					 cache.indicies( primitive ),
+					 [ &primitive ]( const std::uint32_t index ) { return index >= primitive.m_vertex_count; } ) )
+				return std::nullopt;
+
+			// Meshlets are ranges of the full detail level
+			for ( const auto& meshlet : cache.meshlets( primitive ) )
+			{
+				if ( std::uint64_t( meshlet.m_first_index ) + meshlet.m_index_count > primitive.m_lods[ 0 ].m_index_count )
+					return std::nullopt;
+			}
+		}
+
+		return cache;
+	}
+
+	std::span< const CookedPrimitive > MeshCache::primitives( const int mesh_idx ) const
+	{
+		const CookedMesh& mesh { m_meshes[ static_cast< std::size_t >( mesh_idx ) ] };
+		return m_primitives.subspan( mesh.m_first_primitive, mesh.m_primitive_count );
+	}
+
+	std::span< const ModelVertex > MeshCache::vertices( const CookedPrimitive& primitive ) const
+	{
+		return { reinterpret_cast< const ModelVertex* >( m_data.data() + primitive.m_vertex_offset ),
+			     primitive.m_vertex_count };
+	}
+
+	std::span< const std::uint32_t > MeshCache::indicies( const CookedPrimitive& primitive ) const
+	{
+		return { reinterpret_cast< const std::uint32_t* >( m_data.data() + primitive.m_index_offset ),
+			     primitive.m_index_count };
+	}
+
+	std::span< const PrimitiveLod > MeshCache::lods( const CookedPrimitive& primitive )
+	{
+		return std::span( primitive.m_lods ).first( primitive.m_lod_count );
+	}
+
+	std::span< const PrimitiveMeshlet > MeshCache::meshlets( const CookedPrimitive& primitive ) const
+	{
+		return { reinterpret_cast< const PrimitiveMeshlet* >( m_data.data() + primitive.m_meshlet_offset ),
+			     primitive.m_meshlet_count };
+	}
+
+	OrientedBoundingBox< CoordinateSpace::Model > MeshCache::bounds( const CookedPrimitive& primitive )
+	{
+		return { Coordinate< CoordinateSpace::Model >( primitive.m_bounds_center ), primitive.m_bounds_extent };
+	}
+
+} // namespace fgl::engine
@@ -0,0 +1,173 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "engine/assets/model/ModelVertex.hpp"
+#include "engine/assets/model/Primitive.hpp"
+#include "engine/filesystem/MappedFile.hpp"
+
+namespace fgl::engine
+{
+
+	/**
+	 * Cooked meshes are stored as a single file per scene, Named after the hash of the scene's source files.
+	 *
+	 * Layout:
+	 * - CookedMeshHeader
+	 * - CookedMesh[ mesh_count ] (Indexed by GLTF mesh index, Meshes not used by any node have no primitives)
+	 * - CookedPrimitive[ primitive_count ]
+	 * - Vertex, index and meshlet arrays, Each aligned to MESH_CACHE_ALIGNMENT
+	 */
+	constexpr std::uint32_t MESH_CACHE_MAGIC { 0x4D4C4746 }; // "FGLM"
+	//! Must be incremented whenever the layout or the processing of the cooked data changes
+	constexpr std::uint32_t MESH_CACHE_VERSION { 6 };
+	constexpr std::uint64_t MESH_CACHE_ALIGNMENT { 16 };
+
+	enum CookedPrimitiveFlags : std::uint32_t
+	{
+		//! The primitive had a TEXCOORD_0 attribute, And should be given it's material
+		COOKED_HAS_TEXCOORD = 1 << 0
+	};
+
+	struct CookedMeshHeader
+	{
+		std::uint32_t m_magic;
+		std::uint32_t m_version;
+		std::uint64_t m_source_hash;
+		//! sizeof( ModelVertex ) at the time of cooking
+		std::uint32_t m_vertex_stride;
+		std::uint32_t m_mesh_count;
+		std::uint32_t m_primitive_count;
+		std::uint32_t m_padding;
+		//! Offset of the vertex and index arrays from the start of the file
+		std::uint64_t m_data_offset;
+		//! Bytes from m_data_offset to the end of the file. Anything else means the file was cut short or appended to
+		std::uint64_t m_data_size;
+	};
+
+	struct CookedMesh
+	{
+		std::uint32_t m_first_primitive;
+		std::uint32_t m_primitive_count;
+	};
+
+	struct CookedPrimitive
+	{
+		//! Offsets from CookedMeshHeader::m_data_offset
+		std::uint64_t m_vertex_offset;
+		std::uint64_t m_index_offset;
+		std::uint32_t m_vertex_count;
+		std::uint32_t m_index_count;
+
+		std::int32_t m_mode;
+		//! GLTF material index, -1 if the primitive has no material
+		std::int32_t m_material;
+		std::uint32_t m_flags;
+		std::uint32_t m_lod_count;
+
+		//! Model space bounds
+		glm::vec3 m_bounds_center;
+		glm::vec3 m_bounds_extent;
+
+		//! Levels of detail within the index array, See Primitive::m_lods
+		std::array< PrimitiveLod, MAX_LODS > m_lods;
+
+		//! Offset from CookedMeshHeader::m_data_offset. See Primitive::m_meshlets
+		std::uint64_t m_meshlet_offset;
+		std::uint32_t m_meshlet_count;
+		std::uint32_t m_padding;
+	};
+
+	static_assert( sizeof( CookedMeshHeader ) == 48 );
+	static_assert( sizeof( CookedMesh ) == 8 );
+	static_assert( sizeof( CookedPrimitive ) == 80 + sizeof( PrimitiveLod ) * MAX_LODS );
+	static_assert( std::is_trivially_copyable_v< PrimitiveMeshlet > );
+	static_assert( std::is_trivially_copyable_v< ModelVertex > );
+
+	//! Hashes the bytes of the source files of a scene. Used to key and validate the cooked meshes
+	std::uint64_t hashSource( std::span< const std::byte > data, std::uint64_t seed );
+
+	//! Location of the cooked meshes for a source hash
+	std::filesystem::path meshCachePath( std::uint64_t source_hash );
+
+	//! Collects processed primitives and writes them out as a cooked mesh file. Safe to use from any thread
+	class MeshCacheWriter
+	{
+		//! Indexed by mesh, Then by primitive within the mesh
+		std::vector< std::vector< CookedPrimitive > > m_meshes;
+		std::vector< std::byte > m_data {};
+
+		mutable std::mutex m_mtx {};
+
+		//! Appends the bytes to m_data, Returning the aligned offset they were written at
+		std::uint64_t append( std::span< const std::byte > bytes );
+
+	  public:
+
+		explicit MeshCacheWriter( std::size_t mesh_count );
+
+		void addPrimitive(
+			int mesh_idx,
+			std::size_t primitive_idx,
+			std::span< const ModelVertex > verts,
+			std::span< const std::uint32_t > indicies,
+			std::span< const PrimitiveLod > lods,
+			std::span< const PrimitiveMeshlet > meshlets,
+			PrimitiveMode mode,
+			const OrientedBoundingBox< CoordinateSpace::Model >& bounds,
+			int material,
+			std::uint32_t flags );
+
+		//! Writes to a temporary file first, So a partial write is never seen as a valid cache
+		void write( const std::filesystem::path& path, std::uint64_t source_hash ) const;
+	};
+
+	//! Memory mapped view of a cooked mesh file
+	class MeshCache
+	{
+		filesystem::MappedFile m_file;
+
+		const CookedMeshHeader* m_header;
+		std::span< const CookedMesh > m_meshes;
+		std::span< const CookedPrimitive > m_primitives;
+		std::span< const std::byte > m_data;
+
+		MeshCache( filesystem::MappedFile&& file );
+
+		//! Checks the header matches the source and the size of the file
+		bool validate( std::uint64_t source_hash ) const;
+
+	  public:
+
+		/**
+		 * @brief Returns std::nullopt if there is no cache, Or it is for a different source, version, or vertex format
+		 * @details Every table, array and index is checked to be within bounds, So a corrupted file is rejected instead
+		 * of being uploaded
+		 */
+		static std::optional< MeshCache > open( const std::filesystem::path& path, std::uint64_t source_hash );
+
+		std::size_t meshCount() const { return m_meshes.size(); }
+
+		std::span< const CookedPrimitive > primitives( int mesh_idx ) const;
+
+		std::span< const ModelVertex > vertices( const CookedPrimitive& primitive ) const;
+		std::span< const std::uint32_t > indicies( const CookedPrimitive& primitive ) const;
+
+		static std::span< const PrimitiveLod > lods( const CookedPrimitive& primitive );
+
+		std::span< const PrimitiveMeshlet > meshlets( const CookedPrimitive& primitive ) const;
+
+		static OrientedBoundingBox< CoordinateSpace::Model > bounds( const CookedPrimitive& primitive );
+	};
+
+} // namespace fgl::engine
@@ -0,0 +1,798 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "MeshOptimizer.hpp"
+
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "engine/assets/model/ModelVertex.hpp"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Weffc++"
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#pragma GCC diagnostic pop
+
+namespace fgl::engine
+{
+	constexpr std::uint32_t INVALID_VERTEX { std::numeric_limits< std::uint32_t >::max() };
+
+	//! Triangles using each vertex, Stored as one array with an offset for each vertex
+	struct VertexAdjacency
+	{
+		std::vector< std::uint32_t > m_offsets;
+		std::vector< std::uint32_t > m_triangles;
+
+		VertexAdjacency( const std::vector< std::uint32_t >& indicies, const std::size_t vertex_count ) :
+		  m_offsets( vertex_count + 1, 0 ),
+		  m_triangles( indicies.size() )
+		{
+			for ( const auto index : indicies ) ++m_offsets[ index + 1 ];
+
+			std::partial_sum( m_offsets.begin(), m_offsets.end(), m_offsets.begin() );
+
+			std::vector< std::uint32_t > cursor { m_offsets.begin(), m_offsets.end() - 1 };
+
+			for ( std::size_t i = 0; i < indicies.size(); ++i )
+				m_triangles[ cursor[ indicies[ i ] ]++ ] = static_cast< std::uint32_t >( i / 3 );
+		}
+
+		std::span< const std::uint32_t > triangles( const std::uint32_t vertex ) const
+		{
+			return std::span( m_triangles ).subspan( m_offsets[ vertex ], m_offsets[ vertex + 1 ] - m_offsets[ vertex ] );
+		}
+	};
+
+	std::vector< std::uint32_t > optimizeVertexCache( std::vector< std::uint32_t >& indicies, const std::size_t vertex_count )
+	{
+		ZoneScoped;
+		const std::size_t triangle_count { indicies.size() / 3 };
+		if ( triangle_count == 0 ) return {};
+
+		const VertexAdjacency adjacency { indicies, vertex_count };
+
+		//! Triangles that have not been emitted yet, For each vertex
+		std::vector< std::uint32_t > live_triangles( vertex_count );
+		for ( std::uint32_t v = 0; v < vertex_count; ++v )
+			live_triangles[ v ] = static_cast< std::uint32_t >( adjacency.triangles( v ).size() );
+
+		//! Time each vertex last entered the cache
+		std::vector< std::uint32_t > cache_time( vertex_count, 0 );
+		std::vector< bool > emitted( triangle_count, false );
+
+		//! Recently used vertices, Used to find somewhere close to continue from when the current fan runs out
+		std::vector< std::uint32_t > dead_end {};
+		std::vector< std::uint32_t > candidates {};
+
+		std::vector< std::uint32_t > output {};
+		output.reserve( indicies.size() );
+
+		std::vector< std::uint32_t > clusters { 0 };
+
+		std::uint32_t time { VERTEX_CACHE_SIZE + 1 };
+		std::uint32_t cursor { 0 };
+
+		const auto skipDeadEnd = [ & ]() -> std::uint32_t
+		{
+			while ( !dead_end.empty() )
+			{
+				const std::uint32_t vertex { dead_end.back() };
+				dead_end.pop_back();
+				if ( live_triangles[ vertex ] > 0 ) return vertex;
+			}
+
+			for ( ; cursor < vertex_count; ++cursor )
+				if ( live_triangles[ cursor ] > 0 ) return cursor;
+
+			return INVALID_VERTEX;
+		};
+
+		std::uint32_t fan { skipDeadEnd() };
+
+		while ( fan != INVALID_VERTEX )
+		{
+			candidates.clear();
+
+			for ( const auto triangle : adjacency.triangles( fan ) )
+			{
+				if ( emitted[ triangle ] ) continue;
+				emitted[ triangle ] = true;
+
+				for ( std::size_t i = 0; i < 3; ++i )
+				{
+					const std::uint32_t vertex { indicies[ triangle * 3 + i ] };
+
+					output.emplace_back( vertex );
+					dead_end.emplace_back( vertex );
+					candidates.emplace_back( vertex );
+					--live_triangles[ vertex ];
+
+					if ( time - cache_time[ vertex ] > VERTEX_CACHE_SIZE ) cache_time[ vertex ] = time++;
+				}
+			}
+
+			// Prefer the candidate that is still in the cache, And will stay in it while it's fan is emitted
+			std::uint32_t next { INVALID_VERTEX };
+			std::int64_t best_priority { -1 };
+
+			for ( const auto vertex : candidates )
+			{
+				if ( live_triangles[ vertex ] == 0 ) continue;
+
+				std::int64_t priority { 0 };
+				const std::int64_t age { time - cache_time[ vertex ] };
+
+				if ( age + 2 * live_triangles[ vertex ] <= VERTEX_CACHE_SIZE ) priority = age;
+
+				if ( priority > best_priority )
+				{
+					best_priority = priority;
+					next = vertex;
+				}
+			}
+
+			if ( next == INVALID_VERTEX )
+			{
+				next = skipDeadEnd();
+
+				// Nothing nearby in the cache, So everything after this is a new cluster
+				if ( output.size() / 3 < triangle_count ) clusters.emplace_back( output.size() / 3 );
+			}
+
+			fan = next;
+		}
+
+		indicies = std::move( output );
+
+		return clusters;
+	}
+
+	void optimizeOverdraw(
+		std::vector< std::uint32_t >& indicies,
+		const std::span< const std::uint32_t > clusters,
+		const std::vector< ModelVertex >& verts )
+	{
+		ZoneScoped;
+		const std::size_t triangle_count { indicies.size() / 3 };
+		if ( clusters.size() <= 1 ) return;
+
+		struct Cluster
+		{
+			std::uint32_t m_first;
+			std::uint32_t m_last;
+			glm::vec3 m_centroid { 0.0f };
+			glm::vec3 m_normal { 0.0f };
+			float m_sort_key { 0.0f };
+		};
+
+		std::vector< Cluster > sorted {};
+		sorted.reserve( clusters.size() );
+
+		glm::vec3 mesh_centroid { 0.0f };
+		float mesh_area { 0.0f };
+
+		for ( std::size_t i = 0; i < clusters.size(); ++i )
+		{
+			Cluster cluster {};
+			cluster.m_first = clusters[ i ];
+			cluster.m_last =
+				i + 1 < clusters.size() ? clusters[ i + 1 ] : static_cast< std::uint32_t >( triangle_count );
+
+			float cluster_area { 0.0f };
+
+			for ( std::uint32_t triangle = cluster.m_first; triangle < cluster.m_last; ++triangle )
+			{
+				const glm::vec3& p0 { verts[ indicies[ triangle * 3 + 0 ] ].m_position };
+				const glm::vec3& p1 { verts[ indicies[ triangle * 3 + 1 ] ].m_position };
+				const glm::vec3& p2 { verts[ indicies[ triangle * 3 + 2 ] ].m_position };
+
+				// Length of the cross product is twice the area, Which cancels out in the weighted average
+				const glm::vec3 normal { glm::cross( p1 - p0, p2 - p0 ) };
+				const float area { glm::length( normal ) };
+
+				cluster.m_centroid += ( p0 + p1 + p2 ) * ( area / 3.0f );
+				cluster.m_normal += normal;
+				cluster_area += area;
+			}
+
+			mesh_centroid += cluster.m_centroid;
+			mesh_area += cluster_area;
+
+			if ( cluster_area > 0.0f ) cluster.m_centroid /= cluster_area;
+
+			sorted.emplace_back( cluster );
+		}
+
+		if ( mesh_area > 0.0f ) mesh_centroid /= mesh_area;
+
+		for ( auto& cluster : sorted )
+		{
+			const float normal_length { glm::length( cluster.m_normal ) };
+			if ( normal_length > 0.0f )
+				cluster.m_sort_key = glm::dot( cluster.m_centroid - mesh_centroid, cluster.m_normal / normal_length );
+		}
+
+		std::ranges::
+			stable_sort( sorted, []( const Cluster& a, const Cluster& b ) { return a.m_sort_key > b.m_sort_key; } );
+
+		std::vector< std::uint32_t > output {};
+		output.reserve( indicies.size() );
+
+		for ( const auto& cluster : sorted )
+			output.insert(
+				output.end(), indicies.begin() + cluster.m_first * 3, indicies.begin() + cluster.m_last * 3 );
+
+		indicies = std::move( output );
+	}
+
+	void optimizeVertexFetch( std::vector< ModelVertex >& verts, std::vector< std::uint32_t >& indicies )
+	{
+		ZoneScoped;
+		std::vector< std::uint32_t > remap( verts.size(), INVALID_VERTEX );
+
+		std::vector< ModelVertex > output {};
+		output.reserve( verts.size() );
+
+		for ( auto& index : indicies )
+		{
+			if ( remap[ index ] == INVALID_VERTEX )
+			{
+				remap[ index ] = static_cast< std::uint32_t >( output.size() );
+				output.emplace_back( verts[ index ] );
+			}
+
+			index = remap[ index ];
+		}
+
+		verts = std::move( output );
+	}
+
+	void optimizeMesh( std::vector< ModelVertex >& verts, std::vector< std::uint32_t >& indicies )
+	{
+		ZoneScoped;
+		const auto clusters { optimizeVertexCache( indicies, verts.size() ) };
+		optimizeOverdraw( indicies, clusters, verts );
+		optimizeVertexFetch( verts, indicies );
+	}
+
+	std::uint64_t vertexCacheMisses( const std::span< const std::uint32_t > indicies, const std::size_t vertex_count )
+	{
+		// Time each vertex entered the cache. A vertex is cached if fewer than VERTEX_CACHE_SIZE vertices entered after it
+		std::vector< std::uint64_t > entered( vertex_count, 0 );
+		std::uint64_t misses { 0 };
+
+		for ( const auto index : indicies )
+		{
+			if ( entered[ index ] != 0 && misses - entered[ index ] < VERTEX_CACHE_SIZE ) continue;
+
+			++misses;
+			entered[ index ] = misses;
+		}
+
+		return misses;
+	}
+
+	//! Sum of the squared distances to a set of planes, As a symmetric 4x4 matrix
+	struct Quadric
+	{
+		double m_xx { 0.0 }, m_xy { 0.0 }, m_xz { 0.0 }, m_xw { 0.0 };
+		double m_yy { 0.0 }, m_yz { 0.0 }, m_yw { 0.0 };
+		double m_zz { 0.0 }, m_zw { 0.0 };
+		double m_ww { 0.0 };
+
+		//! Plane of the triangle. Degenerate triangles give an empty quadric
+		static Quadric fromTriangle( const glm::vec3& a, const glm::vec3& b, const glm::vec3& c )
+		{
+			const glm::vec3 normal { glm::cross( b - a, c - a ) };
+			const float length { glm::length( normal ) };
+			if ( length <= 0.0f ) return {};
+
+			const double x { normal.x / length };
+			const double y { normal.y / length };
+			const double z { normal.z / length };
+			const double w { -( x * a.x + y * a.y + z * a.z ) };
+
+			return { x * x, x * y, x * z, x * w, y * y, y * z, y * w, z * z, z * w, w * w };
+		}
+
+		Quadric& operator+=( const Quadric& other )
+		{
+			m_xx += other.m_xx;
+			m_xy += other.m_xy;
+			m_xz += other.m_xz;
+			m_xw += other.m_xw;
+			m_yy += other.m_yy;
+			m_yz += other.m_yz;
+			m_yw += other.m_yw;
+			m_zz += other.m_zz;
+			m_zw += other.m_zw;
+			m_ww += other.m_ww;
+			return *this;
+		}
+
+		double error( const glm::vec3& point ) const
+		{
+			const double x { point.x };
+			const double y { point.y };
+			const double z { point.z };
+
+			return x * ( m_xx * x + 2.0 * ( m_xy * y + m_xz * z + m_xw ) )
+			     + y * ( m_yy * y + 2.0 * ( m_yz * z + m_yw ) ) + z * ( m_zz * z + 2.0 * m_zw ) + m_ww;
+		}
+	};
+
+	//! Vertices that can not be collapsed without tearing the mesh. Borders, And seams where vertices share a position
+	static std::vector< bool >
+		findLockedVertices( const std::span< const ModelVertex > verts, const std::span< const std::uint32_t > indicies )
+	{
+		const std::size_t vertex_count { verts.size() };
+
+		std::vector< std::uint32_t > order( vertex_count );
+		std::iota( order.begin(), order.end(), 0 );
+
+		const auto position_less = [ &verts ]( const std::uint32_t a, const std::uint32_t b )
+		{
+			const glm::vec3& pa { verts[ a ].m_position };
+			const glm::vec3& pb { verts[ b ].m_position };
+			if ( pa.x != pb.x ) return pa.x < pb.x;
+			if ( pa.y != pb.y ) return pa.y < pb.y;
+			return pa.z < pb.z;
+		};
+
+		std::ranges::sort( order, position_less );
+
+		// Welded vertices point at the first vertex with the same position, So edges across a seam are shared
+		std::vector< std::uint32_t > weld( vertex_count );
+		std::vector< bool > locked( vertex_count, false );
+
+		for ( std::size_t first = 0; first < vertex_count; )
+		{
+			std::size_t last { first + 1 };
+			while ( last < vertex_count && !position_less( order[ first ], order[ last ] ) ) ++last;
+
+			for ( std::size_t i = first; i < last; ++i )
+			{
+				weld[ order[ i ] ] = order[ first ];
+				locked[ order[ i ] ] = last - first > 1;
+			}
+
+			first = last;
+		}
+
+		std::vector< std::uint64_t > edges {};
+		edges.reserve( indicies.size() );
+
+		for ( std::size_t i = 0; i + 2 < indicies.size(); i += 3 )
+		{
+			for ( std::size_t corner = 0; corner < 3; ++corner )
+			{
+				const auto a { weld[ indicies[ i + corner ] ] };
+				const auto b { weld[ indicies[ i + ( corner + 1 ) % 3 ] ] };
+				edges.emplace_back( ( std::uint64_t( std::min( a, b ) ) << 32 ) | std::max( a, b ) );
+			}
+		}
+
+		std::ranges::sort( edges );
+
+		// Edges with one triangle are on the border, More than two is non manifold
+		for ( std::size_t first = 0; first < edges.size(); )
+		{
+			std::size_t last { first + 1 };
+			while ( last < edges.size() && edges[ last ] == edges[ first ] ) ++last;
+
+			if ( last - first != 2 )
+			{
+				locked[ static_cast< std::uint32_t >( edges[ first ] >> 32 ) ] = true;
+				locked[ static_cast< std::uint32_t >( edges[ first ] ) ] = true;
+			}
+
+			first = last;
+		}
+
+		return locked;
+	}
+
+	//! True if collapsing would flip, Or fold over, Any of the triangles that remain around the vertex
+	static bool collapseFlips(
+		const std::uint32_t from,
+		const std::uint32_t to,
+		const VertexAdjacency& adjacency,
+		const std::vector< std::uint32_t >& indicies,
+		const std::span< const ModelVertex > verts )
+	{
+		// Triangles may only turn up to ~75 degrees
+		constexpr float MIN_NORMAL_DOT { 0.25f };
+
+		for ( const auto triangle : adjacency.triangles( from ) )
+		{
+			const std::uint32_t* corners { indicies.data() + triangle * 3 };
+
+			// Removed by the collapse
+			if ( corners[ 0 ] == to || corners[ 1 ] == to || corners[ 2 ] == to ) continue;
+
+			glm::vec3 before[ 3 ];
+			glm::vec3 after[ 3 ];
+
+			for ( std::size_t i = 0; i < 3; ++i )
+			{
+				before[ i ] = verts[ corners[ i ] ].m_position;
+				after[ i ] = corners[ i ] == from ? verts[ to ].m_position : before[ i ];
+			}
+
+			const glm::vec3 normal_before { glm::cross( before[ 1 ] - before[ 0 ], before[ 2 ] - before[ 0 ] ) };
+			const glm::vec3 normal_after { glm::cross( after[ 1 ] - after[ 0 ], after[ 2 ] - after[ 0 ] ) };
+
+			const float lengths { glm::length( normal_before ) * glm::length( normal_after ) };
+			if ( lengths <= 0.0f ) return true;
+
+			if ( glm::dot( normal_before, normal_after ) < MIN_NORMAL_DOT * lengths ) return true;
+		}
+
+		return false;
+	}
+
+	float simplifyMesh(
+		std::vector< std::uint32_t >& indicies,
+		const std::span< const ModelVertex > verts,
+		const std::size_t target_index_count )
+	{
+		ZoneScoped;
+		const std::size_t vertex_count { verts.size() };
+
+		const std::vector< bool > locked { findLockedVertices( verts, indicies ) };
+
+		std::vector< Quadric > quadrics( vertex_count );
+
+		for ( std::size_t i = 0; i + 2 < indicies.size(); i += 3 )
+		{
+			const Quadric plane { Quadric::fromTriangle(
+				verts[ indicies[ i ] ].m_position,
+				verts[ indicies[ i + 1 ] ].m_position,
+				verts[ indicies[ i + 2 ] ].m_position ) };
+
+			for ( std::size_t corner = 0; corner < 3; ++corner ) quadrics[ indicies[ i + corner ] ] += plane;
+		}
+
+		struct Collapse
+		{
+			std::uint32_t m_from;
+			std::uint32_t m_to;
+			double m_cost;
+		};
+
+		std::vector< Collapse > collapses {};
+		std::vector< std::uint32_t > remap( vertex_count );
+		std::vector< bool > touched( vertex_count );
+
+		double max_cost { 0.0 };
+
+		// Each pass collapses the cheapest edges that do not share a neighbourhood, Then rebuilds the triangles
+		while ( indicies.size() > target_index_count )
+		{
+			const VertexAdjacency adjacency { indicies, vertex_count };
+
+			collapses.clear();
+
+			for ( std::size_t i = 0; i < indicies.size(); i += 3 )
+			{
+				for ( std::size_t corner = 0; corner < 3; ++corner )
+				{
+					const auto a { indicies[ i + corner ] };
+					const auto b { indicies[ i + ( corner + 1 ) % 3 ] };
+
+					// Moving a vertex onto another only costs the error of the vertex that moves
+					if ( !locked[ a ] ) collapses.push_back( { a, b, quadrics[ a ].error( verts[ b ].m_position ) } );
+					if ( !locked[ b ] ) collapses.push_back( { b, a, quadrics[ b ].error( verts[ a ].m_position ) } );
+				}
+			}
+
+			std::ranges::sort( collapses, {}, &Collapse::m_cost );
+
+			std::iota( remap.begin(), remap.end(), 0 );
+			touched.assign( vertex_count, false );
+
+			const std::size_t excess { indicies.size() - target_index_count };
+			std::size_t removed { 0 };
+			bool collapsed { false };
+
+			for ( const auto& [ from, to, cost ] : collapses )
+			{
+				if ( removed >= excess ) break;
+				if ( touched[ from ] || touched[ to ] ) continue;
+				if ( collapseFlips( from, to, adjacency, indicies, verts ) ) continue;
+
+				// Triangles around the vertex change, So nothing else in it's neighbourhood can collapse this pass
+				for ( const auto triangle : adjacency.triangles( from ) )
+				{
+					const std::uint32_t* corners { indicies.data() + triangle * 3 };
+
+					for ( std::size_t i = 0; i < 3; ++i ) touched[ corners[ i ] ] = true;
+
+					if ( corners[ 0 ] == to || corners[ 1 ] == to || corners[ 2 ] == to ) removed += 3;
+				}
+
+				remap[ from ] = to;
+				quadrics[ to ] += quadrics[ from ];
+				max_cost = std::max( max_cost, cost );
+				collapsed = true;
+			}
+
+			if ( !collapsed ) break;
+
+			std::size_t write { 0 };
+
+			for ( std::size_t i = 0; i < indicies.size(); i += 3 )
+			{
+				const auto a { remap[ indicies[ i ] ] };
+				const auto b { remap[ indicies[ i + 1 ] ] };
+				const auto c { remap[ indicies[ i + 2 ] ] };
+
+				// Triangles that contained the collapsed edge
+				if ( a == b || b == c || a == c ) continue;
+
+				indicies[ write++ ] = a;
+				indicies[ write++ ] = b;
+				indicies[ write++ ] = c;
+			}
+
+			indicies.resize( write );
+		}
+
+		return static_cast< float >( std::sqrt( std::max( max_cost, 0.0 ) ) );
+	}
+
+	std::vector< MeshLod > generateLods(
+		const std::span< const ModelVertex > verts,
+		const std::span< const std::uint32_t > indicies,
+		const std::size_t max_lods )
+	{
+		ZoneScoped;
+		std::vector< MeshLod > lods {};
+
+		std::vector< std::uint32_t > current { indicies.begin(), indicies.end() };
+		float error { 0.0f };
+
+		while ( lods.size() < max_lods )
+		{
+			const std::size_t previous_count { current.size() };
+			const std::size_t target { previous_count / 6 * 3 };
+
+			if ( target == 0 ) break;
+
+			// Each level is simplified from the previous one, So it's error is on top of the previous level's
+			error += simplifyMesh( current, verts, target );
+
+			// Less than 10% smaller is not worth the indicies, The rest of the mesh is locked
+			if ( current.empty() || current.size() * 10 > previous_count * 9 ) break;
+
+			lods.push_back( { current, error } );
+		}
+
+		return lods;
+	}
+
+	//! Computes the bounds and normal cone of a meshlet, And orders it's triangles for the vertex cache
+	static Meshlet finishMeshlet(
+		std::span< std::uint32_t > meshlet_indicies,
+		const std::uint32_t first_index,
+		const std::span< const ModelVertex > verts,
+		const std::span< const glm::vec3 > normals,
+		const std::span< const std::uint32_t > triangles )
+	{
+		Meshlet meshlet {};
+		meshlet.m_first_index = first_index;
+		meshlet.m_index_count = static_cast< std::uint32_t >( meshlet_indicies.size() );
+
+		glm::vec3 min { std::numeric_limits< float >::max() };
+		glm::vec3 max { std::numeric_limits< float >::lowest() };
+
+		for ( const auto index : meshlet_indicies )
+		{
+			min = glm::min( min, verts[ index ].m_position );
+			max = glm::max( max, verts[ index ].m_position );
+		}
+
+		meshlet.m_center = ( min + max ) * 0.5f;
+		meshlet.m_extent = ( max - min ) * 0.5f;
+
+		glm::vec3 normal_sum { 0.0f };
+		for ( const auto triangle : triangles ) normal_sum += normals[ triangle ];
+
+		const float normal_length { glm::length( normal_sum ) };
+
+		meshlet.m_cone_axis = normal_length > 0.0f ? normal_sum / normal_length : glm::vec3( 0.0f );
+		meshlet.m_cone_cutoff = 1.0f;
+
+		if ( normal_length > 0.0f )
+		{
+			float min_dot { 1.0f };
+
+			for ( const auto triangle : triangles )
+			{
+				// Degenerate triangles are never drawn, So they can face any direction
+				if ( normals[ triangle ] == glm::vec3( 0.0f ) ) continue;
+				min_dot = std::min( min_dot, glm::dot( normals[ triangle ], meshlet.m_cone_axis ) );
+			}
+
+			// The view direction must be within 90 degrees of every normal, Which leaves the sine of the cone's half angle
+			if ( min_dot > 0.0f ) meshlet.m_cone_cutoff = std::sqrt( 1.0f - min_dot * min_dot );
+		}
+
+		// Renumbered to the meshlet's own vertices, So the cache optimization does not touch every vertex of the mesh
+		std::vector< std::uint32_t > local_to_vertex {};
+		std::vector< std::uint32_t > local_indicies( meshlet_indicies.size() );
+
+		for ( std::size_t i = 0; i < meshlet_indicies.size(); ++i )
+		{
+			const auto found { std::ranges::find( local_to_vertex, meshlet_indicies[ i ] ) };
+			local_indicies[ i ] = static_cast< std::uint32_t >( found - local_to_vertex.begin() );
+			if ( found == local_to_vertex.end() ) local_to_vertex.emplace_back( meshlet_indicies[ i ] );
+		}
+
+		optimizeVertexCache( local_indicies, local_to_vertex.size() );
+
+		for ( std::size_t i = 0; i < meshlet_indicies.size(); ++i )
+			meshlet_indicies[ i ] = local_to_vertex[ local_indicies[ i ] ];
+
+		return meshlet;
+	}
+
+	std::vector< Meshlet > buildMeshlets( std::vector< std::uint32_t >& indicies, const std::span< const ModelVertex > verts )
+	{
+		ZoneScoped;
+		const std::size_t triangle_count { indicies.size() / 3 };
+		if ( triangle_count == 0 ) return {};
+
+		const VertexAdjacency adjacency { indicies, verts.size() };
+
+		std::vector< glm::vec3 > normals( triangle_count );
+		std::vector< glm::vec3 > centroids( triangle_count );
+
+		for ( std::size_t triangle = 0; triangle < triangle_count; ++triangle )
+		{
+			const glm::vec3& p0 { verts[ indicies[ triangle * 3 + 0 ] ].m_position };
+			const glm::vec3& p1 { verts[ indicies[ triangle * 3 + 1 ] ].m_position };
+			const glm::vec3& p2 { verts[ indicies[ triangle * 3 + 2 ] ].m_position };
+
+			const glm::vec3 normal { glm::cross( p1 - p0, p2 - p0 ) };
+			const float length { glm::length( normal ) };
+
+			normals[ triangle ] = length > 0.0f ? normal / length : glm::vec3( 0.0f );
+			centroids[ triangle ] = ( p0 + p1 + p2 ) / 3.0f;
+		}
+
+		//! Meshlet each vertex and triangle was last added to, Or considered for. Avoids clearing them for every meshlet
+		std::vector< std::uint32_t > vertex_meshlet( verts.size(), INVALID_VERTEX );
+		std::vector< std::uint32_t > candidate_meshlet( triangle_count, INVALID_VERTEX );
+		std::vector< bool > assigned( triangle_count, false );
+
+		std::vector< std::uint32_t > output {};
+		output.reserve( indicies.size() );
+
+		std::vector< Meshlet > meshlets {};
+		std::vector< std::uint32_t > candidates {};
+		std::vector< std::uint32_t > meshlet_triangles {};
+
+		std::size_t seed { 0 };
+
+		while ( true )
+		{
+			// Each meshlet starts from the first triangle left in the original order, Which is already spatially coherent
+			while ( seed < triangle_count && assigned[ seed ] ) ++seed;
+			if ( seed == triangle_count ) break;
+
+			const auto meshlet_idx { static_cast< std::uint32_t >( meshlets.size() ) };
+			const auto first_index { static_cast< std::uint32_t >( output.size() ) };
+
+			std::size_t vertex_count { 0 };
+			glm::vec3 normal_sum { 0.0f };
+			glm::vec3 centroid_sum { 0.0f };
+			float spread { 0.0f };
+
+			candidates.clear();
+			meshlet_triangles.clear();
+
+			const auto newVertices = [ & ]( const std::uint32_t triangle ) -> std::size_t
+			{
+				const std::uint32_t* corners { indicies.data() + triangle * 3 };
+				std::size_t count { 0 };
+
+				for ( std::size_t i = 0; i < 3; ++i )
+				{
+					// Degenerate triangles can use a vertex twice
+					const bool repeated { ( i > 0 && corners[ i ] == corners[ 0 ] )
+						                  || ( i > 1 && corners[ i ] == corners[ 1 ] ) };
+					if ( !repeated && vertex_meshlet[ corners[ i ] ] != meshlet_idx ) ++count;
+				}
+
+				return count;
+			};
+
+			const auto addTriangle = [ & ]( const std::uint32_t triangle )
+			{
+				assigned[ triangle ] = true;
+				meshlet_triangles.emplace_back( triangle );
+
+				for ( std::size_t i = 0; i < 3; ++i )
+				{
+					const std::uint32_t vertex { indicies[ triangle * 3 + i ] };
+					output.emplace_back( vertex );
+
+					if ( vertex_meshlet[ vertex ] == meshlet_idx ) continue;
+					vertex_meshlet[ vertex ] = meshlet_idx;
+					++vertex_count;
+
+					for ( const auto neighbour : adjacency.triangles( vertex ) )
+					{
+						if ( assigned[ neighbour ] || candidate_meshlet[ neighbour ] == meshlet_idx ) continue;
+						candidate_meshlet[ neighbour ] = meshlet_idx;
+						candidates.emplace_back( neighbour );
+					}
+				}
+
+				normal_sum += normals[ triangle ];
+				centroid_sum += centroids[ triangle ];
+
+				const glm::vec3 center { centroid_sum / static_cast< float >( meshlet_triangles.size() ) };
+				spread = std::max( spread, glm::length( centroids[ triangle ] - center ) );
+			};
+
+			addTriangle( static_cast< std::uint32_t >( seed ) );
+
+			while ( meshlet_triangles.size() < MESHLET_MAX_TRIANGLES )
+			{
+				const float normal_length { glm::length( normal_sum ) };
+				const glm::vec3 axis { normal_length > 0.0f ? normal_sum / normal_length : glm::vec3( 0.0f ) };
+				const glm::vec3 center { centroid_sum / static_cast< float >( meshlet_triangles.size() ) };
+
+				std::uint32_t best { INVALID_VERTEX };
+				float best_score { std::numeric_limits< float >::max() };
+
+				for ( std::size_t i = 0; i < candidates.size(); )
+				{
+					const std::uint32_t triangle { candidates[ i ] };
+					const std::size_t added { newVertices( triangle ) };
+
+					// The vertex count only grows, So a triangle that does not fit now never will
+					if ( assigned[ triangle ] || vertex_count + added > MESHLET_MAX_VERTICES )
+					{
+						candidates[ i ] = candidates.back();
+						candidates.pop_back();
+						continue;
+					}
+
+					// Fewer new vertices first. Then the triangles facing the same way and closest to the meshlet
+					const float distance { glm::length( centroids[ triangle ] - center ) };
+					const float score { static_cast< float >( added ) + ( 1.0f - glm::dot( normals[ triangle ], axis ) )
+						                + distance / ( spread + distance + std::numeric_limits< float >::min() ) };
+
+					if ( score < best_score )
+					{
+						best_score = score;
+						best = triangle;
+					}
+
+					++i;
+				}
+
+				if ( best == INVALID_VERTEX ) break;
+
+				addTriangle( best );
+			}
+
+			meshlets.emplace_back( finishMeshlet(
+				std::span( output ).subspan( first_index ), first_index, verts, normals, meshlet_triangles ) );
+		}
+
+		indicies = std::move( output );
+
+		return meshlets;
+	}
+
+} // namespace fgl::engine
@@ -0,0 +1,96 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Weffc++"
+#include <glm/vec3.hpp>
+#pragma GCC diagnostic pop
+
+namespace fgl::engine
+{
+	struct ModelVertex;
+
+	//! Number of entries in the post transform vertex cache that triangles are ordered for
+	constexpr std::uint32_t VERTEX_CACHE_SIZE { 16 };
+
+	/**
+	 * @brief Reorders the triangles to reuse vertices in the post transform cache (Tipsify, Sander et al. 2007)
+	 * @return The first triangle of each cluster. A new cluster begins wherever the ordering had to jump across the mesh
+	 */
+	std::vector< std::uint32_t > optimizeVertexCache( std::vector< std::uint32_t >& indicies, std::size_t vertex_count );
+
+	/**
+	 * @brief Reorders the clusters given by optimizeVertexCache so clusters facing away from the center are drawn first.
+	 * Those are the most likely to occlude the rest of the mesh, Reducing overdraw without breaking up the clusters
+	 */
+	void optimizeOverdraw(
+		std::vector< std::uint32_t >& indicies,
+		std::span< const std::uint32_t > clusters,
+		const std::vector< ModelVertex >& verts );
+
+	//! Reorders the vertices into the order the indicies first use them, Removing any unused vertices
+	void optimizeVertexFetch( std::vector< ModelVertex >& verts, std::vector< std::uint32_t >& indicies );
+
+	//! Runs every optimization stage over a triangle list
+	void optimizeMesh( std::vector< ModelVertex >& verts, std::vector< std::uint32_t >& indicies );
+
+	/**
+	 * @brief Collapses edges until the triangle list has no more then target_index_count indicies (Garland & Heckbert 1997).
+	 * Vertices are never moved, Only dropped from the indicies, So every level of detail can share the vertex buffer.
+	 * Borders and seams (Vertices sharing a position) are locked, Which can stop the simplification short of the target
+	 * @return Approximate model space distance the simplified surface deviates from the original by
+	 */
+	float simplifyMesh(
+		std::vector< std::uint32_t >& indicies, std::span< const ModelVertex > verts, std::size_t target_index_count );
+
+	//! Simplified version of a triangle list, Drawn with the same vertices
+	struct MeshLod
+	{
+		std::vector< std::uint32_t > m_indicies;
+		//! See simplifyMesh. Accumulated across each level
+		float m_error;
+	};
+
+	//! Builds up to max_lods levels of detail, Each with about half the triangles of the previous. Stops once they stall
+	std::vector< MeshLod > generateLods(
+		std::span< const ModelVertex > verts, std::span< const std::uint32_t > indicies, std::size_t max_lods );
+
+	//! Limits of a meshlet. Small enough to be culled finely, Large enough to still be worth a draw command each
+	constexpr std::size_t MESHLET_MAX_VERTICES { 64 };
+	constexpr std::size_t MESHLET_MAX_TRIANGLES { 124 };
+
+	//! Contiguous range of triangles culled as one
+	struct Meshlet
+	{
+		std::uint32_t m_first_index;
+		std::uint32_t m_index_count;
+
+		//! Model space bounds of the meshlet's vertices
+		glm::vec3 m_center;
+		glm::vec3 m_extent;
+
+		//! Average normal of the triangles. Every triangle faces away from any view direction within
+		//! `dot( view, axis ) >= cutoff * length( view )`. A cutoff of 1 means the meshlet can never be backface culled
+		glm::vec3 m_cone_axis;
+		float m_cone_cutoff;
+	};
+
+	/**
+	 * @brief Groups the triangles into meshlets of at most MESHLET_MAX_VERTICES vertices and MESHLET_MAX_TRIANGLES
+	 * triangles, Reordering the indicies so each meshlet is a contiguous range. Meshlets are grown from the triangles
+	 * sharing the most vertices and facing the same way, Keeping their bounds small and normal cones narrow.
+	 * The triangles within each meshlet are then ordered for the vertex cache
+	 */
+	std::vector< Meshlet > buildMeshlets( std::vector< std::uint32_t >& indicies, std::span< const ModelVertex > verts );
+
+	//! Number of misses in a FIFO cache of VERTEX_CACHE_SIZE entries when drawing the indicies
+	std::uint64_t vertexCacheMisses( std::span< const std::uint32_t > indicies, std::size_t vertex_count );
+
+} // namespace fgl::engine
@@ -26,14 +26,13 @@ namespace fgl::engine
 	void ModelBuilder::loadVerts( const std::vector< ModelVertex >& verts, const std::vector< std::uint32_t >& indicies )
 	{
 		ZoneScoped;
-		VertexBufferSuballocation vertex_suballoc { this->m_vertex_buffer, verts };
+		const OrientedBoundingBox bounding_box { generateBoundingFromVerts( verts ) };
+
+		VertexBufferSuballocation vertex_suballoc { this->m_vertex_buffer, verts, bounding_box };
 		IndexBufferSuballocation index_suballoc { this->m_index_buffer, indicies };
 
 		this->m_primitives.emplace_back(
-			std::move( vertex_suballoc ),
-			std::move( index_suballoc ),
-			generateBoundingFromVerts( verts ),
-			PrimitiveMode::TRIS );
+			std::move( vertex_suballoc ), std::move( index_suballoc ), bounding_box, PrimitiveMode::TRIS );
 	}
 
 } // namespace fgl::engine
\ No newline at end of file
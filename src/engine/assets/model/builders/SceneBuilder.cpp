@@ -12,18 +12,50 @@
 #include "objectloaders/tiny_gltf.h"
 #pragma GCC diagnostic pop
 
+#include "AccessorData.hpp"
+#include "MeshOptimizer.hpp"
+#include "Tangents.hpp"
 #include "assets/model/ModelVertex.hpp"
 #include "engine/assets/stores.hpp"
+#include "engine/assets/texture/TextureCache.hpp"
 #include "engine/camera/Camera.hpp"
 #include "engine/debug/logging/logging.hpp"
 #include "engine/descriptors/DescriptorSet.hpp"
 #include "engine/gameobjects/GameObject.hpp"
+#include "engine/utility/ThreadPool.hpp"
 #include "gameobjects/components/TransformComponent.hpp"
-#include "mikktspace/mikktspace.hpp"
 
 namespace fgl::engine
 {
 
+#if ENABLE_IMPORT_PROFILING
+	static double toMilliseconds( const Clock::duration duration )
+	{
+		return std::chrono::duration< double, std::milli >( duration ).count();
+	}
+#endif
+
+	//! Keeps the encoded image instead of decoding it. SceneBuilder decodes each image once on the thread pool
+	static bool deferImageLoad(
+		tinygltf::Image* image,
+		[[maybe_unused]] const int image_idx,
+		[[maybe_unused]] std::string* err,
+		[[maybe_unused]] std::string* warn,
+		[[maybe_unused]] const int req_width,
+		[[maybe_unused]] const int req_height,
+		const unsigned char* bytes,
+		const int size,
+		[[maybe_unused]] void* user_data )
+	{
+		// Images in a buffer view are read straight from the buffer when decoding
+		if ( image->bufferView != -1 ) return true;
+
+		image->image.assign( bytes, bytes + size );
+		image->as_is = true;
+
+		return true;
+	}
+
 	SceneBuilder::SceneBuilder( const memory::Buffer& vertex_buffer, const memory::Buffer& index_buffer ) :
 	  m_vertex_buffer( vertex_buffer ),
 	  m_index_buffer( index_buffer )
@@ -40,147 +72,6 @@ namespace fgl::engine
 		return counter;
 	}
 
-	template < typename T >
-	std::vector< T > extractData( const tinygltf::Model& model, const tinygltf::Accessor& accessor )
-	{
-		ZoneScoped;
-		if ( accessor.sparse.isSparse )
-		{
-			//Sparse loading required
-			throw std::runtime_error( "Sparse loading not implemeneted" );
-		}
-
-		const auto& buffer_view { model.bufferViews.at( accessor.bufferView ) };
-		const auto& buffer { model.buffers.at( buffer_view.buffer ) };
-
-		std::vector< T > data {};
-		data.reserve( accessor.count );
-
-		std::uint16_t byte_count { 0 };
-		switch ( accessor.componentType )
-		{
-			default:
-				throw std::runtime_error( "Unhandled access size" );
-			case TINYGLTF_COMPONENT_TYPE_FLOAT:
-				byte_count = 32 / 8;
-				break;
-			case TINYGLTF_COMPONENT_TYPE_BYTE:
-				byte_count = 8 / 8;
-				break;
-			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
-				byte_count = 32 / 8;
-				break;
-			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
-				byte_count = 16 / 8;
-				break;
-		}
-
-		switch ( accessor.type )
-		{
-			default:
-				throw std::runtime_error( "Unhandled access type" );
-			case TINYGLTF_TYPE_VEC3:
-				byte_count *= 3;
-				break;
-			case TINYGLTF_TYPE_VEC2:
-				byte_count *= 2;
-				break;
-			case TINYGLTF_TYPE_SCALAR:
-				byte_count *= 1;
-				break;
-		}
-
-		// Size of the type we are extracting into
-		constexpr auto T_SIZE { sizeof( T ) };
-
-		// If the type size is smaller then we need. Then we need to throw an error
-		if ( T_SIZE != byte_count )
-		{
-			// If the type is scalar type we can still safely use it without any major worries
-			if ( accessor.type == TINYGLTF_TYPE_SCALAR && T_SIZE >= byte_count )
-			{
-				// If the type is a smaller scalar then we want can still copy the data.
-				// log::warn( "Attempting to copy data of size {} into type of size {}", byte_count, T_SIZE );
-
-				if constexpr ( std::is_scalar_v< T > )
-				{
-					switch ( byte_count )
-					{
-						default:
-							throw std::runtime_error( "Unknown size" );
-						case 1:
-							for ( std::size_t i = 0; i < accessor.count; ++i )
-							{
-								std::uint8_t tmp {};
-								std::memcpy(
-									&tmp,
-									buffer.data.data() + buffer_view.byteOffset + accessor.byteOffset
-										+ ( i * byte_count ),
-									byte_count );
-								data.emplace_back( static_cast< T >( tmp ) );
-							}
-							return data;
-						case 2:
-							for ( std::size_t i = 0; i < accessor.count; ++i )
-							{
-								std::uint16_t tmp {};
-								std::memcpy(
-									&tmp,
-									buffer.data.data() + buffer_view.byteOffset + accessor.byteOffset
-										+ ( i * byte_count ),
-									byte_count );
-								data.emplace_back( static_cast< T >( tmp ) );
-							}
-							return data;
-						case 4:
-							for ( std::size_t i = 0; i < accessor.count; ++i )
-							{
-								std::uint32_t tmp {};
-								std::memcpy(
-									&tmp,
-									buffer.data.data() + buffer_view.byteOffset + accessor.byteOffset
-										+ ( i * byte_count ),
-									byte_count );
-								data.emplace_back( static_cast< T >( tmp ) );
-							}
-							return data;
-						case 8:
-							for ( std::size_t i = 0; i < accessor.count; ++i )
-							{
-								std::uint64_t tmp {};
-								std::memcpy(
-									&tmp,
-									buffer.data.data() + buffer_view.byteOffset + accessor.byteOffset
-										+ ( i * byte_count ),
-									byte_count );
-								data.emplace_back( static_cast< T >( tmp ) );
-							}
-							return data;
-					}
-				}
-				else
-				{
-					throw std::runtime_error(
-						std::format( "Tried extracting data of size {} into type of size {}", byte_count, T_SIZE ) );
-				}
-			}
-			else
-			{
-				throw std::runtime_error(
-					std::format( "Tried extracting data of size {} into type of size {}", byte_count, T_SIZE ) );
-			}
-		}
-
-		// Size matches perfectly. We can copy the data directly
-		const auto real_size { byte_count * accessor.count };
-
-		data.resize( accessor.count );
-
-		std::memcpy( data.data(), buffer.data.data() + buffer_view.byteOffset + accessor.byteOffset, real_size );
-
-		return data;
-	}
-
 	std::vector< std::uint32_t > SceneBuilder::
 		extractIndicies( const tinygltf::Primitive& prim, const tinygltf::Model& model )
 	{
@@ -193,7 +84,7 @@ namespace fgl::engine
 		}
 		else
 		{
-			//TODO: Figure out any time we can use a smaller indicies value instead of a 32 bit number all the time
+			// Widened for processing. IndexBufferSuballocation narrows them back to 16 bit when every index fits
 			std::vector< std::uint32_t > indicies {};
 
 			const auto tmp { extractData< std::uint32_t >( model, indicies_accessor ) };
@@ -341,7 +232,11 @@ namespace fgl::engine
 		verts.reserve( pos.size() );
 
 		const std::vector< glm::vec3 > normals { extractNormalInfo( prim, root ) };
-		[[maybe_unused]] const std::vector< glm::vec4 > tangents { extractTangentInfo( prim, root ) };
+		const std::vector< glm::vec4 > tangents { extractTangentInfo( prim, root ) };
+		const bool has_tangents { !tangents.empty() };
+
+		if ( has_tangents && tangents.size() != pos.size() )
+			throw std::runtime_error( "Failed to load model. TANGENT count does not match POSITION count" );
 
 		//TODO: If we don't have normals we likely will need to compute them ourselves.
 		// I have no idea if this is actually going to be needed for us. But I might wanna implement it
@@ -357,6 +252,7 @@ namespace fgl::engine
 			vert.m_position = pos[ i ];
 			vert.m_normal = has_normals ? normals[ i ] : glm::vec3();
 			vert.m_uv = has_uv ? uvs[ i ] : glm::vec2();
+			vert.m_tangent = has_tangents ? tangents[ i ] : glm::vec4();
 			vert.m_color = glm::vec3( 0.1f );
 			verts.emplace_back( vert );
 		}
@@ -364,88 +260,12 @@ namespace fgl::engine
 		return verts;
 	}
 
-	inline void generateTrisTangents( std::vector< ModelVertex >& verts, const std::vector< std::uint32_t >& indicies )
+	Primitive SceneBuilder::
+		loadPrimitive( const int mesh_idx, const std::size_t primitive_idx, const tinygltf::Model& root )
 	{
 		ZoneScoped;
-		SMikkTSpaceContext context {};
-		SMikkTSpaceInterface interface {};
-
-		context.m_pUserData = &interface;
-		context.m_pInterface = &interface;
-
-		auto getNumFaces = [ & ]( [[maybe_unused]] const SMikkTSpaceContext* ctx ) -> int
-		{ return static_cast< int >( indicies.size() ) / 3; };
-
-		auto getNumVerticesOfFace =
-			[ & ]( [[maybe_unused]] const SMikkTSpaceContext* ctx, [[maybe_unused]] const int i_face ) -> int
-		{ return 3; };
-
-		auto getPosition = [ & ](
-							   [[maybe_unused]] const SMikkTSpaceContext* ctx,
-							   float fv_pos_out[],
-							   const int i_face,
-							   const int i_vert ) -> void
-		{
-			const auto idx { indicies[ i_face * 3 + i_vert ] };
-			const auto& vert { verts.at( idx ) };
-
-			static_assert( sizeof( glm::vec3 ) == sizeof( float ) * 3 );
-			std::memcpy( fv_pos_out, &vert.m_position, sizeof( glm::vec3 ) );
-		};
-
-		auto getNormal = [ & ](
-							 [[maybe_unused]] const SMikkTSpaceContext* ctx,
-							 float fv_norm_out[],
-							 const int i_face,
-							 const int i_vert ) -> void
-		{
-			const auto idx { indicies[ i_face * 3 + i_vert ] };
-			const auto& vert { verts.at( idx ) };
-
-			static_assert( sizeof( glm::vec3 ) == sizeof( float ) * 3 );
-			std::memcpy( fv_norm_out, &vert.m_normal, sizeof( glm::vec3 ) );
-		};
+		const tinygltf::Primitive& prim { root.meshes[ mesh_idx ].primitives[ primitive_idx ] };
 
-		auto getTexCoord = [ & ](
-							   [[maybe_unused]] const SMikkTSpaceContext* ctx,
-							   float fv_texc_out[],
-							   const int i_face,
-							   const int i_vert ) -> void
-		{
-			const auto idx { indicies[ i_face * 3 + i_vert ] };
-			const auto& vert { verts.at( idx ) };
-
-			static_assert( sizeof( glm::vec2 ) == sizeof( float ) * 2 );
-			std::memcpy( fv_texc_out, &vert.m_uv, sizeof( glm::vec2 ) );
-		};
-
-		auto setTSpaceBasic = [ & ](
-								  [[maybe_unused]] const SMikkTSpaceContext* ctx,
-								  float fv_tangent[],
-								  float f_sign,
-								  const int i_face,
-								  const int i_vert ) -> void
-		{
-			const auto idx { indicies[ i_face * 3 + i_vert ] };
-			auto& vert { verts.at( idx ) };
-
-			static_assert( sizeof( glm::vec3 ) == sizeof( float ) * 3 );
-			vert.m_tangent = { fv_tangent[ 0 ], fv_tangent[ 1 ], fv_tangent[ 2 ], f_sign };
-		};
-
-		interface.m_getNumFaces = getNumFaces;
-		interface.m_getNumVerticesOfFace = getNumVerticesOfFace;
-		interface.m_getPosition = getPosition;
-		interface.m_getNormal = getNormal;
-		interface.m_getTexCoord = getTexCoord;
-		interface.m_setTSpaceBasic = setTSpaceBasic;
-
-		genTangSpaceDefault( &context );
-	}
-
-	Primitive SceneBuilder::loadPrimitive( const tinygltf::Primitive& prim, const tinygltf::Model& root )
-	{
-		ZoneScoped;
 		std::string att_str { "" };
 		for ( const auto& attrib : prim.attributes )
 		{
@@ -455,17 +275,30 @@ namespace fgl::engine
 		[[maybe_unused]] const bool has_normal { hasAttribute( prim, "NORMAL" ) };
 		const bool has_position { hasAttribute( prim, "POSITION" ) };
 		const bool has_texcoord { hasAttribute( prim, "TEXCOORD_0" ) };
+		const bool has_tangent { hasAttribute( prim, "TANGENT" ) };
 		[[maybe_unused]] const int texcoord_count { has_texcoord ? getTexcoordCount( prim ) : 0 };
 
 		if ( !has_position ) throw std::runtime_error( "Failed to load model. Missing expected POSITION attribute" );
 
+		const auto extract_start { ImportStageTime::start() };
+
 		std::vector< ModelVertex > verts { extractVertexInfo( prim, root ) };
 		std::vector< std::uint32_t > indicies { extractIndicies( prim, root ) };
 
+		// Checked once here, So tangent generation can index the vertices without bounds checks
+		for ( const auto index : indicies )
+			if ( index >= verts.size() )
+				throw std::runtime_error(
+					std::format( "Primitive index {} is out of range of {} vertices", index, verts.size() ) );
+
+		m_extract_time.stop( extract_start );
+		const auto tangent_start { ImportStageTime::start() };
+
 		switch ( static_cast< PrimitiveMode >( prim.mode ) )
 		{
 			case TRIS:
-				generateTrisTangents( verts, indicies );
+				// Tangents supplied by the asset are used as is, As the GLTF spec expects them to be mikktspace already
+				if ( !has_tangent ) generateTrisTangents( verts, indicies );
 				break;
 			case POINTS:
 				[[fallthrough]];
@@ -486,20 +319,123 @@ namespace fgl::engine
 				}
 		}
 
-		Primitive primitive_mesh { Primitive::fromVerts(
-			std::move( verts ),
-			static_cast< PrimitiveMode >( prim.mode ),
-			std::move( indicies ),
-			m_vertex_buffer,
-			m_index_buffer ) };
+		m_tangent_time.stop( tangent_start );
+		const auto optimize_start { ImportStageTime::start() };
 
-		// If we have a texcoord then we have a UV map. Meaning we likely have textures to use
-		if ( !has_texcoord ) return primitive_mesh;
+		if ( m_optimize_meshes )
+		{
+#if ENABLE_IMPORT_PROFILING
+			m_cache_misses_before += vertexCacheMisses( indicies, verts.size() );
+#endif
+			optimizeMesh( verts, indicies );
+#if ENABLE_IMPORT_PROFILING
+			m_cache_misses_after += vertexCacheMisses( indicies, verts.size() );
+			m_triangle_count += indicies.size() / 3;
+#endif
+
+			m_optimize_time.stop( optimize_start );
+		}
+
+		const auto meshlet_start { ImportStageTime::start() };
+
+		std::vector< PrimitiveMeshlet > meshlets {};
+
+		// Meshlets are ranges of the full detail level, So they are built before the other levels are appended
+		if ( m_build_meshlets )
+		{
+			for ( const Meshlet& meshlet : buildMeshlets( indicies, verts ) )
+			{
+				PrimitiveMeshlet& gpu_meshlet { meshlets.emplace_back() };
+				gpu_meshlet.m_bounds_center = meshlet.m_center;
+				gpu_meshlet.m_bounds_extent = meshlet.m_extent;
+				gpu_meshlet.m_cone_axis = meshlet.m_cone_axis;
+				gpu_meshlet.m_cone_cutoff = meshlet.m_cone_cutoff;
+				gpu_meshlet.m_first_index = meshlet.m_first_index;
+				gpu_meshlet.m_index_count = meshlet.m_index_count;
+			}
 
-		//primitive_mesh.m_textures = loadTextures( prim, root );
-		primitive_mesh.default_material = loadMaterial( prim, root );
+			// A single meshlet would only be culled the same as the entire primitive
+			if ( meshlets.size() <= 1 ) meshlets.clear();
 
-		return primitive_mesh;
+			if ( !meshlets.empty() )
+			{
+				m_meshlet_count += meshlets.size();
+				++m_meshlet_primitives;
+			}
+
+			m_meshlet_time.stop( meshlet_start );
+		}
+
+		const auto simplify_start { ImportStageTime::start() };
+
+		std::vector< PrimitiveLod > lods { { 0, static_cast< std::uint32_t >( indicies.size() ), 0.0f, 0 } };
+
+		if ( m_generate_lods )
+		{
+			const std::size_t full_count { indicies.size() };
+
+			// Every level shares the vertices, So the levels are only appended to the indicies
+			for ( auto& [ lod_indicies, error ] : generateLods( verts, indicies, MAX_LODS - 1 ) )
+			{
+				if ( m_optimize_meshes ) optimizeVertexCache( lod_indicies, verts.size() );
+
+				lods.push_back(
+					{ static_cast< std::uint32_t >( indicies.size() ),
+					  static_cast< std::uint32_t >( lod_indicies.size() ),
+					  error,
+					  0 } );
+
+				m_lod_triangles += lod_indicies.size() / 3;
+				indicies.insert( indicies.end(), lod_indicies.begin(), lod_indicies.end() );
+			}
+
+			m_lod_source_triangles += full_count / 3;
+			m_lod_levels += lods.size() - 1;
+			m_simplify_time.stop( simplify_start );
+		}
+
+		// The material is loaded by finishNode, Since textures and descriptors must be created on the main thread
+		const auto mode { static_cast< PrimitiveMode >( prim.mode ) };
+		const auto bounds { generateBoundingFromVerts( verts ) };
+
+		if ( m_cache_writer )
+		{
+			m_cache_writer->addPrimitive(
+				mesh_idx,
+				primitive_idx,
+				verts,
+				indicies,
+				lods,
+				meshlets,
+				mode,
+				bounds,
+				prim.material,
+				has_texcoord ? COOKED_HAS_TEXCOORD : 0 );
+		}
+
+		return submitPrimitive( verts, mode, indicies, bounds, lods, meshlets );
+	}
+
+	Primitive SceneBuilder::submitPrimitive(
+		const std::span< const ModelVertex > verts,
+		const PrimitiveMode mode,
+		const std::span< const std::uint32_t > indicies,
+		const OrientedBoundingBox< CoordinateSpace::Model >& bounds,
+		const std::span< const PrimitiveLod > lods,
+		const std::span< const PrimitiveMeshlet > meshlets )
+	{
+		ZoneScoped;
+		const auto submit_start { ImportStageTime::start() };
+
+		std::lock_guard guard { m_submit_mtx };
+
+		Primitive primitive {
+			Primitive::fromVerts( verts, mode, indicies, bounds, m_vertex_buffer, m_index_buffer, lods, meshlets )
+		};
+
+		m_submit_time.stop( submit_start );
+
+		return primitive;
 	}
 
 	OrientedBoundingBox< CoordinateSpace::Model > createModelBoundingBox( const std::vector< Primitive >& primitives )
@@ -581,19 +517,11 @@ namespace fgl::engine
 		return transform_component;
 	}
 
-	std::shared_ptr< Model > SceneBuilder::loadModel( const int mesh_idx, const tinygltf::Model& root )
+	std::shared_ptr< Model > SceneBuilder::
+		loadModel( const int mesh_idx, std::vector< Primitive >&& finished_primitives, const tinygltf::Model& root )
 	{
 		ZoneScoped;
-		const auto mesh { root.meshes[ mesh_idx ] };
-		const auto& primitives { mesh.primitives };
-
-		std::vector< Primitive > finished_primitives {};
-
-		for ( const auto& prim : primitives )
-		{
-			Primitive primitive { loadPrimitive( prim, root ) };
-			finished_primitives.emplace_back( std::move( primitive ) );
-		}
+		const auto& mesh { root.meshes[ mesh_idx ] };
 
 		const auto bounding_box { createModelBoundingBox( finished_primitives ) };
 
@@ -601,43 +529,63 @@ namespace fgl::engine
 			Model >( std::move( finished_primitives ), mesh.name.empty() ? "Unnamed Model" : mesh.name );
 	}
 
-	std::shared_ptr< Texture > SceneBuilder::loadTexture( const int tex_id, const tinygltf::Model& root ) const
+	std::shared_ptr< Texture > SceneBuilder::loadTexture( const int tex_id, const tinygltf::Model& root )
 	{
 		if ( tex_id == -1 ) return { nullptr };
 
+		if ( const auto itter = m_texture_cache.find( tex_id ); itter != m_texture_cache.end() ) return itter->second;
+
 		const tinygltf::Texture& tex_info { root.textures[ tex_id ] };
 
 		const auto source_idx { tex_info.source };
 
+		// Textures may have no source (Or only one from an extension), Those are treated as no texture at all
+		if ( source_idx < 0 || static_cast< std::size_t >( source_idx ) >= root.images.size() )
+		{
+			log::warn( "Texture {} has no image source, Using the material's defaults instead", tex_id );
+			m_texture_cache.emplace( tex_id, nullptr );
+			return { nullptr };
+		}
+
 		const tinygltf::Image& source { root.images[ source_idx ] };
 
-		if ( source.uri.empty() ) throw std::runtime_error( "Unsupported loading method for image (Must be a file)" );
+		std::filesystem::path full_path { m_root / std::filesystem::path( source.uri ) };
+
+		// Embedded images (buffer views and data URIs) have no file, So they are keyed by the scene instead
+		if ( source.uri.empty() ) full_path = std::format( "{}#image{}", m_scene_path.string(), source_idx );
 
-		const std::filesystem::path filepath { source.uri };
-		const auto full_path { m_root / filepath };
+		// The image job is handed to the first texture using it. Any later texture is found in the texture store
+		auto& image_job { m_image_jobs.at( source_idx ) };
 
 		const auto sampler_idx { tex_info.sampler };
-		const tinygltf::Sampler& sampler_info { root.samplers[ sampler_idx ] };
 
-		Sampler sampler { sampler_info.minFilter, sampler_info.magFilter, sampler_info.wrapS, sampler_info.wrapT };
+		// Embedded images commonly have no sampler, Those use the default sampler
+		Sampler sampler {};
+
+		if ( sampler_idx != -1 )
+		{
+			const tinygltf::Sampler& sampler_info { root.samplers[ sampler_idx ] };
+			sampler = Sampler( sampler_info.minFilter, sampler_info.magFilter, sampler_info.wrapS, sampler_info.wrapT );
+		}
 
-		std::shared_ptr< Texture > texture { getTextureStore().load( full_path, std::move( sampler ) ) };
+		// Bound to the placeholder until the texture store finishes it, So this never waits on the image job
+		std::shared_ptr< Texture > texture {
+			getTextureStore().loadAsync( full_path, std::move( image_job ), std::move( sampler ) )
+		};
 
-		//Prepare the texture into the global system
-		Texture::getDescriptorSet().bindTexture( 0, texture );
-		Texture::getDescriptorSet().update();
+		m_texture_cache.emplace( tex_id, texture );
 
 		return texture;
 	}
 
-	std::shared_ptr< Material > SceneBuilder::
-		loadMaterial( const tinygltf::Primitive& prim, const tinygltf::Model& root )
+	std::shared_ptr< Material > SceneBuilder::loadMaterial( const int material_id, const tinygltf::Model& root )
 	{
-		const auto& material_id { prim.material };
-
 		// No material
 		if ( material_id == -1 ) return Material::createNullMaterial();
 
+		if ( const auto itter = m_material_cache.find( material_id ); itter != m_material_cache.end() )
+			return itter->second;
+
 		auto material { Material::createMaterial() };
 
 		const auto& gltf_material { root.materials[ material_id ] };
@@ -669,20 +617,91 @@ namespace fgl::engine
 
 		material->update();
 
+		m_material_cache.emplace( material_id, material );
+
 		return material;
 	}
 
 	void SceneBuilder::handleNode( const int node_idx, const tinygltf::Model& root )
 	{
 		ZoneScoped;
-		const tinygltf::Node& node { root.nodes[ node_idx ] };
+		const int mesh_idx { root.nodes[ node_idx ].mesh };
+
+		if ( mesh_idx == -1 ) return;
+
+		m_pending_nodes.emplace_back( node_idx );
+
+		// The model is created once by finishMesh, Every other node referencing the mesh only instances it
+		if ( m_model_cache.contains( mesh_idx ) ) return;
+		m_model_cache.emplace( mesh_idx, nullptr );
+
+		PendingMesh pending { mesh_idx, {} };
+
+		// Cooked meshes are uploaded by finishMesh straight from the mapped cache
+		if ( !m_mesh_cache )
+		{
+			for ( std::size_t i = 0; i < root.meshes[ mesh_idx ].primitives.size(); ++i )
+			{
+				pending.m_primitives.emplace_back( getThreadPool().submit(
+					[ this, mesh_idx, i, &root ]() { return loadPrimitive( mesh_idx, i, root ); } ) );
+			}
+		}
+
+		m_pending_meshes.emplace_back( std::move( pending ) );
+	}
+
+	void SceneBuilder::finishMesh( PendingMesh& pending, const tinygltf::Model& root )
+	{
+		ZoneScoped;
+		const int mesh_idx { pending.m_mesh_idx };
+		const auto& gltf_primitives { root.meshes[ mesh_idx ].primitives };
+
+		std::vector< Primitive > primitives {};
+		primitives.reserve( gltf_primitives.size() );
+
+		if ( m_mesh_cache )
+		{
+			for ( const CookedPrimitive& cooked : m_mesh_cache->primitives( mesh_idx ) )
+			{
+				Primitive primitive { submitPrimitive(
+					m_mesh_cache->vertices( cooked ),
+					static_cast< PrimitiveMode >( cooked.m_mode ),
+					m_mesh_cache->indicies( cooked ),
+					MeshCache::bounds( cooked ),
+					MeshCache::lods( cooked ),
+					m_mesh_cache->meshlets( cooked ) ) };
+
+				if ( cooked.m_flags & COOKED_HAS_TEXCOORD )
+					primitive.default_material = loadMaterial( cooked.m_material, root );
+
+				primitives.emplace_back( std::move( primitive ) );
+			}
+		}
+		else
+		{
+			for ( std::size_t i = 0; i < pending.m_primitives.size(); ++i )
+			{
+				Primitive primitive { pending.m_primitives[ i ].get() };
+
+				// If we have a texcoord then we have a UV map. Meaning we likely have textures to use
+				if ( hasAttribute( gltf_primitives[ i ], "TEXCOORD_0" ) )
+					primitive.default_material = loadMaterial( gltf_primitives[ i ].material, root );
+
+				primitives.emplace_back( std::move( primitive ) );
+			}
+		}
+
+		m_model_cache[ mesh_idx ] = loadModel( mesh_idx, std::move( primitives ), root );
+	}
 
-		const int mesh_idx { node.mesh };
-		const int skin_idx { node.skin };
+	void SceneBuilder::finishNode( const int node_idx, const tinygltf::Model& root )
+	{
+		ZoneScoped;
+		const tinygltf::Node& node { root.nodes[ node_idx ] };
 
 		auto obj { GameObject::createGameObject() };
 
-		std::shared_ptr< Model > model { loadModel( mesh_idx, root ) };
+		std::shared_ptr< Model > model { m_model_cache.at( node.mesh ) };
 
 		assert( model );
 
@@ -718,13 +737,169 @@ namespace fgl::engine
 		}
 	}
 
+	std::uint64_t SceneBuilder::openMeshCache( const std::filesystem::path& path, const tinygltf::Model& root )
+	{
+		ZoneScoped;
+		m_mesh_cache.reset();
+		m_cache_writer.reset();
+
+		// The scene file covers the JSON (And the binary chunk for .glb), External buffers are hashed on top of it
+		// Meshes are cooked separately for each combination of processing options
+		const std::uint64_t seed { ( std::uint64_t( MESH_CACHE_VERSION ) << 3 ) | ( m_build_meshlets ? 4 : 0 )
+			                       | ( m_generate_lods ? 2 : 0 ) | ( m_optimize_meshes ? 1 : 0 ) };
+
+		std::uint64_t source_hash { hashSource( filesystem::MappedFile( path ).data(), seed ) };
+		for ( const auto& buffer : root.buffers )
+			source_hash = hashSource( std::as_bytes( std::span( buffer.data ) ), source_hash );
+
+		const auto cache_path { meshCachePath( source_hash ) };
+
+		if ( auto cache = MeshCache::open( cache_path, source_hash ) )
+		{
+			// Every mesh a node uses must have been cooked with all of it's primitives
+			bool complete { cache->meshCount() == root.meshes.size() };
+
+			for ( const auto& node : root.nodes )
+			{
+				if ( !complete ) break;
+				if ( node.mesh == -1 ) continue;
+				complete = cache->primitives( node.mesh ).size() == root.meshes[ node.mesh ].primitives.size();
+			}
+
+			if ( complete )
+			{
+				log::info( "Loading cooked meshes for {} from {}", path.filename().string(), cache_path.string() );
+				m_mesh_cache = std::move( cache );
+				return source_hash;
+			}
+
+			log::warn( "Mesh cache {} does not match the scene, Cooking again", cache_path.string() );
+		}
+
+		m_cache_writer = std::make_unique< MeshCacheWriter >( root.meshes.size() );
+
+		return source_hash;
+	}
+
+	void SceneBuilder::queueImages( const tinygltf::Model& root )
+	{
+		ZoneScoped;
+		m_image_jobs.clear();
+		m_image_jobs.resize( root.images.size() );
+
+		// Images used by several material slots are compressed with a format that keeps every channel they need
+		std::vector< std::optional< TextureCompression > > image_compression( root.images.size() );
+		// Images used as color by any material have their mips filtered in linear space
+		std::vector< bool > image_srgb( root.images.size(), false );
+
+		const auto useAs = [ &root, &image_compression, &image_srgb ]( const int texture_idx, const TextureRole role )
+		{
+			if ( texture_idx == -1 || root.textures[ texture_idx ].source == -1 ) return;
+
+			const int image_idx { root.textures[ texture_idx ].source };
+			auto& compression { image_compression[ image_idx ] };
+			const TextureCompression role_compression { compressionForRole( role ) };
+			compression = compression ? mergeCompression( *compression, role_compression ) : role_compression;
+
+			if ( isSrgbRole( role ) ) image_srgb[ image_idx ] = true;
+		};
+
+		for ( const auto& material : root.materials )
+		{
+			useAs( material.pbrMetallicRoughness.baseColorTexture.index, TextureRole::Color );
+			useAs( material.pbrMetallicRoughness.metallicRoughnessTexture.index, TextureRole::MetallicRoughness );
+			useAs( material.normalTexture.index, TextureRole::Normal );
+			useAs( material.occlusionTexture.index, TextureRole::Occlusion );
+			useAs( material.emissiveTexture.index, TextureRole::Emissive );
+		}
+
+		for ( const auto& texture : root.textures )
+		{
+			const int image_idx { texture.source };
+			if ( image_idx == -1 || m_image_jobs[ image_idx ].valid() ) continue;
+
+			const TextureCompression compression {
+				image_compression[ image_idx ].value_or( compressionForRole( TextureRole::Color ) )
+			};
+			// Images no material uses are treated as color, Like their compression
+			const bool srgb { !image_compression[ image_idx ].has_value() || image_srgb[ image_idx ] };
+
+			m_image_jobs[ image_idx ] = getThreadPool().submit(
+				[ this, &root, image_idx, compression, srgb ]()
+				{
+					const auto decode_start { ImportStageTime::start() };
+					const tinygltf::Image& image { root.images[ image_idx ] };
+
+					std::span< const std::byte > encoded {};
+
+					if ( image.bufferView != -1 )
+					{
+						const auto& buffer_view { root.bufferViews.at( image.bufferView ) };
+						const auto& buffer { root.buffers.at( buffer_view.buffer ) };
+						encoded = std::as_bytes( std::span( buffer.data ) )
+						              .subspan( buffer_view.byteOffset, buffer_view.byteLength );
+					}
+					else
+						encoded = std::as_bytes( std::span( image.image ) );
+
+					if ( encoded.empty() )
+						throw std::runtime_error( std::format( "Failed to load image {} \"{}\"", image_idx, image.uri ) );
+
+					// Mips and compression are done here on the pool, Instead of when the texture is created
+					DecodedImage decoded { prepareTextureImage( encoded, compression, srgb ) };
+
+					m_decode_time.stop( decode_start );
+
+					return decoded;
+				} );
+		}
+	}
+
+	void SceneBuilder::reserveInstances( const tinygltf::Model& root )
+	{
+		ZoneScoped;
+		std::size_t node_count { 0 };
+		std::size_t primitive_count { 0 };
+		std::size_t instance_count { 0 };
+
+		std::vector< bool > mesh_seen( root.meshes.size(), false );
+
+		for ( const auto& scene : root.scenes )
+		{
+			for ( const auto node_idx : scene.nodes )
+			{
+				const int mesh_idx { root.nodes[ node_idx ].mesh };
+				if ( mesh_idx == -1 ) continue;
+
+				const auto mesh_primitives { root.meshes[ mesh_idx ].primitives.size() };
+
+				++node_count;
+				instance_count += mesh_primitives;
+
+				if ( mesh_seen[ mesh_idx ] ) continue;
+				mesh_seen[ mesh_idx ] = true;
+				primitive_count += mesh_primitives;
+			}
+		}
+
+		// Each unique mesh gets one model, Each node an instance of it. Growing the vectors now avoids reallocating them
+		auto& buffers { getModelBuffers() };
+		buffers.m_primitive_info.reserveFree( primitive_count );
+		buffers.m_primitive_instances.reserveFree( instance_count );
+		buffers.m_model_instances.reserveFree( node_count );
+	}
+
 	void SceneBuilder::loadScene( const std::filesystem::path& path )
 	{
 		ZoneScoped;
 		if ( !std::filesystem::exists( path ) ) throw std::runtime_error( "Failed to find scene at filepath" );
 		m_root = path.parent_path();
+		m_scene_path = path;
+
+		const auto parse_start { ImportStageTime::start() };
 
 		tinygltf::TinyGLTF loader {};
+		loader.SetImageLoader( &deferImageLoad, nullptr );
 		tinygltf::Model gltf_model {};
 
 		std::string err {};
@@ -763,12 +938,145 @@ namespace fgl::engine
 			log::warn( "Warning loading model {}: \"{}\"", path.string(), warn );
 		}
 
-		const auto scenes { gltf_model.scenes };
-
-		for ( const auto& scene : scenes )
+		m_parse_time.reset();
+		m_parse_time.stop( parse_start );
+		const auto primitives_start { ImportStageTime::start() };
+
+		reserveInstances( gltf_model );
+
+		m_extract_time.reset();
+		m_tangent_time.reset();
+		m_optimize_time.reset();
+		m_meshlet_time.reset();
+		m_simplify_time.reset();
+		m_submit_time.reset();
+		m_cache_misses_before = 0;
+		m_cache_misses_after = 0;
+		m_triangle_count = 0;
+		m_lod_source_triangles = 0;
+		m_lod_triangles = 0;
+		m_lod_levels = 0;
+		m_meshlet_count = 0;
+		m_meshlet_primitives = 0;
+		m_decode_time.reset();
+
+		m_model_cache.clear();
+		m_material_cache.clear();
+		m_texture_cache.clear();
+
+		const std::uint64_t source_hash { openMeshCache( path, gltf_model ) };
+
+		// Images are queued first, Since decoding them is usually the longest part of the import
+		queueImages( gltf_model );
+
+		for ( const auto& scene : gltf_model.scenes )
 		{
 			handleScene( scene, gltf_model );
 		}
+
+		// Every job references gltf_model, So they must all finish before any exception can unwind the stack
+		for ( const auto& pending : m_pending_meshes )
+			for ( const auto& primitive : pending.m_primitives ) primitive.wait();
+
+		for ( const auto& image_job : m_image_jobs )
+			if ( image_job.valid() ) image_job.wait();
+
+		m_primitives_time.reset();
+		m_primitives_time.stop( primitives_start );
+		const auto objects_start { ImportStageTime::start() };
+
+		for ( auto& pending : m_pending_meshes )
+		{
+			finishMesh( pending, gltf_model );
+		}
+
+		for ( const auto node_idx : m_pending_nodes )
+		{
+			finishNode( node_idx, gltf_model );
+		}
+
+		if ( m_cache_writer )
+		{
+			// A failure to cook only costs the next import it's speedup
+			try
+			{
+				const auto cache_path { meshCachePath( source_hash ) };
+				m_cache_writer->write( cache_path, source_hash );
+				log::info( "Cooked meshes for {} into {}", path.filename().string(), cache_path.string() );
+			}
+			catch ( const std::exception& e )
+			{
+				log::warn( "Failed to cook meshes for {}: {}", path.filename().string(), e.what() );
+			}
+		}
+
+		log::info(
+			"Scene {} has {} nodes sharing {} meshes and {} materials",
+			path.filename().string(),
+			m_pending_nodes.size(),
+			m_pending_meshes.size(),
+			m_material_cache.size() );
+
+		m_pending_meshes.clear();
+		m_pending_nodes.clear();
+		m_image_jobs.clear();
+		m_mesh_cache.reset();
+		m_cache_writer.reset();
+
+		// The game objects keep what they need alive. The caches are only for this import
+		m_model_cache.clear();
+		m_material_cache.clear();
+		m_texture_cache.clear();
+
+		m_objects_time.reset();
+		m_objects_time.stop( objects_start );
+
+#if ENABLE_IMPORT_PROFILING
+		log::info(
+			"Imported scene {} in {:.2f}ms: Parse {:.2f}ms, Primitives & images {:.2f}ms, Materials & objects {:.2f}ms",
+			path.filename().string(),
+			toMilliseconds( m_parse_time.total() + m_primitives_time.total() + m_objects_time.total() ),
+			toMilliseconds( m_parse_time.total() ),
+			toMilliseconds( m_primitives_time.total() ),
+			toMilliseconds( m_objects_time.total() ) );
+
+		log::info(
+			"Worker time across {} threads: Extract {:.2f}ms, Tangents {:.2f}ms, Optimize {:.2f}ms, Meshlets {:.2f}ms, "
+			"Simplify {:.2f}ms, Submit {:.2f}ms, Decode {:.2f}ms",
+			getThreadPool().threadCount(),
+			toMilliseconds( m_extract_time.total() ),
+			toMilliseconds( m_tangent_time.total() ),
+			toMilliseconds( m_optimize_time.total() ),
+			toMilliseconds( m_meshlet_time.total() ),
+			toMilliseconds( m_simplify_time.total() ),
+			toMilliseconds( m_submit_time.total() ),
+			toMilliseconds( m_decode_time.total() ) );
+
+		if ( m_triangle_count > 0 )
+		{
+			const auto triangles { static_cast< double >( m_triangle_count.load() ) };
+
+			log::info(
+				"Vertex cache misses per triangle (ACMR): {:.3f} -> {:.3f} across {} triangles",
+				static_cast< double >( m_cache_misses_before.load() ) / triangles,
+				static_cast< double >( m_cache_misses_after.load() ) / triangles,
+				m_triangle_count.load() );
+		}
+#endif
+
+		if ( m_lod_levels > 0 )
+		{
+			log::info(
+				"Generated {} levels of detail with {} triangles, From {} full detail triangles",
+				m_lod_levels.load(),
+				m_lod_triangles.load(),
+				m_lod_source_triangles.load() );
+		}
+
+		if ( m_meshlet_primitives > 0 )
+		{
+			log::info( "Split {} primitives into {} meshlets", m_meshlet_primitives.load(), m_meshlet_count.load() );
+		}
 	}
 
 } // namespace fgl::engine
@@ -13,10 +13,19 @@
 #include <glm/vec3.hpp>
 #pragma GCC diagnostic pop
 
+#include <atomic>
 #include <filesystem>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "engine/assets/material/Material.hpp"
+#include "engine/assets/model/Primitive.hpp"
+#include "engine/assets/model/builders/MeshCache.hpp"
+#include "engine/assets/texture/Texture.hpp"
+#include "engine/clock.hpp"
 #include "engine/gameobjects/GameObject.hpp"
 #include "engine/primitives/Transform.hpp"
 
@@ -46,23 +55,175 @@ namespace tinygltf
 
 namespace fgl::engine
 {
+	/**
+	 * @brief Time spent on a stage of the import, Summed across the workers
+	 * @details Only measured when built with ENABLE_IMPORT_PROFILING. Otherwise the clock is never read, And the
+	 * total is always zero
+	 */
+	class ImportStageTime
+	{
+#if ENABLE_IMPORT_PROFILING
+		std::atomic< Clock::duration::rep > m_total { 0 };
+#endif
+
+	  public:
+
+#if ENABLE_IMPORT_PROFILING
+		using Start = Clock::time_point;
+#else
+		struct Start
+		{};
+#endif
+
+		static Start start()
+		{
+#if ENABLE_IMPORT_PROFILING
+			return Clock::now();
+#else
+			return {};
+#endif
+		}
+
+		//! Adds the time since start to the total
+		void stop( [[maybe_unused]] const Start start )
+		{
+#if ENABLE_IMPORT_PROFILING
+			m_total += ( Clock::now() - start ).count();
+#endif
+		}
+
+		void reset()
+		{
+#if ENABLE_IMPORT_PROFILING
+			m_total = 0;
+#endif
+		}
+
+		Clock::duration total() const
+		{
+#if ENABLE_IMPORT_PROFILING
+			return Clock::duration( m_total.load() );
+#else
+			return Clock::duration::zero();
+#endif
+		}
+	};
+
 	class SceneBuilder
 	{
 		//! Root path. Set by 'load' functions
 		std::filesystem::path m_root {};
+		//! Path of the scene being loaded. Used to key images embedded in the scene
+		std::filesystem::path m_scene_path {};
 		memory::Buffer m_vertex_buffer;
 		memory::Buffer m_index_buffer;
 
 		std::vector< std::shared_ptr< GameObject > > m_game_objects {};
 
+		//! Mesh who's primitives are being loaded by the thread pool
+		struct PendingMesh
+		{
+			int m_mesh_idx;
+			std::vector< std::future< Primitive > > m_primitives;
+		};
+
+		std::vector< PendingMesh > m_pending_meshes {};
+
+		//! Decoding of each image used by a texture, Indexed by image. Consumed by the first texture using the image
+		std::vector< std::future< DecodedImage > > m_image_jobs {};
+
+		//! Nodes waiting on their mesh to be loaded
+		std::vector< int > m_pending_nodes {};
+
+		//! Per import caches, Keyed by the GLTF index. Nodes sharing a mesh become instances of the same model
+		std::unordered_map< int, std::shared_ptr< Model > > m_model_cache {};
+		std::unordered_map< int, std::shared_ptr< Material > > m_material_cache {};
+		std::unordered_map< int, std::shared_ptr< Texture > > m_texture_cache {};
+
+		//! Cooked primitives of the scene. Set if the cache matched the scene, In which case no primitives are extracted
+		std::optional< MeshCache > m_mesh_cache { std::nullopt };
+
+		//! Collects the extracted primitives to be cooked, Set if there was no usable cache
+		std::unique_ptr< MeshCacheWriter > m_cache_writer { nullptr };
+
+		//! Guards the steps of primitive loading that touch the GPU buffers (Suballocation, staging, render info)
+		std::mutex m_submit_mtx {};
+
+		//! Reorder triangles and vertices for the vertex cache, overdraw and vertex fetch. See MeshOptimizer.hpp
+		bool m_optimize_meshes { true };
+
+		//! Simplify triangle primitives into levels of detail, Stored after the full detail indicies. See generateLods
+		bool m_generate_lods { true };
+
+		//! Split the full detail level of triangle primitives into meshlets, Culled individually. See buildMeshlets
+		bool m_build_meshlets { true };
+
+		//! Simulated vertex cache misses before and after optimization, Summed across all primitives. Only counted when
+		//! built with ENABLE_IMPORT_PROFILING, As each simulation is another pass over the indicies
+		std::atomic< std::uint64_t > m_cache_misses_before { 0 };
+		std::atomic< std::uint64_t > m_cache_misses_after { 0 };
+		std::atomic< std::uint64_t > m_triangle_count { 0 };
+
+		//! Triangles of the full detail levels, And of every level of detail, Summed across all primitives
+		std::atomic< std::uint64_t > m_lod_source_triangles { 0 };
+		std::atomic< std::uint64_t > m_lod_triangles { 0 };
+		std::atomic< std::uint64_t > m_lod_levels { 0 };
+
+		//! Meshlets built across all primitives, And the primitives that were split into them
+		std::atomic< std::uint64_t > m_meshlet_count { 0 };
+		std::atomic< std::uint64_t > m_meshlet_primitives { 0 };
+
+		//! Time spent by the workers on each stage, Summed across all primitives
+		ImportStageTime m_extract_time {};
+		ImportStageTime m_tangent_time {};
+		ImportStageTime m_optimize_time {};
+		ImportStageTime m_meshlet_time {};
+		ImportStageTime m_simplify_time {};
+		ImportStageTime m_submit_time {};
+		ImportStageTime m_decode_time {};
+
+		//! Time spent by loadScene on parsing, Waiting for the workers, And creating the materials and objects
+		ImportStageTime m_parse_time {};
+		ImportStageTime m_primitives_time {};
+		ImportStageTime m_objects_time {};
+
+		//! Opens the cooked meshes for the scene, Or prepares the writer to cook them. Returns the source hash
+		std::uint64_t openMeshCache( const std::filesystem::path& path, const tinygltf::Model& root );
+
+		//! Queues decoding of every image referenced by a texture onto the thread pool. Each image is decoded once
+		void queueImages( const tinygltf::Model& root );
+
+		//! Grows the model buffers once for every node and unique mesh in the model, Instead of once per node
+		void reserveInstances( const tinygltf::Model& root );
+
 		void handleScene( const tinygltf::Scene& scene, const tinygltf::Model& root );
+
+		//! Queues the primitives of the node's mesh onto the thread pool, Unless another node already did or it is cooked
 		void handleNode( int node_idx, const tinygltf::Model& root );
 
+		//! Waits on the primitives of the mesh (Or uploads the cooked primitives) and creates the shared model for it
+		void finishMesh( PendingMesh& pending, const tinygltf::Model& root );
+
+		//! Creates the game object for a node, Instancing the model of it's mesh
+		void finishNode( int node_idx, const tinygltf::Model& root );
+
 		WorldTransform loadTransform( int node_idx, const tinygltf::Model& root );
-		std::shared_ptr< Model > loadModel( int mesh_idx, const tinygltf::Model& root );
-		std::shared_ptr< Texture > loadTexture( int tex_id, const tinygltf::Model& root ) const;
-		std::shared_ptr< Material > loadMaterial( const tinygltf::Primitive& prim, const tinygltf::Model& root );
-		Primitive loadPrimitive( const tinygltf::Primitive& prim, const tinygltf::Model& model );
+		std::shared_ptr< Model >
+			loadModel( int mesh_idx, std::vector< Primitive >&& primitives, const tinygltf::Model& root );
+		std::shared_ptr< Texture > loadTexture( int tex_id, const tinygltf::Model& root );
+		std::shared_ptr< Material > loadMaterial( int material_id, const tinygltf::Model& root );
+
+		//! Extracts and processes the primitive's vertex data, Cooking it if m_cache_writer is set. Safe from any thread
+		Primitive loadPrimitive( int mesh_idx, std::size_t primitive_idx, const tinygltf::Model& root );
+
+		//! Uploads the processed primitive, Serialized by m_submit_mtx
+		Primitive submitPrimitive(
+			std::span< const ModelVertex > verts,
+			PrimitiveMode mode,
+			std::span< const std::uint32_t > indicies,
+			const OrientedBoundingBox< CoordinateSpace::Model >& bounds,
+			std::span< const PrimitiveLod > lods,
+			std::span< const PrimitiveMeshlet > meshlets );
 
 		int getTexcoordCount( const tinygltf::Primitive& prim ) const;
 
@@ -96,6 +257,15 @@ namespace fgl::engine
 
 		SceneBuilder( const memory::Buffer& vertex_buffer, const memory::Buffer& index_buffer );
 
+		//! Enables or disables the optimization stage of primitive loading. Enabled by default
+		void setMeshOptimization( const bool enabled ) { m_optimize_meshes = enabled; }
+
+		//! Enables or disables generating levels of detail for triangle primitives. Enabled by default
+		void setLodGeneration( const bool enabled ) { m_generate_lods = enabled; }
+
+		//! Enables or disables splitting triangle primitives into meshlets. Enabled by default
+		void setMeshletGeneration( const bool enabled ) { m_build_meshlets = enabled; }
+
 		void loadScene( const std::filesystem::path& path );
 	};
 
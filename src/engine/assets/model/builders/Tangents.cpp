@@ -0,0 +1,96 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "Tangents.hpp"
+
+#include <tracy/Tracy.hpp>
+
+#include <cstring>
+
+#include "engine/assets/model/ModelVertex.hpp"
+#include "mikktspace/mikktspace.hpp"
+
+namespace fgl::engine
+{
+
+	void generateTrisTangents( std::vector< ModelVertex >& verts, const std::vector< std::uint32_t >& indicies )
+	{
+		ZoneScoped;
+		SMikkTSpaceContext context {};
+		SMikkTSpaceInterface interface {};
+
+		context.m_pUserData = &interface;
+		context.m_pInterface = &interface;
+
+		auto getNumFaces = [ & ]( [[maybe_unused]] const SMikkTSpaceContext* ctx ) -> int
+		{ return static_cast< int >( indicies.size() ) / 3; };
+
+		auto getNumVerticesOfFace =
+			[ & ]( [[maybe_unused]] const SMikkTSpaceContext* ctx, [[maybe_unused]] const int i_face ) -> int
+		{ return 3; };
+
+		auto getPosition = [ & ](
+							   [[maybe_unused]] const SMikkTSpaceContext* ctx,
+							   float fv_pos_out[],
+							   const int i_face,
+							   const int i_vert ) -> void
+		{
+			const auto idx { indicies[ i_face * 3 + i_vert ] };
+			const auto& vert { verts[ idx ] };
+
+			static_assert( sizeof( glm::vec3 ) == sizeof( float ) * 3 );
+			std::memcpy( fv_pos_out, &vert.m_position, sizeof( glm::vec3 ) );
+		};
+
+		auto getNormal = [ & ](
+							 [[maybe_unused]] const SMikkTSpaceContext* ctx,
+							 float fv_norm_out[],
+							 const int i_face,
+							 const int i_vert ) -> void
+		{
+			const auto idx { indicies[ i_face * 3 + i_vert ] };
+			const auto& vert { verts[ idx ] };
+
+			static_assert( sizeof( glm::vec3 ) == sizeof( float ) * 3 );
+			std::memcpy( fv_norm_out, &vert.m_normal, sizeof( glm::vec3 ) );
+		};
+
+		auto getTexCoord = [ & ](
+							   [[maybe_unused]] const SMikkTSpaceContext* ctx,
+							   float fv_texc_out[],
+							   const int i_face,
+							   const int i_vert ) -> void
+		{
+			const auto idx { indicies[ i_face * 3 + i_vert ] };
+			const auto& vert { verts[ idx ] };
+
+			static_assert( sizeof( glm::vec2 ) == sizeof( float ) * 2 );
+			std::memcpy( fv_texc_out, &vert.m_uv, sizeof( glm::vec2 ) );
+		};
+
+		auto setTSpaceBasic = [ & ](
+								  [[maybe_unused]] const SMikkTSpaceContext* ctx,
+								  float fv_tangent[],
+								  float f_sign,
+								  const int i_face,
+								  const int i_vert ) -> void
+		{
+			const auto idx { indicies[ i_face * 3 + i_vert ] };
+			auto& vert { verts[ idx ] };
+
+			static_assert( sizeof( glm::vec3 ) == sizeof( float ) * 3 );
+			vert.m_tangent = { fv_tangent[ 0 ], fv_tangent[ 1 ], fv_tangent[ 2 ], f_sign };
+		};
+
+		interface.m_getNumFaces = getNumFaces;
+		interface.m_getNumVerticesOfFace = getNumVerticesOfFace;
+		interface.m_getPosition = getPosition;
+		interface.m_getNormal = getNormal;
+		interface.m_getTexCoord = getTexCoord;
+		interface.m_setTSpaceBasic = setTSpaceBasic;
+
+		genTangSpaceDefault( &context );
+	}
+
+} // namespace fgl::engine
@@ -0,0 +1,17 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace fgl::engine
+{
+	struct ModelVertex;
+
+	//! Generates the tangents with mikktspace. Every index must be within verts, Since the callbacks do not check
+	void generateTrisTangents( std::vector< ModelVertex >& verts, const std::vector< std::uint32_t >& indicies );
+
+} // namespace fgl::engine
@@ -106,7 +106,7 @@ namespace fgl::engine
 		const OrientedBoundingBox bounding_box { generateBoundingFromVerts( verts ) };
 
 		[[maybe_unused]] auto& itter = m_primitives.emplace_back(
-			VertexBufferSuballocation( m_vertex_buffer, std::move( verts ) ),
+			VertexBufferSuballocation( m_vertex_buffer, verts, bounding_box ),
 			IndexBufferSuballocation( m_index_buffer, std::move( indicies ) ),
 			bounding_box,
 			PrimitiveMode::TRIS );
@@ -0,0 +1,597 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "BlockCompression.hpp"
+
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "Texture.hpp"
+#include "engine/FGL_DEFINES.hpp"
+#include "engine/assets/image/MipChain.hpp"
+
+namespace fgl::engine
+{
+
+	TextureCompression compressionForRole( const TextureRole role )
+	{
+		switch ( role )
+		{
+			case TextureRole::Color:
+				[[fallthrough]];
+			case TextureRole::MetallicRoughness:
+				[[fallthrough]];
+			case TextureRole::Emissive:
+				return TextureCompression::BC7;
+			case TextureRole::Normal:
+				return TextureCompression::BC5;
+			case TextureRole::Occlusion:
+				return TextureCompression::BC4;
+		}
+
+		FGL_UNREACHABLE();
+	}
+
+	bool isSrgbRole( const TextureRole role )
+	{
+		return role == TextureRole::Color || role == TextureRole::Emissive;
+	}
+
+	TextureCompression mergeCompression( const TextureCompression first, const TextureCompression second )
+	{
+		if ( first == second ) return first;
+		if ( first == TextureCompression::None || second == TextureCompression::None ) return TextureCompression::None;
+
+		// BC7 has every channel BC5 and BC4 have
+		return TextureCompression::BC7;
+	}
+
+	vk::Format compressionFormat( const TextureCompression compression )
+	{
+		switch ( compression )
+		{
+			case TextureCompression::None:
+				return vk::Format::eR8G8B8A8Unorm;
+			case TextureCompression::BC7:
+				return vk::Format::eBc7UnormBlock;
+			case TextureCompression::BC5:
+				return vk::Format::eBc5UnormBlock;
+			case TextureCompression::BC4:
+				return vk::Format::eBc4UnormBlock;
+		}
+
+		FGL_UNREACHABLE();
+	}
+
+	namespace
+	{
+		//! Interpolation weights of the 4 bit BC7 indices, Out of 64
+		constexpr std::array< std::uint32_t, 16 > BC7_WEIGHTS { 0,  4,  9,  13, 17, 21, 26, 30,
+			                                                    34, 38, 43, 47, 51, 55, 60, 64 };
+
+		using Color = std::array< float, 4 >;
+
+		//! Mode 6 endpoints have 7 bits per channel, Plus a low bit shared by every channel of the endpoint
+		struct BC7Endpoint
+		{
+			std::array< std::uint8_t, 4 > m_color {};
+			std::uint8_t m_pbit { 0 };
+
+			std::uint32_t value( const std::uint32_t channel ) const
+			{
+				return ( static_cast< std::uint32_t >( m_color[ channel ] ) << 1 ) | m_pbit;
+			}
+		};
+
+		struct BitWriter
+		{
+			std::uint8_t* m_out;
+			std::uint32_t m_bit { 0 };
+
+			void write( const std::uint32_t value, const std::uint32_t bits )
+			{
+				for ( std::uint32_t i = 0; i < bits; ++i, ++m_bit )
+				{
+					if ( ( ( value >> i ) & 1 ) == 0 ) continue;
+					m_out[ m_bit / 8 ] |= static_cast< std::uint8_t >( 1 << ( m_bit % 8 ) );
+				}
+			}
+		};
+
+		BC7Endpoint quantizeEndpoint( const Color& color )
+		{
+			BC7Endpoint best {};
+			float best_error { std::numeric_limits< float >::max() };
+
+			for ( std::uint8_t pbit = 0; pbit < 2; ++pbit )
+			{
+				BC7Endpoint endpoint {};
+				endpoint.m_pbit = pbit;
+				float error { 0.0f };
+
+				for ( std::uint32_t channel = 0; channel < 4; ++channel )
+				{
+					const float quantized { std::round( ( color[ channel ] - pbit ) / 2.0f ) };
+					endpoint.m_color[ channel ] = static_cast< std::uint8_t >( std::clamp( quantized, 0.0f, 127.0f ) );
+
+					const float difference { static_cast< float >( endpoint.value( channel ) ) - color[ channel ] };
+					error += difference * difference;
+				}
+
+				if ( error < best_error )
+				{
+					best_error = error;
+					best = endpoint;
+				}
+			}
+
+			return best;
+		}
+
+		//! Picks the closest palette entry for every texel, Returning the total squared error
+		std::uint32_t assignIndices(
+			const TexelBlock& texels,
+			const BC7Endpoint& first,
+			const BC7Endpoint& second,
+			std::array< std::uint8_t, 16 >& indices )
+		{
+			std::array< std::array< std::int32_t, 4 >, 16 > palette {};
+
+			for ( std::uint32_t i = 0; i < 16; ++i )
+			{
+				for ( std::uint32_t channel = 0; channel < 4; ++channel )
+				{
+					const std::uint32_t weight { BC7_WEIGHTS[ i ] };
+					palette[ i ][ channel ] = static_cast< std::int32_t >(
+						( ( 64 - weight ) * first.value( channel ) + weight * second.value( channel ) + 32 ) >> 6 );
+				}
+			}
+
+			// Texels are projected onto the line between the endpoints, Only the entries either side of it are tested
+			std::array< std::int32_t, 4 > direction {};
+			std::int32_t direction_length { 0 };
+
+			for ( std::uint32_t channel = 0; channel < 4; ++channel )
+			{
+				direction[ channel ] = palette[ 15 ][ channel ] - palette[ 0 ][ channel ];
+				direction_length += direction[ channel ] * direction[ channel ];
+			}
+
+			std::uint32_t total_error { 0 };
+
+			for ( std::uint32_t texel = 0; texel < 16; ++texel )
+			{
+				std::int32_t projection { 0 };
+
+				for ( std::uint32_t channel = 0; channel < 4; ++channel )
+					projection += ( texels[ texel * 4 + channel ] - palette[ 0 ][ channel ] ) * direction[ channel ];
+
+				const float t { direction_length > 0 ? static_cast< float >( projection ) / direction_length : 0.0f };
+				const auto nearest { static_cast< std::int32_t >( std::round( std::clamp( t, 0.0f, 1.0f ) * 15.0f ) ) };
+
+				std::uint32_t best_error { std::numeric_limits< std::uint32_t >::max() };
+
+				for ( std::int32_t i = std::max( nearest - 1, 0 ); i <= std::min( nearest + 1, 15 ); ++i )
+				{
+					std::uint32_t error { 0 };
+
+					for ( std::uint32_t channel = 0; channel < 4; ++channel )
+					{
+						const std::int32_t difference { palette[ i ][ channel ] - texels[ texel * 4 + channel ] };
+						error += static_cast< std::uint32_t >( difference * difference );
+					}
+
+					if ( error < best_error )
+					{
+						best_error = error;
+						indices[ texel ] = static_cast< std::uint8_t >( i );
+					}
+				}
+
+				total_error += best_error;
+			}
+
+			return total_error;
+		}
+
+		//! Endpoints at either end of the principal axis of the texels
+		std::pair< Color, Color > principalEndpoints( const TexelBlock& texels )
+		{
+			Color mean {};
+			Color min { 255.0f, 255.0f, 255.0f, 255.0f };
+			Color max {};
+
+			for ( std::uint32_t texel = 0; texel < 16; ++texel )
+			{
+				for ( std::uint32_t channel = 0; channel < 4; ++channel )
+				{
+					const float value { static_cast< float >( texels[ texel * 4 + channel ] ) };
+					mean[ channel ] += value / 16.0f;
+					min[ channel ] = std::min( min[ channel ], value );
+					max[ channel ] = std::max( max[ channel ], value );
+				}
+			}
+
+			std::array< std::array< float, 4 >, 4 > covariance {};
+
+			for ( std::uint32_t texel = 0; texel < 16; ++texel )
+			{
+				for ( std::uint32_t row = 0; row < 4; ++row )
+				{
+					for ( std::uint32_t column = 0; column < 4; ++column )
+					{
+						covariance[ row ][ column ] += ( texels[ texel * 4 + row ] - mean[ row ] )
+						                             * ( texels[ texel * 4 + column ] - mean[ column ] );
+					}
+				}
+			}
+
+			// Power iteration, Starting from the diagonal of the bounds as it is usually close already
+			Color axis {};
+			for ( std::uint32_t channel = 0; channel < 4; ++channel ) axis[ channel ] = max[ channel ] - min[ channel ];
+
+			for ( std::uint32_t iteration = 0; iteration < 8; ++iteration )
+			{
+				Color next {};
+				float largest { 0.0f };
+
+				for ( std::uint32_t row = 0; row < 4; ++row )
+				{
+					for ( std::uint32_t column = 0; column < 4; ++column )
+						next[ row ] += covariance[ row ][ column ] * axis[ column ];
+
+					largest = std::max( largest, std::abs( next[ row ] ) );
+				}
+
+				if ( largest <= 0.0f ) break;
+
+				for ( std::uint32_t channel = 0; channel < 4; ++channel ) axis[ channel ] = next[ channel ] / largest;
+			}
+
+			float axis_length { 0.0f };
+			for ( const float value : axis ) axis_length += value * value;
+
+			// Every texel is the same color
+			if ( axis_length <= 0.0f ) return { mean, mean };
+
+			float min_t { std::numeric_limits< float >::max() };
+			float max_t { std::numeric_limits< float >::lowest() };
+
+			for ( std::uint32_t texel = 0; texel < 16; ++texel )
+			{
+				float t { 0.0f };
+				for ( std::uint32_t channel = 0; channel < 4; ++channel )
+					t += ( texels[ texel * 4 + channel ] - mean[ channel ] ) * axis[ channel ];
+
+				min_t = std::min( min_t, t / axis_length );
+				max_t = std::max( max_t, t / axis_length );
+			}
+
+			Color first {};
+			Color second {};
+
+			for ( std::uint32_t channel = 0; channel < 4; ++channel )
+			{
+				first[ channel ] = std::clamp( mean[ channel ] + axis[ channel ] * min_t, 0.0f, 255.0f );
+				second[ channel ] = std::clamp( mean[ channel ] + axis[ channel ] * max_t, 0.0f, 255.0f );
+			}
+
+			return { first, second };
+		}
+
+		//! Mode 5 endpoints of a single color channel, Interpolated with BC7_MODE5_SOLID_WEIGHT
+		struct BC7SolidEndpoints
+		{
+			std::uint8_t m_first;
+			std::uint8_t m_second;
+		};
+
+		//! Weight of the second 2 bit index of mode 5. Every 8 bit value lies exactly 21/64 of the way between two
+		//! 7 bit endpoints, Which no single weight can do for mode 6 as it's endpoints share their low bit
+		constexpr std::uint32_t BC7_MODE5_SOLID_WEIGHT { 21 };
+
+		//! Mode 5 endpoints for every 8 bit value, Built once
+		const std::array< BC7SolidEndpoints, 256 >& solidEndpoints()
+		{
+			static const std::array< BC7SolidEndpoints, 256 > table { []()
+			{
+				std::array< BC7SolidEndpoints, 256 > endpoints {};
+				std::array< bool, 256 > found {};
+
+				// Endpoints with the smallest difference are found first, So the block is as close to solid as possible
+				for ( std::uint32_t difference = 0; difference < 128; ++difference )
+				{
+					for ( std::uint32_t first = 0; first < 128; ++first )
+					{
+						for ( const std::uint32_t second : { first + difference, first - difference } )
+						{
+							if ( second >= 128 ) continue;
+
+							// 7 bit endpoints are expanded by repeating their high bit
+							const std::uint32_t first_value { ( first << 1 ) | ( first >> 6 ) };
+							const std::uint32_t second_value { ( second << 1 ) | ( second >> 6 ) };
+							const std::uint32_t value { ( ( 64 - BC7_MODE5_SOLID_WEIGHT ) * first_value
+								                          + BC7_MODE5_SOLID_WEIGHT * second_value + 32 )
+								                        >> 6 };
+
+							if ( found[ value ] ) continue;
+
+							found[ value ] = true;
+							endpoints[ value ] = { static_cast< std::uint8_t >( first ),
+								                   static_cast< std::uint8_t >( second ) };
+						}
+					}
+				}
+
+				return endpoints;
+			}() };
+
+			return table;
+		}
+
+		//! Encodes a block where every texel is the same color as mode 5, Which decodes to exactly that color
+		void encodeBC7Solid( const std::array< std::uint8_t, 4 >& color, std::uint8_t* const out )
+		{
+			const auto& endpoints { solidEndpoints() };
+
+			std::memset( out, 0, 16 );
+			BitWriter writer { out };
+
+			// Mode 5 is 5 zero bits followed by a one, Then the channel rotation
+			writer.write( 1 << 5, 6 );
+			writer.write( 0, 2 );
+
+			for ( std::uint32_t channel = 0; channel < 3; ++channel )
+			{
+				writer.write( endpoints[ color[ channel ] ].m_first, 7 );
+				writer.write( endpoints[ color[ channel ] ].m_second, 7 );
+			}
+
+			// Alpha endpoints are 8 bits, So the first one is the alpha of the block
+			writer.write( color[ 3 ], 8 );
+			writer.write( color[ 3 ], 8 );
+
+			// Every color index is 1, The first has it's implied high bit dropped. Alpha indices are all 0
+			writer.write( 1, 1 );
+			for ( std::uint32_t texel = 1; texel < 16; ++texel ) writer.write( 1, 2 );
+		}
+
+		//! Least squares endpoints for the weights the indices give every texel. Returns false if they are degenerate
+		bool refitEndpoints(
+			const TexelBlock& texels, const std::array< std::uint8_t, 16 >& indices, Color& first, Color& second )
+		{
+			float aa { 0.0f };
+			float ab { 0.0f };
+			float bb { 0.0f };
+			Color a_sum {};
+			Color b_sum {};
+
+			for ( std::uint32_t texel = 0; texel < 16; ++texel )
+			{
+				const float weight { static_cast< float >( BC7_WEIGHTS[ indices[ texel ] ] ) / 64.0f };
+				const float inverse { 1.0f - weight };
+
+				aa += inverse * inverse;
+				ab += inverse * weight;
+				bb += weight * weight;
+
+				for ( std::uint32_t channel = 0; channel < 4; ++channel )
+				{
+					a_sum[ channel ] += inverse * texels[ texel * 4 + channel ];
+					b_sum[ channel ] += weight * texels[ texel * 4 + channel ];
+				}
+			}
+
+			const float determinant { aa * bb - ab * ab };
+			if ( std::abs( determinant ) < 1e-6f ) return false;
+
+			for ( std::uint32_t channel = 0; channel < 4; ++channel )
+			{
+				first[ channel ] =
+					std::clamp( ( bb * a_sum[ channel ] - ab * b_sum[ channel ] ) / determinant, 0.0f, 255.0f );
+				second[ channel ] =
+					std::clamp( ( aa * b_sum[ channel ] - ab * a_sum[ channel ] ) / determinant, 0.0f, 255.0f );
+			}
+
+			return true;
+		}
+
+	} // namespace
+
+	void encodeBC7Block( const TexelBlock& texels, std::uint8_t* const out )
+	{
+		const std::array< std::uint8_t, 4 > first_texel { texels[ 0 ], texels[ 1 ], texels[ 2 ], texels[ 3 ] };
+		bool solid { true };
+
+		for ( std::uint32_t texel = 1; texel < 16 && solid; ++texel )
+			solid = std::memcmp( texels.data() + texel * 4, first_texel.data(), 4 ) == 0;
+
+		if ( solid )
+		{
+			encodeBC7Solid( first_texel, out );
+			return;
+		}
+
+		auto [ first_color, second_color ] = principalEndpoints( texels );
+
+		BC7Endpoint first { quantizeEndpoint( first_color ) };
+		BC7Endpoint second { quantizeEndpoint( second_color ) };
+
+		std::array< std::uint8_t, 16 > indices {};
+		std::uint32_t error { assignIndices( texels, first, second, indices ) };
+
+		// The principal axis ignores how the endpoints are quantized, Refitting to the chosen indices makes up for it
+		for ( std::uint32_t iteration = 0; iteration < 2 && error > 0; ++iteration )
+		{
+			if ( !refitEndpoints( texels, indices, first_color, second_color ) ) break;
+
+			const BC7Endpoint refit_first { quantizeEndpoint( first_color ) };
+			const BC7Endpoint refit_second { quantizeEndpoint( second_color ) };
+
+			std::array< std::uint8_t, 16 > refit_indices {};
+			const std::uint32_t refit_error { assignIndices( texels, refit_first, refit_second, refit_indices ) };
+
+			if ( refit_error >= error ) break;
+
+			first = refit_first;
+			second = refit_second;
+			indices = refit_indices;
+			error = refit_error;
+		}
+
+		// The high bit of the first index is implied to be 0, Which swapping the endpoints guarantees
+		if ( indices[ 0 ] >= 8 )
+		{
+			std::swap( first, second );
+			for ( auto& index : indices ) index = static_cast< std::uint8_t >( 15 - index );
+		}
+
+		std::memset( out, 0, 16 );
+		BitWriter writer { out };
+
+		// Mode 6 is 6 zero bits followed by a one
+		writer.write( 1 << 6, 7 );
+
+		for ( std::uint32_t channel = 0; channel < 4; ++channel )
+		{
+			writer.write( first.m_color[ channel ], 7 );
+			writer.write( second.m_color[ channel ], 7 );
+		}
+
+		writer.write( first.m_pbit, 1 );
+		writer.write( second.m_pbit, 1 );
+
+		writer.write( indices[ 0 ], 3 );
+		for ( std::uint32_t texel = 1; texel < 16; ++texel ) writer.write( indices[ texel ], 4 );
+	}
+
+	void encodeBC4Block( const TexelBlock& texels, const std::uint32_t channel, std::uint8_t* const out )
+	{
+		std::uint32_t min { 255 };
+		std::uint32_t max { 0 };
+
+		for ( std::uint32_t texel = 0; texel < 16; ++texel )
+		{
+			min = std::min< std::uint32_t >( min, texels[ texel * 4 + channel ] );
+			max = std::max< std::uint32_t >( max, texels[ texel * 4 + channel ] );
+		}
+
+		// The first endpoint being larger selects the 8 value palette, Which runs from the first to the second endpoint
+		out[ 0 ] = static_cast< std::uint8_t >( max );
+		out[ 1 ] = static_cast< std::uint8_t >( min );
+
+		std::uint64_t bits { 0 };
+
+		if ( max != min )
+		{
+			const std::uint32_t range { max - min };
+
+			for ( std::uint32_t texel = 0; texel < 16; ++texel )
+			{
+				// Position between the endpoints in sevenths, Rounded to the nearest
+				const std::uint32_t distance { max - texels[ texel * 4 + channel ] };
+				const std::uint32_t position { ( distance * 14 + range ) / ( 2 * range ) };
+
+				// Indices 0 and 1 are the endpoints themselves, 2 to 7 are the values between them
+				std::uint64_t index { position + 1 };
+				if ( position == 0 ) index = 0;
+				if ( position == 7 ) index = 1;
+
+				bits |= index << ( texel * 3 );
+			}
+		}
+
+		for ( std::uint32_t byte = 0; byte < 6; ++byte )
+			out[ 2 + byte ] = static_cast< std::uint8_t >( bits >> ( byte * 8 ) );
+	}
+
+	void encodeBC5Block( const TexelBlock& texels, std::uint8_t* const out )
+	{
+		encodeBC4Block( texels, 0, out );
+		encodeBC4Block( texels, 1, out + 8 );
+	}
+
+	DecodedImage compressImage( DecodedImage&& image, const TextureCompression compression )
+	{
+		ZoneScoped;
+		FGL_ASSERT( image.m_format == vk::Format::eR8G8B8A8Unorm, "Only RGBA8 images can be compressed" );
+
+		if ( compression == TextureCompression::None ) return std::move( image );
+
+		const vk::Format format { compressionFormat( compression ) };
+		const vk::Extent2D extent { static_cast< std::uint32_t >( image.m_width ),
+			                        static_cast< std::uint32_t >( image.m_height ) };
+
+		const auto source_offsets { mipOffsets( extent, image.m_mip_levels, vk::Format::eR8G8B8A8Unorm ) };
+		const auto block_offsets { mipOffsets( extent, image.m_mip_levels, format ) };
+		const vk::DeviceSize block_size { vk::blockSize( format ) };
+
+		FGL_ASSERT( image.m_pixels.size() == source_offsets.back(), "Image must contain it's full mip chain" );
+
+		std::vector< std::byte > blocks( block_offsets.back() );
+
+		for ( std::uint32_t level = 0; level < image.m_mip_levels; ++level )
+		{
+			const vk::Extent2D level_extent { mipExtent( extent, level ) };
+			const auto* const source {
+				reinterpret_cast< const std::uint8_t* >( image.m_pixels.data() + source_offsets[ level ] )
+			};
+			auto* const destination { reinterpret_cast< std::uint8_t* >( blocks.data() + block_offsets[ level ] ) };
+
+			const std::uint32_t blocks_x { ( level_extent.width + 3 ) / 4 };
+			const std::uint32_t blocks_y { ( level_extent.height + 3 ) / 4 };
+
+			for ( std::uint32_t block_y = 0; block_y < blocks_y; ++block_y )
+			{
+				for ( std::uint32_t block_x = 0; block_x < blocks_x; ++block_x )
+				{
+					TexelBlock texels {};
+
+					for ( std::uint32_t y = 0; y < 4; ++y )
+					{
+						const std::uint32_t source_y { std::min( block_y * 4 + y, level_extent.height - 1 ) };
+
+						for ( std::uint32_t x = 0; x < 4; ++x )
+						{
+							const std::uint32_t source_x { std::min( block_x * 4 + x, level_extent.width - 1 ) };
+							std::memcpy(
+								texels.data() + ( y * 4 + x ) * 4,
+								source + ( static_cast< std::size_t >( source_y ) * level_extent.width + source_x ) * 4,
+								4 );
+						}
+					}
+
+					std::uint8_t* const out {
+						destination + ( static_cast< std::size_t >( block_y ) * blocks_x + block_x ) * block_size
+					};
+
+					switch ( compression )
+					{
+						default:
+							[[fallthrough]];
+						case TextureCompression::BC7:
+							encodeBC7Block( texels, out );
+							break;
+						case TextureCompression::BC5:
+							encodeBC5Block( texels, out );
+							break;
+						case TextureCompression::BC4:
+							encodeBC4Block( texels, 0, out );
+							break;
+					}
+				}
+			}
+		}
+
+		image.m_pixels = std::move( blocks );
+		image.m_format = format;
+
+		return std::move( image );
+	}
+
+} // namespace fgl::engine
@@ -0,0 +1,69 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace fgl::engine
+{
+	struct DecodedImage;
+
+	//! Block compressed format a texture is stored with on the GPU
+	enum class TextureCompression : std::uint8_t
+	{
+		//! RGBA8, 4 bytes per texel
+		None = 0,
+		//! RGBA, 1 byte per texel. Color, Emissive and packed data maps
+		BC7 = 1,
+		//! Two channels, 1 byte per texel. Normal maps, Where Z is rebuilt in the shader
+		BC5 = 2,
+		//! Single channel, Half a byte per texel. Occlusion maps
+		BC4 = 3,
+	};
+
+	//! What a texture is used for by a material, Which decides how it can be compressed
+	enum class TextureRole : std::uint8_t
+	{
+		Color,
+		MetallicRoughness,
+		Normal,
+		Occlusion,
+		Emissive,
+	};
+
+	TextureCompression compressionForRole( TextureRole role );
+
+	//! Roles holding sRGB encoded color, Which have their mip chains filtered in linear space
+	bool isSrgbRole( TextureRole role );
+
+	//! Compression able to hold every channel either compression needs. Used for images shared between roles
+	TextureCompression mergeCompression( TextureCompression first, TextureCompression second );
+
+	vk::Format compressionFormat( TextureCompression compression );
+
+	//! A 4x4 block of RGBA8 texels, Row major
+	using TexelBlock = std::array< std::uint8_t, 16 * 4 >;
+
+	//! Encodes the block as BC7 mode 6 (Single subset, RGBA endpoints, 4 bit indices). Writes 16 bytes.
+	//! Blocks of a single color are encoded as mode 5 instead, Which decodes to exactly that color
+	void encodeBC7Block( const TexelBlock& texels, std::uint8_t* out );
+
+	//! Encodes a single channel of the block as BC4. Writes 8 bytes
+	void encodeBC4Block( const TexelBlock& texels, std::uint32_t channel, std::uint8_t* out );
+
+	//! Encodes the red and green channels of the block as BC5. Writes 16 bytes
+	void encodeBC5Block( const TexelBlock& texels, std::uint8_t* out );
+
+	/**
+	 * @brief Compresses every level of an RGBA8 image
+	 * @details Blocks past the edge of a level repeat the last row and column of texels
+	 * @return The image with it's pixels replaced by the compressed blocks of every level, Largest first
+	 */
+	DecodedImage compressImage( DecodedImage&& image, TextureCompression compression );
+
+} // namespace fgl::engine
@@ -0,0 +1,89 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "StreamSelection.hpp"
+
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+
+namespace fgl::engine
+{
+
+	std::vector< StreamDecision > selectStreams(
+		const std::span< const StreamCandidate > candidates,
+		vk::DeviceSize& resident_bytes,
+		const vk::DeviceSize budget )
+	{
+		ZoneScoped;
+
+		std::vector< std::size_t > upgrades {};
+		std::vector< std::size_t > evictions {};
+
+		for ( std::size_t i = 0; i < candidates.size(); ++i )
+		{
+			const StreamCandidate& candidate { candidates[ i ] };
+
+			if ( candidate.m_desired_level < candidate.m_resident_level )
+				upgrades.emplace_back( i );
+			else if ( candidate.m_desired_level > candidate.m_resident_level )
+				evictions.emplace_back( i );
+		}
+
+		// Textures missing the most levels go first. Evictions start with the textures sampled the longest ago
+		std::ranges::stable_sort(
+			upgrades,
+			std::ranges::greater {},
+			[ candidates ]( const std::size_t i )
+			{ return candidates[ i ].m_resident_level - candidates[ i ].m_desired_level; } );
+		std::ranges::stable_sort(
+			evictions,
+			std::ranges::less {},
+			[ candidates ]( const std::size_t i ) { return candidates[ i ].m_last_used_frame; } );
+
+		std::vector< StreamDecision > decisions {};
+		auto next_eviction { evictions.begin() };
+
+		const auto evict = [ candidates, &resident_bytes, &decisions ]( const std::size_t i )
+		{
+			const StreamCandidate& candidate { candidates[ i ] };
+			resident_bytes -=
+				candidate.levelsSize( candidate.m_resident_level ) - candidate.levelsSize( candidate.m_desired_level );
+			decisions.emplace_back( i, candidate.m_desired_level );
+		};
+
+		for ( const std::size_t i : upgrades )
+		{
+			if ( decisions.size() >= MAX_STREAMS_PER_FRAME ) break;
+
+			const StreamCandidate& candidate { candidates[ i ] };
+			const vk::DeviceSize resident_size { candidate.levelsSize( candidate.m_resident_level ) };
+
+			const auto fits = [ & ]( const std::uint32_t level ) -> bool
+			{ return resident_bytes + candidate.levelsSize( level ) - resident_size <= budget; };
+
+			// Room is made by dropping levels nothing is asking for
+			while ( !fits( candidate.m_desired_level ) && next_eviction != evictions.end()
+			        && decisions.size() + 1 < MAX_STREAMS_PER_FRAME )
+				evict( *next_eviction++ );
+
+			// Whatever still does not fit is left for when more of the budget is free
+			std::uint32_t level { candidate.m_desired_level };
+			while ( level < candidate.m_resident_level && !fits( level ) ) ++level;
+
+			if ( level == candidate.m_resident_level ) continue;
+
+			resident_bytes += candidate.levelsSize( level ) - resident_size;
+			decisions.emplace_back( i, level );
+		}
+
+		// Unwanted levels are only dropped to get back under the budget, As keeping them avoids uploading them again
+		while ( resident_bytes > budget && next_eviction != evictions.end()
+		        && decisions.size() < MAX_STREAMS_PER_FRAME )
+			evict( *next_eviction++ );
+
+		return decisions;
+	}
+
+} // namespace fgl::engine
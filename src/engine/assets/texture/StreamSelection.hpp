@@ -0,0 +1,60 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace fgl::engine
+{
+
+	//! Number of textures that can start uploading new levels each frame
+	constexpr std::uint32_t MAX_STREAMS_PER_FRAME { 4 };
+
+	//! A streamed texture that wants a different set of levels than it has resident. See TextureStreamer
+	struct StreamCandidate
+	{
+		//! Level 0 of the resident image
+		std::uint32_t m_resident_level;
+
+		//! Level the texture should have resident
+		std::uint32_t m_desired_level;
+
+		//! Frame the texture was last sampled in
+		std::uint64_t m_last_used_frame;
+
+		//! Offset of each level of the full mip chain, Followed by the size of the chain. See mipOffsets
+		std::span< const vk::DeviceSize > m_level_offsets;
+
+		//! Memory used by the levels from first_level on
+		vk::DeviceSize levelsSize( const std::uint32_t first_level ) const
+		{
+			return m_level_offsets.back() - m_level_offsets[ first_level ];
+		}
+	};
+
+	struct StreamDecision
+	{
+		//! Index of the texture in the candidates
+		std::size_t m_candidate;
+
+		//! First level of the image the texture should be given
+		std::uint32_t m_level;
+	};
+
+	/**
+	 * @brief Picks which textures start streaming levels in or out this frame
+	 * @details Textures missing the most levels are given them first, As much of them as fits in the budget. Room is
+	 * made by dropping the unwanted levels of the textures sampled the longest ago, Which are otherwise only dropped
+	 * once the budget is exceeded. At most MAX_STREAMS_PER_FRAME textures are picked.
+	 * @param resident_bytes Memory used by every streamed texture, Updated to include the picked streams
+	 */
+	std::vector< StreamDecision > selectStreams(
+		std::span< const StreamCandidate > candidates, vk::DeviceSize& resident_bytes, vk::DeviceSize budget );
+
+} // namespace fgl::engine
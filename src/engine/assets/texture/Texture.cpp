@@ -4,12 +4,19 @@
 
 #include "Texture.hpp"
 
+#include "engine/FGL_DEFINES.hpp"
 #include "engine/FrameInfo.hpp"
 #include "engine/assets/image/Image.hpp"
 #include "engine/assets/image/ImageView.hpp"
+#include "engine/assets/image/MipChain.hpp"
+#include "engine/assets/texture/TextureCache.hpp"
+#include "engine/assets/texture/TextureStreamer.hpp"
 #include "engine/debug/logging/logging.hpp"
 #include "engine/descriptors/DescriptorSet.hpp"
+#include "engine/filesystem/MappedFile.hpp"
 #include "engine/math/noise/perlin/generator.hpp"
+#include "engine/memory/DefferedCleanup.hpp"
+#include "engine/utility/ThreadPool.hpp"
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Weffc++"
@@ -25,35 +32,72 @@ namespace fgl::engine
 
 	static IDPool< TextureID > texture_id_pool { 1 };
 
-	std::tuple< std::vector< std::byte >, int, int, vk::Format, Sampler >
-		loadTexture( const std::filesystem::path& path, Sampler&& sampler, vk::Format format = vk::Format::eUndefined )
+	//! Reads and decodes a texture file with it's full mip chain. Safe to call from any thread
+	static DecodedImage decodeTextureFile( const std::filesystem::path& path, const vk::Format format )
 	{
 		ZoneScoped;
 		if ( !std::filesystem::exists( path ) )
 			throw std::
 				runtime_error( std::format( "Failed to open file: {}", std::filesystem::absolute( path ).string() ) );
 
+		const filesystem::MappedFile file { path };
+
+		// Without a specific format the file is treated as a color texture, Which can be compressed
+		if ( format == vk::Format::eUndefined )
+			return prepareTextureImage(
+				file.data(), compressionForRole( TextureRole::Color ), isSrgbRole( TextureRole::Color ) );
+
 		//TODO: More robust image loading. I should be checking what channels images have and what they are using for their bits per channel.
-		if ( format == vk::Format::eUndefined ) format = vk::Format::eR8G8B8A8Unorm;
+		//TODO: Write check to ensure the format matches the number of channels
+		DecodedImage image { decodeImage( file.data() ) };
+
+		image.m_mip_levels = generateMipChain(
+			image.m_pixels,
+			vk::Extent2D(
+				static_cast< std::uint32_t >( image.m_width ), static_cast< std::uint32_t >( image.m_height ) ),
+			format == vk::Format::eR8G8B8A8Srgb );
+		image.m_format = format;
+
+		return image;
+	}
 
+	std::tuple< DecodedImage, vk::Format, Sampler >
+		loadTexture( const std::filesystem::path& path, Sampler&& sampler, vk::Format format = vk::Format::eUndefined )
+	{
+		ZoneScoped;
+		DecodedImage image { decodeTextureFile( path, format ) };
+		const vk::Format image_format { image.m_format };
+
+		return { std::move( image ), image_format, std::forward< Sampler >( sampler ) };
+	}
+
+	DecodedImage decodeImage( const std::span< const std::byte > encoded )
+	{
+		ZoneScoped;
 		int x { 0 };
 		int y { 0 };
 		int channels { 0 };
 
-		std::string path_str { path.string() };
-
-		const auto data_c { stbi_load( path_str.data(), &x, &y, &channels, 4 ) };
+		const auto data_c { stbi_load_from_memory(
+			reinterpret_cast< const stbi_uc* >( encoded.data() ),
+			static_cast< int >( encoded.size() ),
+			&x,
+			&y,
+			&channels,
+			4 ) };
 
-		std::vector< std::byte > data {};
+		if ( data_c == nullptr )
+			throw std::runtime_error( std::format( "Failed to decode image: {}", stbi_failure_reason() ) );
 
-		data.resize( x * y * 4 );
-		std::memcpy( data.data(), data_c, x * y * 4 );
+		DecodedImage image {};
+		image.m_width = x;
+		image.m_height = y;
+		image.m_pixels.resize( x * y * 4 );
+		std::memcpy( image.m_pixels.data(), data_c, x * y * 4 );
 
 		stbi_image_free( data_c );
 
-		//TODO: Write check to ensure the format matches the number of channels
-
-		return { std::move( data ), x, y, format, std::forward< Sampler >( sampler ) };
+		return image;
 	}
 
 	void Texture::drawImGui( vk::Extent2D extent )
@@ -97,13 +141,13 @@ namespace fgl::engine
 		return ImGui::ImageButton( m_name.c_str(), getImGuiDescriptorSet(), imgui_size );
 	}
 
-	Texture::Texture( std::tuple< std::vector< std::byte >, int, int, vk::Format, Sampler > tuple ) :
+	Texture::Texture( std::tuple< DecodedImage, vk::Format, Sampler > tuple ) :
 	  Texture(
-		  std::move( std::get< 0 >( tuple ) ),
-		  std::get< 1 >( tuple ),
-		  std::get< 2 >( tuple ),
-		  std::get< 3 >( tuple ),
-		  std::move( std::get< 4 >( tuple ) ) )
+		  std::move( std::get< 0 >( tuple ).m_pixels ),
+		  vk::Extent2D( std::get< 0 >( tuple ).m_width, std::get< 0 >( tuple ).m_height ),
+		  std::get< 0 >( tuple ).m_mip_levels,
+		  std::move( std::get< 2 >( tuple ) ),
+		  std::get< 1 >( tuple ) )
 	{}
 
 	Texture::Texture(
@@ -117,6 +161,15 @@ namespace fgl::engine
 
 	Texture::Texture(
 		std::vector< std::byte >&& data, const vk::Extent2D extent, Sampler&& sampler, const vk::Format format ) :
+	  Texture( std::forward< std::vector< std::byte > >( data ), extent, 1, std::forward< Sampler >( sampler ), format )
+	{}
+
+	Texture::Texture(
+		std::vector< std::byte >&& data,
+		const vk::Extent2D extent,
+		const std::uint32_t mip_levels,
+		Sampler&& sampler,
+		const vk::Format format ) :
 	  m_texture_id( texture_id_pool.getID() ),
 	  m_image(
 		  std::make_shared< Image >(
@@ -124,7 +177,8 @@ namespace fgl::engine
 			  format,
 			  vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
 			  vk::ImageLayout::eUndefined,
-			  vk::ImageLayout::eShaderReadOnlyOptimal ) ),
+			  vk::ImageLayout::eShaderReadOnlyOptimal,
+			  mip_levels ) ),
 	  m_image_view( m_image->getView( std::forward< Sampler >( sampler ) ) ),
 	  m_extent( extent ),
 	  m_name( "Default Texture Name" )
@@ -147,9 +201,208 @@ namespace fgl::engine
 	  Texture( loadTexture( path, std::forward< Sampler >( sampler ) ) )
 	{}
 
+	Texture::Texture( const std::filesystem::path& path, DecodedImage&& image, Sampler&& sampler ) :
+	  Texture(
+		  std::move( image.m_pixels ),
+		  vk::Extent2D( image.m_width, image.m_height ),
+		  image.m_mip_levels,
+		  std::forward< Sampler >( sampler ),
+		  image.m_format )
+	{
+		setName( path.filename() );
+	}
+
 	Texture::Texture( const std::filesystem::path& path ) : Texture( path, {} )
 	{}
 
+	Texture::Texture( Sampler&& sampler, const std::shared_ptr< Texture >& placeholder ) :
+	  m_texture_id( texture_id_pool.getID() ),
+	  m_image( nullptr ),
+	  m_image_view( nullptr ),
+	  m_extent( placeholder->getExtent() ),
+	  m_name( "Default Texture Name" ),
+	  m_pending( PendingLoad { std::forward< Sampler >( sampler ), placeholder, {} } )
+	{}
+
+	std::shared_ptr< Texture > Texture::placeholder()
+	{
+		static std::weak_ptr< Texture > placeholder_texture {};
+
+		if ( auto texture = placeholder_texture.lock() ) return texture;
+
+		// A single mid grey texel, Which also reads as a flat normal for normal maps
+		std::vector< std::byte > data( 4, std::byte { 0x80 } );
+		data[ 3 ] = std::byte { 0xFF };
+
+		std::shared_ptr< Texture > texture {
+			new Texture( std::move( data ), vk::Extent2D( 1, 1 ), Sampler(), vk::Format::eR8G8B8A8Unorm )
+		};
+		texture->setName( "Placeholder Texture" );
+
+		placeholder_texture = texture;
+
+		return texture;
+	}
+
+	std::pair< std::shared_ptr< Texture >, std::future< DecodedImage > >
+		Texture::beginLoad( const std::filesystem::path& path, Sampler&& sampler )
+	{
+		auto image { getThreadPool().submit(
+			[ path ]() -> DecodedImage { return decodeTextureFile( path, vk::Format::eUndefined ); } ) };
+
+		return beginLoad( path, std::move( image ), std::forward< Sampler >( sampler ) );
+	}
+
+	std::pair< std::shared_ptr< Texture >, std::future< DecodedImage > >
+		Texture::beginLoad( const std::filesystem::path& path )
+	{
+		return beginLoad( path, Sampler() );
+	}
+
+	std::pair< std::shared_ptr< Texture >, std::future< DecodedImage > > Texture::beginLoad(
+		const std::filesystem::path& path, std::future< DecodedImage >&& image, Sampler&& sampler )
+	{
+		ZoneScoped;
+		FGL_ASSERT( image.valid(), "Texture must be given the image it is waiting for" );
+
+		std::shared_ptr< Texture > texture { new Texture( std::forward< Sampler >( sampler ), placeholder() ) };
+		texture->setName( path.filename() );
+
+		// Bound right away, So anything using the texture id samples the placeholder until the image arrives
+		getDescriptorSet().bindTexture( 0, texture );
+		getDescriptorSet().update();
+
+		return { std::move( texture ), std::move( image ) };
+	}
+
+	//! Creates an image holding the levels of the mip chain from first_level on, And queues it's upload
+	static std::shared_ptr< Image > uploadLevels( const DecodedImage& source, const std::uint32_t first_level )
+	{
+		ZoneScoped;
+		const vk::Extent2D extent { static_cast< std::uint32_t >( source.m_width ),
+			                        static_cast< std::uint32_t >( source.m_height ) };
+		const std::vector< vk::DeviceSize > offsets { mipOffsets( extent, source.m_mip_levels, source.m_format ) };
+
+		auto image { std::make_shared< Image >(
+			mipExtent( extent, first_level ),
+			source.m_format,
+			vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
+			vk::ImageLayout::eUndefined,
+			vk::ImageLayout::eShaderReadOnlyOptimal,
+			source.m_mip_levels - first_level ) };
+
+		// The size of a level only depends on it's extent, So the levels are packed the same in the shorter chain
+		std::vector< std::byte > pixels(
+			source.m_pixels.begin() + static_cast< std::ptrdiff_t >( offsets[ first_level ] ), source.m_pixels.end() );
+
+		// ready() flips once the transfer manager has staged this
+		memory::TransferManager::getInstance().copyToImage( std::move( pixels ), *image );
+
+		return image;
+	}
+
+	void Texture::finishLoad( const std::shared_ptr< Texture >& texture, DecodedImage&& image )
+	{
+		ZoneScoped;
+		FGL_ASSERT( texture->m_pending.has_value(), "Texture was not waiting for an image" );
+
+		PendingLoad& pending { *texture->m_pending };
+
+		const vk::Extent2D extent { static_cast< std::uint32_t >( image.m_width ),
+			                        static_cast< std::uint32_t >( image.m_height ) };
+
+		// Without the streamer nothing would ever bring the finer levels in, So the whole chain is kept resident
+		const std::uint32_t tail_level {
+			getTextureStreamer().enabled() ? streamingTailLevel( extent, image.m_mip_levels ) : 0
+		};
+
+		if ( tail_level == 0 )
+		{
+			texture->m_image = std::make_shared< Image >(
+				extent,
+				image.m_format,
+				vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
+				vk::ImageLayout::eUndefined,
+				vk::ImageLayout::eShaderReadOnlyOptimal,
+				image.m_mip_levels );
+
+			// ready() flips once the transfer manager has staged this
+			memory::TransferManager::getInstance().copyToImage( std::move( image.m_pixels ), *texture->m_image );
+		}
+		else
+		{
+			// Only the tail is uploaded, The finer levels are streamed in once the texture is sampled with them
+			texture->m_source = std::make_unique< const DecodedImage >( std::move( image ) );
+			texture->m_level_offsets =
+				mipOffsets( extent, texture->m_source->m_mip_levels, texture->m_source->m_format );
+			texture->m_resident_level = tail_level;
+			texture->m_image = uploadLevels( *texture->m_source, tail_level );
+		}
+
+		texture->m_image_view = texture->m_image->getView( std::move( pending.m_sampler ) );
+		texture->m_extent = extent;
+
+		const std::string name { std::move( pending.m_name ) };
+		texture->m_pending.reset();
+
+		if ( !name.empty() ) texture->setName( name );
+
+		getDescriptorSet().bindTexture( 0, texture );
+		getDescriptorSet().update();
+
+		if ( texture->streamed() ) getTextureStreamer().track( texture );
+	}
+
+	std::uint32_t Texture::mipLevels() const
+	{
+		if ( m_source ) return m_source->m_mip_levels;
+
+		assert( m_image );
+		return m_image->mipLevels();
+	}
+
+	vk::DeviceSize Texture::levelsSize( const std::uint32_t first_level ) const
+	{
+		FGL_ASSERT( m_source, "Only streamed textures keep their full mip chain" );
+
+		return m_level_offsets.back() - m_level_offsets[ first_level ];
+	}
+
+	void Texture::streamLevels( const std::uint32_t first_level )
+	{
+		ZoneScoped;
+		FGL_ASSERT( m_source, "Only streamed textures keep their full mip chain" );
+		FGL_ASSERT( first_level < m_source->m_mip_levels, "Level is past the end of the mip chain" );
+
+		m_streaming_image = uploadLevels( *m_source, first_level );
+		m_streaming_view = m_streaming_image->getView( m_image_view->getSampler() );
+		m_streaming_level = first_level;
+	}
+
+	bool Texture::finishStreaming()
+	{
+		if ( !m_streaming_view || !m_streaming_view->ready() ) return false;
+
+		// Frames in flight can still be sampling the previous image
+		memory::deferredDelete( std::move( m_image_view ) );
+		memory::deferredDelete( std::move( m_image ) );
+
+		m_image = std::move( m_streaming_image );
+		m_image_view = std::move( m_streaming_view );
+		m_resident_level = m_streaming_level;
+
+#if ENABLE_IMGUI
+		// Recreated for the new view the next time it is drawn
+		if ( m_imgui_set != VK_NULL_HANDLE )
+		{
+			ImGui_ImplVulkan_RemoveTexture( m_imgui_set );
+			m_imgui_set = VK_NULL_HANDLE;
+		}
+#endif
+
+		return true;
+	}
+
 	Texture::Texture( const std::filesystem::path& path, const vk::Format format ) : Texture( path, {}, format )
 	{}
 
@@ -164,21 +417,28 @@ namespace fgl::engine
 
 	Image& Texture::getImageRef()
 	{
+		assert( m_image );
 		return *m_image;
 	}
 
 	vk::DescriptorImageInfo Texture::getDescriptor() const
 	{
+		if ( m_pending ) return m_pending->m_placeholder->getDescriptor();
+
 		return m_image_view->descriptorInfo( vk::ImageLayout::eGeneral );
 	}
 
 	vk::Extent2D Texture::getExtent() const
 	{
-		return m_image_view->getExtent();
+		// Streamed textures have views of only some levels, So this is the extent of the full mip chain instead
+		return m_extent;
 	}
 
 	ImageView& Texture::getImageView()
 	{
+		// Waiting textures are bound with the view of the placeholder
+		if ( m_pending ) return m_pending->m_placeholder->getImageView();
+
 		assert( m_image_view );
 		return *m_image_view;
 	}
@@ -221,6 +481,8 @@ namespace fgl::engine
 
 	bool Texture::ready() const
 	{
+		if ( m_pending ) return false;
+
 		assert( m_image_view );
 		return this->m_image_view->ready();
 	}
@@ -232,6 +494,13 @@ namespace fgl::engine
 
 	void Texture::setName( const std::string& str )
 	{
+		// There is nothing to name until the image arrives
+		if ( m_pending )
+		{
+			m_pending->m_name = str;
+			return;
+		}
+
 		m_image->setName( str + " Image" );
 		m_image_view->setName( str + " ImageView" );
 	}
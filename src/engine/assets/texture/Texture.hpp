@@ -7,6 +7,9 @@
 #include <vulkan/vulkan.hpp>
 
 #include <filesystem>
+#include <future>
+#include <optional>
+#include <span>
 
 #include "debug/Track.hpp"
 #include "engine/assets/AssetManager.hpp"
@@ -37,6 +40,20 @@ namespace fgl::engine
 
 	class Texture;
 
+	//! Image decoded ahead of time, So a texture can be created without reading or decoding the file again
+	struct DecodedImage
+	{
+		//! Every level of the mip chain packed one after the other, Largest first. Blocks for compressed formats
+		std::vector< std::byte > m_pixels {};
+		int m_width { 0 };
+		int m_height { 0 };
+		std::uint32_t m_mip_levels { 1 };
+		vk::Format m_format { vk::Format::eR8G8B8A8Unorm };
+	};
+
+	//! Decodes an encoded (png, jpeg, ect) image into RGBA8. Safe to call from any thread
+	DecodedImage decodeImage( std::span< const std::byte > encoded );
+
 	using TextureStore = AssetStore< Texture >;
 
 	//TODO: Implement texture handle map to avoid loading the same texture multiple times
@@ -65,7 +82,40 @@ namespace fgl::engine
 
 		std::string m_name;
 
-		[[nodiscard]] Texture( std::tuple< std::vector< std::byte >, int, int, vk::Format, Sampler > );
+		//! State of a texture from beginLoad, Until finishLoad is given it's image
+		struct PendingLoad
+		{
+			Sampler m_sampler;
+
+			//! Bound in it's place until then. See getImageView
+			std::shared_ptr< Texture > m_placeholder;
+
+			std::string m_name;
+		};
+
+		std::optional< PendingLoad > m_pending { std::nullopt };
+
+		//! Every level of the mip chain. Kept by streamed textures, So levels can be uploaded again after an eviction
+		std::unique_ptr< const DecodedImage > m_source { nullptr };
+
+		//! mipOffsets of m_source, Kept as the streamer asks for the size of levels every frame
+		std::vector< vk::DeviceSize > m_level_offsets {};
+
+		//! Level of the mip chain that is level 0 of m_image
+		std::uint32_t m_resident_level { 0 };
+
+		//! Image with a different set of levels, Swapped in by finishStreaming once it has been staged
+		std::shared_ptr< Image > m_streaming_image { nullptr };
+		std::shared_ptr< ImageView > m_streaming_view { nullptr };
+		std::uint32_t m_streaming_level { 0 };
+
+		//! Shared by every texture waiting for it's image, Created when the first of them begins loading
+		static std::shared_ptr< Texture > placeholder();
+
+		//! Construct a texture with no image yet. See beginLoad
+		[[nodiscard]] Texture( Sampler&& sampler, const std::shared_ptr< Texture >& placeholder );
+
+		[[nodiscard]] Texture( std::tuple< DecodedImage, vk::Format, Sampler > );
 
 		//! Construct texture with a specific extent and data
 		[[nodiscard]] Texture(
@@ -75,10 +125,22 @@ namespace fgl::engine
 		[[nodiscard]] Texture(
 			std::vector< std::byte >&& data, vk::Extent2D extent, Sampler&& sampler, vk::Format texture_format );
 
+		//! Construct texture with a specific extent and data containing every level of a mip chain, Largest first
+		[[nodiscard]] Texture(
+			std::vector< std::byte >&& data,
+			vk::Extent2D extent,
+			std::uint32_t mip_levels,
+			Sampler&& sampler,
+			vk::Format texture_format );
+
 		//! Construct with a specific format
 		[[nodiscard]] Texture( const std::filesystem::path& path, Sampler&&, vk::Format format );
 
 		[[nodiscard]] Texture( const std::filesystem::path& path, Sampler&& sampler );
+
+		//! Construct from an image that was already decoded. The path is only used as the key and name
+		[[nodiscard]] Texture( const std::filesystem::path& path, DecodedImage&& image, Sampler&& sampler );
+
 		[[nodiscard]] Texture( const std::filesystem::path& path );
 		[[nodiscard]] Texture( const std::filesystem::path& path, vk::Format format );
 
@@ -88,8 +150,43 @@ namespace fgl::engine
 
 		static UIDKeyT extractKey( const std::filesystem::path& path ) { return path; }
 
+		static UIDKeyT extractKey(
+			const std::filesystem::path& path, [[maybe_unused]] DecodedImage&&, [[maybe_unused]] Sampler&& )
+		{
+			return path;
+		}
+
 		static UIDKeyT extractKey( const std::filesystem::path& path, [[maybe_unused]] vk::Format ) { return path; }
 
+		static UIDKeyT extractKey(
+			const std::filesystem::path& path,
+			[[maybe_unused]] std::future< DecodedImage >&&,
+			[[maybe_unused]] Sampler&& )
+		{
+			return path;
+		}
+
+		//! Result of the background work of beginLoad
+		using PreparedT = DecodedImage;
+
+		/**
+		 * @brief Creates a texture that is bound to the placeholder texture, Then decodes the file on the thread pool
+		 * @details Used by AssetStore::loadAsync. The texture becomes ready once finishLoad was called and the
+		 * upload it queued has been staged
+		 */
+		static std::pair< std::shared_ptr< Texture >, std::future< DecodedImage > >
+			beginLoad( const std::filesystem::path& path, Sampler&& sampler );
+
+		static std::pair< std::shared_ptr< Texture >, std::future< DecodedImage > >
+			beginLoad( const std::filesystem::path& path );
+
+		//! Same as above, But for an image that is already being decoded
+		static std::pair< std::shared_ptr< Texture >, std::future< DecodedImage > > beginLoad(
+			const std::filesystem::path& path, std::future< DecodedImage >&& image, Sampler&& sampler );
+
+		//! Creates the image for a texture from beginLoad, Queues it's upload and binds it in place of the placeholder
+		static void finishLoad( const std::shared_ptr< Texture >& texture, DecodedImage&& image );
+
 		Texture() = delete;
 
 		~Texture();
@@ -105,6 +202,32 @@ namespace fgl::engine
 
 		bool ready() const;
 
+		//! True if only some levels of the mip chain are resident. See TextureStreamer
+		bool streamed() const { return m_source != nullptr; }
+
+		//! True while an image from streamLevels is waiting to be staged
+		bool streaming() const { return m_streaming_image != nullptr; }
+
+		std::uint32_t residentLevel() const { return m_resident_level; }
+
+		//! Level the image from streamLevels starts at. Only meaningful while streaming()
+		std::uint32_t streamingLevel() const { return m_streaming_level; }
+
+		//! Number of levels in the full mip chain
+		std::uint32_t mipLevels() const;
+
+		//! Memory used by the levels of the full mip chain from first_level on
+		vk::DeviceSize levelsSize( std::uint32_t first_level ) const;
+
+		//! Offset of each level of the full mip chain, Followed by the size of the chain. Only kept if streamed()
+		const std::vector< vk::DeviceSize >& levelOffsets() const { return m_level_offsets; }
+
+		//! Starts uploading an image holding the levels of the full mip chain from first_level on
+		void streamLevels( std::uint32_t first_level );
+
+		//! Swaps in the image from streamLevels once it has been staged, Returns true if it did
+		bool finishStreaming();
+
 		[[nodiscard]] TextureID getID() const;
 		void setName( const std::string& str );
 
@@ -0,0 +1,346 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "TextureCache.hpp"
+
+#include <tracy/Tracy.hpp>
+
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <numeric>
+
+#include "Texture.hpp"
+#include "engine/FGL_DEFINES.hpp"
+#include "engine/assets/image/MipChain.hpp"
+#include "engine/assets/model/builders/MeshCache.hpp"
+#include "engine/debug/logging/logging.hpp"
+#include "engine/filesystem/MappedFile.hpp"
+#include "engine/rendering/devices/Device.hpp"
+
+namespace fgl::engine
+{
+
+	//! Offset of the level index, Which directly follows the identifier, Header and index
+	constexpr std::uint64_t KTX2_LEVELS_OFFSET { KTX2_IDENTIFIER.size() + sizeof( Ktx2Header ) + sizeof( Ktx2Index ) };
+
+	std::filesystem::path textureCachePath( const std::uint64_t source_hash )
+	{
+		return std::filesystem::current_path() / "cache" / "textures" / std::format( "{:016x}.ktx2", source_hash );
+	}
+
+	static std::uint64_t alignUp( const std::uint64_t value, const std::uint64_t alignment )
+	{
+		return ( value + alignment - 1 ) / alignment * alignment;
+	}
+
+	//! Formats compressImage can produce, The only ones the cache will read back
+	static bool isCacheFormat( const vk::Format format )
+	{
+		return format == compressionFormat( TextureCompression::None )
+		    || format == compressionFormat( TextureCompression::BC7 )
+		    || format == compressionFormat( TextureCompression::BC5 )
+		    || format == compressionFormat( TextureCompression::BC4 );
+	}
+
+	//! Basic data format descriptor of the format, As required by KTX2. See the Khronos Data Format specification
+	static std::vector< std::uint32_t > dataFormatDescriptor( const vk::Format format )
+	{
+		struct Sample
+		{
+			std::uint32_t m_bit_offset;
+			std::uint32_t m_bit_length;
+			std::uint32_t m_channel;
+			std::uint32_t m_upper;
+		};
+
+		constexpr std::uint32_t MODEL_RGBSDA { 1 };
+		constexpr std::uint32_t MODEL_BC4 { 131 };
+		constexpr std::uint32_t MODEL_BC5 { 132 };
+		constexpr std::uint32_t MODEL_BC7 { 134 };
+		constexpr std::uint32_t CHANNEL_ALPHA { 15 };
+
+		std::uint32_t color_model { MODEL_RGBSDA };
+		std::vector< Sample > samples {};
+
+		switch ( format )
+		{
+			default:
+				throw std::runtime_error( std::format( "No data format descriptor for {}", vk::to_string( format ) ) );
+			case vk::Format::eR8G8B8A8Unorm:
+				samples = { { 0, 8, 0, 255 }, { 8, 8, 1, 255 }, { 16, 8, 2, 255 }, { 24, 8, CHANNEL_ALPHA, 255 } };
+				break;
+			case vk::Format::eBc7UnormBlock:
+				color_model = MODEL_BC7;
+				samples = { { 0, 128, 0, 0xFFFFFFFF } };
+				break;
+			case vk::Format::eBc5UnormBlock:
+				color_model = MODEL_BC5;
+				samples = { { 0, 64, 0, 0xFFFFFFFF }, { 64, 64, 1, 0xFFFFFFFF } };
+				break;
+			case vk::Format::eBc4UnormBlock:
+				color_model = MODEL_BC4;
+				samples = { { 0, 64, 0, 0xFFFFFFFF } };
+				break;
+		}
+
+		const auto block_extent { vk::blockExtent( format ) };
+		const auto block_size { static_cast< std::uint32_t >( 24 + 16 * samples.size() ) };
+
+		std::vector< std::uint32_t > words {};
+
+		words.emplace_back( 4 + block_size );
+		// Khronos vendor, Basic descriptor type
+		words.emplace_back( 0 );
+		// Version 1.3 of the specification
+		words.emplace_back( 2 | ( block_size << 16 ) );
+		// BT.709 primaries, Linear transfer, Straight alpha
+		words.emplace_back( color_model | ( 1 << 8 ) | ( 1 << 16 ) );
+		// Stored as one less than the dimension
+		words.emplace_back( ( block_extent[ 0 ] - 1u ) | ( ( block_extent[ 1 ] - 1u ) << 8 ) );
+		words.emplace_back( vk::blockSize( format ) );
+		words.emplace_back( 0 );
+
+		for ( const auto& sample : samples )
+		{
+			// Bit lengths are also stored as one less
+			words.emplace_back(
+				sample.m_bit_offset | ( ( sample.m_bit_length - 1 ) << 16 ) | ( sample.m_channel << 24 ) );
+			words.emplace_back( 0 );
+			words.emplace_back( 0 );
+			words.emplace_back( sample.m_upper );
+		}
+
+		return words;
+	}
+
+	void writeTextureCache(
+		const std::filesystem::path& path, const DecodedImage& image, const std::uint64_t source_hash )
+	{
+		ZoneScoped;
+		const vk::Format format { image.m_format };
+		const vk::Extent2D extent { static_cast< std::uint32_t >( image.m_width ),
+			                        static_cast< std::uint32_t >( image.m_height ) };
+
+		const auto offsets { mipOffsets( extent, image.m_mip_levels, format ) };
+		FGL_ASSERT( image.m_pixels.size() == offsets.back(), "Image must contain it's full mip chain" );
+
+		const std::vector< std::uint32_t > descriptor { dataFormatDescriptor( format ) };
+
+		// A single entry, The length, Then the key and value separated by a null
+		std::vector< std::byte > key_values( sizeof( std::uint32_t ) + KTX2_SOURCE_HASH_KEY.size() + 1
+		                                     + sizeof( source_hash ) );
+		const auto entry_length { static_cast< std::uint32_t >( key_values.size() - sizeof( std::uint32_t ) ) };
+		std::memcpy( key_values.data(), &entry_length, sizeof( entry_length ) );
+		std::memcpy( key_values.data() + 4, KTX2_SOURCE_HASH_KEY.data(), KTX2_SOURCE_HASH_KEY.size() );
+		std::memcpy( key_values.data() + 4 + KTX2_SOURCE_HASH_KEY.size() + 1, &source_hash, sizeof( source_hash ) );
+		key_values.resize( alignUp( key_values.size(), 4 ) );
+
+		Ktx2Header header {};
+		header.m_vk_format = static_cast< std::uint32_t >( format );
+		header.m_type_size = 1;
+		header.m_pixel_width = extent.width;
+		header.m_pixel_height = extent.height;
+		header.m_pixel_depth = 0;
+		header.m_layer_count = 0;
+		header.m_face_count = 1;
+		header.m_level_count = image.m_mip_levels;
+		header.m_supercompression_scheme = 0;
+
+		Ktx2Index index {};
+		index.m_dfd_byte_offset =
+			static_cast< std::uint32_t >( KTX2_LEVELS_OFFSET + sizeof( Ktx2Level ) * image.m_mip_levels );
+		index.m_dfd_byte_length = static_cast< std::uint32_t >( std::span( descriptor ).size_bytes() );
+		index.m_kvd_byte_offset = index.m_dfd_byte_offset + index.m_dfd_byte_length;
+		index.m_kvd_byte_length = static_cast< std::uint32_t >( key_values.size() );
+		index.m_sgd_byte_offset = 0;
+		index.m_sgd_byte_length = 0;
+
+		// Levels are stored smallest first, Each aligned to both the block size and 4
+		const std::uint64_t alignment { std::lcm< std::uint64_t >( vk::blockSize( format ), 4 ) };
+		const std::uint64_t data_offset { alignUp( index.m_kvd_byte_offset + index.m_kvd_byte_length, alignment ) };
+
+		std::vector< Ktx2Level > levels( image.m_mip_levels );
+		std::uint64_t level_offset { data_offset };
+
+		for ( std::uint32_t level = image.m_mip_levels; level-- > 0; )
+		{
+			const std::uint64_t size { offsets[ level + 1 ] - offsets[ level ] };
+			levels[ level ] = { level_offset, size, size };
+			level_offset = alignUp( level_offset + size, alignment );
+		}
+
+		std::filesystem::create_directories( path.parent_path() );
+
+		std::filesystem::path temp_path { path };
+		temp_path += ".tmp";
+
+		{
+			std::ofstream file { temp_path, std::ios::binary | std::ios::trunc };
+			if ( !file ) throw std::runtime_error( std::format( "Failed to open {} for writing", temp_path.string() ) );
+
+			const auto writeBytes = [ &file ]( const std::span< const std::byte > bytes )
+			{ file.write( reinterpret_cast< const char* >( bytes.data() ), static_cast< std::streamsize >( bytes.size() ) ); };
+
+			const auto padTo = [ &file, &writeBytes ]( const std::uint64_t offset )
+			{
+				const std::vector< std::byte > padding( offset - static_cast< std::uint64_t >( file.tellp() ) );
+				writeBytes( padding );
+			};
+
+			writeBytes( std::as_bytes( std::span( KTX2_IDENTIFIER ) ) );
+			writeBytes( std::as_bytes( std::span( &header, 1 ) ) );
+			writeBytes( std::as_bytes( std::span( &index, 1 ) ) );
+			writeBytes( std::as_bytes( std::span( levels ) ) );
+			writeBytes( std::as_bytes( std::span( descriptor ) ) );
+			writeBytes( key_values );
+
+			for ( std::uint32_t level = image.m_mip_levels; level-- > 0; )
+			{
+				padTo( levels[ level ].m_byte_offset );
+				writeBytes( std::span( image.m_pixels ).subspan( offsets[ level ], levels[ level ].m_byte_length ) );
+			}
+
+			if ( !file ) throw std::runtime_error( std::format( "Failed to write {}", temp_path.string() ) );
+		}
+
+		std::filesystem::rename( temp_path, path );
+	}
+
+	//! Finds the source hash in the key/value data. Returns std::nullopt if it is missing or malformed
+	static std::optional< std::uint64_t > findSourceHash( std::span< const std::byte > key_values )
+	{
+		while ( key_values.size() >= sizeof( std::uint32_t ) )
+		{
+			std::uint32_t entry_length { 0 };
+			std::memcpy( &entry_length, key_values.data(), sizeof( entry_length ) );
+
+			const std::uint64_t entry_size { alignUp( sizeof( std::uint32_t ) + std::uint64_t( entry_length ), 4 ) };
+			if ( sizeof( std::uint32_t ) + std::uint64_t( entry_length ) > key_values.size() ) return std::nullopt;
+
+			const auto entry { key_values.subspan( sizeof( std::uint32_t ), entry_length ) };
+			const std::string_view text { reinterpret_cast< const char* >( entry.data() ), entry.size() };
+
+			if ( const auto split = text.find( '\0' ); split != std::string_view::npos
+			                                           && text.substr( 0, split ) == KTX2_SOURCE_HASH_KEY
+			                                           && entry.size() - split - 1 == sizeof( std::uint64_t ) )
+			{
+				std::uint64_t source_hash { 0 };
+				std::memcpy( &source_hash, entry.data() + split + 1, sizeof( source_hash ) );
+				return source_hash;
+			}
+
+			if ( entry_size >= key_values.size() ) break;
+			key_values = key_values.subspan( entry_size );
+		}
+
+		return std::nullopt;
+	}
+
+	std::optional< DecodedImage > readTextureCache( const std::filesystem::path& path, const std::uint64_t source_hash )
+	{
+		ZoneScoped;
+		if ( !std::filesystem::exists( path ) ) return std::nullopt;
+
+		const filesystem::MappedFile file { path };
+		const auto data { file.data() };
+
+		const auto invalid = [ &path ]()
+		{
+			log::warn( "Ignoring outdated or invalid texture cache {}", path.string() );
+			return std::nullopt;
+		};
+
+		if ( data.size() < KTX2_LEVELS_OFFSET ) return invalid();
+		if ( std::memcmp( data.data(), KTX2_IDENTIFIER.data(), KTX2_IDENTIFIER.size() ) != 0 ) return invalid();
+
+		Ktx2Header header {};
+		Ktx2Index index {};
+		std::memcpy( &header, data.data() + KTX2_IDENTIFIER.size(), sizeof( header ) );
+		std::memcpy( &index, data.data() + KTX2_IDENTIFIER.size() + sizeof( header ), sizeof( index ) );
+
+		const auto format { static_cast< vk::Format >( header.m_vk_format ) };
+		const vk::Extent2D extent { header.m_pixel_width, header.m_pixel_height };
+
+		// Only the plain 2D textures writeTextureCache creates
+		if ( !isCacheFormat( format ) || header.m_supercompression_scheme != 0 ) return invalid();
+		if ( header.m_pixel_depth > 1 || header.m_layer_count > 1 || header.m_face_count != 1 ) return invalid();
+		if ( header.m_level_count == 0 || header.m_level_count > mipLevelCount( extent ) ) return invalid();
+
+		if ( KTX2_LEVELS_OFFSET + sizeof( Ktx2Level ) * header.m_level_count > data.size() ) return invalid();
+		if ( std::uint64_t( index.m_kvd_byte_offset ) + index.m_kvd_byte_length > data.size() ) return invalid();
+
+		if ( findSourceHash( data.subspan( index.m_kvd_byte_offset, index.m_kvd_byte_length ) ) != source_hash )
+			return invalid();
+
+		DecodedImage image {};
+		image.m_width = static_cast< int >( extent.width );
+		image.m_height = static_cast< int >( extent.height );
+		image.m_mip_levels = header.m_level_count;
+		image.m_format = format;
+
+		const auto offsets { mipOffsets( extent, header.m_level_count, format ) };
+		image.m_pixels.resize( offsets.back() );
+
+		for ( std::uint32_t level = 0; level < header.m_level_count; ++level )
+		{
+			Ktx2Level entry {};
+			std::memcpy( &entry, data.data() + KTX2_LEVELS_OFFSET + sizeof( Ktx2Level ) * level, sizeof( entry ) );
+
+			if ( entry.m_byte_length != offsets[ level + 1 ] - offsets[ level ] ) return invalid();
+			if ( entry.m_byte_offset > data.size() || entry.m_byte_length > data.size() - entry.m_byte_offset )
+				return invalid();
+
+			std::memcpy(
+				image.m_pixels.data() + offsets[ level ], data.data() + entry.m_byte_offset, entry.m_byte_length );
+		}
+
+		return image;
+	}
+
+	DecodedImage prepareTextureImage(
+		const std::span< const std::byte > encoded, TextureCompression compression, const bool srgb )
+	{
+		ZoneScoped;
+		if ( !Device::getInstance().supportsTextureCompressionBC() ) compression = TextureCompression::None;
+
+		std::uint64_t source_hash { 0 };
+		std::filesystem::path cache_path {};
+
+		// Only compressed images are cached, Decoding is cheaper than reading back 4 bytes per texel
+		if ( compression != TextureCompression::None )
+		{
+			const std::uint64_t seed { ( std::uint64_t( TEXTURE_CACHE_VERSION ) << 16 ) | ( std::uint64_t( srgb ) << 8 )
+				                       | static_cast< std::uint64_t >( compression ) };
+
+			source_hash = hashSource( encoded, seed );
+			cache_path = textureCachePath( source_hash );
+
+			if ( auto cached = readTextureCache( cache_path, source_hash ) ) return std::move( *cached );
+		}
+
+		DecodedImage image { decodeImage( encoded ) };
+		image.m_mip_levels = generateMipChain(
+			image.m_pixels,
+			vk::Extent2D(
+				static_cast< std::uint32_t >( image.m_width ), static_cast< std::uint32_t >( image.m_height ) ),
+			srgb );
+
+		if ( compression == TextureCompression::None ) return image;
+
+		image = compressImage( std::move( image ), compression );
+
+		try
+		{
+			writeTextureCache( cache_path, image, source_hash );
+		}
+		catch ( const std::exception& e )
+		{
+			log::warn( "Failed to cache compressed texture {}: {}", cache_path.string(), e.what() );
+		}
+
+		return image;
+	}
+
+} // namespace fgl::engine
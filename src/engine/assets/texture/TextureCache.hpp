@@ -0,0 +1,91 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "BlockCompression.hpp"
+
+namespace fgl::engine
+{
+	struct DecodedImage;
+
+	/**
+	 * Compressed textures are cached as one KTX2 file per source image, Named after the hash of the encoded image and
+	 * the compression used.
+	 *
+	 * Layout (See the KTX2 specification):
+	 * - Identifier, Ktx2Header, Ktx2Index
+	 * - Ktx2Level[ level_count ]
+	 * - Data format descriptor
+	 * - Key/value data holding KTX2_SOURCE_HASH_KEY
+	 * - Every level, Smallest first. Each aligned to it's block size
+	 */
+	constexpr std::array< std::uint8_t, 12 > KTX2_IDENTIFIER { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+		                                                       0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+	//! Must be incremented whenever the layout or the encoders change
+	constexpr std::uint32_t TEXTURE_CACHE_VERSION { 3 };
+
+	//! Key of the source hash in the key/value data. Checked when reading, As the file name alone could collide
+	constexpr std::string_view KTX2_SOURCE_HASH_KEY { "fglSourceHash" };
+
+	struct Ktx2Header
+	{
+		std::uint32_t m_vk_format;
+		std::uint32_t m_type_size;
+		std::uint32_t m_pixel_width;
+		std::uint32_t m_pixel_height;
+		std::uint32_t m_pixel_depth;
+		std::uint32_t m_layer_count;
+		std::uint32_t m_face_count;
+		std::uint32_t m_level_count;
+		std::uint32_t m_supercompression_scheme;
+	};
+
+	struct Ktx2Index
+	{
+		std::uint32_t m_dfd_byte_offset;
+		std::uint32_t m_dfd_byte_length;
+		std::uint32_t m_kvd_byte_offset;
+		std::uint32_t m_kvd_byte_length;
+		std::uint64_t m_sgd_byte_offset;
+		std::uint64_t m_sgd_byte_length;
+	};
+
+	struct Ktx2Level
+	{
+		std::uint64_t m_byte_offset;
+		std::uint64_t m_byte_length;
+		std::uint64_t m_uncompressed_byte_length;
+	};
+
+	static_assert( sizeof( Ktx2Header ) == 36 );
+	static_assert( sizeof( Ktx2Index ) == 32 );
+	static_assert( sizeof( Ktx2Level ) == 24 );
+
+	//! Location of the compressed texture for a source hash
+	std::filesystem::path textureCachePath( std::uint64_t source_hash );
+
+	//! Writes to a temporary file first, So a partial write is never seen as a valid cache
+	void writeTextureCache( const std::filesystem::path& path, const DecodedImage& image, std::uint64_t source_hash );
+
+	//! Returns std::nullopt if there is no cache, Or it is for a different source or is not a texture this can read
+	std::optional< DecodedImage > readTextureCache( const std::filesystem::path& path, std::uint64_t source_hash );
+
+	/**
+	 * @brief Decodes an encoded (png, jpeg, ect) image with it's full mip chain, Compressed if the device supports it
+	 * @details Compressed images are read from the cache when they were compressed before, And cached when they were
+	 * not. srgb is passed to generateMipChain. Safe to call from any thread
+	 */
+	DecodedImage
+		prepareTextureImage( std::span< const std::byte > encoded, TextureCompression compression, bool srgb );
+
+} // namespace fgl::engine
@@ -0,0 +1,175 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "TextureStreamer.hpp"
+
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Texture.hpp"
+#include "engine/EngineContext.hpp"
+#include "engine/FGL_DEFINES.hpp"
+#include "engine/FrameInfo.hpp"
+#include "engine/assets/image/MipChain.hpp"
+#include "engine/descriptors/DescriptorSet.hpp"
+#include "engine/descriptors/DescriptorSetLayout.hpp"
+#include "engine/rendering/devices/Device.hpp"
+
+namespace fgl::engine
+{
+
+	constexpr descriptors::Descriptor TEXTURE_FEEDBACK_DESCRIPTOR { 0,
+		                                                            vk::DescriptorType::eStorageBuffer,
+		                                                            vk::ShaderStageFlagBits::eFragment };
+
+	inline static descriptors::DescriptorSetLayout TEXTURE_FEEDBACK_SET { 4, TEXTURE_FEEDBACK_DESCRIPTOR };
+
+	std::uint32_t streamingTailLevel( const vk::Extent2D extent, const std::uint32_t mip_levels )
+	{
+		for ( std::uint32_t level = 0; level < mip_levels; ++level )
+		{
+			const vk::Extent2D level_extent { mipExtent( extent, level ) };
+
+			if ( level_extent.width <= STREAMING_TAIL_EXTENT && level_extent.height <= STREAMING_TAIL_EXTENT )
+				return level;
+		}
+
+		// Chains without their small levels can only be resident as a whole
+		return 0;
+	}
+
+	TextureStreamer::TextureStreamer() :
+	  m_feedback_buffer(
+		  16_KiB,
+		  vk::BufferUsageFlagBits::eStorageBuffer,
+		  vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent ),
+	  m_enabled( Device::getInstance().supportsFragmentStoresAndAtomics() )
+	{
+		m_feedback_buffer->setDebugName( "Texture feedback" );
+
+		const std::vector< std::uint32_t > no_feedback( texture_descriptor.m_count, NO_TEXTURE_FEEDBACK );
+
+		for ( FrameIndex i = 0; i < m_feedback.size(); ++i )
+		{
+			m_feedback[ i ] = std::make_unique< HostVector< std::uint32_t > >( m_feedback_buffer, no_feedback );
+
+			m_feedback_desc[ i ] = TEXTURE_FEEDBACK_SET.create();
+			m_feedback_desc[ i ]->bindStorageBuffer( 0, *m_feedback[ i ] );
+			m_feedback_desc[ i ]->update();
+			m_feedback_desc[ i ]->setName( "Texture feedback" );
+		}
+	}
+
+	void TextureStreamer::track( const std::shared_ptr< Texture >& texture )
+	{
+		FGL_ASSERT( m_enabled, "Texture streaming is disabled" );
+		FGL_ASSERT( texture->streamed(), "Only textures that kept their full mip chain can be streamed" );
+		FGL_ASSERT( texture->getID() < texture_descriptor.m_count, "Texture id is past the end of the feedback" );
+
+		m_textures.insert_or_assign( texture->getID(), StreamedTexture { texture, texture->residentLevel(), m_frame } );
+	}
+
+	std::uint32_t TextureStreamer::feedbackLevel( const Texture& texture, const std::uint32_t feedback )
+	{
+		const vk::Extent2D extent { texture.getExtent() };
+		const float texels { static_cast< float >( std::max( extent.width, extent.height ) ) };
+
+		// The footprint is in uv space, So scaling it by the size of the texture gives the level
+		const float lod { static_cast< float >( feedback ) / FEEDBACK_LOD_STEPS - FEEDBACK_LOD_BIAS
+			              + std::log2( texels ) };
+
+		const float last_level { static_cast< float >( texture.mipLevels() - 1 ) };
+
+		return static_cast< std::uint32_t >( std::clamp( std::floor( lod ), 0.0f, last_level ) );
+	}
+
+	std::uint32_t TextureStreamer::desiredLevel( const Texture& texture, const StreamedTexture& streamed ) const
+	{
+		const std::uint32_t tail_level { streamingTailLevel( texture.getExtent(), texture.mipLevels() ) };
+
+		if ( m_frame - streamed.m_last_used_frame > STREAMING_IDLE_FRAMES ) return tail_level;
+
+		return std::min( streamed.m_requested_level, tail_level );
+	}
+
+	void TextureStreamer::update( const FrameIndex frame_index )
+	{
+		ZoneScoped;
+
+		// Nothing is written to the feedback, And nothing is tracked
+		if ( !m_enabled ) return;
+
+		++m_frame;
+
+		// The fence for this frame index has been waited on, So the shader has finished writing to it
+		auto& feedback { *m_feedback[ frame_index ] };
+		auto* const requests { static_cast< std::uint32_t* >( feedback.ptr() ) };
+
+		// Textures that want different levels, And what selectStreams needs to know about each of them
+		std::vector< std::shared_ptr< Texture > > textures {};
+		std::vector< StreamCandidate > candidates {};
+
+		std::erase_if( m_textures, []( const auto& pair ) -> bool { return pair.second.m_texture.expired(); } );
+
+		m_resident_bytes = 0;
+
+		for ( auto& [ texture_id, streamed ] : m_textures )
+		{
+			const std::shared_ptr< Texture > texture { streamed.m_texture.lock() };
+
+			if ( texture->finishStreaming() )
+			{
+				Texture::getDescriptorSet().bindTexture( 0, texture );
+				Texture::getDescriptorSet().update();
+			}
+
+			if ( const std::uint32_t request { requests[ texture_id ] }; request != NO_TEXTURE_FEEDBACK )
+			{
+				streamed.m_requested_level = feedbackLevel( *texture, request );
+				streamed.m_last_used_frame = m_frame;
+			}
+
+			// Images still being staged are counted as if they were resident, So they are not given out again
+			const std::uint32_t resident_level { texture->residentLevel() };
+			const std::uint32_t committed_level {
+				texture->streaming() ? std::min( resident_level, texture->streamingLevel() ) : resident_level
+			};
+
+			m_resident_bytes += texture->levelsSize( committed_level );
+
+			if ( texture->streaming() ) continue;
+
+			const std::uint32_t desired_level { desiredLevel( *texture, streamed ) };
+			if ( desired_level == resident_level ) continue;
+
+			candidates.emplace_back(
+				resident_level, desired_level, streamed.m_last_used_frame, texture->levelOffsets() );
+			textures.emplace_back( texture );
+		}
+
+		std::fill_n( requests, feedback.size(), NO_TEXTURE_FEEDBACK );
+
+		for ( const auto& [ candidate, level ] : selectStreams( candidates, m_resident_bytes, m_budget ) )
+			textures[ candidate ]->streamLevels( level );
+	}
+
+	descriptors::DescriptorSet& TextureStreamer::getDescriptor( const FrameIndex frame_index )
+	{
+		return *m_feedback_desc[ frame_index ];
+	}
+
+	descriptors::DescriptorSetLayout& TextureStreamer::getDescriptorLayout()
+	{
+		return TEXTURE_FEEDBACK_SET;
+	}
+
+	TextureStreamer& getTextureStreamer()
+	{
+		return EngineContext::getInstance().m_texture_streamer;
+	}
+
+} // namespace fgl::engine
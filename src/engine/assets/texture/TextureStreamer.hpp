@@ -0,0 +1,129 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include "StreamSelection.hpp"
+#include "engine/math/literals/size.hpp"
+#include "engine/memory/buffers/BufferHandle.hpp"
+#include "engine/memory/buffers/vector/HostVector.hpp"
+#include "engine/rendering/PresentSwapChain.hpp"
+#include "engine/types.hpp"
+
+namespace fgl::engine
+{
+	class Texture;
+
+	namespace descriptors
+	{
+		class DescriptorSet;
+		class DescriptorSetLayout;
+	} // namespace descriptors
+
+	using namespace fgl::literals::size_literals;
+
+	//! Levels no larger than this in either dimension are always resident
+	constexpr std::uint32_t STREAMING_TAIL_EXTENT { 128 };
+
+	//! Texture memory the streamer tries to stay under, Unless changed with TextureStreamer::setBudget
+	constexpr vk::DeviceSize DEFAULT_TEXTURE_BUDGET { 512_MiB };
+
+	//! Frames without feedback before a texture only wants it's tail levels
+	constexpr std::uint64_t STREAMING_IDLE_FRAMES { 120 };
+
+	//! Written for textures that were not sampled. See textured.slang
+	constexpr std::uint32_t NO_TEXTURE_FEEDBACK { ~0u };
+
+	//! Must match textured.slang. The feedback is log2 of the uv footprint of a pixel, Biased and in quarter levels
+	constexpr float FEEDBACK_LOD_BIAS { 32.0f };
+	constexpr float FEEDBACK_LOD_STEPS { 4.0f };
+
+	//! First level of a mip chain that is always resident, 0 if the entire chain is small enough to never stream
+	std::uint32_t streamingTailLevel( vk::Extent2D extent, std::uint32_t mip_levels );
+
+	/**
+	 * @brief Keeps the finer levels of textures resident only while they are being sampled
+	 * @details Streamed textures keep their tail levels resident, And a copy of their full mip chain in host memory.
+	 * textured.slang writes the finest uv footprint each texture is sampled with into a buffer per frame in flight.
+	 * Once that frame's fence has been waited on, The feedback is turned into the level each texture wants. Textures
+	 * are then given an image with more levels, Or less if they have not been sampled for a while or the budget is
+	 * needed for others. Swapping images costs the memory of both until the new image has been staged.
+	 */
+	class TextureStreamer
+	{
+		struct StreamedTexture
+		{
+			std::weak_ptr< Texture > m_texture;
+
+			//! Finest level requested by the feedback
+			std::uint32_t m_requested_level;
+
+			//! Frame the texture last had feedback
+			std::uint64_t m_last_used_frame;
+		};
+
+		//! Host visible buffer for the feedback
+		memory::Buffer m_feedback_buffer;
+
+		//! Feedback of each frame in flight, Indexed by texture id
+		PerFrameArray< std::unique_ptr< HostVector< std::uint32_t > > > m_feedback {};
+		PerFrameArray< std::unique_ptr< descriptors::DescriptorSet > > m_feedback_desc {};
+
+		std::unordered_map< TextureID, StreamedTexture > m_textures {};
+
+		//! False if the device can not write the feedback, In which case textures keep their entire mip chain resident
+		bool m_enabled;
+
+		vk::DeviceSize m_budget { DEFAULT_TEXTURE_BUDGET };
+
+		//! Memory used by the images of streamed textures after the last update
+		vk::DeviceSize m_resident_bytes { 0 };
+
+		std::uint64_t m_frame { 0 };
+
+		//! Level the feedback asks for, In the levels of the texture
+		static std::uint32_t feedbackLevel( const Texture& texture, std::uint32_t feedback );
+
+		//! Level the texture should have resident right now
+		std::uint32_t desiredLevel( const Texture& texture, const StreamedTexture& streamed ) const;
+
+	  public:
+
+		TextureStreamer();
+
+		TextureStreamer( const TextureStreamer& ) = delete;
+		TextureStreamer& operator=( const TextureStreamer& ) = delete;
+
+		//! True if textures should be streamed. See Device::supportsFragmentStoresAndAtomics
+		bool enabled() const { return m_enabled; }
+
+		//! Starts streaming the texture. It must have been created with only it's tail levels resident
+		void track( const std::shared_ptr< Texture >& texture );
+
+		/**
+		 * @brief Reads the feedback of the frame index, Swaps in finished images and starts streaming levels in or out
+		 * @note The fence for the frame index must have been waited on, As the feedback is reset for the next frame
+		 */
+		void update( FrameIndex frame_index );
+
+		void setBudget( vk::DeviceSize budget ) { m_budget = budget; }
+
+		vk::DeviceSize budget() const { return m_budget; }
+
+		vk::DeviceSize residentBytes() const { return m_resident_bytes; }
+
+		descriptors::DescriptorSet& getDescriptor( FrameIndex frame_index );
+
+		static descriptors::DescriptorSetLayout& getDescriptorLayout();
+	};
+
+	TextureStreamer& getTextureStreamer();
+
+} // namespace fgl::engine
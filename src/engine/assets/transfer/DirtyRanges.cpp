@@ -0,0 +1,94 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "DirtyRanges.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include "engine/FGL_DEFINES.hpp"
+
+namespace fgl::engine::memory
+{
+
+	DirtyRanges::DirtyRanges( const std::shared_ptr< BufferSuballocationHandle >& target, const vk::DeviceSize stride ) :
+	  m_target( target ),
+	  m_stride( stride )
+	{}
+
+	void DirtyRanges::write( const std::uint32_t idx, const std::span< const std::byte > data )
+	{
+		FGL_ASSERT( data.size() == m_stride, "Dirty range writes must be exactly one element" );
+
+		const std::uint32_t word { idx / WORD_BITS };
+		const std::size_t offset { idx * m_stride };
+
+		// Both only ever grow, So the allocations are reused between flushes
+		if ( m_dirty.size() <= word ) m_dirty.resize( word + 1, 0 );
+		if ( m_data.size() < offset + m_stride ) m_data.resize( offset + m_stride );
+
+		m_dirty[ word ] |= Word( 1 ) << ( idx % WORD_BITS );
+		m_first_word = std::min( m_first_word, word );
+		m_last_word = std::max( m_last_word, word );
+
+		std::memcpy( m_data.data() + offset, data.data(), m_stride );
+	}
+
+	std::span< const DirtyRanges::Range > DirtyRanges::ranges()
+	{
+		m_ranges.clear();
+
+		if ( empty() ) return m_ranges;
+
+		for ( std::uint32_t word = m_first_word; word <= m_last_word; ++word )
+		{
+			Word bits { m_dirty[ word ] };
+
+			// Each iteration takes a whole run of set bits at once
+			while ( bits != 0 )
+			{
+				const auto start { static_cast< std::uint32_t >( std::countr_zero( bits ) ) };
+				const auto length { static_cast< std::uint32_t >( std::countr_one( bits >> start ) ) };
+
+				const std::uint32_t first { word * WORD_BITS + start };
+
+				if ( !m_ranges.empty() && m_ranges.back().m_first + m_ranges.back().m_count == first )
+					m_ranges.back().m_count += length;
+				else
+					m_ranges.emplace_back( first, length );
+
+				// Shifting by the full width is undefined, So the final run of a word clears it instead
+				bits = ( start + length == WORD_BITS ) ? 0 : bits & ( ~Word( 0 ) << ( start + length ) );
+			}
+		}
+
+		return m_ranges;
+	}
+
+	std::span< const std::byte > DirtyRanges::data( const Range& range ) const
+	{
+		FGL_ASSERT( ( range.m_first + range.m_count ) * m_stride <= m_data.size(), "Range is outside of the shadow" );
+
+		return { m_data.data() + ( range.m_first * m_stride ), range.m_count * m_stride };
+	}
+
+	void DirtyRanges::read( const Range& range, const std::span< std::byte > out ) const
+	{
+		FGL_ASSERT( out.size() == range.m_count * m_stride, "Output must fit the entire range" );
+
+		const auto source { data( range ) };
+		std::memcpy( out.data(), source.data(), source.size() );
+	}
+
+	void DirtyRanges::clear()
+	{
+		// The bitmap and shadow are kept as is, So the next round of updates can reuse the allocations
+		if ( !empty() ) std::fill( m_dirty.begin() + m_first_word, m_dirty.begin() + m_last_word + 1, Word( 0 ) );
+
+		m_first_word = std::numeric_limits< std::uint32_t >::max();
+		m_last_word = 0;
+	}
+
+} // namespace fgl::engine::memory
@@ -0,0 +1,88 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace fgl::engine::memory
+{
+	struct BufferSuballocationHandle;
+
+	/**
+	 * @brief Element updates to a single device vector that have not been staged yet.
+	 *
+	 * Writing the same element twice replaces the previous write, And runs of adjacent elements are staged as a single copy.
+	 * This keeps the number of TransferData, copy regions and barriers proportional to the number of dirty ranges instead of
+	 * the number of updates.
+	 *
+	 * Element data is kept in a host shadow laid out the same as the vector, With a bitmap of the dirty elements. Each
+	 * range can then be copied straight from the shadow with a single copy. Nothing is allocated once the shadow and
+	 * bitmap have grown to the highest updated index.
+	 */
+	class DirtyRanges
+	{
+	  public:
+
+		//! Contiguous run of dirty elements
+		struct Range
+		{
+			std::uint32_t m_first;
+			std::uint32_t m_count;
+		};
+
+	  private:
+
+		using Word = std::uint64_t;
+		static constexpr std::uint32_t WORD_BITS { 64 };
+
+		std::shared_ptr< BufferSuballocationHandle > m_target;
+		vk::DeviceSize m_stride;
+
+		//! One bit per element, Set if the element is dirty
+		std::vector< Word > m_dirty {};
+
+		//! Words of m_dirty that can have bits set. Avoids walking the entire bitmap for a handful of updates
+		std::uint32_t m_first_word { std::numeric_limits< std::uint32_t >::max() };
+		std::uint32_t m_last_word { 0 };
+
+		//! Latest data for each element, At `index * stride`. Only the dirty elements are valid
+		std::vector< std::byte > m_data {};
+
+		//! Output of ranges(), Kept to avoid reallocating every flush
+		std::vector< Range > m_ranges {};
+
+	  public:
+
+		DirtyRanges( const std::shared_ptr< BufferSuballocationHandle >& target, vk::DeviceSize stride );
+
+		const std::shared_ptr< BufferSuballocationHandle >& target() const { return m_target; }
+
+		vk::DeviceSize stride() const { return m_stride; }
+
+		bool empty() const { return m_first_word > m_last_word; }
+
+		//! Records the new data for an element. `data` must be exactly one stride
+		void write( std::uint32_t idx, std::span< const std::byte > data );
+
+		//! Returns the dirty elements merged into contiguous ranges, Ordered by index. Valid until the next call
+		std::span< const Range > ranges();
+
+		//! Returns the data of a range, Directly from the shadow
+		std::span< const std::byte > data( const Range& range ) const;
+
+		//! Copies the data of a range into `out`. `out` must be `range.m_count * stride()` bytes
+		void read( const Range& range, std::span< std::byte > out ) const;
+
+		//! Forgets all dirty elements
+		void clear();
+	};
+
+} // namespace fgl::engine::memory
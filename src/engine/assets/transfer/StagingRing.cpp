@@ -0,0 +1,51 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "StagingRing.hpp"
+
+#include <cstring>
+
+namespace fgl::engine::memory
+{
+
+	StagingRing::StagingRing( const vk::DeviceSize size ) :
+	  m_buffer(
+		  size,
+		  vk::BufferUsageFlagBits::eTransferSrc,
+		  vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent ),
+	  m_memory( m_buffer, size ),
+	  m_allocator( m_memory.bytesize() )
+	{
+		m_buffer->setDebugName( "Staging ring" );
+	}
+
+	std::optional< StagingRegion > StagingRing::reserve( const vk::DeviceSize size, const vk::DeviceSize alignment )
+	{
+		const auto allocation { m_allocator.allocate( size, alignment ) };
+
+		if ( !allocation.has_value() ) return std::nullopt;
+
+		m_bytes_reserved.fetch_add( size, std::memory_order_relaxed );
+
+		return StagingRegion { m_memory.getVkBuffer(),
+			                   m_memory.getOffset() + allocation->m_offset,
+			                   size,
+			                   static_cast< std::byte* >( m_memory.ptr() ) + allocation->m_offset,
+			                   allocation->m_marker };
+	}
+
+	std::optional< StagingRegion >
+		StagingRing::write( const std::span< const std::byte > data, const vk::DeviceSize alignment )
+	{
+		auto region { reserve( data.size(), alignment ) };
+
+		if ( !region.has_value() ) return std::nullopt;
+
+		// The ring is host coherent, So no flush is required
+		std::memcpy( region->m_ptr, data.data(), data.size() );
+
+		return region;
+	}
+
+} // namespace fgl::engine::memory
@@ -0,0 +1,86 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+
+#include <atomic>
+#include <optional>
+#include <span>
+
+#include "engine/FGL_DEFINES.hpp"
+#include "engine/memory/allocators/RingAllocator.hpp"
+#include "engine/memory/buffers/BufferHandle.hpp"
+#include "engine/memory/buffers/BufferSuballocation.hpp"
+
+namespace fgl::engine::memory
+{
+	//! Alignment of every staging region. Satisfies the bufferOffset requirements of buffer to image copies.
+	constexpr vk::DeviceSize STAGING_ALIGNMENT { 16 };
+
+	//! Region of the staging ring that data has been (or will be) written to
+	struct StagingRegion
+	{
+		vk::Buffer m_buffer;
+		vk::DeviceSize m_offset;
+		vk::DeviceSize m_size;
+
+		//! Mapped pointer to the start of the region
+		void* m_ptr;
+
+		//! Ring marker from before this region was reserved. Retiring past this would release the region.
+		RingAllocator::Marker m_marker;
+
+		std::span< std::byte > data() const { return { static_cast< std::byte* >( m_ptr ), m_size }; }
+	};
+
+	/**
+	 * @brief Persistently mapped, host visible, ring of staging memory.
+	 *
+	 * Data is written linearly into the ring, and is retired all at once when the transfer that used it has completed.
+	 * This avoids any allocator or fragmentation cost for staging.
+	 */
+	class StagingRing
+	{
+		Buffer m_buffer;
+
+		//! Suballocation covering the entire buffer
+		BufferSuballocation m_memory;
+
+		RingAllocator m_allocator;
+
+		//! Total number of bytes ever reserved in this ring. Used for tracking throughput
+		std::atomic< std::uint64_t > m_bytes_reserved { 0 };
+
+	  public:
+
+		explicit StagingRing( vk::DeviceSize size );
+
+		FGL_DELETE_ALL_RO5( StagingRing );
+
+		//! Reserves a region of the ring. Returns std::nullopt if the ring does not have space until a transfer retires.
+		std::optional< StagingRegion > reserve( vk::DeviceSize size, vk::DeviceSize alignment = STAGING_ALIGNMENT );
+
+		//! Reserves a region of the ring and copies the data into it.
+		std::optional< StagingRegion >
+			write( std::span< const std::byte > data, vk::DeviceSize alignment = STAGING_ALIGNMENT );
+
+		//! Marker for everything reserved so far. See RingAllocator::mark
+		RingAllocator::Marker mark() const { return m_allocator.mark(); }
+
+		//! Releases everything reserved before the marker was taken. The transfers using it must have completed.
+		void retire( const RingAllocator::Marker marker ) { m_allocator.retire( marker ); }
+
+		//! Starts reserving from the beginning of the ring again. See RingAllocator::rewind
+		void rewind() { m_allocator.rewind(); }
+
+		vk::DeviceSize capacity() const { return m_allocator.capacity(); }
+
+		vk::DeviceSize used() const { return m_allocator.used(); }
+
+		std::uint64_t bytesReserved() const { return m_bytes_reserved.load( std::memory_order_relaxed ); }
+	};
+
+} // namespace fgl::engine::memory
@@ -5,10 +5,10 @@
 #include "TransferData.hpp"
 
 #include "engine/assets/image/ImageHandle.hpp"
+#include "engine/assets/image/MipChain.hpp"
 #include "engine/debug/logging/logging.hpp"
 #include "engine/memory/buffers/BufferHandle.hpp"
 #include "engine/memory/buffers/exceptions.hpp"
-#include "engine/memory/buffers/vector/HostVector.hpp"
 #include "engine/utils.hpp"
 
 namespace fgl::engine::memory
@@ -32,13 +32,13 @@ namespace fgl::engine::memory
 	bool TransferData::
 		performImageStage( vk::raii::CommandBuffer& cmd_buffer, std::uint32_t transfer_idx, std::uint32_t graphics_idx )
 	{
-		auto& source_buffer { std::get< TransferBufferHandle >( m_source ) };
+		const auto [ source_buffer, source_offset ] = sourceLocation();
 		auto& dest_image { std::get< TransferImageHandle >( m_target ) };
 
 		vk::ImageSubresourceRange range;
 		range.aspectMask = vk::ImageAspectFlagBits::eColor;
 		range.baseMipLevel = 0;
-		range.levelCount = 1;
+		range.levelCount = dest_image->mipLevels();
 		range.baseArrayLayer = 0;
 		range.layerCount = 1;
 
@@ -60,23 +60,36 @@ namespace fgl::engine::memory
 			{},
 			barriers_to );
 
-		vk::BufferImageCopy region {};
-		region.bufferOffset = source_buffer->offset();
-		region.bufferRowLength = 0;
-		region.bufferImageHeight = 0;
+		// The source is every level packed one after the other, Largest first. Each level gets it's own region
+		const std::vector< vk::DeviceSize > level_offsets {
+			mipOffsets( dest_image->extent(), dest_image->mipLevels(), dest_image->format() )
+		};
 
-		region.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
-		region.imageSubresource.mipLevel = 0;
-		region.imageSubresource.baseArrayLayer = 0;
-		region.imageSubresource.layerCount = 1;
+		FGL_ASSERT( level_offsets.back() <= m_size, "Source data is smaller than the mip chain of the image" );
 
-		region.imageOffset = vk::Offset3D( 0, 0, 0 );
-		region.imageExtent = vk::Extent3D( dest_image->extent(), 1 );
+		std::vector< vk::BufferImageCopy > regions {};
+		regions.reserve( dest_image->mipLevels() );
 
-		std::vector< vk::BufferImageCopy > regions { region };
+		for ( std::uint32_t level = 0; level < dest_image->mipLevels(); ++level )
+		{
+			vk::BufferImageCopy region {};
+			region.bufferOffset = source_offset + level_offsets[ level ];
+			region.bufferRowLength = 0;
+			region.bufferImageHeight = 0;
+
+			region.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+			region.imageSubresource.mipLevel = level;
+			region.imageSubresource.baseArrayLayer = 0;
+			region.imageSubresource.layerCount = 1;
+
+			region.imageOffset = vk::Offset3D( 0, 0, 0 );
+			region.imageExtent = vk::Extent3D( mipExtent( dest_image->extent(), level ), 1 );
+
+			regions.emplace_back( region );
+		}
 
 		cmd_buffer.copyBufferToImage(
-			source_buffer->getVkBuffer(), dest_image->getVkImage(), vk::ImageLayout::eTransferDstOptimal, regions );
+			source_buffer, dest_image->getVkImage(), vk::ImageLayout::eTransferDstOptimal, regions );
 
 		//Transfer back to eGeneral
 
@@ -105,22 +118,37 @@ namespace fgl::engine::memory
 
 	bool TransferData::performRawImageStage(
 		vk::raii::CommandBuffer& buffer,
-		Buffer& staging_buffer,
+		StagingRing& staging,
 		const std::uint32_t transfer_idx,
 		const std::uint32_t graphics_idx )
 	{
-		if ( !convertRawToBuffer( staging_buffer ) ) return false;
+		if ( std::holds_alternative< RawData >( m_source ) && !convertRawToBuffer( staging ) ) return false;
 		return performImageStage( buffer, transfer_idx, graphics_idx );
 	}
 
 	bool TransferData::performBufferStage( CopyRegionMap& copy_regions )
 	{
 		ZoneScoped;
-		auto& source { std::get< TransferBufferHandle >( m_source ) };
 		auto& target { std::get< TransferBufferHandle >( m_target ) };
-		const CopyRegionKey key { std::make_pair( source->getBuffer(), target->getBuffer() ) };
 
-		const auto copy_info { source->copyRegion( *target, m_target_offset ) };
+		vk::Buffer source_buffer {};
+		vk::BufferCopy copy_info {};
+
+		if ( const auto* staged = std::get_if< StagedData >( &m_source ) )
+		{
+			source_buffer = staged->m_buffer;
+			copy_info.srcOffset = staged->m_offset;
+			copy_info.dstOffset = target->offset() + m_target_offset;
+			copy_info.size = staged->m_size;
+		}
+		else
+		{
+			const auto& source { std::get< TransferBufferHandle >( m_source ) };
+			source_buffer = source->getBuffer();
+			copy_info = source->copyRegion( *target, m_target_offset );
+		}
+
+		const CopyRegionKey key { std::make_pair( source_buffer, target->getBuffer() ) };
 
 		if ( auto itter = copy_regions.find( key ); itter != copy_regions.end() )
 		{
@@ -136,32 +164,54 @@ namespace fgl::engine::memory
 		return true;
 	}
 
-	bool TransferData::performRawBufferStage( Buffer& staging_buffer, CopyRegionMap& copy_regions )
+	bool TransferData::performRawBufferStage( StagingRing& staging, CopyRegionMap& copy_regions )
 	{
-		if ( !convertRawToBuffer( staging_buffer ) ) return false;
+		// The data might have already been written into the ring by the producer
+		if ( std::holds_alternative< RawData >( m_source ) && !convertRawToBuffer( staging ) ) return false;
 		return performBufferStage( copy_regions );
 	}
 
-	bool TransferData::convertRawToBuffer( Buffer& staging_buffer )
+	bool TransferData::convertRawToBuffer( StagingRing& staging )
 	{
 		// Prepare the staging buffer first.
 		assert( std::holds_alternative< RawData >( m_source ) );
-		assert( !std::get< RawData >( m_source ).empty() );
 
-		// Check if we are capable of allocating into the staging buffer
-		if ( !staging_buffer->canAllocate( std::get< RawData >( m_source ).size(), 1 ) ) return false;
+		const auto& raw { std::get< RawData >( m_source ) };
+		assert( !raw.empty() );
+		FGL_ASSERT( m_source_offset + m_size <= raw.size(), "Attempting to copy from beyond the end of the source data" );
+
+		// Only the range being copied needs to be staged
+		const std::span< const std::byte > data { raw.data() + m_source_offset, m_size };
 
-		HostVector< std::byte > vector { staging_buffer, std::get< RawData >( m_source ) };
+		const auto region { staging.write( data ) };
 
-		m_source = vector.getHandle();
-		std::get< TransferBufferHandle >( m_source )->setReady( true );
+		// The ring is full until the in flight transfers retire
+		if ( !region.has_value() ) return false;
+
+		m_source = *region;
+		m_source_offset = 0;
 
 		return true;
 	}
 
+	std::pair< vk::Buffer, vk::DeviceSize > TransferData::sourceLocation() const
+	{
+		if ( const auto* staged = std::get_if< StagedData >( &m_source ) )
+			return { staged->m_buffer, staged->m_offset };
+
+		const auto& source { std::get< TransferBufferHandle >( m_source ) };
+		return { source->getVkBuffer(), source->offset() + m_source_offset };
+	}
+
+	vk::DeviceSize TransferData::stagingSize() const
+	{
+		if ( std::holds_alternative< RawData >( m_source ) ) return m_size;
+		return 0;
+	}
+
 	bool TransferData::stage(
 		vk::raii::CommandBuffer& buffer,
-		Buffer& staging_buffer,
+		StagingRing& staging,
 		CopyRegionMap& copy_regions,
 		const std::uint32_t transfer_idx,
 		const std::uint32_t graphics_idx )
@@ -174,7 +224,7 @@ namespace fgl::engine::memory
 				throw std::runtime_error( "Invalid transfer type" );
 			case eImageFromRaw:
 				{
-					return performRawImageStage( buffer, staging_buffer, transfer_idx, graphics_idx );
+					return performRawImageStage( buffer, staging, transfer_idx, graphics_idx );
 				}
 			case eImageFromBuffer:
 				{
@@ -183,7 +233,7 @@ namespace fgl::engine::memory
 				}
 			case eBufferFromRaw:
 				{
-					return performRawBufferStage( staging_buffer, copy_regions );
+					return performRawBufferStage( staging, copy_regions );
 				}
 			case eBufferFromBuffer:
 				{
@@ -195,6 +245,38 @@ namespace fgl::engine::memory
 		FGL_UNREACHABLE();
 	}
 
+	std::optional< StagingRegion > TransferData::stagedRegion() const
+	{
+		if ( const auto* staged = std::get_if< StagedData >( &m_source ) ) return *staged;
+		return std::nullopt;
+	}
+
+	void TransferData::unstage()
+	{
+		const auto* staged { std::get_if< StagedData >( &m_source ) };
+		if ( staged == nullptr ) return;
+
+		// Only buffer uploads can be written to the ring by producers, Images are staged and recorded at once
+		FGL_ASSERT( m_type == eBufferFromRaw, "Only raw buffer uploads can be unstaged" );
+
+		const std::span< const std::byte > data { staged->data() };
+
+		m_source = RawData( data.begin(), data.end() );
+		m_source_offset = 0;
+	}
+
+	const void* TransferData::targetKey() const
+	{
+		return std::visit( []( const auto& target ) -> const void* { return target.get(); }, m_target );
+	}
+
+	const void* TransferData::sourceKey() const
+	{
+		if ( const auto* buffer = std::get_if< TransferBufferHandle >( &m_source ) ) return buffer->get();
+		if ( const auto* image = std::get_if< TransferImageHandle >( &m_source ) ) return image->get();
+		return nullptr;
+	}
+
 	void TransferData::markBad() const
 	{
 		switch ( m_type )
@@ -216,10 +298,18 @@ namespace fgl::engine::memory
 		switch ( m_type )
 		{
 			case eBufferFromRaw:
-				[[fallthrough]];
-			case eBufferFromBuffer:
 				std::get< TransferBufferHandle >( m_target )->setReady( true );
 				break;
+			case eBufferFromBuffer:
+				{
+					const auto& source { std::get< TransferBufferHandle >( m_source ) };
+					const auto& target { std::get< TransferBufferHandle >( m_target ) };
+					target->setReady( true );
+
+					// If this copy was a relocation (defragmentation) then the source can now take over the target's region
+					if ( source->reallocated() && source->reallocatedTo() == target ) source->commitRelocation();
+					break;
+				}
 			case eImageFromRaw:
 				[[fallthrough]];
 			case eImageFromBuffer:
@@ -259,12 +349,28 @@ namespace fgl::engine::memory
 	  m_source_offset( src_offset ),
 	  m_target( target ),
 	  m_target_offset( dst_offset ),
-	  m_size( size == 0 ? source.size() : size )
+	  m_size( size == 0 ? std::get< RawData >( m_source ).size() : size )
 	{
 		FGL_ASSERT( m_size <= target->size(), "Attempting to copy to beyond size of target" );
 		markBad();
 	}
 
+	//! BUFFER_FROM_RAW (Pre-staged)
+	TransferData::TransferData(
+		const StagingRegion& source,
+		const std::shared_ptr< BufferSuballocationHandle >& target,
+		const vk::DeviceSize dst_offset ) :
+	  m_type( eBufferFromRaw ),
+	  m_source( source ),
+	  m_source_offset( 0 ),
+	  m_target( target ),
+	  m_target_offset( dst_offset ),
+	  m_size( source.m_size )
+	{
+		FGL_ASSERT( m_target_offset + m_size <= target->size(), "Attempting to copy to beyond size of target" );
+		markBad();
+	}
+
 	//! IMAGE_FROM_BUFFER
 	TransferData::TransferData(
 		const std::shared_ptr< BufferSuballocationHandle >& source,
@@ -292,7 +398,7 @@ namespace fgl::engine::memory
 	  m_source_offset( src_offset ),
 	  m_target( target ),
 	  m_target_offset( 0 ),
-	  m_size( size == 0 ? source.size() : size )
+	  m_size( size == 0 ? std::get< RawData >( m_source ).size() : size )
 	{
 		assert( std::get< RawData >( m_source ).size() > 0 );
 		markBad();
@@ -5,10 +5,12 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <variant>
 #include <vector>
 
+#include "StagingRing.hpp"
 #include "engine/memory/buffers/BufferHandle.hpp"
 
 namespace vk
@@ -66,7 +68,10 @@ namespace fgl::engine::memory
 		using TransferBufferHandle = std::shared_ptr< BufferSuballocationHandle >;
 		using TransferImageHandle = std::shared_ptr< ImageHandle >;
 
-		using SourceData = std::variant< RawData, TransferBufferHandle, TransferImageHandle >;
+		//! Raw data that has been written into the staging ring
+		using StagedData = StagingRegion;
+
+		using SourceData = std::variant< RawData, TransferBufferHandle, TransferImageHandle, StagedData >;
 		using TargetData = std::variant< TransferBufferHandle, TransferImageHandle >;
 
 		//! Source data. Data type depends on m_type
@@ -79,27 +84,30 @@ namespace fgl::engine::memory
 
 		vk::DeviceSize m_size;
 
-		//! Performs copy of raw data to the staging buffer
-		bool convertRawToBuffer( Buffer& staging_buffer );
+		//! Performs copy of raw data to the staging ring. Returns false if the ring is currently full
+		bool convertRawToBuffer( StagingRing& staging );
+
+		//! Returns the buffer and offset that the source data can be copied from
+		std::pair< vk::Buffer, vk::DeviceSize > sourceLocation() const;
 
 		bool performImageStage(
 			vk::raii::CommandBuffer& cmd_buffer, std::uint32_t transfer_idx, std::uint32_t graphics_idx );
 
 		//! Same as @ref performImageStage Performs extra step of copying data to a staging buffer
-		/** @note After calling this function m_type will be `IMAGE_FROM_BUFFER`
+		/** @note After calling this function m_source will be the region of the staging ring used
 		 */
 		bool performRawImageStage(
 			vk::raii::CommandBuffer& buffer,
-			Buffer& staging_buffer,
+			StagingRing& staging,
 			std::uint32_t transfer_idx,
 			std::uint32_t graphics_idx );
 
 		bool performBufferStage( CopyRegionMap& copy_regions );
 
 		//! Same as @ref performBufferStage Performs extra step of copying data to a staging buffer
-		/** @note After calling this function m_type will be `BUFFER_FROM_BUFFER`
+		/** @note After calling this function m_source will be the region of the staging ring used
 		 */
-		bool performRawBufferStage( Buffer& staging_buffer, CopyRegionMap& copy_regions );
+		bool performRawBufferStage( StagingRing& staging, CopyRegionMap& copy_regions );
 
 		friend class TransferManager;
 
@@ -115,11 +123,26 @@ namespace fgl::engine::memory
 
 		bool stage(
 			vk::raii::CommandBuffer& buffer,
-			Buffer& staging_buffer,
+			StagingRing& staging,
 			CopyRegionMap& copy_regions,
 			std::uint32_t transfer_idx,
 			std::uint32_t graphics_idx );
 
+		//! Number of bytes this transfer needs in the staging ring. 0 if it has already been staged or needs no staging
+		vk::DeviceSize stagingSize() const;
+
+		//! Returns the staging region this transfer references, If it has been staged
+		std::optional< StagingRegion > stagedRegion() const;
+
+		//! Copies data staged in the ring back into host memory, So the region can be retired while this waits
+		void unstage();
+
+		//! Identifies the buffer region or image this transfer writes to
+		const void* targetKey() const;
+
+		//! Identifies the buffer region or image this transfer reads from, nullptr for raw or staged data
+		const void* sourceKey() const;
+
 		//! Marks the target as not staged/not ready
 		void markBad() const;
 
@@ -141,6 +164,12 @@ namespace fgl::engine::memory
 			vk::DeviceSize dst_offset = 0,
 			vk::DeviceSize src_offset = 0 );
 
+		//! Data already written to the staging ring by the caller
+		TransferData(
+			const StagingRegion& source,
+			const std::shared_ptr< BufferSuballocationHandle >& target,
+			vk::DeviceSize dst_offset = 0 );
+
 		//IMAGE_FROM_X
 		TransferData(
 			const std::shared_ptr< BufferSuballocationHandle >& source,
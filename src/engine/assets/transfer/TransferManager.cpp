@@ -12,6 +12,9 @@
 #include "engine/memory/buffers/BufferSuballocation.hpp"
 #include "engine/memory/buffers/vector/HostVector.hpp"
 
+#include <algorithm>
+#include <bit>
+
 #ifdef ENABLE_IMGUI
 #include "imgui.h"
 #endif
@@ -25,34 +28,28 @@ namespace fgl::engine::memory
 
 		if ( !m_queue.empty() ) log::info( "[TransferManager]: Queue size: {}", m_queue.size() );
 
-		std::size_t counter { 0 };
-		constexpr std::size_t counter_max { 256 };
+		const std::size_t processing { m_processing.size() };
 
-		while ( !m_queue.empty() )
+		const auto stage = [ this, &command_buffer ]( TransferData& data ) -> bool
 		{
-			++counter;
-			if ( counter > counter_max ) break;
-
-			TransferData data { std::move( m_queue.front() ) };
-			m_queue.pop();
-
-			if ( data.stage(
-					 command_buffer,
-					 m_staging_buffer,
-					 m_copy_regions,
-					 m_transfer_queue_index,
-					 m_graphics_queue_index ) )
-			{
-				m_processing.emplace_back( std::move( data ) );
-			}
-			else
+			return data
+			    .stage( command_buffer, *m_staging, m_copy_regions, m_transfer_queue_index, m_graphics_queue_index );
+		};
+
+		// Staging is only limited by the space in the ring, So keep going until it is full
+		m_waiting_for_ring = stageQueue(
+			m_queue,
+			m_processing,
+			[ this, &stage ]( TransferData& data ) -> bool
 			{
-				// We were unable to stage for a reason
-				log::debug( "Unable to stage object. Breaking out of loop, Objects will be staged next pass" );
-				m_queue.push( data );
-				break;
-			}
-		}
+				// Transfers that do not fit in the empty ring need it to be grown or rewound first
+				return stage( data ) || ( growStaging( data.stagingSize() ) && stage( data ) );
+			} );
+
+		const std::size_t counter { m_processing.size() - processing };
+
+		if ( !m_queue.empty() )
+			log::debug( "Unable to stage {} objects, They will be staged next pass", m_queue.size() );
 
 		if ( counter > 0 ) log::debug( "Queued {} objects for transfer", counter );
 
@@ -96,7 +93,51 @@ namespace fgl::engine::memory
 
 	void TransferManager::resizeBuffer( const std::uint64_t size )
 	{
-		m_staging_buffer.resize( size );
+		FGL_ASSERT( m_staging->used() == 0, "Attempted to resize the staging ring while it was in use" );
+
+		m_staging = std::make_unique< StagingRing >( size );
+		m_sampled_bytes = 0;
+		m_sample_time = Clock::now();
+	}
+
+	bool TransferManager::growStaging( const vk::DeviceSize required )
+	{
+		// Nothing can be resized or rewound while the ring is still referenced by a transfer. Those wait for a retire
+		if ( required == 0 || m_staging->used() > 0 ) return false;
+
+		// Allocations are never wrapped, So a transfer can fail to fit in the empty ring if it starts near the end
+		if ( required <= m_staging->capacity() )
+		{
+			m_staging->rewind();
+			return true;
+		}
+
+		const auto new_size { std::bit_ceil( required ) };
+
+		log::info(
+			"[TransferManager]: Growing staging ring from {} to {}",
+			literals::size_literals::toString( m_staging->capacity() ),
+			literals::size_literals::toString( new_size ) );
+
+		resizeBuffer( new_size );
+
+		return true;
+	}
+
+	void TransferManager::sampleThroughput()
+	{
+		using namespace std::chrono_literals;
+
+		const auto now { Clock::now() };
+		const std::chrono::duration< double > elapsed { now - m_sample_time };
+
+		if ( elapsed < 1s ) return;
+
+		const auto bytes { m_staging->bytesReserved() };
+
+		m_throughput = static_cast< double >( bytes - m_sampled_bytes ) / elapsed.count();
+		m_sampled_bytes = bytes;
+		m_sample_time = now;
 	}
 
 	void TransferManager::copySuballocationRegion(
@@ -114,7 +155,7 @@ namespace fgl::engine::memory
 
 		TransferData transfer_data { src, dst, size, dst_offset, src_offset };
 
-		m_queue.emplace( std::move( transfer_data ) );
+		m_queue.emplace_back( std::move( transfer_data ) );
 	}
 
 	void TransferManager::submitBuffer( const vk::raii::CommandBuffer& command_buffer ) const
@@ -138,27 +179,69 @@ namespace fgl::engine::memory
 		m_transfer_queue.submit( info, m_completion_fence );
 	}
 
-	std::vector< vk::BufferMemoryBarrier > TransferManager::createFromGraphicsBarriers()
+	//! Range of a target buffer written by one or more copy regions
+	struct TargetRange
 	{
-		std::vector< vk::BufferMemoryBarrier > barriers {};
+		vk::Buffer m_buffer;
+		vk::DeviceSize m_offset;
+		vk::DeviceSize m_size;
+	};
 
-		for ( auto& [ key, regions ] : m_copy_regions )
+	//! Merges the destinations of every copy region, So that each contiguous range of a buffer only needs one barrier
+	static std::vector< TargetRange > mergeTargetRanges( const CopyRegionMap& copy_regions )
+	{
+		std::vector< TargetRange > ranges {};
+
+		for ( const auto& [ key, regions ] : copy_regions )
 		{
-			auto& [ source, target ] = key;
+			const vk::Buffer target { key.second };
 
-			for ( const auto& region : regions )
+			for ( const auto& region : regions ) ranges.emplace_back( target, region.dstOffset, region.size );
+		}
+
+		std::ranges::sort(
+			ranges,
+			[]( const TargetRange& left, const TargetRange& right )
 			{
-				vk::BufferMemoryBarrier barrier {};
-				barrier.buffer = target;
-				barrier.offset = region.dstOffset;
-				barrier.size = region.size;
-				barrier.srcAccessMask = vk::AccessFlagBits::eNone;
-				barrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
-				barrier.srcQueueFamilyIndex = m_graphics_queue_index;
-				barrier.dstQueueFamilyIndex = m_transfer_queue_index;
-
-				barriers.emplace_back( barrier );
+				if ( left.m_buffer != right.m_buffer )
+					return static_cast< VkBuffer >( left.m_buffer ) < static_cast< VkBuffer >( right.m_buffer );
+				return left.m_offset < right.m_offset;
+			} );
+
+		std::vector< TargetRange > merged {};
+
+		for ( const auto& range : ranges )
+		{
+			if ( !merged.empty() && merged.back().m_buffer == range.m_buffer
+			     && merged.back().m_offset + merged.back().m_size >= range.m_offset )
+			{
+				auto& back { merged.back() };
+				back.m_size = std::max( back.m_offset + back.m_size, range.m_offset + range.m_size ) - back.m_offset;
+				continue;
 			}
+
+			merged.emplace_back( range );
+		}
+
+		return merged;
+	}
+
+	std::vector< vk::BufferMemoryBarrier > TransferManager::createFromGraphicsBarriers()
+	{
+		std::vector< vk::BufferMemoryBarrier > barriers {};
+
+		for ( const auto& range : mergeTargetRanges( m_copy_regions ) )
+		{
+			vk::BufferMemoryBarrier barrier {};
+			barrier.buffer = range.m_buffer;
+			barrier.offset = range.m_offset;
+			barrier.size = range.m_size;
+			barrier.srcAccessMask = vk::AccessFlagBits::eNone;
+			barrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+			barrier.srcQueueFamilyIndex = m_graphics_queue_index;
+			barrier.dstQueueFamilyIndex = m_transfer_queue_index;
+
+			barriers.emplace_back( barrier );
 		}
 
 		return barriers;
@@ -168,23 +251,18 @@ namespace fgl::engine::memory
 	{
 		std::vector< vk::BufferMemoryBarrier > barriers {};
 
-		for ( auto& [ key, regions ] : m_copy_regions )
+		for ( const auto& range : mergeTargetRanges( m_copy_regions ) )
 		{
-			auto& [ source, target ] = key;
-
-			for ( const auto& region : regions )
-			{
-				vk::BufferMemoryBarrier barrier {};
-				barrier.buffer = target;
-				barrier.offset = region.dstOffset;
-				barrier.size = region.size;
-				barrier.srcAccessMask = vk::AccessFlagBits::eNone;
-				barrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
-				barrier.srcQueueFamilyIndex = m_graphics_queue_index;
-				barrier.dstQueueFamilyIndex = m_transfer_queue_index;
-
-				barriers.emplace_back( barrier );
-			}
+			vk::BufferMemoryBarrier barrier {};
+			barrier.buffer = range.m_buffer;
+			barrier.offset = range.m_offset;
+			barrier.size = range.m_size;
+			barrier.srcAccessMask = vk::AccessFlagBits::eNone;
+			barrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+			barrier.srcQueueFamilyIndex = m_graphics_queue_index;
+			barrier.dstQueueFamilyIndex = m_transfer_queue_index;
+
+			barriers.emplace_back( barrier );
 		}
 
 		return barriers;
@@ -194,23 +272,18 @@ namespace fgl::engine::memory
 	{
 		std::vector< vk::BufferMemoryBarrier > barriers {};
 
-		for ( auto& [ key, regions ] : m_copy_regions )
+		for ( const auto& range : mergeTargetRanges( m_copy_regions ) )
 		{
-			auto& [ source, target ] = key;
-
-			for ( const auto& region : regions )
-			{
-				vk::BufferMemoryBarrier barrier {};
-				barrier.buffer = target;
-				barrier.offset = region.dstOffset;
-				barrier.size = region.size;
-				barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
-				barrier.dstAccessMask = vk::AccessFlagBits::eVertexAttributeRead | vk::AccessFlagBits::eIndexRead;
-				barrier.srcQueueFamilyIndex = m_transfer_queue_index;
-				barrier.dstQueueFamilyIndex = m_graphics_queue_index;
-
-				barriers.emplace_back( barrier );
-			}
+			vk::BufferMemoryBarrier barrier {};
+			barrier.buffer = range.m_buffer;
+			barrier.offset = range.m_offset;
+			barrier.size = range.m_size;
+			barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+			barrier.dstAccessMask = vk::AccessFlagBits::eVertexAttributeRead | vk::AccessFlagBits::eIndexRead;
+			barrier.srcQueueFamilyIndex = m_transfer_queue_index;
+			barrier.dstQueueFamilyIndex = m_graphics_queue_index;
+
+			barriers.emplace_back( barrier );
 		}
 
 		return barriers;
@@ -220,23 +293,19 @@ namespace fgl::engine::memory
 	{
 		std::vector< vk::BufferMemoryBarrier > barriers {};
 
-		for ( const auto& [ key, regions ] : m_copy_regions )
+		for ( const auto& range : mergeTargetRanges( m_copy_regions ) )
 		{
-			const auto& [ src, dst ] = key;
-			for ( const auto& region : regions )
-			{
-				vk::BufferMemoryBarrier barrier {};
+			vk::BufferMemoryBarrier barrier {};
 
-				barrier.buffer = dst;
-				barrier.offset = region.dstOffset;
-				barrier.size = region.size;
-				barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite,
-				barrier.dstAccessMask = vk::AccessFlagBits::eIndexRead | vk::AccessFlagBits::eVertexAttributeRead;
-				barrier.srcQueueFamilyIndex = m_transfer_queue_index;
-				barrier.dstQueueFamilyIndex = m_graphics_queue_index;
+			barrier.buffer = range.m_buffer;
+			barrier.offset = range.m_offset;
+			barrier.size = range.m_size;
+			barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+			barrier.dstAccessMask = vk::AccessFlagBits::eIndexRead | vk::AccessFlagBits::eVertexAttributeRead;
+			barrier.srcQueueFamilyIndex = m_transfer_queue_index;
+			barrier.dstQueueFamilyIndex = m_graphics_queue_index;
 
-				barriers.emplace_back( barrier );
-			}
+			barriers.emplace_back( barrier );
 		}
 
 		return barriers;
@@ -275,6 +344,10 @@ namespace fgl::engine::memory
 
 		(void)Device::getInstance()->waitForFences( fences, VK_TRUE, std::numeric_limits< std::size_t >::max() );
 
+		// Everything staged for the last submission has been consumed by the device
+		m_staging->retire( m_in_flight_marker );
+		sampleThroughput();
+
 		m_processing.clear();
 		m_copy_regions.clear();
 		m_allow_transfers = true;
@@ -288,9 +361,98 @@ namespace fgl::engine::memory
 
 	void TransferManager::copyToVector( BufferVector& source, BufferVector& target, const std::size_t target_offset )
 	{
+		// Any pending element updates must land before the contents are copied out (Resizing)
+		flushDirtyRanges( source.getHandle().get() );
+		flushDirtyRanges( target.getHandle().get() );
+
 		TransferData transfer_data { source.getHandle(), target.getHandle(), target_offset };
 
-		m_queue.emplace( std::move( transfer_data ) );
+		m_queue.emplace_back( std::move( transfer_data ) );
+	}
+
+	std::optional< StagedWrite > TransferManager::
+		reserveWrite( BufferVector& target, const vk::DeviceSize size, const vk::DeviceSize dst_offset )
+	{
+		flushDirtyRanges( target.getHandle().get() );
+		return reserveStaged( target.getHandle(), size, dst_offset );
+	}
+
+	std::optional< StagedWrite > TransferManager::reserveStaged(
+		const std::shared_ptr< BufferSuballocationHandle >& target,
+		const vk::DeviceSize size,
+		const vk::DeviceSize dst_offset )
+	{
+		FGL_ASSERT( dst_offset + size <= target->size(), "Attempting to write beyond the end of the target" );
+
+		// Space retired from the ring goes to the transfers already waiting for it first
+		if ( m_waiting_for_ring ) return std::nullopt;
+
+		auto region { m_staging->reserve( size ) };
+
+		if ( !region.has_value() ) return std::nullopt;
+
+		return StagedWrite { *region, target, dst_offset };
+	}
+
+	void TransferManager::queueElementUpdate(
+		BufferVector& target,
+		const std::uint32_t idx,
+		const vk::DeviceSize stride,
+		const std::span< const std::byte > data )
+	{
+		const auto& handle { target.getHandle() };
+
+		auto [ itter, inserted ] = m_dirty_ranges.try_emplace( handle.get(), handle, stride );
+
+		itter->second.write( idx, data );
+	}
+
+	void TransferManager::flushDirtyRanges( const BufferSuballocationHandle* target )
+	{
+		if ( auto itter = m_dirty_ranges.find( target ); itter != m_dirty_ranges.end() ) flushDirtyRanges( itter->second );
+	}
+
+	void TransferManager::flushDirtyRanges( DirtyRanges& ranges )
+	{
+		ZoneScoped;
+
+		for ( const auto& range : ranges.ranges() )
+		{
+			const vk::DeviceSize size { range.m_count * ranges.stride() };
+			const vk::DeviceSize dst_offset { range.m_first * ranges.stride() };
+
+			if ( auto write = reserveStaged( ranges.target(), size, dst_offset ) )
+			{
+				ranges.read( range, write->data() );
+				commit( std::move( *write ) );
+				continue;
+			}
+
+			// Ring is full, Fallback to staging it during recordCommands
+			const auto data { ranges.data( range ) };
+
+			m_queue
+				.emplace_back( std::vector< std::byte >( data.begin(), data.end() ), ranges.target(), size, dst_offset );
+		}
+
+		ranges.clear();
+	}
+
+	void TransferManager::flushAllDirtyRanges()
+	{
+		ZoneScoped;
+
+		for ( auto& [ target, ranges ] : m_dirty_ranges ) flushDirtyRanges( ranges );
+
+		// Entries are kept so their data allocation can be reused, Unless the target is no longer used by anything else
+		std::erase_if( m_dirty_ranges, []( const auto& pair ) { return pair.second.target().use_count() == 1; } );
+	}
+
+	void TransferManager::commit( StagedWrite&& write )
+	{
+		TransferData transfer_data { write.m_region, write.m_target, write.m_target_offset };
+
+		m_queue.emplace_back( std::move( transfer_data ) );
 	}
 
 	void TransferManager::copyToImage( std::vector< std::byte >&& data, const Image& image )
@@ -300,14 +462,11 @@ namespace fgl::engine::memory
 
 		assert( std::get< TransferData::RawData >( transfer_data.m_source ).size() > 0 );
 
-		m_queue.emplace( std::move( transfer_data ) );
+		m_queue.emplace_back( std::move( transfer_data ) );
 	}
 
 	TransferManager::TransferManager( Device& device, const vk::DeviceSize buffer_size ) :
-	  m_staging_buffer(
-		  buffer_size,
-		  vk::BufferUsageFlagBits::eTransferSrc,
-		  vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent ),
+	  m_staging( std::make_unique< StagingRing >( buffer_size ) ),
 	  m_transfer_queue_index( device.phyDevice()
 	                              .queueInfo()
 	                              .getIndex( vk::QueueFlagBits::eTransfer, vk::QueueFlagBits::eGraphics ) ),
@@ -321,7 +480,6 @@ namespace fgl::engine::memory
 		log::info( "Transfer manager created with size {}", literals::size_literals::toString( buffer_size ) );
 
 		GLOBAL_TRANSFER_MANAGER = this;
-		m_staging_buffer->setDebugName( "Staging buffer" );
 	}
 
 	void TransferManager::submitNow()
@@ -337,16 +495,22 @@ namespace fgl::engine::memory
 
 		transfer_buffer.begin( info );
 
+		flushAllDirtyRanges();
+
 		recordCommands( transfer_buffer );
 
 		submitBuffer( transfer_buffer );
 
+		// Everything reserved in the ring up to this point is used by this submission.
+		// Transfers left in the queue were moved out of the ring, So they do not hold it back. See stageQueue
+		m_in_flight_marker = m_staging->mark();
+
 		if ( m_processing.size() > 0 )
 		{
 			log::debug(
-				"Submitted {} objects to be transfered, Transfer buffer usage: {}",
+				"Submitted {} objects to be transfered, Staging ring usage: {}",
 				m_processing.size(),
-				literals::size_literals::toString( m_staging_buffer->used() ) );
+				literals::size_literals::toString( m_staging->used() ) );
 		}
 
 		for ( auto& processed : m_processing )
@@ -361,11 +525,11 @@ namespace fgl::engine::memory
 	void TransferManager::drawImGui() const
 	{
 #ifdef ENABLE_IMGUI
-		ImGui::Text( "|- %s Allocated", literals::size_literals::toString( m_staging_buffer->size() ).c_str() );
-		ImGui::Text( "|- %s Used ", literals::size_literals::toString( m_staging_buffer->used() ).c_str() );
+		ImGui::Text( "|- %s Allocated", literals::size_literals::toString( m_staging->capacity() ).c_str() );
+		ImGui::Text( "|- %s Used ", literals::size_literals::toString( m_staging->used() ).c_str() );
 		ImGui::Text(
-			"|- %s Unused",
-			literals::size_literals::toString( m_staging_buffer->size() - m_staging_buffer->used() ).c_str() );
+			"|- %s Unused", literals::size_literals::toString( m_staging->capacity() - m_staging->used() ).c_str() );
+		ImGui::Text( "|- %.2f MB/s staged", m_throughput / ( 1024.0 * 1024.0 ) );
 
 		ImGui::Text( "|- %i transfer remaining", m_queue.size() );
 		ImGui::Text( "|- %zu objects being processed", m_processing.size() );
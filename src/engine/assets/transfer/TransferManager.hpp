@@ -5,11 +5,17 @@
 #pragma once
 #include <vulkan/vulkan_raii.hpp>
 
+#include <deque>
+#include <span>
 #include <functional>
-#include <queue>
+#include <unordered_map>
 
+#include "DirtyRanges.hpp"
+#include "StagingRing.hpp"
 #include "TransferData.hpp"
+#include "TransferQueue.hpp"
 #include "engine/FGL_DEFINES.hpp"
+#include "engine/clock.hpp"
 #include "engine/memory/buffers/vector/concepts.hpp"
 
 namespace fgl::engine
@@ -30,16 +36,60 @@ namespace fgl::engine
 namespace fgl::engine::memory
 {
 
+	//! Region of the staging ring reserved for a copy into a buffer.
+	//! The producer writes directly into `data()` and then hands it to TransferManager::commit
+	struct StagedWrite
+	{
+		StagingRegion m_region;
+		std::shared_ptr< BufferSuballocationHandle > m_target;
+		vk::DeviceSize m_target_offset;
+
+		std::span< std::byte > data() const { return m_region.data(); }
+	};
+
 	//! Manages transfers from HOST (CPU) to DEVICE (GPU)
 	class TransferManager
 	{
-		//TODO: Ring Buffer
+		//! Ring used for any raw -> buffer/image transfers
+		std::unique_ptr< StagingRing > m_staging;
+
+		//! Marker of everything staged by the last submit. Retired once m_completion_fence is signaled
+		RingAllocator::Marker m_in_flight_marker { 0 };
+
+		//! True while a queued transfer is waiting for space in the ring. No new writes are reserved until it is staged
+		bool m_waiting_for_ring { false };
+
+		//! Throughput tracking for the staging ring
+		std::uint64_t m_sampled_bytes { 0 };
+		std::chrono::time_point< Clock > m_sample_time { Clock::now() };
+		double m_throughput { 0.0 };
+
+		//! Makes room for a transfer that did not fit in the empty ring. Returns true if the transfer should be retried
+		bool growStaging( vk::DeviceSize required );
 
-		//! Buffer used for any raw -> buffer transfers
-		Buffer m_staging_buffer;
+		void sampleThroughput();
+
+		//! Same as reserveWrite, But does not flush any pending element updates to the target
+		std::optional< StagedWrite > reserveStaged(
+			const std::shared_ptr< BufferSuballocationHandle >& target, vk::DeviceSize size, vk::DeviceSize dst_offset );
+
+		//! Records a single element update, To be merged with any other updates to the same vector
+		void queueElementUpdate(
+			BufferVector& target, std::uint32_t idx, vk::DeviceSize stride, std::span< const std::byte > data );
+
+		//! Stages the dirty ranges of a vector. Queued before any other transfer that touches it, To keep them ordered
+		void flushDirtyRanges( const BufferSuballocationHandle* target );
+
+		void flushDirtyRanges( DirtyRanges& ranges );
+
+		//! Stages the dirty ranges of every vector
+		void flushAllDirtyRanges();
 
 		//! Queue of data needing to be transfered and submitted.
-		std::queue< TransferData > m_queue {};
+		std::deque< TransferData > m_queue {};
+
+		//! Element updates that have not been staged yet, Keyed by the target vector
+		std::unordered_map< const BufferSuballocationHandle*, DirtyRanges > m_dirty_ranges {};
 
 		//! Data actively in flight (Submitted to the DEVICE transfer queue)
 		std::vector< TransferData > m_processing {};
@@ -98,7 +148,8 @@ namespace fgl::engine::memory
 
 		static TransferManager& getInstance();
 
-		//! Resizes the staging buffer.
+		//! Resizes the staging ring.
+		//! @note Must only be called when no staged transfers are in flight
 		void resizeBuffer( std::uint64_t size );
 
 		void copySuballocationRegion(
@@ -108,6 +159,17 @@ namespace fgl::engine::memory
 			vk::DeviceSize dst_offset = 0,
 			std::size_t src_offset = 0 );
 
+		/**
+		 * @brief Reserves `size` bytes of the staging ring to be copied into `target` at `dst_offset`.
+		 * @return std::nullopt if the ring is full or a transfer is waiting for it.
+		 * Callers should fall back to copyToVector.
+		 * @note The write must be given to commit() for the copy to happen. Uncommitted writes are released with the next retire
+		 */
+		std::optional< StagedWrite > reserveWrite( BufferVector& target, vk::DeviceSize size, vk::DeviceSize dst_offset );
+
+		//! Queues a write reserved by reserveWrite to be copied into it's target
+		void commit( StagedWrite&& write );
+
 		//! Queues a buffer to be transfered
 		template < typename DeviceVectorT >
 			requires is_device_vector< DeviceVectorT >
@@ -119,44 +181,59 @@ namespace fgl::engine::memory
 			const vk::DeviceSize src_offset = 0 )
 		{
 			assert( !data.empty() );
+			flushDirtyRanges( device_vector.m_handle.get() );
+
 			TransferData transfer_data {
 				std::forward< std::vector< std::byte > >( data ), device_vector.m_handle, size, dst_offset, src_offset
 			};
 
-			m_queue.emplace( std::move( transfer_data ) );
+			m_queue.emplace_back( std::move( transfer_data ) );
 		}
 
 		template < typename T, typename DeviceVectorT >
 			requires is_device_vector< DeviceVectorT > && std::same_as< T, typename DeviceVectorT::Type >
 		void copyToVector( const T& t, const std::size_t idx, DeviceVectorT& device_vector )
 		{
-			std::vector< std::byte > data {};
-			data.resize( sizeof( T ) );
-
 			assert( idx < device_vector.bytesize() / sizeof( T ) );
 
-			std::memcpy( data.data(), &t, sizeof( T ) );
-
-			const auto size { sizeof( T ) };
-			const auto dst_offset { idx * size };
-
-			copyToVector( std::move( data ), device_vector, size, dst_offset );
+			// Merged with any other updates to this vector, And staged all at once when the queue is submitted
+			queueElementUpdate(
+				device_vector,
+				static_cast< std::uint32_t >( idx ),
+				sizeof( T ),
+				std::as_bytes( std::span< const T, 1 >( &t, 1 ) ) );
 		}
 
-		//! Queues a data copy from a STL vector to a device vector
+		//! Queues a data copy from contiguous memory (Such as a memory mapped file) to a device vector
 		template < typename T, typename DeviceVectorT >
 			requires is_device_vector< DeviceVectorT > && std::same_as< T, typename DeviceVectorT::Type >
-		void copyToVector( const std::vector< T >& data, DeviceVectorT& device_vector )
+		void copyToVector( const std::span< const T > data, DeviceVectorT& device_vector )
 		{
 			assert( data.size() > 0 );
+
+			if ( auto write = reserveWrite( device_vector, data.size_bytes(), 0 ) )
+			{
+				std::memcpy( write->data().data(), data.data(), data.size_bytes() );
+				commit( std::move( *write ) );
+				return;
+			}
+
 			std::vector< std::byte > punned_data {};
-			punned_data.resize( sizeof( T ) * data.size() );
+			punned_data.resize( data.size_bytes() );
 
-			std::memcpy( punned_data.data(), data.data(), sizeof( T ) * data.size() );
+			std::memcpy( punned_data.data(), data.data(), data.size_bytes() );
 
 			copyToVector( std::move( punned_data ), device_vector, punned_data.size() );
 		}
 
+		//! Queues a data copy from a STL vector to a device vector
+		template < typename T, typename DeviceVectorT >
+			requires is_device_vector< DeviceVectorT > && std::same_as< T, typename DeviceVectorT::Type >
+		void copyToVector( const std::vector< T >& data, DeviceVectorT& device_vector )
+		{
+			copyToVector< T, DeviceVectorT >( std::span< const T >( data ), device_vector );
+		}
+
 		void copyToVector( BufferVector& source, BufferVector& target, std::size_t target_offset );
 
 		void copyToImage( std::vector< std::byte >&& data, const Image& image );
@@ -0,0 +1,83 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <deque>
+#include <unordered_set>
+#include <vector>
+
+namespace fgl::engine::memory
+{
+
+	template < typename T >
+	concept is_queued_transfer = requires( T& transfer, const T& const_transfer ) {
+		{ const_transfer.stagingSize() } -> std::convertible_to< std::uint64_t >;
+		{ const_transfer.targetKey() } -> std::same_as< const void* >;
+		{ const_transfer.sourceKey() } -> std::same_as< const void* >;
+		{ transfer.unstage() };
+	};
+
+	/**
+	 * @brief Stages as many queued transfers as possible, Moving them from `queue` to `staged` in order.
+	 * @details Once a transfer that needs space in the staging ring fails, Any later transfer that needs space waits
+	 * behind it, So the large transfer gets the ring first once it has retired. Transfers with their data already in
+	 * the ring (Or that do not use it) are still staged. Later transfers that read from or write to a target or source
+	 * of a waiting transfer also wait, So a copy out of a buffer (Such as when a vector is reallocated) never runs
+	 * before the writes queued to it. Anything left waiting is unstaged, So the queue never holds any region of the
+	 * ring and the whole ring can be retired once the submission completes.
+	 * @param stage Attempts to stage a single transfer. Returns true on success.
+	 * @return True if a transfer is waiting for space in the ring.
+	 */
+	template < typename T, typename Func >
+		requires is_queued_transfer< T > && std::predicate< Func&, T& >
+	bool stageQueue( std::deque< T >& queue, std::vector< T >& staged, Func&& stage )
+	{
+		std::deque< T > waiting {};
+
+		//! Targets and sources of the waiting transfers. Any later transfer touching one of them has to wait
+		std::unordered_set< const void* > blocked {};
+
+		const auto is_blocked = [ &blocked ]( const T& transfer ) -> bool
+		{
+			const void* const source { transfer.sourceKey() };
+			return blocked.contains( transfer.targetKey() ) || ( source != nullptr && blocked.contains( source ) );
+		};
+
+		bool ring_full { false };
+
+		while ( !queue.empty() )
+		{
+			T transfer { std::move( queue.front() ) };
+			queue.pop_front();
+
+			const bool needs_ring { transfer.stagingSize() > 0 };
+
+			if ( !is_blocked( transfer ) && !( needs_ring && ring_full ) )
+			{
+				if ( stage( transfer ) )
+				{
+					staged.emplace_back( std::move( transfer ) );
+					continue;
+				}
+
+				ring_full |= needs_ring;
+			}
+
+			// Data already in the ring would keep it from being retired while it waits
+			transfer.unstage();
+
+			blocked.insert( transfer.targetKey() );
+			if ( const void* const source = transfer.sourceKey() ) blocked.insert( source );
+			waiting.emplace_back( std::move( transfer ) );
+		}
+
+		queue = std::move( waiting );
+
+		return ring_full;
+	}
+
+} // namespace fgl::engine::memory
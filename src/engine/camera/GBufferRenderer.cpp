@@ -36,10 +36,13 @@ namespace fgl::engine
 		command_buffer->setScissor( 0, scissors );
 	}
 
-	void GBufferRenderer::
-		beginRenderPass( const CommandBuffer& command_buffer, GBufferSwapchain& swapchain, const FrameIndex index )
+	void GBufferRenderer::beginRenderPass(
+		const CommandBuffer& command_buffer,
+		GBufferSwapchain& swapchain,
+		const FrameIndex index,
+		const vk::AttachmentLoadOp load_op )
 	{
-		const vk::RenderingInfo info { swapchain.getRenderingInfo( index ) };
+		const vk::RenderingInfo info { swapchain.getRenderingInfo( index, load_op ) };
 
 		command_buffer->beginRendering( info );
 
@@ -71,6 +74,17 @@ namespace fgl::engine
 
 		endRenderPass( command_buffer );
 
+		// Draws anything that was hidden by the previous frame's depth, But is visible in this frame's
+		if ( m_culling_system.latePass( frame_info, camera_swapchain ) )
+		{
+			beginRenderPass(
+				command_buffer, camera_swapchain, frame_info.in_flight_idx, vk::AttachmentLoadOp::eLoad );
+
+			m_entity_renderer.pass( frame_info );
+
+			endRenderPass( command_buffer );
+		}
+
 		camera_swapchain.transitionImages( command_buffer, GBufferSwapchain::FINAL, frame_info.in_flight_idx );
 
 		m_compositor.composite( command_buffer, *frame_info.camera, frame_info.in_flight_idx );
@@ -26,7 +26,11 @@ namespace fgl::engine
 		// SubPass 1
 		// CompositionSystem m_composition_system {};
 
-		void beginRenderPass( const CommandBuffer& command_buffer, GBufferSwapchain& swapchain, FrameIndex index );
+		void beginRenderPass(
+			const CommandBuffer& command_buffer,
+			GBufferSwapchain& swapchain,
+			FrameIndex index,
+			vk::AttachmentLoadOp load_op = vk::AttachmentLoadOp::eClear );
 
 		void setViewport( const CommandBuffer& command_buffer, vk::Extent2D extent );
 		void setScissor( const CommandBuffer& command_buffer, vk::Extent2D extent );
@@ -73,6 +73,63 @@ namespace fgl::engine
 						{},
 						barriers );
 
+					return;
+				}
+			case HIZ_BUILD:
+				{
+					const std::vector< vk::ImageMemoryBarrier > barriers {
+						m_gbuffer.m_depth.getImage( index ).transitionTo(
+							vk::ImageLayout::eDepthAttachmentOptimal,
+							vk::ImageLayout::eShaderReadOnlyOptimal,
+							vk::ImageAspectFlagBits::eDepth ),
+					};
+
+					command_buffer->pipelineBarrier(
+						vk::PipelineStageFlagBits::eEarlyFragmentTests | vk::PipelineStageFlagBits::eLateFragmentTests,
+						vk::PipelineStageFlagBits::eComputeShader,
+						vk::DependencyFlags( 0 ),
+						{},
+						{},
+						barriers );
+
+					return;
+				}
+			case LATE:
+				{
+					// The late draw loads the attachments instead of clearing them
+					const auto color_barrier = []( Image& image )
+					{
+						vk::ImageMemoryBarrier barrier { image.transitionColorTo(
+							vk::ImageLayout::eColorAttachmentOptimal, vk::ImageLayout::eColorAttachmentOptimal ) };
+						barrier.dstAccessMask |= vk::AccessFlagBits::eColorAttachmentRead;
+						return barrier;
+					};
+
+					vk::ImageMemoryBarrier depth_barrier { m_gbuffer.m_depth.getImage( index ).transitionTo(
+						vk::ImageLayout::eShaderReadOnlyOptimal,
+						vk::ImageLayout::eDepthAttachmentOptimal,
+						vk::ImageAspectFlagBits::eDepth ) };
+					depth_barrier.dstAccessMask |= vk::AccessFlagBits::eDepthStencilAttachmentRead;
+
+					const std::vector< vk::ImageMemoryBarrier > barriers {
+						color_barrier( m_gbuffer.m_color.getImage( index ) ),
+						color_barrier( m_gbuffer.m_emissive.getImage( index ) ),
+						color_barrier( m_gbuffer.m_metallic.getImage( index ) ),
+						color_barrier( m_gbuffer.m_position.getImage( index ) ),
+						color_barrier( m_gbuffer.m_normal.getImage( index ) ),
+						depth_barrier,
+					};
+
+					command_buffer->pipelineBarrier(
+						vk::PipelineStageFlagBits::eColorAttachmentOutput | vk::PipelineStageFlagBits::eComputeShader,
+						vk::PipelineStageFlagBits::eColorAttachmentOutput
+							| vk::PipelineStageFlagBits::eEarlyFragmentTests
+							| vk::PipelineStageFlagBits::eLateFragmentTests,
+						vk::DependencyFlags( 0 ),
+						{},
+						{},
+						barriers );
+
 					return;
 				}
 			case FINAL:
@@ -109,21 +166,22 @@ namespace fgl::engine
 		}
 	}
 
-	vk::RenderingInfo GBufferSwapchain::getRenderingInfo( const FrameIndex frame_index )
+	vk::RenderingInfo GBufferSwapchain::
+		getRenderingInfo( const FrameIndex frame_index, const vk::AttachmentLoadOp load_op )
 	{
 		// This should be safe to have as static as the information used here will only capable of being used in a single frame.
 		static thread_local std::vector< vk::RenderingAttachmentInfo > color_attachment_infos {};
 		static thread_local vk::RenderingAttachmentInfo depth_attachment_infos {};
 
-		depth_attachment_infos = m_gbuffer.m_depth.renderInfo( frame_index, vk::ImageLayout::eDepthAttachmentOptimal );
+		depth_attachment_infos = m_gbuffer.m_depth.renderInfo( frame_index, vk::ImageLayout::eDepthAttachmentOptimal, load_op );
 
 		color_attachment_infos.clear();
 		color_attachment_infos = {
-			m_gbuffer.m_color.renderInfo( frame_index, vk::ImageLayout::eColorAttachmentOptimal ),
-			m_gbuffer.m_position.renderInfo( frame_index, vk::ImageLayout::eColorAttachmentOptimal ),
-			m_gbuffer.m_normal.renderInfo( frame_index, vk::ImageLayout::eColorAttachmentOptimal ),
-			m_gbuffer.m_metallic.renderInfo( frame_index, vk::ImageLayout::eColorAttachmentOptimal ),
-			m_gbuffer.m_emissive.renderInfo( frame_index, vk::ImageLayout::eColorAttachmentOptimal )
+			m_gbuffer.m_color.renderInfo( frame_index, vk::ImageLayout::eColorAttachmentOptimal, load_op ),
+			m_gbuffer.m_position.renderInfo( frame_index, vk::ImageLayout::eColorAttachmentOptimal, load_op ),
+			m_gbuffer.m_normal.renderInfo( frame_index, vk::ImageLayout::eColorAttachmentOptimal, load_op ),
+			m_gbuffer.m_metallic.renderInfo( frame_index, vk::ImageLayout::eColorAttachmentOptimal, load_op ),
+			m_gbuffer.m_emissive.renderInfo( frame_index, vk::ImageLayout::eColorAttachmentOptimal, load_op )
 		};
 
 		vk::RenderingInfo rendering_info {};
@@ -144,6 +202,11 @@ namespace fgl::engine
 		return *m_gbuffer_descriptor_set[ frame_index ];
 	}
 
+	ImageView& GBufferSwapchain::getDepthView( const FrameIndex frame_index ) const
+	{
+		return m_gbuffer.m_depth.getView( frame_index );
+	}
+
 	vk::Extent2D GBufferSwapchain::getExtent() const
 	{
 		return m_extent;
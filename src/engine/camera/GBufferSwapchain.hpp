@@ -31,7 +31,7 @@ namespace fgl::engine
 			ColorAttachment< METALLIC_INDEX > m_metallic { pickMetallicFormat() };
 			ColorAttachment< EMISSIVE_INDEX > m_emissive { pickEmissiveFormat() };
 			//TODO: Move depth into m_position A channel
-			DepthAttachment< DEPTH_INDEX > m_depth { pickDepthFormat() };
+			SampledDepthAttachment< DEPTH_INDEX > m_depth { pickDepthFormat() };
 
 			// ColorAttachment< COMPOSITE_INDEX > m_composite { pickCompositeFormat() };
 		} m_gbuffer {};
@@ -49,18 +49,25 @@ namespace fgl::engine
 		enum StageID : std::uint16_t
 		{
 			INITAL,
+			//! Depth is read by the Hi-Z pyramid build
+			HIZ_BUILD,
+			//! Back to attachments for the late occlusion draw
+			LATE,
 			COMPOSITE,
 			FINAL
 		};
 
 		void transitionImages( CommandBuffer& command_buffer, std::uint16_t stage_id, FrameIndex index );
-		vk::RenderingInfo getRenderingInfo( const FrameIndex frame_index );
+		vk::RenderingInfo getRenderingInfo(
+			const FrameIndex frame_index, vk::AttachmentLoadOp load_op = vk::AttachmentLoadOp::eClear );
 
 		GBufferSwapchain( vk::Extent2D extent );
 		~GBufferSwapchain();
 
 		descriptors::DescriptorSet& getGBufferDescriptor( FrameIndex frame_index );
 
+		ImageView& getDepthView( FrameIndex frame_index ) const;
+
 		vk::Extent2D getExtent() const;
 
 		float getAspectRatio();
@@ -31,11 +31,19 @@ namespace fgl::engine::profiling
 		COUNTERS.m_instance_count += n;
 	}
 
+	void addCullingResults( std::size_t visible, std::size_t culled )
+	{
+		COUNTERS.m_visible += visible;
+		COUNTERS.m_culled += culled;
+	}
+
 	void resetCounters()
 	{
 		COUNTERS.m_verts_drawn = 0;
 		COUNTERS.m_models_draw = 0;
 		COUNTERS.m_instance_count = 0;
+		COUNTERS.m_culled = 0;
+		COUNTERS.m_visible = 0;
 	}
 
 	// In order for resetCounters to work we need to ensure we can just zero the struct.
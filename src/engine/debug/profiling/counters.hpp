@@ -13,6 +13,10 @@ namespace fgl::engine::profiling
 		std::size_t m_verts_drawn;
 		std::size_t m_models_draw;
 		std::size_t m_instance_count;
+
+		//! Primitive instances rejected/accepted by GPU culling. Read back from the GPU a few frames late
+		std::size_t m_culled;
+		std::size_t m_visible;
 	};
 
 	Counters& getCounters();
@@ -20,6 +24,7 @@ namespace fgl::engine::profiling
 	void addModelDrawn( std::size_t n = 1 );
 	void addVertexDrawn( std::size_t n );
 	void addInstances( std::size_t n = 1 );
+	void addCullingResults( std::size_t visible, std::size_t culled );
 
 	void resetCounters();
 
@@ -0,0 +1,105 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "MappedFile.hpp"
+
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#if __has_include( <sys/mman.h> )
+#define FGL_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define FGL_HAS_MMAP 0
+#endif
+
+namespace fgl::engine::filesystem
+{
+
+	MappedFile::MappedFile( const std::filesystem::path& path )
+	{
+#if FGL_HAS_MMAP
+		const int fd { ::open( path.c_str(), O_RDONLY ) };
+		if ( fd == -1 ) throw std::runtime_error( std::format( "Failed to open file: {}", path.string() ) );
+
+		struct stat info {};
+		if ( ::fstat( fd, &info ) != 0 )
+		{
+			::close( fd );
+			throw std::runtime_error( std::format( "Failed to stat file: {}", path.string() ) );
+		}
+
+		const auto size { static_cast< std::size_t >( info.st_size ) };
+
+		if ( size > 0 )
+		{
+			void* ptr { ::mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 ) };
+
+			if ( ptr == MAP_FAILED )
+			{
+				::close( fd );
+				throw std::runtime_error( std::format( "Failed to map file: {}", path.string() ) );
+			}
+
+			// The file is mostly read front to back, So let the kernel read ahead
+			::madvise( ptr, size, MADV_SEQUENTIAL | MADV_WILLNEED );
+
+			m_data = { static_cast< const std::byte* >( ptr ), size };
+		}
+
+		// The mapping keeps the file alive
+		::close( fd );
+#else
+		std::ifstream file { path, std::ios::binary | std::ios::ate };
+		if ( !file ) throw std::runtime_error( std::format( "Failed to open file: {}", path.string() ) );
+
+		m_fallback.resize( static_cast< std::size_t >( file.tellg() ) );
+		file.seekg( 0 );
+		file.read( reinterpret_cast< char* >( m_fallback.data() ), static_cast< std::streamsize >( m_fallback.size() ) );
+
+		m_data = m_fallback;
+#endif
+	}
+
+	void MappedFile::unmap()
+	{
+#if FGL_HAS_MMAP
+		if ( !m_data.empty() && m_fallback.empty() )
+			::munmap( const_cast< std::byte* >( m_data.data() ), m_data.size() );
+#endif
+		m_data = {};
+		m_fallback.clear();
+	}
+
+	MappedFile::MappedFile( MappedFile&& other ) noexcept :
+	  m_data( std::exchange( other.m_data, {} ) ),
+	  m_fallback( std::move( other.m_fallback ) )
+	{
+		if ( !m_fallback.empty() ) m_data = m_fallback;
+	}
+
+	MappedFile& MappedFile::operator=( MappedFile&& other ) noexcept
+	{
+		if ( this == &other ) return *this;
+
+		unmap();
+
+		m_data = std::exchange( other.m_data, {} );
+		m_fallback = std::move( other.m_fallback );
+		if ( !m_fallback.empty() ) m_data = m_fallback;
+
+		return *this;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		unmap();
+	}
+
+} // namespace fgl::engine::filesystem
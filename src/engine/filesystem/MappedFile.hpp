@@ -0,0 +1,47 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace fgl::engine::filesystem
+{
+
+	/**
+	 * @brief Read only view of a file's contents.
+	 * @note Uses mmap where available, So the pages are only read from disk as they are touched.
+	 * Other platforms read the entire file into memory instead.
+	 */
+	class MappedFile
+	{
+		std::span< const std::byte > m_data {};
+
+		//! Contents of the file when it could not be mapped
+		std::vector< std::byte > m_fallback {};
+
+		void unmap();
+
+	  public:
+
+		//! Throws std::runtime_error if the file could not be opened
+		explicit MappedFile( const std::filesystem::path& path );
+
+		MappedFile( const MappedFile& ) = delete;
+		MappedFile& operator=( const MappedFile& ) = delete;
+
+		MappedFile( MappedFile&& other ) noexcept;
+		MappedFile& operator=( MappedFile&& other ) noexcept;
+
+		~MappedFile();
+
+		std::span< const std::byte > data() const { return m_data; }
+
+		std::size_t size() const { return m_data.size(); }
+	};
+
+} // namespace fgl::engine::filesystem
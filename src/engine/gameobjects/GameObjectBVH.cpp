@@ -0,0 +1,156 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "GameObjectBVH.hpp"
+
+#include <tracy/Tracy.hpp>
+
+#include "GameObject.hpp"
+#include "components/ModelComponent.hpp"
+#include "components/TransformComponent.hpp"
+#include "engine/assets/model/Model.hpp"
+#include "engine/math/raycast/raycast.hpp"
+#include "engine/primitives/Frustum.hpp"
+#include "engine/primitives/boxes/AxisAlignedBoundingBox.hpp"
+
+namespace fgl::engine
+{
+
+	//! Model space bounds of every model of the object
+	static BVHBounds localBounds( const std::vector< components::ModelComponent* >& models )
+	{
+		// The box of a model is the unit cube transformed by it's matrix
+		const BVHBounds unit_cube { glm::vec3( -1.0f ), glm::vec3( 1.0f ) };
+
+		BVHBounds bounds {};
+
+		for ( components::ModelComponent* model : models )
+		{
+			const std::shared_ptr< ModelInstance >& instance { model->getModelInstance() };
+			if ( !instance ) continue;
+
+			bounds.grow( transformBounds( unit_cube, instance->getModel()->getBoundingBox().getMatrix() ) );
+		}
+
+		return bounds;
+	}
+
+	void GameObjectBVH::build( const GameObjectList& objects )
+	{
+		ZoneScoped;
+
+		m_hierarchy = std::make_shared< BoundingVolumeHierarchy >();
+		m_objects.clear();
+		m_source_generation = objects.generation();
+
+		std::vector< BVHBounds > world_bounds {};
+		world_bounds.reserve( objects.size() );
+		m_objects.reserve( objects.size() );
+
+		struct Registration
+		{
+			components::TransformComponent* m_transform;
+			BVHUpdateTarget m_target;
+		};
+
+		std::vector< Registration > registrations {};
+
+		for ( const std::shared_ptr< GameObject >& object : objects )
+		{
+			const auto models { object->getComponents< components::ModelComponent >() };
+			if ( models.empty() ) continue;
+
+			const BVHBounds local { localBounds( models ) };
+			if ( !local.valid() ) continue;
+
+			const auto item { static_cast< BoundingVolumeHierarchy::ItemIndex >( m_objects.size() ) };
+			const auto transforms { object->getComponents< components::TransformComponent >() };
+
+			if ( transforms.empty() )
+			{
+				// Nothing can move the object, So it's models are left where they were created
+				world_bounds.emplace_back( transformBounds( local, models.front()->getModelInstance()->getMatrix() ) );
+			}
+			else
+			{
+				world_bounds.emplace_back( transformBounds( local, ( **transforms.front() ).mat4() ) );
+				registrations.push_back( { transforms.front(), { m_hierarchy, item, local } } );
+			}
+
+			m_objects.emplace_back( object );
+		}
+
+		m_hierarchy->build( world_bounds );
+
+		// Registered after the build, As the items have to exist before they can be moved
+		for ( const auto& [ transform, target ] : registrations ) transform->addUpdateTarget( target );
+
+		// Registering moves every item to the bounds it was built with, So this only clears them from the dirty list
+		m_hierarchy->refit();
+
+		log::debug( "Built game object BVH over {} objects with {} nodes", m_objects.size(), m_hierarchy->nodeCount() );
+	}
+
+	void GameObjectBVH::update( const GameObjectList& objects )
+	{
+		ZoneScoped;
+
+		if ( m_source_generation != objects.generation() )
+		{
+			build( objects );
+			return;
+		}
+
+		m_hierarchy->refit();
+	}
+
+	std::vector< std::shared_ptr< GameObject > >
+		GameObjectBVH::resolve( const std::vector< BoundingVolumeHierarchy::ItemIndex >& items ) const
+	{
+		std::vector< std::shared_ptr< GameObject > > resolved {};
+		resolved.reserve( items.size() );
+
+		for ( const auto item : items )
+		{
+			if ( auto object = m_objects[ item ].lock() ) resolved.emplace_back( std::move( object ) );
+		}
+
+		return resolved;
+	}
+
+	std::optional< GameObjectBVH::Hit > GameObjectBVH::raycast( const Ray& ray, const float max_distance ) const
+	{
+		ZoneScoped;
+
+		const auto hit { m_hierarchy->raycast( ray.m_start.vec(), ray.m_vector.vec(), max_distance ) };
+		if ( !hit ) return std::nullopt;
+
+		auto object { m_objects[ hit->m_item ].lock() };
+		if ( !object ) return std::nullopt;
+
+		return Hit { std::move( object ), hit->m_distance };
+	}
+
+	std::vector< std::shared_ptr< GameObject > > GameObjectBVH::query( const Frustum& frustum ) const
+	{
+		ZoneScoped;
+
+		std::vector< BoundingVolumeHierarchy::ItemIndex > items {};
+		m_hierarchy->query( frustum.gpuPlanes(), items );
+
+		return resolve( items );
+	}
+
+	std::vector< std::shared_ptr< GameObject > >
+		GameObjectBVH::query( const AxisAlignedBoundingBox< CoordinateSpace::World >& bounds ) const
+	{
+		ZoneScoped;
+
+		std::vector< BoundingVolumeHierarchy::ItemIndex > items {};
+		m_hierarchy->query( BVHBounds { bounds.bottomLeftBack().vec(), bounds.topLeftForward().vec() }, items );
+
+		return resolve( items );
+	}
+
+} // namespace fgl::engine
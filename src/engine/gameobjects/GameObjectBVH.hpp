@@ -0,0 +1,70 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "GameObjectList.hpp"
+#include "engine/math/bvh/BoundingVolumeHierarchy.hpp"
+#include "engine/primitives/CoordinateSpace.hpp"
+
+namespace fgl::engine
+{
+	class GameObject;
+	struct Frustum;
+	struct Ray;
+
+	template < CoordinateSpace CType >
+	class AxisAlignedBoundingBox;
+
+	//! Bounding volume hierarchy over the world space bounds of the models of a list of game objects
+	class GameObjectBVH
+	{
+		//! Replaced on every build, Which expires the update targets registered for the previous build
+		std::shared_ptr< BoundingVolumeHierarchy > m_hierarchy { std::make_shared< BoundingVolumeHierarchy >() };
+
+		//! Object of each item in the hierarchy
+		std::vector< std::weak_ptr< GameObject > > m_objects {};
+
+		//! Generation of the list the hierarchy was built from, Empty until the first build
+		std::optional< std::uint64_t > m_source_generation {};
+
+		std::vector< std::shared_ptr< GameObject > >
+			resolve( const std::vector< BoundingVolumeHierarchy::ItemIndex >& items ) const;
+
+	  public:
+
+		struct Hit
+		{
+			std::shared_ptr< GameObject > m_object;
+			//! Distance along the ray to where it enters the bounds of the object
+			float m_distance;
+		};
+
+		GameObjectBVH() = default;
+
+		//! Builds over every object with a model. Objects with a transform refit their item when it is updated
+		void build( const GameObjectList& objects );
+
+		//! Rebuilds the hierarchy if the list changed since it was built, Otherwise refits the objects that moved
+		void update( const GameObjectList& objects );
+
+		//! Closest object who's bounds are hit by the ray
+		std::optional< Hit >
+			raycast( const Ray& ray, float max_distance = std::numeric_limits< float >::infinity() ) const;
+
+		//! Every object who's bounds are at least partially inside of the frustum
+		std::vector< std::shared_ptr< GameObject > > query( const Frustum& frustum ) const;
+
+		//! Every object who's bounds overlap the box
+		std::vector< std::shared_ptr< GameObject > >
+			query( const AxisAlignedBoundingBox< CoordinateSpace::World >& bounds ) const;
+
+		const BoundingVolumeHierarchy& hierarchy() const { return *m_hierarchy; }
+	};
+
+} // namespace fgl::engine
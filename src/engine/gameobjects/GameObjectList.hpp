@@ -0,0 +1,49 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace fgl::engine
+{
+	class GameObject;
+
+	//! Game objects of the world. Counts every change, So anything built over the list knows when it is outdated
+	class GameObjectList
+	{
+		std::vector< std::shared_ptr< GameObject > > m_objects {};
+
+		std::uint64_t m_generation { 0 };
+
+	  public:
+
+		GameObjectList() = default;
+
+		void add( std::shared_ptr< GameObject > object )
+		{
+			m_objects.emplace_back( std::move( object ) );
+			++m_generation;
+		}
+
+		//! Must be called after an object in the list gains or loses a model
+		void markChanged() { ++m_generation; }
+
+		//! Incremented by every change to the list
+		std::uint64_t generation() const { return m_generation; }
+
+		const std::vector< std::shared_ptr< GameObject > >& objects() const { return m_objects; }
+
+		std::size_t size() const { return m_objects.size(); }
+
+		bool empty() const { return m_objects.empty(); }
+
+		auto begin() const { return m_objects.begin(); }
+
+		auto end() const { return m_objects.end(); }
+	};
+
+} // namespace fgl::engine
@@ -5,6 +5,7 @@
 #include "ComponentIDS.hpp"
 #include "assets/model/ModelInstanceInfo.hpp"
 #include "interface/GameObjectComponent.hpp"
+#include "math/bvh/BoundingVolumeHierarchy.hpp"
 
 namespace fgl::engine
 {
@@ -18,7 +19,7 @@ namespace fgl::engine::components
 		WorldTransform m_transform;
 		std::shared_ptr< ModelInstanceInfoIndex > m_model_instance_info_index;
 
-		using Updatable = std::variant< std::weak_ptr< ModelInstance > >;
+		using Updatable = std::variant< std::weak_ptr< ModelInstance >, BVHUpdateTarget >;
 
 		std::vector< Updatable > m_updatables {};
 
@@ -45,6 +46,12 @@ namespace fgl::engine::components
 		{
 			// static_assert( std::constructible_from< Updatable, T >, "T must be Updatable" );
 
+			// Targets of anything that has since been destroyed or rebuilt would otherwise pile up
+			std::erase_if(
+				m_updatables,
+				[]( const Updatable& updatable )
+				{ return std::visit( []( const auto& target ) { return target.expired(); }, updatable ); } );
+
 			m_updatables.emplace_back( unique );
 			triggerUpdate();
 		}
@@ -0,0 +1,657 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "BoundingVolumeHierarchy.hpp"
+
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+
+#include "engine/FGL_DEFINES.hpp"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Weffc++"
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#pragma GCC diagnostic pop
+
+namespace fgl::engine
+{
+
+	//! Cost of visiting a node, Relative to testing the bounds of an item
+	constexpr float SAH_TRAVERSAL_COST { 1.0f };
+
+	//! refit() recomputes every node once more than 1 in this many nodes are dirty leaves
+	constexpr std::size_t FULL_REFIT_RATIO { 8 };
+
+	constexpr float NO_HIT { std::numeric_limits< float >::infinity() };
+
+	void BVHBounds::grow( const glm::vec3& point )
+	{
+		m_min = glm::min( m_min, point );
+		m_max = glm::max( m_max, point );
+	}
+
+	void BVHBounds::grow( const BVHBounds& other )
+	{
+		m_min = glm::min( m_min, other.m_min );
+		m_max = glm::max( m_max, other.m_max );
+	}
+
+	float BVHBounds::halfArea() const
+	{
+		if ( !valid() ) return 0.0f;
+
+		const glm::vec3 size { m_max - m_min };
+		return size.x * size.y + size.y * size.z + size.z * size.x;
+	}
+
+	bool BVHBounds::overlaps( const BVHBounds& other ) const
+	{
+		return m_min.x <= other.m_max.x && m_max.x >= other.m_min.x && m_min.y <= other.m_max.y
+		    && m_max.y >= other.m_min.y && m_min.z <= other.m_max.z && m_max.z >= other.m_min.z;
+	}
+
+	BVHBounds transformBounds( const BVHBounds& bounds, const glm::mat4& matrix )
+	{
+		if ( !bounds.valid() ) return bounds;
+
+		const glm::vec3 center { matrix * glm::vec4( bounds.center(), 1.0f ) };
+		const glm::vec3 extent { bounds.extent() };
+
+		// Each axis of the box contributes the absolute of it's transformed axis to the new extent
+		glm::vec3 transformed_extent { 0.0f };
+		for ( glm::length_t axis = 0; axis < 3; ++axis )
+			transformed_extent += glm::abs( glm::vec3( matrix[ axis ] ) ) * extent[ axis ];
+
+		return { center - transformed_extent, center + transformed_extent };
+	}
+
+	//! Distance at which the ray enters the box, Or NO_HIT if it does not within max_distance
+	FGL_FORCE_INLINE inline float intersectRay(
+		const glm::vec3& min,
+		const glm::vec3& max,
+		const glm::vec3& origin,
+		const glm::vec3& inverse_direction,
+		const float max_distance )
+	{
+		const glm::vec3 t0 { ( min - origin ) * inverse_direction };
+		const glm::vec3 t1 { ( max - origin ) * inverse_direction };
+
+		const glm::vec3 near { glm::min( t0, t1 ) };
+		const glm::vec3 far { glm::max( t0, t1 ) };
+
+		const float enter { std::max( std::max( near.x, near.y ), std::max( near.z, 0.0f ) ) };
+		const float exit { std::min( std::min( far.x, far.y ), std::min( far.z, max_distance ) ) };
+
+		return enter <= exit ? enter : NO_HIT;
+	}
+
+	enum class Containment
+	{
+		Outside,
+		Intersecting,
+		Inside
+	};
+
+	//! Where the box lies relative to the planes. Inside only if it is entirely on the inside of every plane
+	FGL_FORCE_INLINE inline Containment
+		classify( const glm::vec3& min, const glm::vec3& max, const std::array< glm::vec4, 6 >& planes )
+	{
+		const glm::vec3 center { ( min + max ) * 0.5f };
+		const glm::vec3 extent { ( max - min ) * 0.5f };
+
+		Containment result { Containment::Inside };
+
+		for ( const glm::vec4& plane : planes )
+		{
+			const glm::vec3 normal { plane };
+			const float distance { glm::dot( normal, center ) + plane.w };
+			const float radius { glm::dot( glm::abs( normal ), extent ) };
+
+			if ( distance + radius < 0.0f ) return Containment::Outside;
+			if ( distance - radius < 0.0f ) result = Containment::Intersecting;
+		}
+
+		return result;
+	}
+
+	void BoundingVolumeHierarchy::build( const std::span< const BVHBounds > bounds )
+	{
+		ZoneScoped;
+
+		FGL_ASSERT(
+			bounds.size() < std::numeric_limits< ItemIndex >::max(), "Too many items for a bounding volume hierarchy" );
+
+		m_bounds.assign( bounds.begin(), bounds.end() );
+		m_item_leaf.assign( m_bounds.size(), INVALID_NODE );
+		m_nodes.clear();
+		m_items.clear();
+		m_parents.clear();
+		m_dirty_leaves.clear();
+		m_leaf_dirty.clear();
+
+		// Items without bounds can not be placed in the tree
+		m_items.reserve( m_bounds.size() );
+		for ( ItemIndex item = 0; item < m_bounds.size(); ++item )
+			if ( m_bounds[ item ].valid() ) m_items.emplace_back( item );
+
+		if ( m_items.empty() ) return;
+
+		struct BuildItem
+		{
+			BVHBounds m_bounds;
+			glm::vec3 m_centroid;
+			ItemIndex m_item;
+		};
+
+		// Partitioned instead of m_items, So the build reads the items sequentially instead of through their index
+		std::vector< BuildItem > build_items {};
+		build_items.reserve( m_items.size() );
+		for ( const ItemIndex item : m_items )
+			build_items.push_back( { m_bounds[ item ], m_bounds[ item ].center(), item } );
+
+		// A binary tree with a leaf per item is the largest the tree can be
+		m_nodes.reserve( m_items.size() * 2 );
+		m_parents.reserve( m_items.size() * 2 );
+
+		m_nodes.emplace_back();
+		m_parents.emplace_back( INVALID_NODE );
+
+		struct Task
+		{
+			std::uint32_t m_node;
+			std::uint32_t m_first;
+			std::uint32_t m_count;
+			std::uint32_t m_depth;
+		};
+
+		std::vector< Task > tasks {};
+		tasks.push_back( { 0, 0, static_cast< std::uint32_t >( m_items.size() ), 0 } );
+
+		struct Bin
+		{
+			BVHBounds m_bounds {};
+			std::uint32_t m_count { 0 };
+		};
+
+		while ( !tasks.empty() )
+		{
+			const Task task { tasks.back() };
+			tasks.pop_back();
+
+			const auto first { build_items.begin() + task.m_first };
+			const auto last { first + task.m_count };
+
+			BVHBounds node_bounds {};
+			BVHBounds centroid_bounds {};
+
+			for ( auto itter = first; itter != last; ++itter )
+			{
+				node_bounds.grow( itter->m_bounds );
+				centroid_bounds.grow( itter->m_centroid );
+			}
+
+			// Every node starts as a leaf, And is turned into an interior node if it is split
+			m_nodes[ task.m_node ] = Node { node_bounds.m_min, task.m_first, node_bounds.m_max, task.m_count };
+
+			if ( task.m_count == 1 ) continue;
+
+			const glm::vec3 centroid_size { centroid_bounds.m_max - centroid_bounds.m_min };
+
+			// The node is split if SAH finds a split cheaper than the leaf, Or the leaf would be too large
+			const float leaf_cost { static_cast< float >( task.m_count ) * node_bounds.halfArea() };
+			float best_cost { std::numeric_limits< float >::infinity() };
+			glm::length_t best_axis { -1 };
+			std::uint32_t best_bin { 0 };
+
+			if ( task.m_depth < MAX_SAH_DEPTH )
+			{
+				for ( glm::length_t axis = 0; axis < 3; ++axis )
+				{
+					if ( centroid_size[ axis ] <= 0.0f ) continue;
+
+					const float bin_scale { static_cast< float >( SAH_BINS ) / centroid_size[ axis ] };
+					std::array< Bin, SAH_BINS > bins {};
+
+					for ( auto itter = first; itter != last; ++itter )
+					{
+						const float offset { itter->m_centroid[ axis ] - centroid_bounds.m_min[ axis ] };
+						const auto bin_index {
+							std::min( static_cast< std::uint32_t >( offset * bin_scale ), SAH_BINS - 1 )
+						};
+
+						bins[ bin_index ].m_bounds.grow( itter->m_bounds );
+						++bins[ bin_index ].m_count;
+					}
+
+					// Cost of everything right of each split, Swept from the right
+					std::array< float, SAH_BINS > right_costs {};
+					BVHBounds right_bounds {};
+					std::uint32_t right_count { 0 };
+
+					for ( std::uint32_t bin = SAH_BINS - 1; bin > 0; --bin )
+					{
+						right_bounds.grow( bins[ bin ].m_bounds );
+						right_count += bins[ bin ].m_count;
+						right_costs[ bin - 1 ] =
+							right_count == 0 ? NO_HIT : static_cast< float >( right_count ) * right_bounds.halfArea();
+					}
+
+					BVHBounds left_bounds {};
+					std::uint32_t left_count { 0 };
+
+					for ( std::uint32_t bin = 0; bin < SAH_BINS - 1; ++bin )
+					{
+						left_bounds.grow( bins[ bin ].m_bounds );
+						left_count += bins[ bin ].m_count;
+
+						if ( left_count == 0 ) continue;
+
+						const float cost { SAH_TRAVERSAL_COST * node_bounds.halfArea()
+							               + static_cast< float >( left_count ) * left_bounds.halfArea()
+							               + right_costs[ bin ] };
+
+						if ( cost < best_cost )
+						{
+							best_cost = cost;
+							best_axis = axis;
+							best_bin = bin;
+						}
+					}
+				}
+			}
+
+			const bool sah_split { best_axis >= 0 && ( best_cost < leaf_cost || task.m_count > MAX_LEAF_SIZE ) };
+
+			if ( !sah_split && task.m_count <= MAX_LEAF_SIZE ) continue;
+
+			std::uint32_t left_count { 0 };
+
+			if ( sah_split )
+			{
+				const float bin_scale { static_cast< float >( SAH_BINS ) / centroid_size[ best_axis ] };
+
+				// Must match the binning exactly, Otherwise an item could land on the wrong side of the split
+				const auto middle { std::partition(
+					first,
+					last,
+					[ & ]( const BuildItem& item )
+					{
+						const float offset { item.m_centroid[ best_axis ] - centroid_bounds.m_min[ best_axis ] };
+						return std::min( static_cast< std::uint32_t >( offset * bin_scale ), SAH_BINS - 1 )
+						    <= best_bin;
+					} ) };
+
+				left_count = static_cast< std::uint32_t >( middle - first );
+			}
+			else
+			{
+				// Too deep, Or every centroid is in the same place. Halving the items bounds the depth of the tree
+				glm::length_t axis { 0 };
+				if ( centroid_size.y > centroid_size[ axis ] ) axis = 1;
+				if ( centroid_size.z > centroid_size[ axis ] ) axis = 2;
+
+				left_count = task.m_count / 2;
+
+				std::nth_element(
+					first,
+					first + left_count,
+					last,
+					[ & ]( const BuildItem& left, const BuildItem& right )
+					{ return left.m_centroid[ axis ] < right.m_centroid[ axis ]; } );
+			}
+
+			FGL_ASSERT( left_count > 0 && left_count < task.m_count, "Split produced an empty child" );
+
+			const auto child { static_cast< std::uint32_t >( m_nodes.size() ) };
+
+			m_nodes.emplace_back();
+			m_nodes.emplace_back();
+			m_parents.emplace_back( task.m_node );
+			m_parents.emplace_back( task.m_node );
+
+			m_nodes[ task.m_node ].m_offset = child;
+			m_nodes[ task.m_node ].m_count = 0;
+
+			// The left child is built first, Keeping it's subtree close to it in memory
+			tasks.push_back( { child + 1, task.m_first + left_count, task.m_count - left_count, task.m_depth + 1 } );
+			tasks.push_back( { child, task.m_first, left_count, task.m_depth + 1 } );
+		}
+
+		for ( std::size_t i = 0; i < build_items.size(); ++i ) m_items[ i ] = build_items[ i ].m_item;
+
+		for ( std::uint32_t node_index = 0; node_index < m_nodes.size(); ++node_index )
+		{
+			const Node& node { m_nodes[ node_index ] };
+			if ( !node.isLeaf() ) continue;
+
+			for ( std::uint32_t i = node.m_offset; i < node.m_offset + node.m_count; ++i )
+				m_item_leaf[ m_items[ i ] ] = node_index;
+		}
+
+		m_leaf_dirty.assign( m_nodes.size(), false );
+	}
+
+	void BoundingVolumeHierarchy::update( const ItemIndex item, const BVHBounds& bounds )
+	{
+		FGL_ASSERT( item < m_bounds.size(), "Item is not in the bounding volume hierarchy" );
+		FGL_ASSERT( bounds.valid(), "Items can not be moved to invalid bounds" );
+
+		m_bounds[ item ] = bounds;
+
+		// Items left out of the build are only added by the next build
+		const std::uint32_t leaf { m_item_leaf[ item ] };
+		if ( leaf == INVALID_NODE || m_leaf_dirty[ leaf ] ) return;
+
+		m_leaf_dirty[ leaf ] = true;
+		m_dirty_leaves.emplace_back( leaf );
+	}
+
+	bool BoundingVolumeHierarchy::refitNode( const std::uint32_t node_index )
+	{
+		Node& node { m_nodes[ node_index ] };
+		BVHBounds bounds {};
+
+		if ( node.isLeaf() )
+		{
+			for ( std::uint32_t i = node.m_offset; i < node.m_offset + node.m_count; ++i )
+				bounds.grow( m_bounds[ m_items[ i ] ] );
+		}
+		else
+		{
+			bounds.grow( m_nodes[ node.m_offset ].bounds() );
+			bounds.grow( m_nodes[ node.m_offset + 1 ].bounds() );
+		}
+
+		if ( bounds == node.bounds() ) return false;
+
+		node.m_min = bounds.m_min;
+		node.m_max = bounds.m_max;
+
+		return true;
+	}
+
+	void BoundingVolumeHierarchy::refit()
+	{
+		ZoneScoped;
+
+		if ( m_dirty_leaves.empty() ) return;
+
+		if ( m_dirty_leaves.size() * FULL_REFIT_RATIO > m_nodes.size() )
+		{
+			// Children are always stored after their parent, So walking backwards refits every child before it's parent
+			for ( std::size_t i = m_nodes.size(); i > 0; --i ) refitNode( static_cast< std::uint32_t >( i - 1 ) );
+		}
+		else
+		{
+			for ( const std::uint32_t leaf : m_dirty_leaves )
+			{
+				// Nodes above one that did not change only need to be refit for other leaves
+				for ( std::uint32_t node = leaf; node != INVALID_NODE && refitNode( node ); node = m_parents[ node ] )
+				{}
+			}
+		}
+
+		for ( const std::uint32_t leaf : m_dirty_leaves ) m_leaf_dirty[ leaf ] = false;
+		m_dirty_leaves.clear();
+	}
+
+	BVHBounds BoundingVolumeHierarchy::rootBounds() const
+	{
+		if ( m_nodes.empty() ) return {};
+		return m_nodes[ 0 ].bounds();
+	}
+
+	float BoundingVolumeHierarchy::sahCost() const
+	{
+		if ( m_nodes.empty() ) return 0.0f;
+
+		const float root_area { m_nodes[ 0 ].bounds().halfArea() };
+		if ( root_area <= 0.0f ) return 0.0f;
+
+		float cost { 0.0f };
+
+		for ( const Node& node : m_nodes )
+		{
+			const float area { node.bounds().halfArea() };
+
+			if ( node.isLeaf() )
+				cost += static_cast< float >( node.m_count ) * area;
+			else
+				cost += SAH_TRAVERSAL_COST * area;
+		}
+
+		return cost / root_area;
+	}
+
+	std::optional< BoundingVolumeHierarchy::RayHit > BoundingVolumeHierarchy::raycast(
+		const glm::vec3& origin, const glm::vec3& direction, const float max_distance ) const
+	{
+		ZoneScoped;
+
+		if ( m_nodes.empty() ) return std::nullopt;
+
+		const glm::vec3 inverse_direction { 1.0f / direction };
+
+		std::optional< RayHit > closest { std::nullopt };
+		float closest_distance { max_distance };
+
+		struct Pending
+		{
+			std::uint32_t m_node;
+			float m_distance;
+		};
+
+		// Only the far child is pushed, So there is at most one entry per level of the tree
+		std::array< Pending, MAX_DEPTH + 1 > stack;
+		std::size_t stack_size { 0 };
+
+		const Node& root { m_nodes[ 0 ] };
+		if ( intersectRay( root.m_min, root.m_max, origin, inverse_direction, closest_distance ) == NO_HIT )
+			return std::nullopt;
+
+		std::uint32_t node_index { 0 };
+
+		while ( true )
+		{
+			const Node& node { m_nodes[ node_index ] };
+
+			if ( node.isLeaf() )
+			{
+				for ( std::uint32_t i = node.m_offset; i < node.m_offset + node.m_count; ++i )
+				{
+					const ItemIndex item { m_items[ i ] };
+					const BVHBounds& bounds { m_bounds[ item ] };
+
+					const float distance {
+						intersectRay( bounds.m_min, bounds.m_max, origin, inverse_direction, closest_distance )
+					};
+
+					if ( distance == NO_HIT || ( closest && distance >= closest->m_distance ) ) continue;
+
+					closest = RayHit { item, distance };
+					closest_distance = distance;
+				}
+			}
+			else
+			{
+				std::uint32_t near_child { node.m_offset };
+				std::uint32_t far_child { node.m_offset + 1 };
+
+				float near_distance { intersectRay(
+					m_nodes[ near_child ].m_min,
+					m_nodes[ near_child ].m_max,
+					origin,
+					inverse_direction,
+					closest_distance ) };
+				float far_distance { intersectRay(
+					m_nodes[ far_child ].m_min,
+					m_nodes[ far_child ].m_max,
+					origin,
+					inverse_direction,
+					closest_distance ) };
+
+				if ( far_distance < near_distance )
+				{
+					std::swap( near_child, far_child );
+					std::swap( near_distance, far_distance );
+				}
+
+				if ( near_distance != NO_HIT )
+				{
+					if ( far_distance != NO_HIT )
+					{
+						FGL_ASSERT( stack_size < stack.size(), "Bounding volume hierarchy is deeper than MAX_DEPTH" );
+						stack[ stack_size++ ] = { far_child, far_distance };
+					}
+
+					node_index = near_child;
+					continue;
+				}
+			}
+
+			// Skip anything that is further away than the closest hit found since it was pushed
+			while ( stack_size > 0 && stack[ stack_size - 1 ].m_distance > closest_distance ) --stack_size;
+
+			if ( stack_size == 0 ) break;
+
+			node_index = stack[ --stack_size ].m_node;
+		}
+
+		return closest;
+	}
+
+	void BoundingVolumeHierarchy::raycastAll(
+		const glm::vec3& origin,
+		const glm::vec3& direction,
+		const float max_distance,
+		std::vector< RayHit >& out_hits ) const
+	{
+		ZoneScoped;
+
+		if ( m_nodes.empty() ) return;
+
+		const glm::vec3 inverse_direction { 1.0f / direction };
+
+		std::array< std::uint32_t, MAX_DEPTH + 1 > stack;
+		std::size_t stack_size { 0 };
+		stack[ stack_size++ ] = 0;
+
+		while ( stack_size > 0 )
+		{
+			const Node& node { m_nodes[ stack[ --stack_size ] ] };
+
+			if ( intersectRay( node.m_min, node.m_max, origin, inverse_direction, max_distance ) == NO_HIT ) continue;
+
+			if ( node.isLeaf() )
+			{
+				for ( std::uint32_t i = node.m_offset; i < node.m_offset + node.m_count; ++i )
+				{
+					const BVHBounds& bounds { m_bounds[ m_items[ i ] ] };
+					const float distance {
+						intersectRay( bounds.m_min, bounds.m_max, origin, inverse_direction, max_distance )
+					};
+
+					if ( distance != NO_HIT ) out_hits.push_back( { m_items[ i ], distance } );
+				}
+
+				continue;
+			}
+
+			FGL_ASSERT( stack_size + 2 <= stack.size(), "Bounding volume hierarchy is deeper than MAX_DEPTH" );
+			stack[ stack_size++ ] = node.m_offset + 1;
+			stack[ stack_size++ ] = node.m_offset;
+		}
+	}
+
+	void BoundingVolumeHierarchy::
+		query( const std::array< glm::vec4, 6 >& planes, std::vector< ItemIndex >& out_items ) const
+	{
+		ZoneScoped;
+
+		if ( m_nodes.empty() ) return;
+
+		struct Pending
+		{
+			std::uint32_t m_node;
+			//! The node is entirely inside, So nothing below it needs to be tested
+			bool m_inside;
+		};
+
+		std::array< Pending, MAX_DEPTH + 1 > stack;
+		std::size_t stack_size { 0 };
+		stack[ stack_size++ ] = { 0, false };
+
+		while ( stack_size > 0 )
+		{
+			const Pending pending { stack[ --stack_size ] };
+			const Node& node { m_nodes[ pending.m_node ] };
+
+			bool inside { pending.m_inside };
+
+			if ( !inside )
+			{
+				const Containment containment { classify( node.m_min, node.m_max, planes ) };
+				if ( containment == Containment::Outside ) continue;
+				inside = containment == Containment::Inside;
+			}
+
+			if ( node.isLeaf() )
+			{
+				for ( std::uint32_t i = node.m_offset; i < node.m_offset + node.m_count; ++i )
+				{
+					const ItemIndex item { m_items[ i ] };
+
+					if ( inside
+					     || classify( m_bounds[ item ].m_min, m_bounds[ item ].m_max, planes ) != Containment::Outside )
+						out_items.emplace_back( item );
+				}
+
+				continue;
+			}
+
+			FGL_ASSERT( stack_size + 2 <= stack.size(), "Bounding volume hierarchy is deeper than MAX_DEPTH" );
+			stack[ stack_size++ ] = { node.m_offset + 1, inside };
+			stack[ stack_size++ ] = { node.m_offset, inside };
+		}
+	}
+
+	void BoundingVolumeHierarchy::query( const BVHBounds& bounds, std::vector< ItemIndex >& out_items ) const
+	{
+		ZoneScoped;
+
+		if ( m_nodes.empty() ) return;
+
+		std::array< std::uint32_t, MAX_DEPTH + 1 > stack;
+		std::size_t stack_size { 0 };
+		stack[ stack_size++ ] = 0;
+
+		while ( stack_size > 0 )
+		{
+			const Node& node { m_nodes[ stack[ --stack_size ] ] };
+
+			if ( !bounds.overlaps( node.bounds() ) ) continue;
+
+			if ( node.isLeaf() )
+			{
+				for ( std::uint32_t i = node.m_offset; i < node.m_offset + node.m_count; ++i )
+					if ( bounds.overlaps( m_bounds[ m_items[ i ] ] ) ) out_items.emplace_back( m_items[ i ] );
+
+				continue;
+			}
+
+			FGL_ASSERT( stack_size + 2 <= stack.size(), "Bounding volume hierarchy is deeper than MAX_DEPTH" );
+			stack[ stack_size++ ] = node.m_offset + 1;
+			stack[ stack_size++ ] = node.m_offset;
+		}
+	}
+
+	void BVHUpdateTarget::update( const glm::mat4& matrix ) const
+	{
+		if ( const auto hierarchy = m_hierarchy.lock() )
+			hierarchy->update( m_item, transformBounds( m_local_bounds, matrix ) );
+	}
+
+} // namespace fgl::engine
@@ -0,0 +1,187 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Weffc++"
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#pragma GCC diagnostic pop
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace fgl::engine
+{
+
+	//! Axis aligned bounds stored as plain vectors, So the nodes of the hierarchy stay small
+	struct BVHBounds
+	{
+		glm::vec3 m_min { std::numeric_limits< float >::max() };
+		glm::vec3 m_max { std::numeric_limits< float >::lowest() };
+
+		//! False until something has been added to the bounds
+		bool valid() const { return m_min.x <= m_max.x && m_min.y <= m_max.y && m_min.z <= m_max.z; }
+
+		void grow( const glm::vec3& point );
+		void grow( const BVHBounds& other );
+
+		glm::vec3 center() const { return ( m_min + m_max ) * 0.5f; }
+
+		glm::vec3 extent() const { return ( m_max - m_min ) * 0.5f; }
+
+		//! Half the surface area of the bounds, Which is all the SAH needs
+		float halfArea() const;
+
+		bool overlaps( const BVHBounds& other ) const;
+
+		bool operator==( const BVHBounds& other ) const = default;
+	};
+
+	//! Bounds of the box after it is transformed by the matrix
+	BVHBounds transformBounds( const BVHBounds& bounds, const glm::mat4& matrix );
+
+	/**
+	 * @brief Flattened bounding volume hierarchy over axis aligned bounds, Built with the surface area heuristic
+	 * @details Items are identified by their index in the span given to build(). Each node is 32 bytes, And siblings
+	 * are stored next to each other so the traversal reads both children from one cache line.
+	 * Moved items are refit with update() and refit(), Which keeps the topology. Rebuild once the tree has degraded
+	 */
+	class BoundingVolumeHierarchy
+	{
+	  public:
+
+		using ItemIndex = std::uint32_t;
+
+		struct Node
+		{
+			glm::vec3 m_min;
+			//! Leaves: first item in m_items. Interior nodes: index of the first child, The second child follows it
+			std::uint32_t m_offset;
+			glm::vec3 m_max;
+			//! Items in the leaf, 0 for interior nodes
+			std::uint32_t m_count;
+
+			bool isLeaf() const { return m_count != 0; }
+
+			BVHBounds bounds() const { return { m_min, m_max }; }
+		};
+
+		static_assert( sizeof( Node ) == 32 );
+
+		struct RayHit
+		{
+			ItemIndex m_item;
+			//! Distance along the ray to where it enters the item's bounds. 0 if the ray starts inside of them
+			float m_distance;
+		};
+
+		//! Most items a leaf is allowed to have when the SAH would rather not split it
+		static constexpr std::uint32_t MAX_LEAF_SIZE { 4 };
+
+		//! Number of bins the centroids are sorted into along each axis when searching for the best split
+		static constexpr std::uint32_t SAH_BINS { 16 };
+
+		//! Depth after which nodes are split at the median instead, Bounding the depth of the tree
+		static constexpr std::uint32_t MAX_SAH_DEPTH { 64 };
+
+		//! Deepest a tree can be, Used to size the traversal stacks
+		static constexpr std::uint32_t MAX_DEPTH { MAX_SAH_DEPTH + 32 };
+
+	  private:
+
+		static constexpr std::uint32_t INVALID_NODE { std::numeric_limits< std::uint32_t >::max() };
+
+		std::vector< Node > m_nodes {};
+		//! Items in the order the leaves reference them
+		std::vector< ItemIndex > m_items {};
+
+		//! Current bounds of every item
+		std::vector< BVHBounds > m_bounds {};
+		//! Leaf containing each item
+		std::vector< std::uint32_t > m_item_leaf {};
+		//! Parent of each node, INVALID_NODE for the root
+		std::vector< std::uint32_t > m_parents {};
+
+		//! Leaves with an item that was moved since the last refit
+		std::vector< std::uint32_t > m_dirty_leaves {};
+		std::vector< bool > m_leaf_dirty {};
+
+		//! Recomputes the bounds of a node from it's items or children. Returns false if they did not change
+		bool refitNode( std::uint32_t node_index );
+
+	  public:
+
+		BoundingVolumeHierarchy() = default;
+
+		explicit BoundingVolumeHierarchy( std::span< const BVHBounds > bounds ) { build( bounds ); }
+
+		//! Rebuilds the hierarchy over the bounds. Items without valid bounds are never returned by any query
+		void build( std::span< const BVHBounds > bounds );
+
+		//! Moves an item. The hierarchy is not updated until refit() is called
+		void update( ItemIndex item, const BVHBounds& bounds );
+
+		//! Grows and shrinks the nodes above every item moved since the last refit
+		void refit();
+
+		//! True if items have been moved since the last refit
+		bool needsRefit() const { return !m_dirty_leaves.empty(); }
+
+		std::size_t size() const { return m_bounds.size(); }
+
+		bool empty() const { return m_bounds.empty(); }
+
+		std::size_t nodeCount() const { return m_nodes.size(); }
+
+		const BVHBounds& bounds( const ItemIndex item ) const { return m_bounds[ item ]; }
+
+		//! Bounds of every item in the hierarchy
+		BVHBounds rootBounds() const;
+
+		//! Expected cost of a ray query relative to testing a single item, See the SAH. Lower is better
+		float sahCost() const;
+
+		//! Closest item who's bounds are hit by the ray within max_distance. The direction need not be normalized
+		std::optional< RayHit > raycast(
+			const glm::vec3& origin,
+			const glm::vec3& direction,
+			float max_distance = std::numeric_limits< float >::infinity() ) const;
+
+		//! Appends every item who's bounds are hit by the ray within max_distance, Unordered
+		void raycastAll(
+			const glm::vec3& origin,
+			const glm::vec3& direction,
+			float max_distance,
+			std::vector< RayHit >& out_hits ) const;
+
+		//! Appends every item who's bounds are at least partially inside of every plane (xyz normal, w distance)
+		void query( const std::array< glm::vec4, 6 >& planes, std::vector< ItemIndex >& out_items ) const;
+
+		//! Appends every item who's bounds overlap the given bounds
+		void query( const BVHBounds& bounds, std::vector< ItemIndex >& out_items ) const;
+	};
+
+	//! Registered with a TransformComponent, Moves the item in the hierarchy when the transform is updated
+	struct BVHUpdateTarget
+	{
+		std::weak_ptr< BoundingVolumeHierarchy > m_hierarchy;
+		BoundingVolumeHierarchy::ItemIndex m_item;
+		//! Bounds of the item before it is transformed
+		BVHBounds m_local_bounds;
+
+		//! Moves the item to it's local bounds transformed by the matrix, If the hierarchy still exists
+		void update( const glm::mat4& matrix ) const;
+
+		bool expired() const { return m_hierarchy.expired(); }
+	};
+
+} // namespace fgl::engine
@@ -4,8 +4,15 @@
 
 #include "raycast.hpp"
 
+#include "engine/primitives/boxes/AxisAlignedBoundingBox.hpp"
 #include "engine/primitives/vectors/Vector.hpp"
 
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Weffc++"
+#include <glm/common.hpp>
+#include <glm/matrix.hpp>
+#pragma GCC diagnostic pop
+
 namespace fgl::engine
 {
 	Ray constructRay( const WorldCoordinate& start, const WorldCoordinate& end )
@@ -14,16 +21,38 @@ namespace fgl::engine
 		return ray;
 	}
 
-	bool rayHit( [[maybe_unused]] const Ray& ray, [[maybe_unused]] const OrientedBoundingBox< CS::World >& obb )
+	//! Slab test of a ray against the box between min and max
+	static bool slabTest( const glm::vec3 start, const glm::vec3 direction, const glm::vec3 min, const glm::vec3 max )
+	{
+		const glm::vec3 inverse_direction { 1.0f / direction };
+
+		const glm::vec3 t0 { ( min - start ) * inverse_direction };
+		const glm::vec3 t1 { ( max - start ) * inverse_direction };
+
+		const glm::vec3 near { glm::min( t0, t1 ) };
+		const glm::vec3 far { glm::max( t0, t1 ) };
+
+		const float enter { std::max( std::max( near.x, near.y ), std::max( near.z, 0.0f ) ) };
+		const float exit { std::min( std::min( far.x, far.y ), far.z ) };
+
+		return enter <= exit;
+	}
+
+	bool rayHit( const Ray& ray, const OrientedBoundingBox< CS::World >& obb )
 	{
-		//TODO: Implement raycasts
-		FGL_TODO();
-		return false;
+		// The box is the unit cube transformed by it's matrix, So the ray is moved into the space of the cube instead
+		const glm::mat4 inverse { glm::inverse( obb.getMatrix() ) };
+
+		const glm::vec3 start { inverse * glm::vec4( ray.m_start.vec(), 1.0f ) };
+		const glm::vec3 direction { inverse * glm::vec4( ray.m_vector.vec(), 0.0f ) };
+
+		return slabTest( start, direction, glm::vec3( -1.0f ), glm::vec3( 1.0f ) );
 	}
 
-	bool rayHit( [[maybe_unused]] const Ray& ray, [[maybe_unused]] const AxisAlignedBoundingBox< CS::World >& aabb )
+	bool rayHit( const Ray& ray, const AxisAlignedBoundingBox< CS::World >& aabb )
 	{
-		FGL_TODO();
+		return slabTest(
+			ray.m_start.vec(), ray.m_vector.vec(), aabb.bottomLeftBack().vec(), aabb.topLeftForward().vec() );
 	}
 
 } // namespace fgl::engine
\ No newline at end of file
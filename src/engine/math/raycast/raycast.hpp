@@ -9,8 +9,6 @@
 
 namespace fgl::engine
 {
-	class OctTreeNode;
-
 	struct Ray
 	{
 		WorldCoordinate m_start;
@@ -19,8 +17,9 @@ namespace fgl::engine
 
 	Ray constructRay( const WorldCoordinate& start, const WorldCoordinate& end );
 
-	bool rayHit( const Ray& ray, const OrientedBoundingBox< CS::World >& obb, OctTreeNode* root );
+	//! Returns true if the ray hits the box anywhere in front of it's start. See GameObjectBVH::raycast to find objects
+	bool rayHit( const Ray& ray, const OrientedBoundingBox< CS::World >& obb );
 
-	bool rayHit( const Ray& ray, const AxisAlignedBoundingBox< CS::World >& aabb, OctTreeNode* root );
+	bool rayHit( const Ray& ray, const AxisAlignedBoundingBox< CS::World >& aabb );
 
 } // namespace fgl::engine
@@ -0,0 +1,39 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "DefferedCleanup.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "engine/constants.hpp"
+
+namespace fgl::engine::memory
+{
+	inline static std::vector< std::pair< std::uint_fast8_t, std::shared_ptr< void > > > DEFERRED_QUEUE {};
+
+	void deferredDelete( std::shared_ptr< void > item )
+	{
+		DEFERRED_QUEUE.emplace_back( 0, std::move( item ) );
+	}
+
+	void processDeferredDeletes()
+	{
+		// Prevent deleting an item until we are sure it's been here long enough
+		std::erase_if(
+			DEFERRED_QUEUE,
+			[]( auto& pair ) -> bool
+			{
+				auto& [ counter, item ] = pair;
+				return counter++ > constants::MAX_FRAMES_IN_FLIGHT + 1;
+			} );
+	}
+
+	void clearDeferredDeletes()
+	{
+		DEFERRED_QUEUE.clear();
+	}
+
+} // namespace fgl::engine::memory
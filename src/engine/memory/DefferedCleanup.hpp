@@ -3,9 +3,18 @@
 //
 #pragma once
 
+#include <memory>
+
 namespace fgl::engine::memory
 {
 
-	void deferredDelete( auto&& item ) {}
+	//! Holds onto an item until any frames in flight that could be using it have finished
+	void deferredDelete( std::shared_ptr< void > item );
+
+	//! Ticks the deferred items, Deleting any that have been held long enough. Should be called once per frame
+	void processDeferredDeletes();
+
+	//! Deletes all deferred items immediately. The device should be idle before calling this
+	void clearDeferredDeletes();
 
-}
+} // namespace fgl::engine::memory
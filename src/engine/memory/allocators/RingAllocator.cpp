@@ -0,0 +1,66 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "RingAllocator.hpp"
+
+namespace fgl::engine::memory
+{
+
+	RingAllocator::RingAllocator( const Size capacity ) : m_capacity( capacity )
+	{}
+
+	std::optional< RingAllocator::Allocation > RingAllocator::allocate( const Size size, const Size alignment )
+	{
+		if ( size == 0 || size > m_capacity ) return std::nullopt;
+
+		Marker head { m_head.load( std::memory_order_acquire ) };
+
+		while ( true )
+		{
+			const Offset physical { head % m_capacity };
+
+			Offset aligned { physical };
+			if ( alignment > 1 && aligned % alignment != 0 ) aligned += alignment - ( aligned % alignment );
+
+			Marker start { head + ( aligned - physical ) };
+
+			// Skip the remainder of the ring instead of wrapping the allocation
+			if ( aligned + size > m_capacity )
+			{
+				start = head + ( m_capacity - physical );
+				aligned = 0;
+			}
+
+			const Marker end { start + size };
+
+			// Not enough space has been retired yet
+			if ( end - m_tail.load( std::memory_order_acquire ) > m_capacity ) return std::nullopt;
+
+			if ( m_head.compare_exchange_weak( head, end, std::memory_order_acq_rel, std::memory_order_acquire ) )
+				return Allocation { aligned, start };
+		}
+	}
+
+	void RingAllocator::retire( const Marker marker )
+	{
+		Marker tail { m_tail.load( std::memory_order_acquire ) };
+
+		// The tail only moves forward
+		while ( tail < marker
+		        && !m_tail.compare_exchange_weak( tail, marker, std::memory_order_acq_rel, std::memory_order_acquire ) )
+		{}
+	}
+
+	void RingAllocator::rewind()
+	{
+		m_head.store( 0, std::memory_order_release );
+		m_tail.store( 0, std::memory_order_release );
+	}
+
+	RingAllocator::Size RingAllocator::used() const
+	{
+		return m_head.load( std::memory_order_acquire ) - m_tail.load( std::memory_order_acquire );
+	}
+
+} // namespace fgl::engine::memory
@@ -0,0 +1,79 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+namespace fgl::engine::memory
+{
+
+	/**
+	 * @brief Lock-free linear (ring) allocator for offsets within a range.
+	 *
+	 * Allocations are never freed individually. Instead the owner takes a marker with `mark()` when submitting work
+	 * that uses everything allocated so far, and passes it to `retire()` once that work has completed (fence signaled).
+	 *
+	 * Allocations never wrap around the end of the range. If an allocation would wrap then the remaining space at the end
+	 * is skipped and the allocation starts at offset 0.
+	 *
+	 * @note allocate() can be called from any thread. mark() and retire() are expected to be called from the thread that submits.
+	 */
+	class RingAllocator
+	{
+	  public:
+
+		using Offset = std::uint64_t;
+		using Size = std::uint64_t;
+		using Marker = std::uint64_t;
+
+		struct Allocation
+		{
+			Offset m_offset;
+
+			//! Marker taken just before this allocation. Retiring up to this marker will keep this allocation alive
+			Marker m_marker;
+		};
+
+	  private:
+
+		Size m_capacity;
+
+		//! Total number of bytes ever reserved (Including skipped bytes when wrapping)
+		std::atomic< Marker > m_head { 0 };
+
+		//! Total number of bytes ever retired
+		std::atomic< Marker > m_tail { 0 };
+
+	  public:
+
+		explicit RingAllocator( Size capacity );
+
+		RingAllocator( const RingAllocator& ) = delete;
+		RingAllocator& operator=( const RingAllocator& ) = delete;
+
+		/**
+		 * @brief Reserves `size` bytes with the offset aligned to `alignment`.
+		 * @return The allocation, or std::nullopt if the ring does not have enough retired space.
+		 */
+		std::optional< Allocation > allocate( Size size, Size alignment = 1 );
+
+		//! Returns a marker covering every allocation made so far.
+		Marker mark() const { return m_head.load( std::memory_order_acquire ); }
+
+		//! Releases every allocation made before the marker was taken.
+		void retire( Marker marker );
+
+		//! Moves the head back to the start of the range. Nothing can be in use, And older markers become invalid.
+		void rewind();
+
+		Size capacity() const { return m_capacity; }
+
+		//! Number of bytes that are reserved and not yet retired
+		Size used() const;
+	};
+
+} // namespace fgl::engine::memory
@@ -0,0 +1,426 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "TLSFAllocator.hpp"
+
+#include <bit>
+#include <format>
+#include <stdexcept>
+
+namespace fgl::engine::memory
+{
+
+	TLSFAllocator::Bucket TLSFAllocator::mappingInsert( const Size size )
+	{
+		// Small sizes are all placed linearly in the first bucket
+		if ( size < SL_COUNT ) return { 0, static_cast< std::uint32_t >( size ) };
+
+		const auto msb { static_cast< std::uint32_t >( std::bit_width( size ) - 1 ) };
+		const auto sl { static_cast< std::uint32_t >( size >> ( msb - SL_BITS ) ) - SL_COUNT };
+
+		return { msb - SL_BITS + 1, sl };
+	}
+
+	TLSFAllocator::Bucket TLSFAllocator::mappingSearch( const Size size )
+	{
+		if ( size < SL_COUNT ) return mappingInsert( size );
+
+		// Round up to the next bucket so that any block in the bucket is guaranteed to fit
+		const auto msb { static_cast< std::uint32_t >( std::bit_width( size ) - 1 ) };
+		const Size round { ( Size( 1 ) << ( msb - SL_BITS ) ) - 1 };
+
+		if ( size > std::numeric_limits< Size >::max() - round ) return mappingInsert( size );
+
+		return mappingInsert( size + round );
+	}
+
+	TLSFAllocator::BlockIndex TLSFAllocator::createBlock()
+	{
+		if ( !m_unused_blocks.empty() )
+		{
+			const auto index { m_unused_blocks.back() };
+			m_unused_blocks.pop_back();
+			m_blocks[ index ] = Block {};
+			return index;
+		}
+
+		m_blocks.emplace_back();
+		return static_cast< BlockIndex >( m_blocks.size() - 1 );
+	}
+
+	void TLSFAllocator::releaseBlock( const BlockIndex index )
+	{
+		m_blocks[ index ] = Block {};
+		m_unused_blocks.push_back( index );
+	}
+
+	void TLSFAllocator::insertFree( const BlockIndex index )
+	{
+		Block& block { m_blocks[ index ] };
+		const auto [ fl, sl ] = mappingInsert( block.m_size );
+
+		const BlockIndex head { m_heads[ fl ][ sl ] };
+
+		block.m_free = true;
+		block.m_prev_free = INVALID_BLOCK;
+		block.m_next_free = head;
+
+		if ( head != INVALID_BLOCK ) m_blocks[ head ].m_prev_free = index;
+
+		m_heads[ fl ][ sl ] = index;
+		m_sl_bitmap[ fl ] |= ( 1u << sl );
+		m_fl_bitmap |= ( std::uint64_t( 1 ) << fl );
+	}
+
+	void TLSFAllocator::removeFree( const BlockIndex index )
+	{
+		Block& block { m_blocks[ index ] };
+		const auto [ fl, sl ] = mappingInsert( block.m_size );
+
+		if ( block.m_prev_free != INVALID_BLOCK ) m_blocks[ block.m_prev_free ].m_next_free = block.m_next_free;
+		if ( block.m_next_free != INVALID_BLOCK ) m_blocks[ block.m_next_free ].m_prev_free = block.m_prev_free;
+
+		if ( m_heads[ fl ][ sl ] == index )
+		{
+			m_heads[ fl ][ sl ] = block.m_next_free;
+
+			if ( block.m_next_free == INVALID_BLOCK )
+			{
+				m_sl_bitmap[ fl ] &= ~( 1u << sl );
+				if ( m_sl_bitmap[ fl ] == 0 ) m_fl_bitmap &= ~( std::uint64_t( 1 ) << fl );
+			}
+		}
+
+		block.m_free = false;
+		block.m_prev_free = INVALID_BLOCK;
+		block.m_next_free = INVALID_BLOCK;
+	}
+
+	std::optional< TLSFAllocator::Bucket > TLSFAllocator::findBucket( const Bucket bucket ) const
+	{
+		if ( bucket.m_fl >= FL_COUNT ) return std::nullopt;
+
+		// Anything in this first level at or above the second level?
+		const std::uint32_t sl_map { m_sl_bitmap[ bucket.m_fl ] & ( ~0u << bucket.m_sl ) };
+
+		if ( sl_map != 0 ) return Bucket { bucket.m_fl, static_cast< std::uint32_t >( std::countr_zero( sl_map ) ) };
+
+		if ( bucket.m_fl + 1 >= FL_COUNT ) return std::nullopt;
+
+		// Otherwise take the smallest bucket in any larger first level
+		const std::uint64_t fl_map { m_fl_bitmap & ( ~std::uint64_t( 0 ) << ( bucket.m_fl + 1 ) ) };
+
+		if ( fl_map == 0 ) return std::nullopt;
+
+		const auto fl { static_cast< std::uint32_t >( std::countr_zero( fl_map ) ) };
+		const auto sl { static_cast< std::uint32_t >( std::countr_zero( m_sl_bitmap[ fl ] ) ) };
+
+		return Bucket { fl, sl };
+	}
+
+	bool TLSFAllocator::fits( const Block& block, const Size size, const Size alignment ) const
+	{
+		Offset aligned_offset { block.m_offset };
+		if ( alignment > 1 && aligned_offset % alignment != 0 )
+			aligned_offset += alignment - ( aligned_offset % alignment );
+
+		const Size padding { aligned_offset - block.m_offset };
+
+		return block.m_size >= padding && block.m_size - padding >= size;
+	}
+
+	TLSFAllocator::BlockIndex TLSFAllocator::
+		scanBucket( const Bucket bucket, const Size size, const Size alignment ) const
+	{
+		if ( bucket.m_fl >= FL_COUNT ) return INVALID_BLOCK;
+
+		for ( BlockIndex index = m_heads[ bucket.m_fl ][ bucket.m_sl ]; index != INVALID_BLOCK;
+		      index = m_blocks[ index ].m_next_free )
+		{
+			if ( fits( m_blocks[ index ], size, alignment ) ) return index;
+		}
+
+		return INVALID_BLOCK;
+	}
+
+	TLSFAllocator::BlockIndex TLSFAllocator::findBlock( const Size size, const Size alignment ) const
+	{
+		if ( size == 0 || size > m_capacity ) return INVALID_BLOCK;
+
+		// Most blocks are already aligned, So try to find a block without accounting for padding first.
+		if ( const auto bucket = findBucket( mappingSearch( size ) ) )
+		{
+			const BlockIndex head { m_heads[ bucket->m_fl ][ bucket->m_sl ] };
+			if ( fits( m_blocks[ head ], size, alignment ) ) return head;
+		}
+
+		// Last resort. Blocks in the bucket the size maps to are not guaranteed to fit, But might.
+		if ( alignment <= 1 ) return scanBucket( mappingInsert( size ), size, alignment );
+
+		// Any block that is at least size + alignment - 1 is guaranteed to fit after alignment
+		const Size padded_size { size + alignment - 1 };
+
+		if ( const auto bucket = findBucket( mappingSearch( padded_size ) ) )
+		{
+			return m_heads[ bucket->m_fl ][ bucket->m_sl ];
+		}
+
+		return scanBucket( mappingInsert( padded_size ), size, alignment );
+	}
+
+	TLSFAllocator::BlockIndex TLSFAllocator::splitFront( const BlockIndex index, const Size front_size )
+	{
+		const BlockIndex back_index { createBlock() };
+
+		// createBlock can resize m_blocks, So references must be taken after it
+		Block& front { m_blocks[ index ] };
+		Block& back { m_blocks[ back_index ] };
+
+		back.m_offset = front.m_offset + front_size;
+		back.m_size = front.m_size - front_size;
+		back.m_prev_phys = index;
+		back.m_next_phys = front.m_next_phys;
+
+		if ( front.m_next_phys != INVALID_BLOCK ) m_blocks[ front.m_next_phys ].m_prev_phys = back_index;
+
+		front.m_size = front_size;
+		front.m_next_phys = back_index;
+
+		// The front block is padding, and is free.
+		insertFree( index );
+
+		return back_index;
+	}
+
+	void TLSFAllocator::splitBack( const BlockIndex index, const Size size )
+	{
+		const BlockIndex back_index { createBlock() };
+
+		Block& front { m_blocks[ index ] };
+		Block& back { m_blocks[ back_index ] };
+
+		back.m_offset = front.m_offset + size;
+		back.m_size = front.m_size - size;
+		back.m_prev_phys = index;
+		back.m_next_phys = front.m_next_phys;
+
+		if ( front.m_next_phys != INVALID_BLOCK ) m_blocks[ front.m_next_phys ].m_prev_phys = back_index;
+
+		front.m_size = size;
+		front.m_next_phys = back_index;
+
+		insertFree( back_index );
+	}
+
+	TLSFAllocator::TLSFAllocator( const Size capacity ) : m_capacity( capacity )
+	{
+		for ( auto& fl : m_heads ) fl.fill( INVALID_BLOCK );
+
+		if ( capacity == 0 ) return;
+
+		const BlockIndex index { createBlock() };
+		m_blocks[ index ].m_offset = 0;
+		m_blocks[ index ].m_size = capacity;
+
+		insertFree( index );
+	}
+
+	TLSFAllocator::Offset TLSFAllocator::takeBlock( BlockIndex index, const Size size, const Size alignment )
+	{
+		removeFree( index );
+
+		const Offset offset { m_blocks[ index ].m_offset };
+		Offset aligned_offset { offset };
+		if ( alignment > 1 && aligned_offset % alignment != 0 )
+			aligned_offset += alignment - ( aligned_offset % alignment );
+
+		// Since all free blocks are merged with their neighbours the previous block must be in use,
+		// so the padding can be returned to the free lists as it's own block.
+		if ( aligned_offset != offset ) index = splitFront( index, aligned_offset - offset );
+
+		if ( m_blocks[ index ].m_size > size ) splitBack( index, size );
+
+		m_used += size;
+		m_allocated.emplace( aligned_offset, index );
+
+		return aligned_offset;
+	}
+
+	std::optional< TLSFAllocator::Offset > TLSFAllocator::allocate( const Size size, const Size alignment )
+	{
+		const BlockIndex index { findBlock( size, alignment ) };
+
+		if ( index == INVALID_BLOCK ) return std::nullopt;
+
+		return takeBlock( index, size, alignment );
+	}
+
+	std::optional< TLSFAllocator::Offset > TLSFAllocator::
+		allocateBefore( const Size size, const Size alignment, const Offset limit )
+	{
+		if ( size == 0 || size > m_capacity ) return std::nullopt;
+
+		// This walks every free block that could fit, Which is slower then allocate() but finds the lowest offset.
+		BlockIndex best { INVALID_BLOCK };
+
+		for ( std::uint32_t fl = mappingInsert( size ).m_fl; fl < FL_COUNT; ++fl )
+		{
+			if ( ( m_fl_bitmap & ( std::uint64_t( 1 ) << fl ) ) == 0 ) continue;
+
+			for ( std::uint32_t sl = 0; sl < SL_COUNT; ++sl )
+			{
+				for ( BlockIndex index = m_heads[ fl ][ sl ]; index != INVALID_BLOCK;
+				      index = m_blocks[ index ].m_next_free )
+				{
+					const Block& block { m_blocks[ index ] };
+
+					if ( block.m_offset + size > limit ) continue;
+					if ( best != INVALID_BLOCK && m_blocks[ best ].m_offset < block.m_offset ) continue;
+					if ( !fits( block, size, alignment ) ) continue;
+
+					best = index;
+				}
+			}
+		}
+
+		if ( best == INVALID_BLOCK ) return std::nullopt;
+
+		const Offset offset { takeBlock( best, size, alignment ) };
+
+		// Alignment padding could have pushed the allocation past the limit.
+		if ( offset + size > limit )
+		{
+			free( offset );
+			return std::nullopt;
+		}
+
+		return offset;
+	}
+
+	bool TLSFAllocator::canAllocate( const Size size, const Size alignment ) const
+	{
+		return findBlock( size, alignment ) != INVALID_BLOCK;
+	}
+
+	void TLSFAllocator::free( const Offset offset )
+	{
+		const auto itter { m_allocated.find( offset ) };
+
+		if ( itter == m_allocated.end() )
+			throw std::runtime_error( std::format( "No allocation was found at offset {}", offset ) );
+
+		BlockIndex index { itter->second };
+		m_allocated.erase( itter );
+
+		m_used -= m_blocks[ index ].m_size;
+
+		// Merge with the previous block
+		if ( const BlockIndex prev = m_blocks[ index ].m_prev_phys; prev != INVALID_BLOCK && m_blocks[ prev ].m_free )
+		{
+			removeFree( prev );
+
+			Block& prev_block { m_blocks[ prev ] };
+			const Block& block { m_blocks[ index ] };
+
+			prev_block.m_size += block.m_size;
+			prev_block.m_next_phys = block.m_next_phys;
+			if ( block.m_next_phys != INVALID_BLOCK ) m_blocks[ block.m_next_phys ].m_prev_phys = prev;
+
+			releaseBlock( index );
+			index = prev;
+		}
+
+		// Merge with the next block
+		if ( const BlockIndex next = m_blocks[ index ].m_next_phys; next != INVALID_BLOCK && m_blocks[ next ].m_free )
+		{
+			removeFree( next );
+
+			Block& block { m_blocks[ index ] };
+			const Block& next_block { m_blocks[ next ] };
+
+			block.m_size += next_block.m_size;
+			block.m_next_phys = next_block.m_next_phys;
+			if ( next_block.m_next_phys != INVALID_BLOCK ) m_blocks[ next_block.m_next_phys ].m_prev_phys = index;
+
+			releaseBlock( next );
+		}
+
+		insertFree( index );
+	}
+
+	TLSFAllocator::Size TLSFAllocator::allocationSize( const Offset offset ) const
+	{
+		const auto itter { m_allocated.find( offset ) };
+
+		if ( itter == m_allocated.end() ) return 0;
+
+		return m_blocks[ itter->second ].m_size;
+	}
+
+	TLSFAllocator::Size TLSFAllocator::largestBlock() const
+	{
+		if ( m_fl_bitmap == 0 ) return 0;
+
+		// The largest block has to be in the highest non-empty bucket, Which is only a handful of blocks to check.
+		const auto fl { static_cast< std::uint32_t >( 63 - std::countl_zero( m_fl_bitmap ) ) };
+		const auto sl { static_cast< std::uint32_t >( 31 - std::countl_zero( m_sl_bitmap[ fl ] ) ) };
+
+		Size largest { 0 };
+
+		for ( BlockIndex index = m_heads[ fl ][ sl ]; index != INVALID_BLOCK; index = m_blocks[ index ].m_next_free )
+		{
+			largest = std::max( largest, m_blocks[ index ].m_size );
+		}
+
+		return largest;
+	}
+
+	std::size_t TLSFAllocator::freeBlockCount() const
+	{
+		return m_blocks.size() - m_unused_blocks.size() - m_allocated.size();
+	}
+
+	void TLSFAllocator::validate() const
+	{
+		Size sum { 0 };
+		Size used { 0 };
+		Offset expected_offset { 0 };
+
+		// Walk the physical chain starting at the block at offset 0
+		BlockIndex index { INVALID_BLOCK };
+		for ( BlockIndex i = 0; i < m_blocks.size(); ++i )
+		{
+			if ( m_blocks[ i ].m_size != 0 && m_blocks[ i ].m_prev_phys == INVALID_BLOCK )
+			{
+				index = i;
+				break;
+			}
+		}
+
+		for ( ; index != INVALID_BLOCK; index = m_blocks[ index ].m_next_phys )
+		{
+			const Block& block { m_blocks[ index ] };
+
+			if ( block.m_offset != expected_offset )
+				throw std::runtime_error(
+					std::format( "Block gap found! Expected offset {} was {}", expected_offset, block.m_offset ) );
+
+			if ( block.m_free && block.m_next_phys != INVALID_BLOCK && m_blocks[ block.m_next_phys ].m_free )
+				throw std::runtime_error( std::format( "Unmerged free blocks at offset {}", block.m_offset ) );
+
+			if ( !block.m_free ) used += block.m_size;
+
+			sum += block.m_size;
+			expected_offset += block.m_size;
+		}
+
+		if ( sum != m_capacity )
+			throw std::runtime_error(
+				std::format( "Memory leaked! Expected {} was {}: Lost {}", m_capacity, sum, m_capacity - sum ) );
+
+		if ( used != m_used )
+			throw std::runtime_error( std::format( "Used memory mismatch! Expected {} was {}", m_used, used ) );
+	}
+
+} // namespace fgl::engine::memory
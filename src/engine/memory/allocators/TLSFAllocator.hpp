@@ -0,0 +1,156 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace fgl::engine::memory
+{
+
+	/**
+	 * @brief Two level segregated fit (TLSF) allocator for offsets within a linear range.
+	 *
+	 * This allocator does not own any memory. It only hands out offsets into a range of `capacity` bytes,
+	 * which lets BufferHandle use it for suballocating from a single vk::Buffer.
+	 *
+	 * Free blocks are binned into a first level (power of two) and second level (linear subdivision of that power)
+	 * bucket. Both levels have a bitmap, so finding a suitable block is a pair of bit scans.
+	 * Blocks keep links to their physical neighbours, so freeing and merging is O(1).
+	 *
+	 * @note Alignments do not need to be a power of two (vertex strides are commonly used as alignments)
+	 */
+	class TLSFAllocator
+	{
+	  public:
+
+		using Offset = std::uint64_t;
+		using Size = std::uint64_t;
+
+	  private:
+
+		using BlockIndex = std::uint32_t;
+		static constexpr BlockIndex INVALID_BLOCK { std::numeric_limits< BlockIndex >::max() };
+
+		//! Log2 of the number of second level buckets per first level bucket
+		static constexpr std::uint32_t SL_BITS { 5 };
+		static constexpr std::uint32_t SL_COUNT { 1 << SL_BITS };
+		static constexpr std::uint32_t FL_COUNT { 64 - SL_BITS + 1 };
+
+		struct Block
+		{
+			Offset m_offset { 0 };
+			Size m_size { 0 };
+
+			//! Physically adjacent blocks
+			BlockIndex m_prev_phys { INVALID_BLOCK };
+			BlockIndex m_next_phys { INVALID_BLOCK };
+
+			//! Blocks within the same free bucket
+			BlockIndex m_prev_free { INVALID_BLOCK };
+			BlockIndex m_next_free { INVALID_BLOCK };
+
+			bool m_free { false };
+		};
+
+		struct Bucket
+		{
+			std::uint32_t m_fl;
+			std::uint32_t m_sl;
+		};
+
+		Size m_capacity;
+		Size m_used { 0 };
+
+		//! Storage for all block metadata. Unused entries are chained through m_unused_blocks.
+		std::vector< Block > m_blocks {};
+		std::vector< BlockIndex > m_unused_blocks {};
+
+		//! Maps the offset of an allocated block to it's metadata
+		std::unordered_map< Offset, BlockIndex > m_allocated {};
+
+		std::uint64_t m_fl_bitmap { 0 };
+		std::array< std::uint32_t, FL_COUNT > m_sl_bitmap {};
+		std::array< std::array< BlockIndex, SL_COUNT >, FL_COUNT > m_heads {};
+
+		//! Returns the bucket that a block of this size belongs in
+		static Bucket mappingInsert( Size size );
+
+		//! Returns the first bucket where every block is guaranteed to be at least `size`
+		static Bucket mappingSearch( Size size );
+
+		BlockIndex createBlock();
+		void releaseBlock( BlockIndex index );
+
+		void insertFree( BlockIndex index );
+		void removeFree( BlockIndex index );
+
+		//! Finds a non-empty bucket at or above the given bucket
+		std::optional< Bucket > findBucket( Bucket bucket ) const;
+
+		//! Returns true if the block can fit `size` after it's offset is aligned to `alignment`
+		bool fits( const Block& block, Size size, Size alignment ) const;
+
+		//! Walks a single bucket for the first block that fits
+		BlockIndex scanBucket( Bucket bucket, Size size, Size alignment ) const;
+
+		BlockIndex findBlock( Size size, Size alignment ) const;
+
+		//! Splits the front of a block off into a new free block. Returns the remaining (back) block.
+		BlockIndex splitFront( BlockIndex index, Size front_size );
+
+		//! Splits the back of a block into a new free block.
+		void splitBack( BlockIndex index, Size size );
+
+		//! Removes a block from the free lists and trims it down to an aligned block of `size`
+		Offset takeBlock( BlockIndex index, Size size, Size alignment );
+
+	  public:
+
+		explicit TLSFAllocator( Size capacity );
+
+		/**
+		 * @brief Allocates `size` bytes with the offset aligned to `alignment`
+		 * @return The offset of the allocation or std::nullopt if no free block was found
+		 */
+		std::optional< Offset > allocate( Size size, Size alignment = 1 );
+
+		/**
+		 * @brief Allocates `size` bytes using the lowest free block that ends at or before `limit`
+		 * @note This is O(n) over the free blocks and is intended for defragmentation, Not general allocation.
+		 */
+		std::optional< Offset > allocateBefore( Size size, Size alignment, Offset limit );
+
+		//! Returns true if a call to allocate with the same arguments would succeed.
+		bool canAllocate( Size size, Size alignment = 1 ) const;
+
+		//! Frees an allocation previously given by allocate()
+		void free( Offset offset );
+
+		//! Size of the allocation at the given offset
+		Size allocationSize( Offset offset ) const;
+
+		Size capacity() const { return m_capacity; }
+
+		Size used() const { return m_used; }
+
+		//! Size of the largest free block (Before any alignment)
+		Size largestBlock() const;
+
+		//! Number of live allocations
+		std::size_t allocationCount() const { return m_allocated.size(); }
+
+		//! Number of free blocks
+		std::size_t freeBlockCount() const;
+
+		//! Checks that all blocks are accounted for. Throws if any memory has been lost
+		void validate() const;
+	};
+
+} // namespace fgl::engine::memory
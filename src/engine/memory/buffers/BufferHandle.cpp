@@ -32,7 +32,10 @@ namespace fgl::engine::memory
 		std::swap( m_debug_name, other.m_debug_name );
 		std::swap( m_active_suballocations, other.m_active_suballocations );
 		std::swap( m_allocation_traces, other.m_allocation_traces );
-		std::swap( m_free_blocks, other.m_free_blocks );
+		std::swap( m_allocator, other.m_allocator );
+		std::swap( m_defragment_candidates, other.m_defragment_candidates );
+		std::swap( m_defragment_sweep_moved, other.m_defragment_sweep_moved );
+		std::swap( m_defragment_stalled, other.m_defragment_stalled );
 	}
 
 	BufferHandle::BufferHandle(
@@ -41,15 +44,14 @@ namespace fgl::engine::memory
 		const vk::MemoryPropertyFlags memory_properties ) :
 	  m_memory_size( memory_size ),
 	  m_usage( usage ),
-	  m_memory_properties( memory_properties )
+	  m_memory_properties( memory_properties ),
+	  m_allocator( memory_size )
 	{
 		auto [ buffer, vma_alloc_info, vma_allocation ] = allocBuffer( memory_size, m_usage, m_memory_properties );
 
 		m_buffer = buffer;
 		m_alloc_info = vma_alloc_info;
 		m_allocation = vma_allocation;
-
-		m_free_blocks.emplace_back( 0, memory_size );
 	}
 
 	BufferHandle::~BufferHandle()
@@ -170,24 +172,6 @@ namespace fgl::engine::memory
 		return size;
 	}
 
-	decltype( BufferHandle::m_free_blocks )::iterator BufferHandle::
-		findAvailableBlock( vk::DeviceSize memory_size, std::uint32_t t_alignment )
-	{
-		//Find a free space.
-		return std::ranges::find_if(
-			m_free_blocks,
-			[ this, memory_size, t_alignment ]( const std::pair< vk::DeviceSize, vk::DeviceSize >& pair )
-			{
-				const auto [ offset, size ] = pair;
-
-				const auto new_offset = align( offset, alignment(), t_alignment );
-				const auto after_size { size - ( new_offset - offset ) };
-
-				// If the size of the block after alignment is greater than or equal to the size of the memory we want to allocate using it.
-				return after_size >= memory_size;
-			} );
-	}
-
 	BufferSuballocation Buffer::allocate( const vk::DeviceSize desired_size, const std::uint32_t alignment )
 	{
 		auto allocation { operator->()->allocate( desired_size, alignment ) };
@@ -248,64 +232,6 @@ namespace fgl::engine::memory
 		return new_handle;
 	}
 
-	/*
-	void BufferHandle::resize( const vk::DeviceSize new_size )
-	{
-		log::warn( "Resizing buffer from {} to {}", size(), new_size );
-
-		std::shared_ptr< BufferHandle > new_handle { new BufferHandle( new_size, m_usage, m_memory_properties ) };
-
-		//Now we need to re-create all the current live allocations and transfer/replace them using the new buffer
-		std::vector<
-			std::pair< std::shared_ptr< BufferSuballocationHandle >, std::shared_ptr< BufferSuballocationHandle > > >
-			allocations {};
-
-		allocations.reserve( m_active_suballocations.size() );
-
-		for ( auto& suballocation_weak : m_active_suballocations )
-		{
-			if ( suballocation_weak.expired() ) continue;
-			try
-			{
-				auto suballocation { suballocation_weak.lock() };
-
-				auto new_suballocation { new_handle->allocate( suballocation->m_size, suballocation->m_alignment ) };
-				allocations.emplace_back( suballocation, new_suballocation );
-			}
-			catch ( std::bad_weak_ptr& e )
-			{
-				// noop
-				void();
-			}
-		}
-
-		std::swap( m_buffer, new_handle->m_buffer );
-		std::swap( m_alloc_info, new_handle->m_alloc_info );
-		std::swap( m_allocation, new_handle->m_allocation );
-		std::swap( m_free_blocks, new_handle->m_free_blocks );
-		std::swap( m_active_suballocations, new_handle->m_active_suballocations );
-		std::swap( m_allocation_traces, new_handle->m_allocation_traces );
-
-		// This transforms any memory::Buffer to be the `new_handle` we allocated above.
-		const auto old_handle { new_handle };
-		FGL_ASSERT( old_handle.get() != this, "Old handle should not be the current buffer anymore!" );
-		new_handle = this->shared_from_this();
-
-		for ( auto& [ old_allocation, new_allocation ] : allocations )
-		{
-			old_allocation->m_parent_buffer = old_handle;
-			new_allocation->m_parent_buffer = new_handle;
-		}
-
-		//Now we need to transfer the data from the old buffer to the new buffer
-		for ( const auto& allocation : allocations )
-		{
-			const auto& [ old_suballocation, new_suballocation ] = allocation;
-			TransferManager::getInstance().copySuballocationRegion( old_suballocation, new_suballocation );
-		}
-	}
-	*/
-
 	std::shared_ptr< BufferSuballocationHandle > BufferHandle::
 		allocate( vk::DeviceSize desired_memory_size, const vk::DeviceSize t_alignment )
 	{
@@ -313,61 +239,32 @@ namespace fgl::engine::memory
 		//Calculate alignment from alignment, ubo_alignment, and atom_size_alignment
 		desired_memory_size = align( desired_memory_size, alignment() );
 
-		if ( !canAllocate( desired_memory_size, t_alignment ) )
-		{
-			return { nullptr };
-		}
-
-		auto itter { findAvailableBlock( desired_memory_size, t_alignment ) };
+		const auto offset { m_allocator.allocate( desired_memory_size, combineAlignment( alignment(), t_alignment ) ) };
 
-		if ( itter == m_free_blocks.end() )
+		if ( !offset.has_value() )
 		{
 			// Could not find a block that is available.
 			return { nullptr };
 		}
 
-		auto [ selected_block_offset, selected_block_size ] = *itter;
-		m_free_blocks.erase( itter );
+		m_defragment_stalled = false;
 
-		assert( selected_block_offset <= this->size() );
-		assert( selected_block_size <= this->size() );
-
-		const auto aligned_offset { align( selected_block_offset, alignment(), t_alignment ) };
-		FGL_ASSERT( aligned_offset % combineAlignment( alignment(), t_alignment ) == 0, "Alignment failed!" );
-
-		//Fix the offset and size if they aren't alligned
-		if ( aligned_offset != selected_block_offset )
-		{
-			//Insert the space left over before the block starts back into the free blocks
-			const std::size_t leftover_start_size { aligned_offset - selected_block_offset };
-
-			m_free_blocks.emplace_back( selected_block_offset, leftover_start_size );
-
-			mergeFreeBlocks();
+		return createSuballocation( *offset, desired_memory_size, t_alignment );
+	}
 
-			selected_block_offset = aligned_offset;
-			assert( selected_block_size >= leftover_start_size );
-			selected_block_size -= leftover_start_size;
-		}
+	std::shared_ptr< BufferSuballocationHandle > BufferHandle::createSuballocation(
+		const vk::DeviceSize selected_block_offset,
+		const vk::DeviceSize desired_memory_size,
+		const vk::DeviceSize t_alignment )
+	{
+		assert( selected_block_offset + desired_memory_size <= this->size() );
+		FGL_ASSERT( selected_block_offset % combineAlignment( alignment(), t_alignment ) == 0, "Alignment failed!" );
 
-		// Add the suballocation
-		// m_allocations.insert_or_assign( selected_block_offset, desired_memory_size );
 		m_allocation_traces.insert_or_assign( selected_block_offset, std::stacktrace::current() );
 
-		assert( selected_block_size >= desired_memory_size );
-
-		assert( selected_block_size <= this->size() );
-
-		//If there is any memory left over, Then add it back into the free blocks
-		if ( ( selected_block_size >= desired_memory_size ) && ( selected_block_size - desired_memory_size > 0 ) )
-		{
-			assert( selected_block_size - desired_memory_size <= this->size() );
-			m_free_blocks
-				.emplace_back( selected_block_offset + desired_memory_size, selected_block_size - desired_memory_size );
-		}
-
-		std::ranges::
-			remove_if( m_active_suballocations, []( auto& suballocation ) -> bool { return suballocation.expired(); } );
+		// Pruning expired handles is O(n), So only do it once the list has grown well past the live allocation count
+		if ( m_active_suballocations.size() > ( m_allocator.allocationCount() * 2 ) + 64 )
+			std::erase_if( m_active_suballocations, []( auto& suballocation ) -> bool { return suballocation.expired(); } );
 
 		auto suballocation_handle { std::make_shared< BufferSuballocationHandle >(
 			Buffer( this->shared_from_this() ), selected_block_offset, desired_memory_size, t_alignment ) };
@@ -377,63 +274,10 @@ namespace fgl::engine::memory
 		return suballocation_handle;
 	}
 
-	bool BufferHandle::canAllocate( const vk::DeviceSize memory_size, const vk::DeviceSize alignment )
-	{
-		// TODO: This check can be optimized by itterating through and virtually combining blocks that would be combined.
-		// If the combined block is large enough then we should consider it being capable of allocation.
-		// We don't need to care if a block later in the chain is large enough since the allocation would first
-		// check blocks that are already large enough before trying to combine them.
-		if ( findAvailableBlock( memory_size, alignment ) == m_free_blocks.end() )
-		{
-			mergeFreeBlocks();
-			return findAvailableBlock( memory_size, alignment ) != m_free_blocks.end();
-		}
-
-		return true;
-	}
-
-	void BufferHandle::mergeFreeBlocks()
+	bool BufferHandle::canAllocate( const vk::DeviceSize memory_size, const vk::DeviceSize t_alignment ) const
 	{
-		ZoneScoped;
-		//Can't combine blocks if there is only 1
-		if ( m_free_blocks.size() <= 1 ) return;
-
-		//Sort the blocks by offset
-		std::ranges::
-			sort( m_free_blocks, []( const auto& a, const auto& b ) noexcept -> bool { return a.first < b.first; } );
-
-		auto itter { m_free_blocks.begin() };
-		auto next_block { std::next( itter ) };
-
-		// Search through all free blocks
-		while ( next_block != m_free_blocks.end() && itter != m_free_blocks.end() )
-		{
-			//Is the next block adjacent to the current block?
-			auto& [ offset, size ] = *itter;
-			const auto& [ next_offset, next_size ] = *next_block;
-
-			// Is the next block ajacent to us?
-			const bool is_adjacent { offset + size == next_offset };
-
-			if ( is_adjacent )
-			{
-				//Combine the blocks
-				size += next_size;
-				//Remove the next block
-				m_free_blocks.erase( next_block );
-
-				//Reset the next block
-				next_block = std::next( itter );
-				continue;
-			}
-			else
-			{
-				//Move to the next block
-				itter = next_block;
-				next_block = std::next( itter );
-				continue;
-			}
-		}
+		return m_allocator
+		    .canAllocate( align( memory_size, alignment() ), combineAlignment( alignment(), t_alignment ) );
 	}
 
 	void BufferHandle::setDebugName( const std::string& str )
@@ -463,54 +307,100 @@ namespace fgl::engine::memory
 					info.offset() + info.size(),
 					size() ) );
 
-		//Add the block back to the free blocks
-		m_free_blocks.emplace_back( info.offset(), info.size() );
+		m_allocator.free( info.offset() );
+		m_defragment_stalled = false;
 
-		mergeFreeBlocks();
+		m_allocation_traces.erase( info.offset() );
 
 #ifndef NDEBUG
 		//Check that we haven't lost any memory
-		std::size_t sum { 0 };
-		for ( const auto& size : this->m_free_blocks | std::views::values )
-		{
-			sum += size;
-		}
-
-		for ( auto& suballocation : m_active_suballocations )
-		{
-			if ( suballocation.expired() ) continue;
-			sum += suballocation.lock()->size();
-		}
-
-		if ( sum != this->size() )
-			throw std::runtime_error(
-				std::format( "Memory leaked! Expected {} was {}: Lost {}", this->size(), sum, this->size() - sum ) );
+		m_allocator.validate();
 #endif
 	}
 
 	vk::DeviceSize BufferHandle::used() const
 	{
-		vk::DeviceSize total_size { 0 };
+		return m_allocator.used();
+	}
 
-		for ( auto& suballocation : m_active_suballocations )
-		{
-			if ( suballocation.expired() ) continue;
-			total_size += suballocation.lock()->size();
-		}
+	vk::DeviceSize BufferHandle::largestBlock() const
+	{
+		return m_allocator.largestBlock();
+	}
 
-		return total_size;
+	float BufferHandle::fragmentation() const
+	{
+		const vk::DeviceSize free_size { m_allocator.capacity() - m_allocator.used() };
+
+		if ( free_size == 0 ) return 0.0f;
+
+		return 1.0f - ( static_cast< float >( largestBlock() ) / static_cast< float >( free_size ) );
 	}
 
-	vk::DeviceSize BufferHandle::largestBlock() const
+	vk::DeviceSize BufferHandle::defragment( const vk::DeviceSize byte_budget )
 	{
-		vk::DeviceSize largest { 0 };
+		ZoneScoped;
+
+		if ( m_defragment_stalled ) return 0;
 
-		for ( const auto& size : m_free_blocks | std::views::values )
+		if ( m_defragment_candidates.empty() )
 		{
-			largest = std::max( largest, size );
+			// Start a new sweep. The list is only sorted once per sweep, Not every call
+			std::vector< std::shared_ptr< BufferSuballocationHandle > > sweep {};
+			sweep.reserve( m_active_suballocations.size() );
+
+			for ( const auto& suballocation_weak : m_active_suballocations )
+			{
+				auto suballocation { suballocation_weak.lock() };
+				if ( suballocation && suballocation->relocatable() ) sweep.emplace_back( std::move( suballocation ) );
+			}
+
+			// Move the furthest suballocations first, Into the lowest free blocks
+			std::ranges::sort( sweep, []( const auto& a, const auto& b ) { return a->offset() < b->offset(); } );
+
+			m_defragment_candidates.assign( sweep.begin(), sweep.end() );
+			m_defragment_sweep_moved = 0;
 		}
 
-		return largest;
+		vk::DeviceSize moved { 0 };
+
+		for ( std::size_t tried = 0; tried < DEFRAGMENT_CANDIDATE_BUDGET && !m_defragment_candidates.empty(); ++tried )
+		{
+			if ( moved >= byte_budget ) break;
+
+			const auto suballocation { m_defragment_candidates.back().lock() };
+			m_defragment_candidates.pop_back();
+
+			if ( !suballocation ) continue;
+
+			// Only move suballocations that know how to be moved, have valid data, and are not already moving
+			if ( !suballocation->relocatable() || !suballocation->ready() || suballocation->reallocated() ) continue;
+
+			const auto offset { m_allocator.allocateBefore(
+				suballocation->size(),
+				combineAlignment( alignment(), suballocation->alignment() ),
+				suballocation->offset() ) };
+
+			if ( !offset.has_value() ) continue;
+
+			auto target { createSuballocation( *offset, suballocation->size(), suballocation->alignment() ) };
+
+			// The suballocation adopts the target's offset once the copy has been submitted.
+			TransferManager::getInstance().copySuballocationRegion( suballocation, target );
+			suballocation->flagReallocated( target );
+
+			moved += suballocation->size();
+		}
+
+		m_defragment_sweep_moved += moved;
+
+		if ( m_defragment_candidates.empty() && m_defragment_sweep_moved == 0 ) m_defragment_stalled = true;
+
+		if ( moved > 0 )
+			log::debug(
+				"Defragmenting {}: Relocating {}", m_debug_name, literals::size_literals::toString( moved ) );
+
+		return moved;
 	}
 
 } // namespace fgl::engine::memory
@@ -16,6 +16,7 @@
 
 #include "FGL_DEFINES.hpp"
 #include "engine/debug/Track.hpp"
+#include "engine/memory/allocators/TLSFAllocator.hpp"
 #include "math/literals/size.hpp"
 #include "vma/vma_impl.hpp"
 
@@ -41,8 +42,18 @@ namespace fgl::engine::memory
 		eFailedOOM
 	};
 
+	using namespace literals::size_literals;
+
+	//! Fragmentation ratio (See BufferHandle::fragmentation) above which a buffer should be defragmented
+	constexpr float DEFRAGMENT_THRESHOLD { 0.25f };
+
+	//! Maximum number of bytes to relocate per frame when defragmenting
+	constexpr vk::DeviceSize DEFRAGMENT_BYTE_BUDGET { 8_MiB };
+
+	//! Maximum number of suballocations to try and move per frame when defragmenting
+	constexpr std::size_t DEFRAGMENT_CANDIDATE_BUDGET { 64 };
+
 	//TODO: Dynamic/onDemand resizing of Buffer for suballocations
-	//TODO: Defragmentation
 
 	//TODO: Ensure this class can't be directly accessed from within Buffer unless we are trying
 	// to access it in a debug manner (IE the drawStats menu)
@@ -66,10 +77,17 @@ namespace fgl::engine::memory
 		//! <offset, size>
 		using AllocationSize = vk::DeviceSize;
 
-		//! @brief list of any free blocks
-		//! @note All blocks are amalgamated to the largest they can expand to.
-		//! <offset, size>
-		std::vector< std::pair< vk::DeviceSize, vk::DeviceSize > > m_free_blocks {};
+		//! @brief Tracks the free and used regions of this buffer
+		TLSFAllocator m_allocator;
+
+		//! Suballocations left to try in the current defragmentation sweep, Sorted so the furthest is at the back
+		std::vector< std::weak_ptr< BufferSuballocationHandle > > m_defragment_candidates {};
+
+		//! Bytes moved so far in the current defragmentation sweep
+		vk::DeviceSize m_defragment_sweep_moved { 0 };
+
+		//! Set when a full sweep moved nothing. Nothing can move until something is allocated or freed
+		bool m_defragment_stalled { false };
 
 	  public:
 
@@ -104,6 +122,20 @@ namespace fgl::engine::memory
 
 		vk::DeviceSize used() const;
 
+		//! Ratio of free memory that is not part of the largest free block. 0.0 is no fragmentation
+		float fragmentation() const;
+
+		/**
+		 * @brief Moves relocatable suballocations towards the front of the buffer
+		 * @param byte_budget Maximum number of bytes to move in this pass
+		 * @return Number of bytes queued for relocation
+		 * @details Each call continues a sweep over the suballocations from the back of the buffer, Trying at most
+		 * DEFRAGMENT_CANDIDATE_BUDGET of them. If a whole sweep moves nothing, Calls return immediately until the next
+		 * allocate or free.
+		 * @note Only suballocations with a relocation callback are moved. See BufferSuballocationHandle::setRelocationCallback
+		 */
+		vk::DeviceSize defragment( vk::DeviceSize byte_budget );
+
 	  public:
 
 		//! Returns the vulkan buffer handle for this buffer
@@ -133,7 +165,6 @@ namespace fgl::engine::memory
 
 		friend class Buffer;
 		std::shared_ptr< BufferHandle > remake( vk::DeviceSize new_size );
-		// void resize( vk::DeviceSize new_size );
 
 	  public:
 
@@ -154,13 +185,11 @@ namespace fgl::engine::memory
 		std::shared_ptr< BufferSuballocationHandle >
 			allocate( vk::DeviceSize desired_memory_size, vk::DeviceSize t_alignment );
 
-		bool canAllocate( vk::DeviceSize memory_size, vk::DeviceSize alignment = 1 );
+		bool canAllocate( vk::DeviceSize memory_size, vk::DeviceSize alignment = 1 ) const;
 
 		//! Frees a given suballocation. After calling this, the handle is invalid and accessing it is UB
 		void free( BufferSuballocationHandle& info );
 
-		void mergeFreeBlocks();
-
 		void setDebugName( const std::string& str );
 
 	  private:
@@ -170,7 +199,8 @@ namespace fgl::engine::memory
 		//! Returns the required alignment for this buffer.
 		vk::DeviceSize alignment() const;
 
-		decltype( m_free_blocks )::iterator findAvailableBlock( vk::DeviceSize memory_size, std::uint32_t t_alignment );
+		std::shared_ptr< BufferSuballocationHandle >
+			createSuballocation( vk::DeviceSize offset, vk::DeviceSize memory_size, vk::DeviceSize t_alignment );
 	};
 
 	class Buffer final : public std::shared_ptr< BufferHandle >
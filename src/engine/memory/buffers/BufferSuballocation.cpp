@@ -14,7 +14,6 @@ namespace fgl::engine::memory
 
 	BufferSuballocation::BufferSuballocation( std::shared_ptr< BufferSuballocationHandle > handle ) :
 	  m_handle( std::move( handle ) ),
-	  m_offset( m_handle->m_offset ),
 	  m_byte_size( m_handle->m_size )
 	{
 		if ( handle.use_count() > 30 ) throw std::runtime_error( "AAAAAAAAA" );
@@ -24,10 +23,8 @@ namespace fgl::engine::memory
 	{
 		m_handle = std::move( other.m_handle );
 
-		m_offset = m_handle->m_offset;
 		m_byte_size = m_handle->m_size;
 
-		other.m_offset = 0;
 		other.m_byte_size = 0;
 
 		other.m_handle = nullptr;
@@ -37,10 +34,8 @@ namespace fgl::engine::memory
 
 	BufferSuballocation::BufferSuballocation( BufferSuballocation&& other ) noexcept :
 	  m_handle( std::move( other.m_handle ) ),
-	  m_offset( m_handle->m_offset ),
 	  m_byte_size( m_handle->m_size )
 	{
-		other.m_offset = 0;
 		other.m_byte_size = 0;
 
 		other.m_handle = nullptr;
@@ -62,7 +57,7 @@ namespace fgl::engine::memory
 
 		vk::MappedMemoryRange range {};
 		range.memory = m_handle->m_parent_buffer->getMemory();
-		range.offset = m_offset + beg;
+		range.offset = getOffset() + beg;
 
 		const vk::DeviceSize min_atom_size { Device::getInstance().m_properties.limits.nonCoherentAtomSize };
 		const vk::DeviceSize size { end - beg };
@@ -96,15 +91,14 @@ namespace fgl::engine::memory
 
 	vk::DescriptorBufferInfo BufferSuballocation::descriptorInfo( const std::size_t byte_offset ) const
 	{
-		assert( !std::isnan( m_offset ) );
 		assert( !std::isnan( m_byte_size ) );
 
 		FGL_ASSERT( byte_offset < m_byte_size, "Byte offset was greater then byte size!" );
 		FGL_ASSERT(
-			m_offset + byte_offset < this->getBuffer()->size(),
+			getOffset() + byte_offset < this->getBuffer()->size(),
 			"Byte offset + buffer offset was greater then parent buffer size" );
 
-		return { getVkBuffer(), m_offset + byte_offset, m_byte_size };
+		return { getVkBuffer(), getOffset() + byte_offset, m_byte_size };
 	}
 
 	BufferSuballocation::~BufferSuballocation() = default;
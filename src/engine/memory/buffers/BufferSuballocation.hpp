@@ -25,7 +25,6 @@ namespace fgl::engine::memory
 
 	  protected:
 
-		vk::DeviceSize m_offset;
 		vk::DeviceSize m_byte_size;
 
 		void flush( vk::DeviceSize beg, vk::DeviceSize end ) const;
@@ -64,7 +63,9 @@ namespace fgl::engine::memory
 
 		vk::Buffer getVkBuffer() const;
 
-		vk::DeviceSize getOffset() const noexcept { return m_offset; }
+		//! Offset of the suballocation within the buffer.
+		//! @note This is read from the handle, As relocatable suballocations can be moved by defragmentation
+		vk::DeviceSize getOffset() const noexcept { return m_handle->offset(); }
 
 		vk::DescriptorBufferInfo descriptorInfo( std::size_t byte_offset = 0 ) const;
 
@@ -8,6 +8,7 @@
 #include "BufferSuballocation.hpp"
 #include "assets/transfer/TransferManager.hpp"
 #include "engine/debug/logging/logging.hpp"
+#include "memory/DefferedCleanup.hpp"
 
 namespace fgl::engine::memory
 {
@@ -71,6 +72,33 @@ namespace fgl::engine::memory
 		return { old_allocation, new_allocation };
 	}
 
+	void BufferSuballocationHandle::commitRelocation()
+	{
+		if ( !m_reallocated || !m_reallocated_to ) return;
+
+		auto target { std::move( m_reallocated_to ) };
+		m_reallocated = false;
+		m_reallocated_to = nullptr;
+
+		// Reallocations across buffers (Buffer::resize) are not relocations
+		if ( target->m_parent_buffer.get() != m_parent_buffer.get() ) return;
+
+		// If something was written to us since the copy was queued, then the copy is stale. Keep the current region.
+		if ( !ready() )
+		{
+			deferredDelete( std::move( target ) );
+			return;
+		}
+
+		// Swap regions with the target. The target now owns our old region and will free it once it is no longer in use.
+		std::swap( m_offset, target->m_offset );
+		std::swap( m_ptr, target->m_ptr );
+
+		deferredDelete( std::move( target ) );
+
+		if ( m_relocation_callback ) m_relocation_callback();
+	}
+
 	void BufferSuballocationHandle::markSource( const std::shared_ptr< BufferSuballocationHandle >& source )
 	{
 		m_dependents.push_back( source );
@@ -6,6 +6,7 @@
 
 #include <vulkan/vulkan.hpp>
 
+#include <functional>
 #include <queue>
 
 #include "BufferHandle.hpp"
@@ -45,6 +46,10 @@ namespace fgl::engine::memory
 		bool m_staged { false };
 		std::vector< std::weak_ptr< BufferSuballocationHandle > > m_dependents {};
 
+		//! Called after the suballocation has been moved to a new offset within the same buffer.
+		//! Only suballocations with a callback will be moved by BufferHandle::defragment
+		std::function< void() > m_relocation_callback {};
+
 	  public:
 
 		BufferSuballocationHandle(
@@ -72,6 +77,18 @@ namespace fgl::engine::memory
 
 		bool reallocated() const { return m_reallocated; }
 
+		//! Marks this suballocation as safe to move within it's buffer. The callback is invoked once it has moved.
+		void setRelocationCallback( const std::function< void() >& callback ) { m_relocation_callback = callback; }
+
+		bool relocatable() const { return static_cast< bool >( m_relocation_callback ); }
+
+		/**
+		 * @brief Adopts the offset of the suballocation this was reallocated to.
+		 * @note Only valid once the data has been copied to the reallocation target, and only if the target is in the same buffer.
+		 * The previous region is held onto until any frames in flight are done with it.
+		 */
+		void commitRelocation();
+
 		std::shared_ptr< BufferSuballocationHandle > reallocatedTo() const { return m_reallocated_to; }
 
 		void markSource( const std::shared_ptr< BufferSuballocationHandle >& source );
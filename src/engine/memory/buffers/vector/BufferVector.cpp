@@ -20,12 +20,12 @@ namespace fgl::engine::memory
 	{
 		FGL_ASSERT( m_stride > 0, "Stride was not greater then zero" );
 		FGL_ASSERT(
-			m_offset % m_stride == 0,
+			getOffset() % m_stride == 0,
 			std::format(
 				"{} % {} != 0 (Was {}). The offset should be aligned with the stride",
-				m_offset,
+				getOffset(),
 				m_stride,
-				m_offset % m_stride ) );
+				getOffset() % m_stride ) );
 	}
 
 	//! Returns the offset count from the start of the buffer to the first element
@@ -35,9 +35,10 @@ namespace fgl::engine::memory
 		assert( !std::isnan( m_stride ) );
 		assert( m_capacity * m_stride == this->bytesize() );
 		FGL_ASSERT(
-			m_offset % m_stride == 0, std::format( "{} % {} != 0 (Was {})", m_offset, m_stride, m_offset % m_stride ) );
+			getOffset() % m_stride == 0,
+			std::format( "{} % {} != 0 (Was {})", getOffset(), m_stride, getOffset() % m_stride ) );
 
-		return static_cast< std::uint32_t >( this->m_offset / m_stride );
+		return static_cast< std::uint32_t >( this->getOffset() / m_stride );
 	}
 
 	[[nodiscard]] std::uint32_t BufferVector::stride() const noexcept
@@ -77,12 +78,31 @@ namespace fgl::engine::memory
 		// the capacity is not enough for the new size, we must reallocate.
 		if ( count > capacity() )
 		{
-			BufferVector other { this->getBuffer(), count, m_stride };
+			// Grow geometrically, Otherwise adding items one at a time would copy the entire vector every time
+			reallocate( std::max( count, capacity() * CAPACITY_GROWTH_FACTOR ) );
+		}
 
-			TransferManager::getInstance().copyToVector( *this, other, 0 );
+		this->m_count = count;
+	}
 
-			*this = std::move( other );
-		}
+	void BufferVector::reserve( const std::uint32_t count )
+	{
+		if ( count > capacity() ) reallocate( count );
+	}
+
+	void BufferVector::reallocate( const std::uint32_t capacity )
+	{
+		assert( !std::isnan( m_stride ) );
+		assert( !std::isnan( m_count ) );
+		assert( capacity >= m_count );
+
+		const auto count { m_count };
+
+		BufferVector other { this->getBuffer(), capacity, m_stride };
+
+		TransferManager::getInstance().copyToVector( *this, other, 0 );
+
+		*this = std::move( other );
 
 		this->m_count = count;
 	}
@@ -11,6 +11,9 @@ namespace fgl::engine::memory
 	//! Number of spares to allocate when resizing beyond the current capacity + current spare
 	constexpr std::uint32_t SPARE_ALLOCATION_COUNT { 16 };
 
+	//! Factor the capacity is multiplied by when a resize exceeds it
+	constexpr std::uint32_t CAPACITY_GROWTH_FACTOR { 2 };
+
 	class BufferVector : public BufferSuballocation
 	{
 	  protected:
@@ -29,6 +32,9 @@ namespace fgl::engine::memory
 
 		BufferVector( Buffer& buffer, std::uint32_t count, std::uint32_t stride );
 
+		//! Reallocates to exactly `capacity` elements, Copying the old contents over
+		void reallocate( std::uint32_t capacity );
+
 		BufferVector( const BufferVector& ) = delete;
 
 		BufferVector& operator=( const BufferVector& ) = delete;
@@ -43,9 +49,12 @@ namespace fgl::engine::memory
 		std::uint32_t stride() const noexcept;
 		std::uint32_t size() const noexcept;
 		std::uint32_t capacity() const noexcept;
+		//! Resizes the vector. If the capacity is exceeded it grows geometrically, To amortize the cost of reallocating
 		void resize( std::uint32_t count );
 		void resizeDiscard( std::uint32_t count );
-		// void reserve( std::uint32_t count );
+
+		//! Ensures the capacity is at least `count` without changing the size
+		void reserve( std::uint32_t count );
 	};
 
 } // namespace fgl::engine::memory
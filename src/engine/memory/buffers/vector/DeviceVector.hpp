@@ -41,6 +41,11 @@ namespace fgl::engine
 		 * @param data
 		 */
 		DeviceVector( memory::Buffer& buffer, const std::vector< T >& data ) :
+		  DeviceVector( buffer, std::span< const T >( data ) )
+		{}
+
+		//! Constructs a new DeviceVector from contiguous memory, Staging it without any intermediate copy
+		DeviceVector( memory::Buffer& buffer, const std::span< const T > data ) :
 		  DeviceVector( buffer, static_cast< std::uint32_t >( data.size() ) )
 		{
 			memory::TransferManager::getInstance().copyToVector< T, DeviceVector< T > >( data, *this );
@@ -3,6 +3,9 @@
 //
 #pragma once
 
+#include <queue>
+#include <span>
+
 #include "DeviceVector.hpp"
 #include "engine/debug/logging/logging.hpp"
 
@@ -13,13 +16,9 @@ namespace fgl::engine
 	{
 		std::queue< std::uint32_t > m_free_indexes {};
 
-		std::uint32_t acquireInternal( const T& t )
+		std::uint32_t acquireInternal()
 		{
-			if ( m_free_indexes.empty() )
-			{
-				this->resize( this->size() + 1 );
-				m_free_indexes.push( this->size() - 1 );
-			}
+			reserveFree( 1 );
 
 			const auto index { m_free_indexes.front() };
 			m_free_indexes.pop();
@@ -89,18 +88,41 @@ namespace fgl::engine
 
 		Index acquire( const T& t )
 		{
-			if ( m_free_indexes.empty() )
+			Index index { *this, acquireInternal() };
+
+			index.update( t );
+
+			return index;
+		}
+
+		//! Acquires an index for each item, Growing the vector at most once for the entire batch
+		std::vector< Index > acquire( const std::span< const T > items )
+		{
+			reserveFree( items.size() );
+
+			std::vector< Index > indexes {};
+			indexes.reserve( items.size() );
+
+			for ( const T& item : items )
 			{
-				this->resize( this->size() + 1 );
-				m_free_indexes.push( this->size() - 1 );
+				Index& index { indexes.emplace_back( Index( *this, acquireInternal() ) ) };
+				index.update( item );
 			}
 
-			Index index { *this, m_free_indexes.front() };
-			m_free_indexes.pop();
+			return indexes;
+		}
 
-			index.update( t );
+		//! Ensures there are at least `count` free indexes, Growing the vector at most once.
+		void reserveFree( const std::size_t count )
+		{
+			if ( m_free_indexes.size() >= count ) return;
 
-			return index;
+			const auto old_size { this->size() };
+			const auto required { static_cast< std::uint32_t >( count - m_free_indexes.size() ) };
+
+			this->resize( old_size + required );
+
+			for ( std::uint32_t i = old_size; i < this->size(); ++i ) m_free_indexes.push( i );
 		}
 
 		void release( Index&& index_i )
@@ -74,6 +74,20 @@ namespace fgl::engine
 		return false;
 	}
 
+	std::array< glm::vec4, 6 > Frustum::gpuPlanes() const
+	{
+		std::array< glm::vec4, 6 > planes {};
+		const std::array< const WorldPlane*, 6 > sources { &m_near, &m_far, &m_top, &m_bottom, &m_right, &m_left };
+
+		for ( std::size_t i = 0; i < sources.size(); ++i )
+		{
+			const auto simple { sources[ i ]->toSimple() };
+			planes[ i ] = glm::vec4( simple.getDirection().vec(), simple.distance() );
+		}
+
+		return planes;
+	}
+
 	std::array< Coordinate< CoordinateSpace::World >, 4 * 2 > Frustum::points() const
 	{
 		const NormalVector pv0 { glm::cross( m_top.getDirection().vec(), m_left.getDirection().vec() ) };
@@ -97,6 +97,9 @@ namespace fgl::engine
 		//! Used for bounding box tests
 		bool containsAnyPoint( const std::array< WorldCoordinate, interface::BoundingBox::POINT_COUNT >& coords ) const;
 
+		//! Planes packed for the GPU (xyz normal, w distance) in the order near, far, top, bottom, right, left.
+		std::array< glm::vec4, 6 > gpuPlanes() const;
+
 		std::array< WorldCoordinate, 4 * 2 > points() const;
 		std::array< LineSegment< CoordinateSpace::World >, ( ( 4 * 2 ) / 2 ) * 3 > lines() const;
 	};
@@ -40,8 +40,11 @@ namespace fgl::engine
 			                                       vk::Format::eD32SfloatS8Uint,
 			                                       vk::Format::eD24UnormS8Uint };
 
+		// Sampled by the Hi-Z pyramid build
 		return Device::getInstance().findSupportedFormat(
-			formats, vk::ImageTiling::eOptimal, vk::FormatFeatureFlagBits::eDepthStencilAttachment );
+			formats,
+			vk::ImageTiling::eOptimal,
+			vk::FormatFeatureFlagBits::eDepthStencilAttachment | vk::FormatFeatureFlagBits::eSampledImage );
 	}
 
 	vk::Format pickMetallicFormat()
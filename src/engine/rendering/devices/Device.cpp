@@ -52,6 +52,11 @@ namespace fgl::engine
 			throw std::runtime_error( "wideLines not supported by device" );
 		}
 
+		if ( available_features.fragmentStoresAndAtomics != VK_TRUE )
+		{
+			log::warn( "fragmentStoresAndAtomics not supported by device, Texture streaming will be disabled" );
+		}
+
 #ifndef NDEBUG
 		if ( available_features.robustBufferAccess != VK_TRUE )
 		{
@@ -66,6 +71,10 @@ namespace fgl::engine
 		deviceFeatures.tessellationShader = VK_TRUE;
 		deviceFeatures.drawIndirectFirstInstance = VK_TRUE;
 		deviceFeatures.wideLines = VK_TRUE;
+		// Optional, Textures are left uncompressed without it
+		deviceFeatures.textureCompressionBC = available_features.textureCompressionBC;
+		// Optional, Texture feedback is written from the fragment shader. Every mip level is kept resident without it
+		deviceFeatures.fragmentStoresAndAtomics = available_features.fragmentStoresAndAtomics;
 #ifndef NDEBUG
 		deviceFeatures.robustBufferAccess = VK_TRUE;
 #endif
@@ -119,26 +128,36 @@ namespace fgl::engine
 
 		m_create_info.setPEnabledFeatures( &m_requested_features );
 
-		m_create_info.setPEnabledExtensionNames( m_device_extensions );
-
 		//Get device extension list
 		const auto supported_extensions { physical_device.handle().enumerateDeviceExtensionProperties() };
-		std::cout << "Supported device extensions:" << std::endl;
-		for ( auto& desired_ext : m_device_extensions )
+
+		const auto isSupported = [ &supported_extensions ]( const char* desired_ext )
 		{
-			bool found { false };
 			for ( auto& supported_ext : supported_extensions )
 			{
-				if ( strcmp( desired_ext, supported_ext.extensionName ) == 0 )
-				{
-					found = true;
-					break;
-				}
+				if ( strcmp( desired_ext, supported_ext.extensionName ) == 0 ) return true;
 			}
+			return false;
+		};
+
+		std::cout << "Supported device extensions:" << std::endl;
+		for ( auto& desired_ext : m_device_extensions )
+		{
+			const bool found { isSupported( desired_ext ) };
 			std::cout << "\t" << desired_ext << ": " << found << std::endl;
 			if ( !found ) throw std::runtime_error( "Failed to find required extension" );
 		}
 
+		std::cout << "Optional device extensions:" << std::endl;
+		for ( auto& optional_ext : OPTIONAL_DEVICE_EXTENSIONS )
+		{
+			const bool found { isSupported( optional_ext ) };
+			std::cout << "\t" << optional_ext << ": " << found << std::endl;
+			if ( found ) m_enabled_extensions.emplace_back( optional_ext );
+		}
+
+		m_create_info.setPEnabledExtensionNames( m_enabled_extensions );
+
 		// might not really be necessary anymore because device specific validation layers
 		// have been deprecated
 		if ( true )
@@ -161,6 +180,16 @@ namespace fgl::engine
 		getCreateInfo( physical_device );
 	}
 
+	bool Device::DeviceCreateInfo::isExtensionEnabled( const char* extension ) const
+	{
+		for ( const auto& enabled_ext : m_enabled_extensions )
+		{
+			if ( strcmp( enabled_ext, extension ) == 0 ) return true;
+		}
+
+		return false;
+	}
+
 	vk::CommandPoolCreateInfo Device::commandPoolInfo()
 	{
 		vk::CommandPoolCreateInfo poolInfo = {};
@@ -207,6 +236,21 @@ namespace fgl::engine
 		}
 	}
 
+	bool Device::supportsDrawIndirectCount() const
+	{
+		return device_creation_info.isExtensionEnabled( VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME );
+	}
+
+	bool Device::supportsTextureCompressionBC() const
+	{
+		return device_creation_info.enabledFeatures().textureCompressionBC == VK_TRUE;
+	}
+
+	bool Device::supportsFragmentStoresAndAtomics() const
+	{
+		return device_creation_info.enabledFeatures().fragmentStoresAndAtomics == VK_TRUE;
+	}
+
 	bool Device::checkValidationLayerSupport()
 	{
 		std::vector< vk::LayerProperties > availableLayers { vk::enumerateInstanceLayerProperties() };
@@ -49,6 +49,9 @@ namespace fgl::engine
 			vk::PhysicalDeviceFeatures m_requested_features;
 			std::vector< vk::DeviceQueueCreateInfo > m_queue_create_infos;
 
+			//! Required extensions, Plus any optional extensions the device supports
+			std::vector< const char* > m_enabled_extensions { m_device_extensions };
+
 			using InfoChain = vk::StructureChain<
 				vk::DeviceCreateInfo,
 				vk::PhysicalDeviceDynamicRenderingFeatures,
@@ -66,6 +69,10 @@ namespace fgl::engine
 
 		  public:
 
+			bool isExtensionEnabled( const char* extension ) const;
+
+			const vk::PhysicalDeviceFeatures& enabledFeatures() const { return m_requested_features; }
+
 			vk::DeviceCreateInfo& m_create_info { m_info_chain.get< vk::DeviceCreateInfo >() };
 
 			vk::PhysicalDeviceDescriptorIndexingFeatures& m_indexing_features {
@@ -155,6 +162,15 @@ namespace fgl::engine
 
 		VmaAllocator allocator() { return m_allocator; }
 
+		//! True if vkCmdDrawIndexedIndirectCount can be used
+		bool supportsDrawIndirectCount() const;
+
+		//! True if BC1-BC7 compressed images can be sampled
+		bool supportsTextureCompressionBC() const;
+
+		//! True if fragment shaders can write to storage buffers and images
+		bool supportsFragmentStoresAndAtomics() const;
+
 		SwapChainSupportDetails getSwapChainSupport() { return querySwapChainSupport( m_physical_device ); }
 
 		uint32_t findMemoryType( uint32_t typeFilter, vk::MemoryPropertyFlags properties );
@@ -17,3 +17,8 @@ inline const static std::vector< const char* > DEVICE_EXTENSIONS = {
 	// VK_EXT_MESH_SHADER_EXTENSION_NAME, // MAGICAL SHIT
 	VK_KHR_DYNAMIC_RENDERING_LOCAL_READ_EXTENSION_NAME // Required until vulkan 1.4
 };
+
+// Extensions that are enabled only if the device supports them. Check Device before using anything from these
+inline const static std::vector< const char* > OPTIONAL_DEVICE_EXTENSIONS = {
+	VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME, // Used for drawing the compacted commands from the culling pass
+};
@@ -151,12 +151,19 @@ namespace fgl::engine
 		}
 
 		vk::RenderingAttachmentInfo renderInfo( const FrameIndex frame_index, const vk::ImageLayout layout ) const
+		{
+			return renderInfo( frame_index, layout, load_op );
+		}
+
+		//! Overrides the load op, Used when drawing into the attachment again within the same frame
+		vk::RenderingAttachmentInfo renderInfo(
+			const FrameIndex frame_index, const vk::ImageLayout layout, const vk::AttachmentLoadOp load ) const
 		{
 			vk::RenderingAttachmentInfo info {};
 
 			info.setClearValue( m_clear_value );
 			info.imageView = getView( frame_index ).getVkView();
-			info.loadOp = load_op;
+			info.loadOp = load;
 			info.storeOp = store_op;
 			info.imageLayout = layout;
 
@@ -263,6 +270,16 @@ namespace fgl::engine
 		vk::ImageLayout::eDepthStencilAttachmentOptimal,
 		vk::ImageUsageFlagBits::eDepthStencilAttachment >;
 
+	//! Depth that is kept after rendering, So it can be sampled (Hi-Z pyramid) or loaded again later in the frame
+	template < std::uint32_t Index >
+	using SampledDepthAttachment = Attachment<
+		Index,
+		vk::AttachmentLoadOp::eClear,
+		vk::AttachmentStoreOp::eStore,
+		vk::ImageLayout::eUndefined,
+		vk::ImageLayout::eDepthStencilAttachmentOptimal,
+		vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eSampled >;
+
 #if ENABLE_IMGUI
 	constexpr vk::ImageUsageFlags IMGUI_ATTACHMENT_FLAGS { vk::ImageUsageFlagBits::eSampled };
 #else
@@ -9,29 +9,250 @@
 #include "assets/model/Model.hpp"
 #include "engine/FrameInfo.hpp"
 #include "engine/camera/Camera.hpp"
+#include "engine/camera/GBufferSwapchain.hpp"
+#include "engine/debug/profiling/counters.hpp"
+#include "engine/descriptors/DescriptorSet.hpp"
+#include "engine/math/literals/size.hpp"
+#include "engine/rendering/devices/Device.hpp"
 
 namespace fgl::engine
 {
 	static bool enable_culling { true };
 
+	//! Merges visible instances of the same primitive into a single draw. Requires the commands to be compacted
+	static bool enable_instance_merging { true };
+
+	//! Two phase occlusion culling using the Hi-Z pyramid of the previous frame
+	static bool enable_occlusion_culling { true };
+
+	//! Frustum and backface culling of each meshlet of the visible instances. Requires the commands to be compacted
+	static bool enable_cluster_culling { true };
+
+	//! Largest error in pixels a level of detail may have on screen. 0 always draws the full detail level
+	static float lod_error_threshold { 1.0f };
+
+	float& lodErrorThreshold()
+	{
+		return lod_error_threshold;
+	}
+
+	bool& instanceMergingEnabled()
+	{
+		return enable_instance_merging;
+	}
+
+	bool& occlusionCullingEnabled()
+	{
+		return enable_occlusion_culling;
+	}
+
+	bool& clusterCullingEnabled()
+	{
+		return enable_cluster_culling;
+	}
+
 	[[maybe_unused]] static bool& isCullingEnabled()
 	{
 		return enable_culling;
 	}
 
+	enum CullFlags : std::uint32_t
+	{
+		//! Visible commands are appended to the front of their batch and counted in the batch's draw count
+		CULL_COMPACT = 1 << 0,
+		//! Only the visible instances are counted, The merge and scatter passes write the commands
+		CULL_MERGE = 1 << 1,
+		//! Visible instances with meshlets are left for the cluster pass to write the commands of
+		CULL_CLUSTERS = 1 << 2
+	};
+
 	struct CullPushConstants
 	{
+		//! World space frustum planes. See Frustum::gpuPlanes
+		std::array< glm::vec4, 6 > planes;
 		std::uint32_t draw_count;
-		std::uint32_t start_idx;
+		//! See CullFlags
+		std::uint32_t flags;
+		//! See CullingSystem::Phase
+		std::uint32_t phase;
+		//! Size of each index batch, See FrameInfo::commandsPerBatch
+		std::uint32_t batch_size;
+		glm::vec3 camera_position;
+		//! Pixels per world unit at a distance of 1, Divided by lod_error_threshold. 0 disables levels of detail
+		float lod_scale;
+	};
+
+	struct MergePushConstants
+	{
+		std::uint32_t primitive_count;
+		std::uint32_t instance_count;
+		std::uint32_t batch_size;
 	};
 
-	CullingSystem::CullingSystem()
+	struct ClusterPushConstants
 	{
+		std::array< glm::vec4, 6 > planes;
+		glm::vec3 camera_position;
+		std::uint32_t batch_size;
+		std::uint32_t merge;
+		//! Meshlet commands each batch has room for, See CLUSTER_COMMAND_BUDGET
+		std::uint32_t cluster_budget;
+	};
+
+	//! Layout of CullingScratch::m_cluster_state
+	struct ClusterState
+	{
+		vk::DispatchIndirectCommand m_dispatch;
+		//! Meshlet commands reserved from each batch
+		DrawCounts m_budget_used;
+	};
+
+	static_assert( offsetof( ClusterPushConstants, batch_size ) == 108, "Must follow the float3 like the shader" );
+	static_assert( offsetof( ClusterState, m_budget_used ) == 12, "Must match CLUSTER_BUDGET in the shader" );
+
+	static_assert( offsetof( CullPushConstants, camera_position ) == 112, "Must be 16 byte aligned to match the shader" );
+	static_assert( sizeof( CullPushConstants ) <= 128, "Push constants must fit within the guaranteed minimum" );
+
+	//! See CullPushConstants::lod_scale
+	static float lodScale( const Camera& camera )
+	{
+		if ( lod_error_threshold <= 0.0f ) return 0.0f;
+
+		// The projection scales y by 1 / tan( fov / 2 ), Which is half the height of the screen in pixels at distance 1
+		const float half_height { static_cast< float >( camera.getSwapchain().getExtent().height ) * 0.5f };
+		const float pixels_per_unit { std::abs( camera.getProjectionMatrix()[ 1 ][ 1 ] ) * half_height };
+
+		return pixels_per_unit / lod_error_threshold;
+	}
+
+	constexpr descriptors::Descriptor CULLING_STATS_DESCRIPTOR { 0,
+		                                                         vk::DescriptorType::eStorageBuffer,
+		                                                         vk::ShaderStageFlagBits::eCompute };
+
+	inline static descriptors::DescriptorSetLayout CULLING_STATS_SET { 3, CULLING_STATS_DESCRIPTOR };
+
+	constexpr descriptors::Descriptor PRIMITIVE_COUNTS_DESCRIPTOR { 0,
+		                                                            vk::DescriptorType::eStorageBuffer,
+		                                                            vk::ShaderStageFlagBits::eCompute };
+
+	constexpr descriptors::Descriptor INSTANCE_SLOTS_DESCRIPTOR { 1,
+		                                                          vk::DescriptorType::eStorageBuffer,
+		                                                          vk::ShaderStageFlagBits::eCompute };
+
+	constexpr descriptors::Descriptor INSTANCE_CURSOR_DESCRIPTOR { 2,
+		                                                           vk::DescriptorType::eStorageBuffer,
+		                                                           vk::ShaderStageFlagBits::eCompute };
+
+	constexpr descriptors::Descriptor OCCLUSION_STATE_DESCRIPTOR { 3,
+		                                                           vk::DescriptorType::eStorageBuffer,
+		                                                           vk::ShaderStageFlagBits::eCompute };
+
+	constexpr descriptors::Descriptor CLUSTER_INSTANCES_DESCRIPTOR { 4,
+		                                                             vk::DescriptorType::eStorageBuffer,
+		                                                             vk::ShaderStageFlagBits::eCompute };
+
+	constexpr descriptors::Descriptor CLUSTER_STATE_DESCRIPTOR { 5,
+		                                                         vk::DescriptorType::eStorageBuffer,
+		                                                         vk::ShaderStageFlagBits::eCompute };
+
+	inline static descriptors::DescriptorSetLayout CULLING_SCRATCH_SET { 4,
+		                                                                 PRIMITIVE_COUNTS_DESCRIPTOR,
+		                                                                 INSTANCE_SLOTS_DESCRIPTOR,
+		                                                                 INSTANCE_CURSOR_DESCRIPTOR,
+		                                                                 OCCLUSION_STATE_DESCRIPTOR,
+		                                                                 CLUSTER_INSTANCES_DESCRIPTOR,
+		                                                                 CLUSTER_STATE_DESCRIPTOR };
+
+	constexpr std::uint32_t WORKGROUP_SIZE { 64 };
+
+	//! Number of workgroups needed to have one thread per item
+	static std::uint32_t groupCount( const std::uint32_t count )
+	{
+		return ( count + WORKGROUP_SIZE - 1 ) / WORKGROUP_SIZE;
+	}
+
+	CullingSystem::CullingScratch::CullingScratch( memory::Buffer& buffer ) :
+	  m_primitive_counts( buffer ),
+	  m_instance_slots( buffer ),
+	  m_instance_cursor( buffer.allocate( sizeof( std::uint32_t ), alignof( std::uint32_t ) ) ),
+	  m_occlusion_state( buffer ),
+	  m_cluster_instances( buffer ),
+	  m_cluster_state( buffer.allocate( sizeof( ClusterState ), alignof( std::uint32_t ) ) ),
+	  m_descriptor( CULLING_SCRATCH_SET.create() )
+	{
+		m_descriptor->bindStorageBuffer( 0, m_primitive_counts );
+		m_descriptor->bindStorageBuffer( 1, m_instance_slots );
+		m_descriptor->bindStorageBuffer( 2, m_instance_cursor );
+		m_descriptor->bindStorageBuffer( 3, m_occlusion_state );
+		m_descriptor->bindStorageBuffer( 4, m_cluster_instances );
+		m_descriptor->bindStorageBuffer( 5, m_cluster_state );
+		m_descriptor->update();
+		m_descriptor->setName( "Culling scratch" );
+	}
+
+	void CullingSystem::CullingScratch::
+		resize( const std::uint32_t primitive_lod_count, const std::uint32_t instance_count )
+	{
+		const auto primitive_capacity { m_primitive_counts.capacity() };
+		const auto instance_capacity { m_instance_slots.capacity() };
+		const auto state_capacity { m_occlusion_state.capacity() };
+		const auto cluster_capacity { m_cluster_instances.capacity() };
+
+		// The contents are rewritten every frame, So there is no reason to copy them
+		m_primitive_counts.resizeDiscard( std::max( primitive_lod_count, 1u ) );
+		m_instance_slots.resizeDiscard( std::max( instance_count, 1u ) );
+		m_occlusion_state.resizeDiscard( std::max( instance_count, 1u ) );
+		m_cluster_instances.resizeDiscard( std::max( instance_count, 1u ) );
+
+		if ( primitive_capacity == m_primitive_counts.capacity() && instance_capacity == m_instance_slots.capacity()
+		     && state_capacity == m_occlusion_state.capacity()
+		     && cluster_capacity == m_cluster_instances.capacity() )
+			return;
+
+		m_descriptor->bindStorageBuffer( 0, m_primitive_counts );
+		m_descriptor->bindStorageBuffer( 1, m_instance_slots );
+		m_descriptor->bindStorageBuffer( 3, m_occlusion_state );
+		m_descriptor->bindStorageBuffer( 4, m_cluster_instances );
+		m_descriptor->update();
+	}
+
+	CullingSystem::CullingSystem() :
+	  m_scratch_buffer(
+		  4_MiB,
+		  vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst
+			  | vk::BufferUsageFlagBits::eIndirectBuffer,
+		  vk::MemoryPropertyFlagBits::eDeviceLocal ),
+	  m_stats_buffer(
+		  1024,
+		  vk::BufferUsageFlagBits::eStorageBuffer,
+		  vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent )
+	{
+		m_stats_buffer->setDebugName( "Culling stats" );
+		m_scratch_buffer->setDebugName( "Culling scratch" );
+
+		for ( auto& scratch : m_scratch ) scratch = std::make_unique< CullingScratch >( m_scratch_buffer );
+
+		for ( FrameIndex i = 0; i < m_stats.size(); ++i )
+		{
+			m_stats[ i ] = std::make_unique< HostSingleT< CullingStats > >( m_stats_buffer );
+
+			CullingStats zero {};
+			*m_stats[ i ] = zero;
+
+			m_stats_desc[ i ] = CULLING_STATS_SET.create();
+			m_stats_desc[ i ]->bindStorageBuffer( 0, *m_stats[ i ] );
+			m_stats_desc[ i ]->update();
+			m_stats_desc[ i ]->setName( "Culling stats" );
+		}
+
 		PipelineBuilder builder { 0 };
 
 		builder.addDescriptorSet( PRIMITIVE_SET );
 		builder.addDescriptorSet( INSTANCES_SET );
 		builder.addDescriptorSet( COMMANDS_SET );
+		builder.addDescriptorSet( CULLING_STATS_SET );
+		builder.addDescriptorSet( CULLING_SCRATCH_SET );
+		builder.addDescriptorSet( HiZPyramid::getDescriptorLayout() );
 
 		builder.addPushConstants< CullPushConstants >( vk::ShaderStageFlagBits::eCompute );
 
@@ -39,42 +260,262 @@ namespace fgl::engine
 
 		m_cull_compute = builder.create();
 		m_cull_compute->setDebugName( "Culling" );
+
+		PipelineBuilder merge_builder { 0 };
+
+		merge_builder.addDescriptorSet( PRIMITIVE_SET );
+		merge_builder.addDescriptorSet( COMMANDS_SET );
+		merge_builder.addDescriptorSet( CULLING_SCRATCH_SET );
+
+		merge_builder.addPushConstants< MergePushConstants >( vk::ShaderStageFlagBits::eCompute );
+
+		merge_builder.setComputeShader( Shader::loadCompute( "shaders/culling_merge.slang" ) );
+
+		m_merge_compute = merge_builder.create();
+		m_merge_compute->setDebugName( "Culling merge" );
+
+		PipelineBuilder scatter_builder { 0 };
+
+		scatter_builder.addDescriptorSet( PRIMITIVE_SET );
+		scatter_builder.addDescriptorSet( INSTANCES_SET );
+		scatter_builder.addDescriptorSet( COMMANDS_SET );
+		scatter_builder.addDescriptorSet( CULLING_SCRATCH_SET );
+
+		scatter_builder.addPushConstants< MergePushConstants >( vk::ShaderStageFlagBits::eCompute );
+
+		scatter_builder.setComputeShader( Shader::loadCompute( "shaders/culling_scatter.slang" ) );
+
+		m_scatter_compute = scatter_builder.create();
+		m_scatter_compute->setDebugName( "Culling scatter" );
+
+		PipelineBuilder cluster_builder { 0 };
+
+		cluster_builder.addDescriptorSet( PRIMITIVE_SET );
+		cluster_builder.addDescriptorSet( INSTANCES_SET );
+		cluster_builder.addDescriptorSet( COMMANDS_SET );
+		cluster_builder.addDescriptorSet( CULLING_SCRATCH_SET );
+
+		cluster_builder.addPushConstants< ClusterPushConstants >( vk::ShaderStageFlagBits::eCompute );
+
+		cluster_builder.setComputeShader( Shader::loadCompute( "shaders/culling_clusters.slang" ) );
+
+		m_cluster_compute = cluster_builder.create();
+		m_cluster_compute->setDebugName( "Culling clusters" );
 	}
 
 	CullingSystem::~CullingSystem()
 	{}
 
-	void CullingSystem::pass( FrameInfo& info )
+	void CullingSystem::readbackStats( const FrameIndex frame_index )
 	{
-		ZoneScopedN( "Culling pass" );
+		if ( m_last_stats_frame == frame_index ) return;
+		m_last_stats_frame = frame_index;
 
-		const auto frustum { info.camera->getFrustumBounds() };
+		// The fence for this frame index has been waited on, So the shader has finished writing to it
+		auto& stats { *m_stats[ frame_index ] };
+		const CullingStats& results { *static_cast< const CullingStats* >( stats.ptr() ) };
 
-		if ( !enable_culling )
-		{
-			return;
-		}
+		profiling::addCullingResults( results.m_visible, results.m_culled );
+
+		CullingStats zero {};
+		stats = zero;
+	}
+
+	void CullingSystem::mergePass( FrameInfo& info, CullingScratch& scratch, const std::uint32_t primitive_count )
+	{
+		ZoneScopedN( "Culling merge pass" );
+
+		auto& command_buffer { info.command_buffer.render_cb };
+
+		// Each pass reads what the previous pass wrote
+		const vk::MemoryBarrier pass_barrier {
+			vk::AccessFlagBits::eShaderWrite,
+			vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite,
+		};
+
+		MergePushConstants push_constants {};
+		push_constants.primitive_count = primitive_count;
+		push_constants.instance_count = getModelBuffers().m_generated_instance_info[ info.in_flight_idx ].size();
+		push_constants.batch_size = info.commandsPerBatch();
+
+		command_buffer->pipelineBarrier(
+			vk::PipelineStageFlagBits::eComputeShader,
+			vk::PipelineStageFlagBits::eComputeShader,
+			{},
+			{ pass_barrier },
+			{},
+			{} );
+
+		m_merge_compute->bind( command_buffer );
+
+		m_merge_compute->bindDescriptor( command_buffer, info.m_primitives_desc );
+		m_merge_compute->bindDescriptor( command_buffer, info.m_command_buffer_desc );
+		m_merge_compute->bindDescriptor( command_buffer, *scratch.m_descriptor );
+
+		command_buffer->pushConstants< MergePushConstants >(
+			m_merge_compute->layout(), vk::ShaderStageFlagBits::eCompute, 0, { push_constants } );
+
+		command_buffer->dispatch( groupCount( primitive_count * MAX_LODS ), 1, 1 );
+
+		command_buffer->pipelineBarrier(
+			vk::PipelineStageFlagBits::eComputeShader,
+			vk::PipelineStageFlagBits::eComputeShader,
+			{},
+			{ pass_barrier },
+			{},
+			{} );
+
+		m_scatter_compute->bind( command_buffer );
+
+		m_scatter_compute->bindDescriptor( command_buffer, info.m_primitives_desc );
+		m_scatter_compute->bindDescriptor( command_buffer, info.m_instances_desc );
+		m_scatter_compute->bindDescriptor( command_buffer, info.m_command_buffer_desc );
+		m_scatter_compute->bindDescriptor( command_buffer, *scratch.m_descriptor );
+
+		command_buffer->pushConstants< MergePushConstants >(
+			m_scatter_compute->layout(), vk::ShaderStageFlagBits::eCompute, 0, { push_constants } );
+
+		command_buffer->dispatch( groupCount( push_constants.instance_count ), 1, 1 );
+	}
+
+	void CullingSystem::clusterPass( FrameInfo& info, CullingScratch& scratch, const bool merge )
+	{
+		ZoneScopedN( "Culling cluster pass" );
+
+		auto& command_buffer { info.command_buffer.render_cb };
+
+		// The dispatch size is read as an indirect command
+		const vk::MemoryBarrier pass_barrier {
+			vk::AccessFlagBits::eShaderWrite,
+			vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eIndirectCommandRead,
+		};
+
+		command_buffer->pipelineBarrier(
+			vk::PipelineStageFlagBits::eComputeShader,
+			vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eDrawIndirect,
+			{},
+			{ pass_barrier },
+			{},
+			{} );
+
+		m_cluster_compute->bind( command_buffer );
+
+		m_cluster_compute->bindDescriptor( command_buffer, info.m_primitives_desc );
+		m_cluster_compute->bindDescriptor( command_buffer, info.m_instances_desc );
+		m_cluster_compute->bindDescriptor( command_buffer, info.m_command_buffer_desc );
+		m_cluster_compute->bindDescriptor( command_buffer, *scratch.m_descriptor );
+
+		const std::uint32_t instance_count { getModelBuffers().m_generated_instance_info[ info.in_flight_idx ].size() };
+
+		ClusterPushConstants push_constants {};
+		push_constants.planes = info.camera->getFrustumBounds().gpuPlanes();
+		push_constants.camera_position = info.camera->getPosition().vec();
+		push_constants.batch_size = info.commandsPerBatch();
+		push_constants.merge = merge ? 1 : 0;
+		push_constants.cluster_budget = push_constants.batch_size - instance_count;
+
+		command_buffer->pushConstants< ClusterPushConstants >(
+			m_cluster_compute->layout(), vk::ShaderStageFlagBits::eCompute, 0, { push_constants } );
+
+		command_buffer->dispatchIndirect( scratch.m_cluster_state.getVkBuffer(), scratch.m_cluster_state.getOffset() );
+	}
+
+	void CullingSystem::cull( FrameInfo& info, const Phase phase )
+	{
+		ZoneScoped;
 
 		auto& command_buffer { info.command_buffer.render_cb };
 
+		const bool compact { Device::getInstance().supportsDrawIndirectCount() };
+		const bool merge { compact && enable_instance_merging };
+		const bool clusters { compact && enable_cluster_culling };
+
+		const std::uint32_t instance_count { getModelBuffers().m_generated_instance_info[ info.in_flight_idx ].size() };
+		// Merged instances are counted per level of detail of each primitive
+		const std::uint32_t primitive_count { getModelBuffers().m_primitive_info.size() };
+
+		auto& scratch { *m_scratch[ info.in_flight_idx ] };
+
+		// Previous draws this frame might still be reading the commands, instance info, or count
+		command_buffer->pipelineBarrier(
+			vk::PipelineStageFlagBits::eDrawIndirect | vk::PipelineStageFlagBits::eVertexInput,
+			vk::PipelineStageFlagBits::eTransfer | vk::PipelineStageFlagBits::eComputeShader,
+			{},
+			{},
+			{},
+			{} );
+
+		if ( compact )
+		{
+			command_buffer->fillBuffer(
+				info.m_draw_count.getVkBuffer(), info.m_draw_count.getOffset(), sizeof( DrawCounts ), 0 );
+
+			if ( merge )
+			{
+				command_buffer->fillBuffer(
+					scratch.m_primitive_counts.getVkBuffer(),
+					scratch.m_primitive_counts.getOffset(),
+					scratch.m_primitive_counts.size() * scratch.m_primitive_counts.stride(),
+					0 );
+
+				command_buffer->fillBuffer(
+					scratch.m_instance_cursor.getVkBuffer(),
+					scratch.m_instance_cursor.getOffset(),
+					sizeof( std::uint32_t ),
+					0 );
+			}
+
+			if ( clusters )
+			{
+				// Counted up by the culling pass, The rest of the dispatch size is constant
+				const ClusterState cluster_state { vk::DispatchIndirectCommand( 0, 1, 1 ), {} };
+
+				command_buffer->updateBuffer< ClusterState >(
+					scratch.m_cluster_state.getVkBuffer(), scratch.m_cluster_state.getOffset(), { cluster_state } );
+			}
+
+			const vk::MemoryBarrier fill_barrier {
+				vk::AccessFlagBits::eTransferWrite,
+				vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite,
+			};
+
+			command_buffer->pipelineBarrier(
+				vk::PipelineStageFlagBits::eTransfer,
+				vk::PipelineStageFlagBits::eComputeShader,
+				{},
+				{ fill_barrier },
+				{},
+				{} );
+		}
+
 		m_cull_compute->bind( command_buffer );
 
 		m_cull_compute->bindDescriptor( command_buffer, info.m_primitives_desc ); // primitive set
 		m_cull_compute->bindDescriptor( command_buffer, info.m_instances_desc ); // instances
 		m_cull_compute->bindDescriptor( command_buffer, info.m_command_buffer_desc ); // commands output
+		m_cull_compute->bindDescriptor( command_buffer, *m_stats_desc[ info.in_flight_idx ] ); // stats output
+		m_cull_compute->bindDescriptor( command_buffer, *scratch.m_descriptor ); // merge counts, occlusion state
+		m_cull_compute->bindDescriptor( command_buffer, m_hiz.cullDescriptor( info.in_flight_idx ) ); // depth pyramid
 
 		CullPushConstants push_constants {};
-		push_constants.draw_count = info.m_commands.size();
+		push_constants.planes = info.camera->getFrustumBounds().gpuPlanes();
+		push_constants.draw_count = instance_count;
+		if ( compact ) push_constants.flags |= CULL_COMPACT;
+		if ( merge ) push_constants.flags |= CULL_MERGE;
+		if ( clusters ) push_constants.flags |= CULL_CLUSTERS;
+		push_constants.phase = phase;
+		push_constants.batch_size = info.commandsPerBatch();
+		push_constants.camera_position = info.camera->getPosition().vec();
+		push_constants.lod_scale = lodScale( *info.camera );
 
 		command_buffer->pushConstants<
 			CullPushConstants >( m_cull_compute->layout(), vk::ShaderStageFlagBits::eCompute, 0, { push_constants } );
 
-		constexpr std::uint32_t dispatch_count { 64 };
+		command_buffer->dispatch( groupCount( instance_count ), 1, 1 );
 
-		// calculate number of workgroups needed
-		const std::uint32_t group_count { ( push_constants.draw_count + dispatch_count - 1 ) / dispatch_count };
+		if ( merge ) mergePass( info, scratch, primitive_count );
 
-		command_buffer->dispatch( group_count, 1, 1 );
+		if ( clusters ) clusterPass( info, scratch, merge );
 
 		// Add a memory barrier to ensure synchronization between the compute and subsequent stages
 		vk::MemoryBarrier memory_barrier {
@@ -94,4 +535,54 @@ namespace fgl::engine
 		);
 	}
 
+	void CullingSystem::pass( FrameInfo& info )
+	{
+		ZoneScopedN( "Culling pass" );
+
+		if ( !enable_culling )
+		{
+			return;
+		}
+
+		readbackStats( info.in_flight_idx );
+
+		m_scratch[ info.in_flight_idx ]->resize(
+			getModelBuffers().m_primitive_info.size() * MAX_LODS,
+			getModelBuffers().m_generated_instance_info[ info.in_flight_idx ].size() );
+
+		// The pyramid descriptor is bound even if occlusion culling is disabled
+		m_hiz.prepare(
+			info.in_flight_idx, info.camera->getProjectionViewMatrix(), info.camera->getSwapchain().getExtent() );
+
+		// The pyramid is only built while occlusion culling is enabled, So it is outdated once it is enabled again
+		if ( !enable_occlusion_culling ) m_hiz.invalidate();
+
+		// Without a pyramid from the previous frame there is nothing to test against
+		m_phase = enable_occlusion_culling && m_hiz.built() ? EARLY : SINGLE;
+
+		cull( info, m_phase );
+	}
+
+	bool CullingSystem::latePass( FrameInfo& info, GBufferSwapchain& swapchain )
+	{
+		ZoneScopedN( "Culling late pass" );
+
+		if ( !enable_culling || !enable_occlusion_culling ) return false;
+
+		auto& command_buffer { info.command_buffer.render_cb };
+
+		swapchain.transitionImages( command_buffer, GBufferSwapchain::HIZ_BUILD, info.in_flight_idx );
+
+		// Built every frame, So the next frame can use it for the EARLY phase
+		m_hiz.build( command_buffer, swapchain.getDepthView( info.in_flight_idx ), info.in_flight_idx );
+
+		swapchain.transitionImages( command_buffer, GBufferSwapchain::LATE, info.in_flight_idx );
+
+		if ( m_phase != EARLY ) return false;
+
+		cull( info, LATE );
+
+		return true;
+	}
+
 } // namespace fgl::engine
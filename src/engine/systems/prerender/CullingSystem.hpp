@@ -4,14 +4,33 @@
 
 #pragma once
 
+#include <optional>
 #include <thread>
 
+#include "HiZPyramid.hpp"
+#include "engine/memory/buffers/BufferHandle.hpp"
+#include "engine/memory/buffers/HostSingleT.hpp"
+#include "engine/memory/buffers/vector/DeviceVector.hpp"
+#include "engine/rendering/PresentSwapChain.hpp"
 #include "engine/systems/concepts.hpp"
 #include "rendering/pipelines/v2/Pipeline.hpp"
 
 namespace fgl::engine
 {
 	struct FrameInfo;
+	class GBufferSwapchain;
+
+	namespace descriptors
+	{
+		class DescriptorSet;
+	}
+
+	//! Written by the culling shader, Read back once the frame has completed
+	struct CullingStats
+	{
+		std::uint32_t m_visible;
+		std::uint32_t m_culled;
+	};
 
 	class CullingSystem
 	{
@@ -23,6 +42,88 @@ namespace fgl::engine
 
 		std::unique_ptr< Pipeline > m_cull_compute { nullptr };
 
+		//! Writes one command per visible primitive, See culling_merge.slang
+		std::unique_ptr< Pipeline > m_merge_compute { nullptr };
+		//! Writes the instance info for the merged commands, See culling_scatter.slang
+		std::unique_ptr< Pipeline > m_scatter_compute { nullptr };
+		//! Culls the meshlets of the visible instances, See culling_clusters.slang
+		std::unique_ptr< Pipeline > m_cluster_compute { nullptr };
+
+		//! Device local buffer for the intermediate data used when merging instances and occlusion culling
+		memory::Buffer m_scratch_buffer;
+
+		struct CullingScratch
+		{
+			//! Number of visible instances per level of detail of each primitive (See MAX_LODS).
+			//! Overwritten with the first instance by the merge pass
+			DeviceVector< std::uint32_t > m_primitive_counts;
+
+			//! Index of each visible instance within it's primitive
+			DeviceVector< std::uint32_t > m_instance_slots;
+
+			//! Number of instances reserved by the merge pass
+			memory::BufferSuballocation m_instance_cursor;
+
+			//! Which instances the early phase rejected by occlusion, And the late phase needs to test again
+			DeviceVector< std::uint32_t > m_occlusion_state;
+
+			//! Visible instances who's meshlets are culled by the cluster pass
+			DeviceVector< std::uint32_t > m_cluster_instances;
+
+			//! Indirect dispatch size of the cluster pass, Followed by the meshlet commands reserved from each batch
+			memory::BufferSuballocation m_cluster_state;
+
+			std::unique_ptr< descriptors::DescriptorSet > m_descriptor;
+
+			explicit CullingScratch( memory::Buffer& buffer );
+
+			//! Resizes the scratch vectors, Rebinding the descriptor if any had to be reallocated
+			void resize( std::uint32_t primitive_lod_count, std::uint32_t instance_count );
+		};
+
+		PerFrameArray< std::unique_ptr< CullingScratch > > m_scratch {};
+
+		//! Depth of the previous frame, Used for occlusion culling
+		HiZPyramid m_hiz {};
+
+	  public:
+
+		enum Phase : std::uint32_t
+		{
+			//! Frustum culling only
+			SINGLE = 0,
+			//! Frustum culling, And occlusion culling against the depth of the previous frame
+			EARLY = 1,
+			//! Retests the instances occluded in the EARLY phase against the depth written by the EARLY phase
+			LATE = 2
+		};
+
+	  private:
+
+		//! Phase used by the last call to pass()
+		Phase m_phase { SINGLE };
+
+		//! Host visible buffer for the culling stats
+		memory::Buffer m_stats_buffer;
+
+		PerFrameArray< std::unique_ptr< HostSingleT< CullingStats > > > m_stats {};
+		PerFrameArray< std::unique_ptr< descriptors::DescriptorSet > > m_stats_desc {};
+
+		//! Frame index that the stats were last read back for. Cameras after the first in a frame share the stats
+		std::optional< FrameIndex > m_last_stats_frame { std::nullopt };
+
+		//! Adds the stats from the last time this frame index was used to the profiling counters, and resets them
+		void readbackStats( FrameIndex frame_index );
+
+		//! Records the culling dispatch for a phase, Followed by the merge passes if enabled
+		void cull( FrameInfo& info, Phase phase );
+
+		//! Runs the merge and scatter passes after the culling pass has counted the visible instances
+		void mergePass( FrameInfo& info, CullingScratch& scratch, std::uint32_t primitive_count );
+
+		//! Culls the meshlets of the instances the culling pass found visible at full detail, Appending their commands
+		void clusterPass( FrameInfo& info, CullingScratch& scratch, bool merge );
+
 		// void runner();
 
 		// Semaphore to signal the thread to start
@@ -38,9 +139,29 @@ namespace fgl::engine
 
 		~CullingSystem();
 
+		//! Culls the instances before the GBuffer is drawn. This is the EARLY phase if the Hi-Z pyramid is available
 		void pass( FrameInfo& info );
+
+		/**
+		 * @brief Builds the Hi-Z pyramid from the depth drawn after pass(), And culls anything that was disoccluded
+		 * @note Must be called outside of rendering, With the depth in eDepthAttachmentOptimal
+		 * @return True if the commands were rewritten and the GBuffer must be drawn again (Without clearing)
+		 */
+		bool latePass( FrameInfo& info, GBufferSwapchain& swapchain );
 	};
 
+	//! Largest error in pixels a level of detail may have on screen, Used to select the level for each instance
+	float& lodErrorThreshold();
+
+	//! Merging of the visible instances of a primitive into a single draw. Only used if the commands are compacted
+	bool& instanceMergingEnabled();
+
+	//! Two phase occlusion culling against the Hi-Z pyramid of the previous frame. Can be toggled between frames
+	bool& occlusionCullingEnabled();
+
+	//! Culling of each meshlet of the visible instances. Only used if the commands are compacted
+	bool& clusterCullingEnabled();
+
 	static_assert( is_system< CullingSystem > );
 	// static_assert( is_threaded_system< CullingSystem > );
 
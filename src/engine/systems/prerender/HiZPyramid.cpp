@@ -0,0 +1,236 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "HiZPyramid.hpp"
+
+#include <tracy/Tracy.hpp>
+
+#include "engine/assets/image/ImageView.hpp"
+#include "engine/descriptors/DescriptorSet.hpp"
+#include "engine/math/literals/size.hpp"
+#include "engine/memory/DefferedCleanup.hpp"
+#include "engine/memory/buffers/BufferHandle.hpp"
+#include "engine/rendering/pipelines/v2/Pipeline.hpp"
+#include "engine/rendering/pipelines/v2/PipelineBuilder.hpp"
+
+namespace fgl::engine
+{
+
+	struct HiZBuildPushConstants
+	{
+		std::uint32_t level;
+	};
+
+	constexpr descriptors::Descriptor HIZ_PYRAMID_DESCRIPTOR { 0,
+		                                                       vk::DescriptorType::eStorageBuffer,
+		                                                       vk::ShaderStageFlagBits::eCompute };
+
+	constexpr descriptors::Descriptor HIZ_INFO_DESCRIPTOR { 1,
+		                                                    vk::DescriptorType::eStorageBuffer,
+		                                                    vk::ShaderStageFlagBits::eCompute };
+
+	inline static descriptors::DescriptorSetLayout HIZ_SET { 5, HIZ_PYRAMID_DESCRIPTOR, HIZ_INFO_DESCRIPTOR };
+
+	constexpr descriptors::ImageDescriptor HIZ_BUILD_DEPTH_DESCRIPTOR { 0, vk::ShaderStageFlagBits::eCompute };
+
+	constexpr descriptors::Descriptor HIZ_BUILD_PYRAMID_DESCRIPTOR { 1,
+		                                                             vk::DescriptorType::eStorageBuffer,
+		                                                             vk::ShaderStageFlagBits::eCompute };
+
+	constexpr descriptors::Descriptor HIZ_BUILD_INFO_DESCRIPTOR { 2,
+		                                                          vk::DescriptorType::eStorageBuffer,
+		                                                          vk::ShaderStageFlagBits::eCompute };
+
+	inline static descriptors::DescriptorSetLayout HIZ_BUILD_SET {
+		0, HIZ_BUILD_DEPTH_DESCRIPTOR, HIZ_BUILD_PYRAMID_DESCRIPTOR, HIZ_BUILD_INFO_DESCRIPTOR
+	};
+
+	constexpr std::uint32_t HIZ_WORKGROUP_SIZE { 8 };
+
+	descriptors::DescriptorSetLayout& HiZPyramid::getDescriptorLayout()
+	{
+		return HIZ_SET;
+	}
+
+	HiZPyramid::HiZPyramid() :
+	  m_pyramid_buffer(
+		  4_MiB,
+		  vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst,
+		  vk::MemoryPropertyFlagBits::eDeviceLocal ),
+	  m_info_buffer(
+		  4_KiB,
+		  vk::BufferUsageFlagBits::eStorageBuffer,
+		  vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent ),
+	  m_pyramid( m_pyramid_buffer )
+	{
+		m_pyramid_buffer->setDebugName( "Hi-Z pyramid" );
+		m_info_buffer->setDebugName( "Hi-Z info" );
+
+		for ( FrameIndex i = 0; i < constants::MAX_FRAMES_IN_FLIGHT; ++i )
+		{
+			m_info[ i ] = std::make_unique< HostSingleT< HiZInfo > >( m_info_buffer );
+
+			HiZInfo zero {};
+			*m_info[ i ] = zero;
+
+			m_cull_descriptors[ i ] = HIZ_SET.create();
+			m_cull_descriptors[ i ]->bindStorageBuffer( 0, m_pyramid );
+			m_cull_descriptors[ i ]->bindStorageBuffer( 1, *m_info[ i ] );
+			m_cull_descriptors[ i ]->update();
+			m_cull_descriptors[ i ]->setName( "Hi-Z culling" );
+
+			m_build_descriptors[ i ] = HIZ_BUILD_SET.create();
+		}
+
+		PipelineBuilder builder { 0 };
+
+		builder.addDescriptorSet( HIZ_BUILD_SET );
+
+		builder.addPushConstants< HiZBuildPushConstants >( vk::ShaderStageFlagBits::eCompute );
+
+		builder.setComputeShader( Shader::loadCompute( "shaders/hiz_build.slang" ) );
+
+		m_build_compute = builder.create();
+		m_build_compute->setDebugName( "Hi-Z build" );
+	}
+
+	HiZPyramid::~HiZPyramid()
+	{
+		for ( auto& descriptor : m_cull_descriptors ) descriptors::queueDescriptorDeletion( std::move( descriptor ) );
+		for ( auto& descriptor : m_build_descriptors ) descriptors::queueDescriptorDeletion( std::move( descriptor ) );
+	}
+
+	void HiZPyramid::resize( const vk::Extent2D extent )
+	{
+		m_extent = extent;
+		m_built = false;
+
+		std::uint32_t width { extent.width };
+		std::uint32_t height { extent.height };
+		std::uint32_t offset { 0 };
+
+		m_level_count = 0;
+
+		do
+		{
+			// Each level covers the entire previous level, Including the odd row/column
+			width = std::max( ( width + 1 ) / 2, 1u );
+			height = std::max( ( height + 1 ) / 2, 1u );
+
+			m_levels[ m_level_count ] = HiZLevel { offset, width, height, 0 };
+			offset += width * height;
+
+			++m_level_count;
+		}
+		while ( ( width > 1 || height > 1 ) && m_level_count < MAX_HIZ_LEVELS );
+
+		const auto capacity { m_pyramid.capacity() };
+		std::shared_ptr< void > previous { m_pyramid.getHandle() };
+
+		// The old contents are useless after a resize
+		m_pyramid.resizeDiscard( offset );
+
+		if ( capacity == m_pyramid.capacity() ) return;
+
+		// The other frame in flight might still be reading the old pyramid
+		memory::deferredDelete( std::move( previous ) );
+		++m_generation;
+	}
+
+	void HiZPyramid::prepare( const FrameIndex frame_index, const glm::mat4& view_projection, const vk::Extent2D extent )
+	{
+		ZoneScoped;
+
+		if ( extent != m_extent ) resize( extent );
+
+		if ( m_bound_generation[ frame_index ] != m_generation )
+		{
+			// The fence for this frame has been waited on, So it's descriptors are no longer in use
+			m_cull_descriptors[ frame_index ]->bindStorageBuffer( 0, m_pyramid );
+			m_cull_descriptors[ frame_index ]->update();
+
+			// Forces the build descriptor to be rebound with the new pyramid
+			m_bound_depth[ frame_index ] = VK_NULL_HANDLE;
+			m_bound_generation[ frame_index ] = m_generation;
+		}
+
+		HiZInfo info {};
+		info.m_view_projection = view_projection;
+		info.m_levels = m_levels;
+		info.m_depth_width = m_extent.width;
+		info.m_depth_height = m_extent.height;
+		info.m_level_count = m_level_count;
+
+		*m_info[ frame_index ] = info;
+	}
+
+	descriptors::DescriptorSet& HiZPyramid::cullDescriptor( const FrameIndex frame_index ) const
+	{
+		return *m_cull_descriptors[ frame_index ];
+	}
+
+	void HiZPyramid::build( CommandBuffer& command_buffer, const ImageView& depth, const FrameIndex frame_index )
+	{
+		ZoneScoped;
+
+		FGL_ASSERT( depth.getExtent() == m_extent, "Depth does not match the extent of the pyramid" );
+
+		auto& descriptor { *m_build_descriptors[ frame_index ] };
+
+		if ( m_bound_depth[ frame_index ] != *depth )
+		{
+			descriptor.bindImage( 0, depth, vk::ImageLayout::eShaderReadOnlyOptimal );
+			descriptor.bindStorageBuffer( 1, m_pyramid );
+			descriptor.bindStorageBuffer( 2, *m_info[ frame_index ] );
+			descriptor.update();
+			descriptor.setName( "Hi-Z build" );
+
+			m_bound_depth[ frame_index ] = *depth;
+		}
+
+		// The culling passes might still be reading the previous pyramid
+		const vk::MemoryBarrier level_barrier {
+			vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eShaderRead,
+			vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eShaderRead,
+		};
+
+		command_buffer->pipelineBarrier(
+			vk::PipelineStageFlagBits::eComputeShader,
+			vk::PipelineStageFlagBits::eComputeShader,
+			{},
+			{ level_barrier },
+			{},
+			{} );
+
+		m_build_compute->bind( command_buffer );
+		m_build_compute->bindDescriptor( command_buffer, descriptor );
+
+		for ( std::uint32_t level = 0; level < m_level_count; ++level )
+		{
+			const HiZBuildPushConstants push_constants { level };
+
+			command_buffer->pushConstants< HiZBuildPushConstants >(
+				m_build_compute->layout(), vk::ShaderStageFlagBits::eCompute, 0, { push_constants } );
+
+			const auto& [ offset, width, height, padding ] = m_levels[ level ];
+
+			command_buffer->dispatch(
+				( width + HIZ_WORKGROUP_SIZE - 1 ) / HIZ_WORKGROUP_SIZE,
+				( height + HIZ_WORKGROUP_SIZE - 1 ) / HIZ_WORKGROUP_SIZE,
+				1 );
+
+			// Each level reads the previous. The last barrier makes the pyramid visible to the culling passes
+			command_buffer->pipelineBarrier(
+				vk::PipelineStageFlagBits::eComputeShader,
+				vk::PipelineStageFlagBits::eComputeShader,
+				{},
+				{ level_barrier },
+				{},
+				{} );
+		}
+
+		m_built = true;
+	}
+
+} // namespace fgl::engine
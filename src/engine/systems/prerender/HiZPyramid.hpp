@@ -0,0 +1,125 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <glm/mat4x4.hpp>
+
+#include <array>
+#include <memory>
+
+#include "engine/memory/buffers/HostSingleT.hpp"
+#include "engine/memory/buffers/vector/DeviceVector.hpp"
+#include "engine/rendering/PresentSwapChain.hpp"
+
+namespace fgl::engine
+{
+	class Pipeline;
+	class ImageView;
+
+	namespace descriptors
+	{
+		class DescriptorSet;
+		class DescriptorSetLayout;
+	} // namespace descriptors
+
+	constexpr std::uint32_t MAX_HIZ_LEVELS { 16 };
+
+	struct HiZLevel
+	{
+		//! Offset of the first texel within the pyramid
+		std::uint32_t m_offset;
+		std::uint32_t m_width;
+		std::uint32_t m_height;
+		std::uint32_t m_padding;
+	};
+
+	//! Matches HiZInfo in shaders/objects/hiz.slang
+	struct HiZInfo
+	{
+		glm::mat4 m_view_projection;
+		std::array< HiZLevel, MAX_HIZ_LEVELS > m_levels;
+		std::uint32_t m_depth_width;
+		std::uint32_t m_depth_height;
+		std::uint32_t m_level_count;
+		std::uint32_t m_padding;
+	};
+
+	static_assert( offsetof( HiZInfo, m_levels ) == 64 );
+	static_assert( offsetof( HiZInfo, m_depth_width ) == 64 + 16 * MAX_HIZ_LEVELS );
+	static_assert( sizeof( HiZInfo ) % 16 == 0 );
+
+	/**
+	 * @brief Max depth pyramid (Hi-Z) of a depth target, Used for occlusion culling.
+	 *
+	 * Each texel holds the furthest depth of the 2x2 texels below it, Level 0 being half the size of the depth target.
+	 * The levels are stored one after another in a single storage buffer, As images do not have mip levels yet.
+	 *
+	 * The pyramid is shared between frames in flight. It is built from the depth of one frame and then tested against
+	 * during the next frame, Before that frame has written any depth.
+	 */
+	class HiZPyramid
+	{
+		//! Device local buffer for the pyramid texels
+		memory::Buffer m_pyramid_buffer;
+
+		//! Host visible buffer for the per frame info
+		memory::Buffer m_info_buffer;
+
+		DeviceVector< float > m_pyramid;
+
+		PerFrameArray< std::unique_ptr< HostSingleT< HiZInfo > > > m_info {};
+
+		//! Bound to the culling pipelines, Pyramid + info
+		PerFrameArray< std::unique_ptr< descriptors::DescriptorSet > > m_cull_descriptors {};
+
+		//! Bound to the build pipeline, Depth + pyramid + info
+		PerFrameArray< std::unique_ptr< descriptors::DescriptorSet > > m_build_descriptors {};
+
+		//! Incremented each time the pyramid is reallocated, Descriptors are rebound once their frame comes around again
+		std::uint64_t m_generation { 0 };
+		PerFrameArray< std::uint64_t > m_bound_generation {};
+		PerFrameArray< VkImageView > m_bound_depth {};
+
+		std::unique_ptr< Pipeline > m_build_compute { nullptr };
+
+		vk::Extent2D m_extent { 0, 0 };
+		std::array< HiZLevel, MAX_HIZ_LEVELS > m_levels {};
+		std::uint32_t m_level_count { 0 };
+
+		//! False until the pyramid has been built for the current extent
+		bool m_built { false };
+
+		void resize( vk::Extent2D extent );
+
+	  public:
+
+		HiZPyramid();
+		~HiZPyramid();
+
+		FGL_DELETE_COPY( HiZPyramid );
+		FGL_DELETE_MOVE( HiZPyramid );
+
+		//! Layout of the descriptor given by cullDescriptor()
+		static descriptors::DescriptorSetLayout& getDescriptorLayout();
+
+		//! Updates the info for this frame. Must be called before either descriptor is used for the frame
+		void prepare( FrameIndex frame_index, const glm::mat4& view_projection, vk::Extent2D extent );
+
+		//! True if the pyramid contains the depth of a previous frame with the same extent
+		bool built() const { return m_built; }
+
+		//! Marks the pyramid as outdated, So it is not used until it has been built again
+		void invalidate() { m_built = false; }
+
+		descriptors::DescriptorSet& cullDescriptor( FrameIndex frame_index ) const;
+
+		/**
+		 * @brief Reduces the depth into the pyramid
+		 * @note The depth must be in eShaderReadOnlyOptimal, And match the extent given to prepare()
+		 */
+		void build( CommandBuffer& command_buffer, const ImageView& depth, FrameIndex frame_index );
+	};
+
+} // namespace fgl::engine
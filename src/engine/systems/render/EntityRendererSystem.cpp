@@ -9,7 +9,9 @@
 
 #include "EngineContext.hpp"
 #include "assets/model/ModelVertex.hpp"
+#include "assets/model/PackedModelVertex.hpp"
 #include "engine/assets/material/Material.hpp"
+#include "engine/assets/texture/TextureStreamer.hpp"
 #include "engine/camera/Camera.hpp"
 #include "engine/debug/timing/FlameGraph.hpp"
 #include "engine/rendering/pipelines/v2/Pipeline.hpp"
@@ -32,12 +34,29 @@ namespace fgl::engine
 		builder.addDescriptorSet( Camera::getDescriptorLayout() );
 		builder.addDescriptorSet( Texture::getDescriptorLayout() );
 		builder.addDescriptorSet( Material::getDescriptorLayout() );
-
-		builder.setFragmentShader( Shader::loadFragment( "shaders/textured.slang" ) );
-		builder.setVertexShader( Shader::loadVertex( "shaders/textured.slang" ) );
-
-		builder.setAttributeDescriptions( ModelVertex::getAttributeDescriptions() );
-		builder.setBindingDescriptions( ModelVertex::getBindingDescriptions() );
+		builder.addDescriptorSet( TextureStreamer::getDescriptorLayout() );
+
+		// Writing the texture feedback needs fragmentStoresAndAtomics. Without it textures are not streamed
+		if ( getTextureStreamer().enabled() )
+			builder.setFragmentShader( Shader::loadFragment( "shaders/textured.slang" ) );
+		else
+			builder.setFragmentShader( Shader::loadFragment( "shaders/textured_no_feedback.slang" ) );
+
+		// Must match the format the vertex buffer was filled with
+		if ( vertexFormat() == VertexFormat::Packed )
+		{
+			builder.setVertexShader( Shader::loadVertex( "shaders/textured_packed.slang" ) );
+
+			builder.setAttributeDescriptions( PackedModelVertex::getAttributeDescriptions() );
+			builder.setBindingDescriptions( PackedModelVertex::getBindingDescriptions() );
+		}
+		else
+		{
+			builder.setVertexShader( Shader::loadVertex( "shaders/textured.slang" ) );
+
+			builder.setAttributeDescriptions( ModelVertex::getAttributeDescriptions() );
+			builder.setBindingDescriptions( ModelVertex::getBindingDescriptions() );
+		}
 
 		builder.addDepthAttachment();
 
@@ -87,6 +106,7 @@ namespace fgl::engine
 		m_textured_pipeline->bindDescriptor( command_buffer, info.getCameraDescriptor() );
 		m_textured_pipeline->bindDescriptor( command_buffer, Texture::getDescriptorSet() );
 		m_textured_pipeline->bindDescriptor( command_buffer, Material::getDescriptorSet() );
+		m_textured_pipeline->bindDescriptor( command_buffer, getTextureStreamer().getDescriptor( info.in_flight_idx ) );
 
 		auto& model_buffers { getModelBuffers() };
 
@@ -97,13 +117,35 @@ namespace fgl::engine
 
 		command_buffer->bindVertexBuffers(
 			0, vert_buffers, { 0, model_buffers.m_generated_instance_info[ info.in_flight_idx ].getOffset() } );
-		command_buffer->bindIndexBuffer( model_buffers.m_index_buffer->getVkBuffer(), 0, vk::IndexType::eUint32 );
 
-		command_buffer->drawIndexedIndirect(
-			info.m_commands.getVkBuffer(),
-			info.m_commands.getOffset(),
-			info.m_commands.size(),
-			info.m_commands.stride() );
+		const std::uint32_t batch_size { info.commandsPerBatch() };
+
+		// One draw per index type. Both bind the same buffer, With the primitives' first index in units of their type
+		for ( std::uint32_t batch = 0; batch < INDEX_BATCH_COUNT; ++batch )
+		{
+			command_buffer->bindIndexBuffer(
+				model_buffers.m_index_buffer->getVkBuffer(), 0, indexTypeOf( static_cast< IndexBatch >( batch ) ) );
+
+			const vk::DeviceSize commands_offset { info.m_commands.getOffset()
+				                                   + vk::DeviceSize( batch ) * batch_size * info.m_commands.stride() };
+
+			// The culling pass compacts the visible commands if the count can be read by the GPU.
+			if ( Device::getInstance().supportsDrawIndirectCount() )
+			{
+				command_buffer->drawIndexedIndirectCountKHR(
+					info.m_commands.getVkBuffer(),
+					commands_offset,
+					info.m_draw_count.getVkBuffer(),
+					info.m_draw_count.getOffset() + batch * sizeof( std::uint32_t ),
+					batch_size,
+					info.m_commands.stride() );
+			}
+			else
+			{
+				command_buffer->drawIndexedIndirect(
+					info.m_commands.getVkBuffer(), commands_offset, batch_size, info.m_commands.stride() );
+			}
+		}
 	};
 
 } // namespace fgl::engine
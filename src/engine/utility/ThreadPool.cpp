@@ -0,0 +1,60 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include "ThreadPool.hpp"
+
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+
+namespace fgl::engine
+{
+
+	ThreadPool::ThreadPool( const std::size_t thread_count )
+	{
+		m_workers.reserve( thread_count );
+		for ( std::size_t i = 0; i < thread_count; ++i ) m_workers.emplace_back( [ this ]() { workerLoop(); } );
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard guard { m_queue_mtx };
+			m_stopping = true;
+		}
+
+		m_queue_cv.notify_all();
+
+		// jthread joins on destruction
+		m_workers.clear();
+	}
+
+	void ThreadPool::workerLoop()
+	{
+		while ( true )
+		{
+			std::move_only_function< void() > job {};
+
+			{
+				std::unique_lock lock { m_queue_mtx };
+				m_queue_cv.wait( lock, [ this ]() { return m_stopping || !m_jobs.empty(); } );
+
+				if ( m_jobs.empty() ) return;
+
+				job = std::move( m_jobs.front() );
+				m_jobs.pop();
+			}
+
+			ZoneScopedN( "Worker job" );
+			job();
+		}
+	}
+
+	ThreadPool& getThreadPool()
+	{
+		static ThreadPool pool { std::max( std::thread::hardware_concurrency(), 2u ) - 1 };
+		return pool;
+	}
+
+} // namespace fgl::engine
@@ -0,0 +1,69 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace fgl::engine
+{
+
+	/**
+	 * @brief Fixed set of worker threads that run jobs in the order they were submitted.
+	 * @note Jobs must not wait on other jobs from the same pool, As every worker could end up waiting.
+	 */
+	class ThreadPool
+	{
+		std::mutex m_queue_mtx {};
+		std::condition_variable m_queue_cv {};
+		std::queue< std::move_only_function< void() > > m_jobs {};
+		bool m_stopping { false };
+
+		std::vector< std::jthread > m_workers {};
+
+		void workerLoop();
+
+	  public:
+
+		explicit ThreadPool( std::size_t thread_count );
+
+		ThreadPool( const ThreadPool& ) = delete;
+		ThreadPool& operator=( const ThreadPool& ) = delete;
+
+		//! Finishes every job already in the queue before joining the workers
+		~ThreadPool();
+
+		//! Queues a job. Exceptions thrown by the job are rethrown by the returned future
+		template < typename F >
+		std::future< std::invoke_result_t< std::decay_t< F > > > submit( F&& func )
+		{
+			using Result = std::invoke_result_t< std::decay_t< F > >;
+
+			std::packaged_task< Result() > task { std::forward< F >( func ) };
+			auto future { task.get_future() };
+
+			{
+				std::lock_guard guard { m_queue_mtx };
+				m_jobs.emplace( std::move( task ) );
+			}
+
+			m_queue_cv.notify_one();
+
+			return future;
+		}
+
+		std::size_t threadCount() const { return m_workers.size(); }
+	};
+
+	//! Shared pool for asset loading and other CPU heavy work. Uses every core except one
+	ThreadPool& getThreadPool();
+
+} // namespace fgl::engine
@@ -0,0 +1,235 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "engine/math/bvh/BoundingVolumeHierarchy.hpp"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Weffc++"
+#include <glm/geometric.hpp>
+#pragma GCC diagnostic pop
+
+using namespace fgl::engine;
+
+namespace
+{
+	using Planes = std::array< glm::vec4, 6 >;
+	using ItemIndex = BoundingVolumeHierarchy::ItemIndex;
+
+	//! Objects are spread out further as there are more of them, So each frustum sees about the same number
+	float worldExtent( const std::size_t count )
+	{
+		return 10.0f * std::cbrt( static_cast< float >( count ) );
+	}
+
+	BVHBounds makeObject( std::mt19937& rng, const float world_extent )
+	{
+		std::uniform_real_distribution< float > position_dist { -world_extent, world_extent };
+		std::uniform_real_distribution< float > size_dist { 0.25f, 2.0f };
+
+		const glm::vec3 center { position_dist( rng ), position_dist( rng ), position_dist( rng ) };
+		const glm::vec3 extent { size_dist( rng ), size_dist( rng ), size_dist( rng ) };
+
+		return { center - extent, center + extent };
+	}
+
+	std::vector< BVHBounds > makeScene( const std::size_t count, const std::uint32_t seed )
+	{
+		std::mt19937 rng { seed };
+		const float world_extent { worldExtent( count ) };
+
+		std::vector< BVHBounds > bounds {};
+		bounds.reserve( count );
+
+		for ( std::size_t i = 0; i < count; ++i ) bounds.emplace_back( makeObject( rng, world_extent ) );
+
+		return bounds;
+	}
+
+	//! Plane through the point, With the normal facing the inside
+	glm::vec4 makePlane( const glm::vec3& normal, const glm::vec3& point )
+	{
+		return { normal, -glm::dot( normal, point ) };
+	}
+
+	//! Planes of a perspective camera with the given field of view on both axes, Same layout as Frustum::gpuPlanes
+	Planes makeFrustum(
+		const glm::vec3& origin, const glm::vec3& forward, const float fov, const float near, const float far )
+	{
+		const glm::vec3 right { glm::normalize( glm::cross( forward, glm::vec3( 0.0f, 1.0f, 0.0f ) ) ) };
+		const glm::vec3 up { glm::cross( right, forward ) };
+
+		const float sin { std::sin( fov * 0.5f ) };
+		const float cos { std::cos( fov * 0.5f ) };
+
+		return { makePlane( forward, origin + forward * near ),
+			     makePlane( -forward, origin + forward * far ),
+			     makePlane( forward * sin + right * cos, origin ),
+			     makePlane( forward * sin - right * cos, origin ),
+			     makePlane( forward * sin + up * cos, origin ),
+			     makePlane( forward * sin - up * cos, origin ) };
+	}
+
+	//! Cameras placed somewhere in the scene, Looking in random directions
+	std::vector< Planes > makeFrustums( const std::size_t count, const float world_extent, const std::uint32_t seed )
+	{
+		std::mt19937 rng { seed };
+		std::uniform_real_distribution< float > position_dist { -world_extent, world_extent };
+		std::uniform_real_distribution< float > yaw_dist { -std::numbers::pi_v< float >, std::numbers::pi_v< float > };
+		std::uniform_real_distribution< float > pitch_dist { -1.0f, 1.0f };
+		std::uniform_real_distribution< float > fov_dist { 0.5f, 2.0f };
+
+		std::vector< Planes > frustums {};
+		frustums.reserve( count );
+
+		for ( std::size_t i = 0; i < count; ++i )
+		{
+			const glm::vec3 origin { position_dist( rng ), position_dist( rng ), position_dist( rng ) };
+
+			const float yaw { yaw_dist( rng ) };
+			const float pitch { pitch_dist( rng ) };
+			const glm::vec3 forward { std::cos( pitch ) * std::cos( yaw ),
+				                      std::sin( pitch ),
+				                      std::cos( pitch ) * std::sin( yaw ) };
+
+			frustums.emplace_back( makeFrustum( origin, forward, fov_dist( rng ), 0.1f, 100.0f ) );
+		}
+
+		return frustums;
+	}
+
+	//! Same test the hierarchy uses to reject bounds
+	bool insideFrustum( const BVHBounds& bounds, const Planes& planes )
+	{
+		const glm::vec3 center { bounds.center() };
+		const glm::vec3 extent { bounds.extent() };
+
+		for ( const glm::vec4& plane : planes )
+		{
+			const glm::vec3 normal { plane };
+			if ( glm::dot( normal, center ) + plane.w + glm::dot( glm::abs( normal ), extent ) < 0.0f ) return false;
+		}
+
+		return true;
+	}
+
+	void bruteForceQuery( const std::vector< BVHBounds >& bounds, const Planes& planes, std::vector< ItemIndex >& out )
+	{
+		for ( ItemIndex i = 0; i < bounds.size(); ++i )
+			if ( insideFrustum( bounds[ i ], planes ) ) out.emplace_back( i );
+	}
+
+	//! Checks that the hierarchy returns every item in each frustum exactly once. Returns the total found
+	std::size_t checkFrustums(
+		const BoundingVolumeHierarchy& hierarchy,
+		const std::vector< BVHBounds >& bounds,
+		const std::vector< Planes >& frustums )
+	{
+		std::size_t found { 0 };
+
+		for ( const Planes& planes : frustums )
+		{
+			std::vector< ItemIndex > items {};
+			hierarchy.query( planes, items );
+
+			std::vector< ItemIndex > expected {};
+			bruteForceQuery( bounds, planes, expected );
+
+			std::ranges::sort( items );
+			REQUIRE( items == expected );
+
+			found += items.size();
+		}
+
+		return found;
+	}
+
+} // namespace
+
+TEST_CASE( "BoundingVolumeHierarchy frustum queries", "[math][bvh]" )
+{
+	constexpr std::size_t object_count { 20'000 };
+
+	std::vector< BVHBounds > bounds { makeScene( object_count, 1234 ) };
+	BoundingVolumeHierarchy hierarchy { bounds };
+
+	const std::vector< Planes > frustums { makeFrustums( 100, worldExtent( object_count ), 4321 ) };
+
+	SECTION( "Match a brute force query" )
+	{
+		// Something has to be in view, Or the test proves nothing
+		REQUIRE( checkFrustums( hierarchy, bounds, frustums ) > 0 );
+	}
+
+	SECTION( "Match a brute force query after moving objects" )
+	{
+		std::mt19937 rng { 5678 };
+		std::uniform_int_distribution< ItemIndex > item_dist { 0, object_count - 1 };
+
+		for ( int i = 0; i < 2000; ++i )
+		{
+			const ItemIndex item { item_dist( rng ) };
+			bounds[ item ] = makeObject( rng, worldExtent( object_count ) );
+			hierarchy.update( item, bounds[ item ] );
+		}
+
+		hierarchy.refit();
+
+		REQUIRE( checkFrustums( hierarchy, bounds, frustums ) > 0 );
+	}
+
+	SECTION( "A frustum containing everything returns every object" )
+	{
+		const float extent { worldExtent( object_count ) * 2.0f };
+		const Planes everything { makePlane( { 1.0f, 0.0f, 0.0f }, glm::vec3( -extent ) ),
+			                      makePlane( { -1.0f, 0.0f, 0.0f }, glm::vec3( extent ) ),
+			                      makePlane( { 0.0f, 1.0f, 0.0f }, glm::vec3( -extent ) ),
+			                      makePlane( { 0.0f, -1.0f, 0.0f }, glm::vec3( extent ) ),
+			                      makePlane( { 0.0f, 0.0f, 1.0f }, glm::vec3( -extent ) ),
+			                      makePlane( { 0.0f, 0.0f, -1.0f }, glm::vec3( extent ) ) };
+
+		REQUIRE( checkFrustums( hierarchy, bounds, { everything } ) == object_count );
+	}
+}
+
+TEST_CASE( "BoundingVolumeHierarchy benchmarks", "[math][bvh][.benchmark]" )
+{
+	const std::size_t object_count { GENERATE( 10'000uz, 100'000uz, 1'000'000uz ) };
+	const std::string suffix { " (" + std::to_string( object_count ) + " objects)" };
+
+	const std::vector< BVHBounds > bounds { makeScene( object_count, 1234 ) };
+	const std::vector< Planes > frustums { makeFrustums( 16, worldExtent( object_count ), 4321 ) };
+
+	BENCHMARK( "Build" + suffix )
+	{
+		const BoundingVolumeHierarchy hierarchy { bounds };
+		return hierarchy.nodeCount();
+	};
+
+	const BoundingVolumeHierarchy hierarchy { bounds };
+	std::vector< ItemIndex > items {};
+
+	BENCHMARK( "Frustum query" + suffix )
+	{
+		items.clear();
+		for ( const Planes& planes : frustums ) hierarchy.query( planes, items );
+		return items.size();
+	};
+
+	BENCHMARK( "Brute force frustum query" + suffix )
+	{
+		items.clear();
+		for ( const Planes& planes : frustums ) bruteForceQuery( bounds, planes, items );
+		return items.size();
+	};
+}
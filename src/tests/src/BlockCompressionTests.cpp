@@ -0,0 +1,319 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <random>
+
+#include "engine/assets/texture/BlockCompression.hpp"
+
+using namespace fgl::engine;
+
+namespace
+{
+	struct BitReader
+	{
+		const std::uint8_t* m_data;
+		std::uint32_t m_bit { 0 };
+
+		std::uint32_t read( const std::uint32_t bits )
+		{
+			std::uint32_t value { 0 };
+
+			for ( std::uint32_t i = 0; i < bits; ++i, ++m_bit )
+				value |= static_cast< std::uint32_t >( ( m_data[ m_bit / 8 ] >> ( m_bit % 8 ) ) & 1 ) << i;
+
+			return value;
+		}
+	};
+
+	std::uint32_t interpolate( const std::uint32_t first, const std::uint32_t second, const std::uint32_t weight )
+	{
+		return ( ( 64 - weight ) * first + weight * second + 32 ) >> 6;
+	}
+
+	//! Decodes the BC7 modes encodeBC7Block writes (5 and 6), Following the BC7 specification
+	TexelBlock decodeBC7( const std::array< std::uint8_t, 16 >& block )
+	{
+		constexpr std::array< std::uint32_t, 4 > WEIGHTS_2 { 0, 21, 43, 64 };
+		constexpr std::array< std::uint32_t, 16 > WEIGHTS_4 { 0,  4,  9,  13, 17, 21, 26, 30,
+			                                                  34, 38, 43, 47, 51, 55, 60, 64 };
+
+		BitReader reader { block.data() };
+
+		std::uint32_t mode { 0 };
+		while ( mode < 8 && reader.read( 1 ) == 0 ) ++mode;
+
+		TexelBlock texels {};
+
+		if ( mode == 6 )
+		{
+			std::array< std::array< std::uint32_t, 4 >, 2 > endpoints {};
+
+			for ( std::uint32_t channel = 0; channel < 4; ++channel )
+				for ( auto& endpoint : endpoints ) endpoint[ channel ] = reader.read( 7 );
+
+			for ( auto& endpoint : endpoints )
+			{
+				const std::uint32_t pbit { reader.read( 1 ) };
+				for ( auto& value : endpoint ) value = ( value << 1 ) | pbit;
+			}
+
+			for ( std::uint32_t texel = 0; texel < 16; ++texel )
+			{
+				const std::uint32_t index { reader.read( texel == 0 ? 3 : 4 ) };
+
+				for ( std::uint32_t channel = 0; channel < 4; ++channel )
+					texels[ texel * 4 + channel ] = static_cast< std::uint8_t >(
+						interpolate( endpoints[ 0 ][ channel ], endpoints[ 1 ][ channel ], WEIGHTS_4[ index ] ) );
+			}
+
+			return texels;
+		}
+
+		REQUIRE( mode == 5 );
+
+		const std::uint32_t rotation { reader.read( 2 ) };
+		REQUIRE( rotation == 0 );
+
+		std::array< std::array< std::uint32_t, 4 >, 2 > endpoints {};
+
+		for ( std::uint32_t channel = 0; channel < 3; ++channel )
+			for ( auto& endpoint : endpoints )
+			{
+				const std::uint32_t value { reader.read( 7 ) };
+				endpoint[ channel ] = ( value << 1 ) | ( value >> 6 );
+			}
+
+		for ( auto& endpoint : endpoints ) endpoint[ 3 ] = reader.read( 8 );
+
+		std::array< std::uint32_t, 16 > color_indices {};
+		std::array< std::uint32_t, 16 > alpha_indices {};
+
+		for ( std::uint32_t texel = 0; texel < 16; ++texel ) color_indices[ texel ] = reader.read( texel == 0 ? 1 : 2 );
+		for ( std::uint32_t texel = 0; texel < 16; ++texel ) alpha_indices[ texel ] = reader.read( texel == 0 ? 1 : 2 );
+
+		for ( std::uint32_t texel = 0; texel < 16; ++texel )
+		{
+			for ( std::uint32_t channel = 0; channel < 4; ++channel )
+			{
+				const std::uint32_t index { channel == 3 ? alpha_indices[ texel ] : color_indices[ texel ] };
+				texels[ texel * 4 + channel ] = static_cast< std::uint8_t >(
+					interpolate( endpoints[ 0 ][ channel ], endpoints[ 1 ][ channel ], WEIGHTS_2[ index ] ) );
+			}
+		}
+
+		return texels;
+	}
+
+	//! Decodes a BC4 block into a single channel of the texels
+	void decodeBC4( const std::uint8_t* block, const std::uint32_t channel, TexelBlock& texels )
+	{
+		const std::uint32_t first { block[ 0 ] };
+		const std::uint32_t second { block[ 1 ] };
+
+		std::array< std::uint32_t, 8 > palette { first, second };
+
+		if ( first > second )
+		{
+			for ( std::uint32_t i = 1; i < 7; ++i ) palette[ i + 1 ] = ( ( 7 - i ) * first + i * second ) / 7;
+		}
+		else
+		{
+			for ( std::uint32_t i = 1; i < 5; ++i ) palette[ i + 1 ] = ( ( 5 - i ) * first + i * second ) / 5;
+			palette[ 6 ] = 0;
+			palette[ 7 ] = 255;
+		}
+
+		std::uint64_t bits { 0 };
+		for ( std::uint32_t byte = 0; byte < 6; ++byte ) bits |= std::uint64_t( block[ 2 + byte ] ) << ( byte * 8 );
+
+		for ( std::uint32_t texel = 0; texel < 16; ++texel )
+			texels[ texel * 4 + channel ] = static_cast< std::uint8_t >( palette[ ( bits >> ( texel * 3 ) ) & 7 ] );
+	}
+
+	TexelBlock solidBlock( const std::array< std::uint8_t, 4 >& color )
+	{
+		TexelBlock texels {};
+		for ( std::uint32_t texel = 0; texel < 16; ++texel )
+			for ( std::uint32_t channel = 0; channel < 4; ++channel ) texels[ texel * 4 + channel ] = color[ channel ];
+
+		return texels;
+	}
+
+	//! Blend between two colors across the block along a random direction. Channels change by up to 64 over the block,
+	//! About as much as a smooth surface does over 4 texels
+	TexelBlock gradientBlock( std::mt19937& rng )
+	{
+		std::uniform_real_distribution< float > channel_dist { 0.0f, 255.0f };
+		std::uniform_real_distribution< float > change_dist { -64.0f, 64.0f };
+		std::uniform_real_distribution< float > angle_dist { 0.0f, 2.0f * std::numbers::pi_v< float > };
+
+		std::array< float, 4 > from {};
+		std::array< float, 4 > to {};
+
+		for ( std::uint32_t channel = 0; channel < 4; ++channel )
+		{
+			from[ channel ] = channel_dist( rng );
+			to[ channel ] = std::clamp( from[ channel ] + change_dist( rng ), 0.0f, 255.0f );
+		}
+
+		const float angle { angle_dist( rng ) };
+		const float direction_x { std::cos( angle ) };
+		const float direction_y { std::sin( angle ) };
+
+		TexelBlock texels {};
+
+		for ( int y = 0; y < 4; ++y )
+			for ( int x = 0; x < 4; ++x )
+			{
+				// Position along the direction, 0 and 1 being just past the corners
+				const float t { ( ( x - 1.5f ) * direction_x + ( y - 1.5f ) * direction_y ) / 4.25f + 0.5f };
+
+				for ( std::uint32_t channel = 0; channel < 4; ++channel )
+				{
+					const float value { from[ channel ] + ( to[ channel ] - from[ channel ] ) * t };
+					texels[ ( y * 4 + x ) * 4 + channel ] = static_cast< std::uint8_t >( std::round( value ) );
+				}
+			}
+
+		return texels;
+	}
+
+	//! Peak signal to noise ratio of the channels, In dB. Identical blocks are infinite
+	double psnr(
+		const TexelBlock& original, const TexelBlock& decoded, const std::uint32_t first, const std::uint32_t count )
+	{
+		double squared_error { 0.0 };
+
+		for ( std::uint32_t texel = 0; texel < 16; ++texel )
+			for ( std::uint32_t channel = first; channel < first + count; ++channel )
+			{
+				const double difference { double( original[ texel * 4 + channel ] ) - decoded[ texel * 4 + channel ] };
+				squared_error += difference * difference;
+			}
+
+		const double mean_error { squared_error / ( 16.0 * count ) };
+		if ( mean_error == 0.0 ) return std::numeric_limits< double >::infinity();
+
+		return 10.0 * std::log10( 255.0 * 255.0 / mean_error );
+	}
+
+	//! Lowest quality any gradient block may be compressed to
+	constexpr double BC7_GRADIENT_PSNR { 42.0 };
+	constexpr double BC4_GRADIENT_PSNR { 36.0 };
+
+} // namespace
+
+TEST_CASE( "BC7 compression", "[texture][compression]" )
+{
+	SECTION( "Solid blocks decode exactly" )
+	{
+		// Mode 6 can not represent these, As it's endpoints share their low bit between every channel
+		std::vector< std::array< std::uint8_t, 4 > > colors { { 0, 0, 0, 255 },
+			                                                  { 255, 255, 255, 255 },
+			                                                  { 0, 0, 0, 0 },
+			                                                  { 1, 2, 3, 4 },
+			                                                  { 254, 0, 127, 128 } };
+
+		std::mt19937 rng { 1234 };
+		std::uniform_int_distribution< int > channel_dist { 0, 255 };
+
+		for ( int i = 0; i < 1000; ++i )
+			colors.push_back( { static_cast< std::uint8_t >( channel_dist( rng ) ),
+			                    static_cast< std::uint8_t >( channel_dist( rng ) ),
+			                    static_cast< std::uint8_t >( channel_dist( rng ) ),
+			                    static_cast< std::uint8_t >( channel_dist( rng ) ) } );
+
+		// Every value of every channel
+		for ( int value = 0; value < 256; ++value )
+		{
+			const auto v { static_cast< std::uint8_t >( value ) };
+			colors.push_back( { v, static_cast< std::uint8_t >( 255 - v ), v, static_cast< std::uint8_t >( 255 - v ) } );
+		}
+
+		for ( const auto& color : colors )
+		{
+			const TexelBlock texels { solidBlock( color ) };
+
+			std::array< std::uint8_t, 16 > block {};
+			encodeBC7Block( texels, block.data() );
+
+			REQUIRE( decodeBC7( block ) == texels );
+		}
+	}
+
+	SECTION( "Gradient blocks stay above the quality floor" )
+	{
+		std::mt19937 rng { 4321 };
+
+		for ( int i = 0; i < 1000; ++i )
+		{
+			const TexelBlock texels { gradientBlock( rng ) };
+
+			std::array< std::uint8_t, 16 > block {};
+			encodeBC7Block( texels, block.data() );
+
+			REQUIRE( psnr( texels, decodeBC7( block ), 0, 4 ) >= BC7_GRADIENT_PSNR );
+		}
+	}
+}
+
+TEST_CASE( "BC4 and BC5 compression", "[texture][compression]" )
+{
+	SECTION( "Solid blocks decode exactly" )
+	{
+		for ( int value = 0; value < 256; ++value )
+		{
+			const auto v { static_cast< std::uint8_t >( value ) };
+			const TexelBlock texels { solidBlock( { v, static_cast< std::uint8_t >( 255 - v ), 0, 0 } ) };
+
+			std::array< std::uint8_t, 8 > bc4 {};
+			encodeBC4Block( texels, 0, bc4.data() );
+
+			TexelBlock decoded {};
+			decodeBC4( bc4.data(), 0, decoded );
+			REQUIRE( psnr( texels, decoded, 0, 1 ) == std::numeric_limits< double >::infinity() );
+
+			std::array< std::uint8_t, 16 > bc5 {};
+			encodeBC5Block( texels, bc5.data() );
+
+			decoded = {};
+			decodeBC4( bc5.data(), 0, decoded );
+			decodeBC4( bc5.data() + 8, 1, decoded );
+			REQUIRE( psnr( texels, decoded, 0, 2 ) == std::numeric_limits< double >::infinity() );
+		}
+	}
+
+	SECTION( "Gradient blocks stay above the quality floor" )
+	{
+		std::mt19937 rng { 4321 };
+
+		for ( int i = 0; i < 1000; ++i )
+		{
+			const TexelBlock texels { gradientBlock( rng ) };
+
+			std::array< std::uint8_t, 8 > bc4 {};
+			encodeBC4Block( texels, 2, bc4.data() );
+
+			TexelBlock decoded {};
+			decodeBC4( bc4.data(), 2, decoded );
+			REQUIRE( psnr( texels, decoded, 2, 1 ) >= BC4_GRADIENT_PSNR );
+
+			std::array< std::uint8_t, 16 > bc5 {};
+			encodeBC5Block( texels, bc5.data() );
+
+			decoded = {};
+			decodeBC4( bc5.data(), 0, decoded );
+			decodeBC4( bc5.data() + 8, 1, decoded );
+			REQUIRE( psnr( texels, decoded, 0, 2 ) >= BC4_GRADIENT_PSNR );
+		}
+	}
+}
@@ -0,0 +1,214 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "engine/assets/transfer/DirtyRanges.hpp"
+
+using namespace fgl::engine::memory;
+
+namespace
+{
+	//! Same size as an instance of a model in the instance buffer
+	struct Element
+	{
+		std::array< float, 16 > m_matrix;
+	};
+
+	std::span< const std::byte > bytes( const Element& element )
+	{
+		return std::as_bytes( std::span< const Element, 1 >( &element, 1 ) );
+	}
+
+	Element makeElement( const std::uint32_t value )
+	{
+		Element element {};
+		element.m_matrix.fill( static_cast< float >( value ) );
+		return element;
+	}
+
+	//! Copy from the staging ring into the target vector, Standing in for a vk::BufferCopy
+	struct CopyRegion
+	{
+		std::size_t m_src_offset;
+		std::size_t m_dst_offset;
+		std::size_t m_size;
+	};
+
+	//! Stand in for the staging ring and the copy regions recorded from it
+	struct Staging
+	{
+		std::vector< std::byte > m_ring {};
+		std::size_t m_head { 0 };
+		std::vector< CopyRegion > m_regions {};
+
+		explicit Staging( const std::size_t size ) : m_ring( size ) {}
+
+		std::span< std::byte > reserve( const std::size_t size, const std::size_t dst_offset )
+		{
+			m_regions.emplace_back( m_head, dst_offset, size );
+			const std::span< std::byte > region { m_ring.data() + m_head, size };
+			m_head += size;
+			return region;
+		}
+
+		void reset()
+		{
+			m_head = 0;
+			m_regions.clear();
+		}
+	};
+
+	//! Same as TransferManager::flushDirtyRanges
+	void flush( DirtyRanges& ranges, Staging& staging )
+	{
+		for ( const auto& range : ranges.ranges() )
+		{
+			ranges.read( range, staging.reserve( range.m_count * ranges.stride(), range.m_first * ranges.stride() ) );
+		}
+
+		ranges.clear();
+	}
+
+	//! Indexes updated in a frame, Mostly scattered with some runs of adjacent elements
+	std::vector< std::uint32_t > makeUpdates( const std::size_t count, const std::uint32_t elements )
+	{
+		std::mt19937 rng { 1234 };
+		std::uniform_int_distribution< std::uint32_t > index_dist { 0, elements - 1 };
+
+		std::vector< std::uint32_t > updates {};
+		updates.reserve( count );
+
+		while ( updates.size() < count )
+		{
+			const std::uint32_t first { index_dist( rng ) };
+			for ( std::uint32_t i = first; i < std::min( first + 8, elements ) && updates.size() < count; ++i )
+				updates.push_back( i );
+		}
+
+		return updates;
+	}
+
+} // namespace
+
+TEST_CASE( "DirtyRanges", "[transfer]" )
+{
+	DirtyRanges ranges { nullptr, sizeof( Element ) };
+
+	REQUIRE( ranges.empty() );
+	REQUIRE( ranges.ranges().empty() );
+
+	SECTION( "Adjacent elements are merged" )
+	{
+		for ( const std::uint32_t idx : { 5u, 3u, 4u, 10u } ) ranges.write( idx, bytes( makeElement( idx ) ) );
+
+		const auto merged { ranges.ranges() };
+		REQUIRE( merged.size() == 2 );
+		REQUIRE( merged[ 0 ].m_first == 3 );
+		REQUIRE( merged[ 0 ].m_count == 3 );
+		REQUIRE( merged[ 1 ].m_first == 10 );
+		REQUIRE( merged[ 1 ].m_count == 1 );
+
+		std::vector< Element > out( 3 );
+		ranges.read( merged[ 0 ], std::as_writable_bytes( std::span( out ) ) );
+
+		for ( std::uint32_t i = 0; i < 3; ++i ) REQUIRE( out[ i ].m_matrix[ 0 ] == static_cast< float >( 3 + i ) );
+	}
+
+	SECTION( "Runs across bitmap words are merged" )
+	{
+		for ( std::uint32_t idx = 60; idx < 200; ++idx ) ranges.write( idx, bytes( makeElement( idx ) ) );
+
+		const auto merged { ranges.ranges() };
+		REQUIRE( merged.size() == 1 );
+		REQUIRE( merged[ 0 ].m_first == 60 );
+		REQUIRE( merged[ 0 ].m_count == 140 );
+	}
+
+	SECTION( "Writing an element again replaces it" )
+	{
+		ranges.write( 7, bytes( makeElement( 1 ) ) );
+		ranges.write( 7, bytes( makeElement( 2 ) ) );
+
+		const auto merged { ranges.ranges() };
+		REQUIRE( merged.size() == 1 );
+		REQUIRE( merged[ 0 ].m_count == 1 );
+
+		Element out {};
+		ranges.read( merged[ 0 ], std::as_writable_bytes( std::span< Element, 1 >( &out, 1 ) ) );
+		REQUIRE( out.m_matrix[ 0 ] == 2.0f );
+	}
+
+	SECTION( "Clearing forgets every element" )
+	{
+		ranges.write( 0, bytes( makeElement( 0 ) ) );
+		ranges.write( 63, bytes( makeElement( 63 ) ) );
+		ranges.write( 64, bytes( makeElement( 64 ) ) );
+		ranges.write( 1000, bytes( makeElement( 1000 ) ) );
+		ranges.clear();
+
+		REQUIRE( ranges.empty() );
+		REQUIRE( ranges.ranges().empty() );
+
+		ranges.write( 64, bytes( makeElement( 64 ) ) );
+
+		const auto merged { ranges.ranges() };
+		REQUIRE( merged.size() == 1 );
+		REQUIRE( merged[ 0 ].m_first == 64 );
+	}
+}
+
+TEST_CASE( "DirtyRanges benchmarks", "[transfer][.benchmark]" )
+{
+	constexpr std::uint32_t elements { 100'000 };
+	const std::vector< std::uint32_t > updates { makeUpdates( 10'000, elements ) };
+
+	Staging staging { updates.size() * sizeof( Element ) };
+
+	// What copyToVector( const T&, idx ) did before updates were coalesced. Each update got it's own allocation
+	// for the data, Was copied into the ring when submitted, And was recorded as it's own copy region.
+	BENCHMARK( "Per element updates" )
+	{
+		staging.reset();
+
+		std::vector< std::vector< std::byte > > queue {};
+
+		for ( const std::uint32_t idx : updates )
+		{
+			const Element element { makeElement( idx ) };
+
+			std::vector< std::byte > data( sizeof( Element ) );
+			std::memcpy( data.data(), &element, sizeof( Element ) );
+
+			queue.emplace_back( std::move( data ) );
+		}
+
+		for ( std::size_t i = 0; i < queue.size(); ++i )
+		{
+			const auto region { staging.reserve( sizeof( Element ), updates[ i ] * sizeof( Element ) ) };
+			std::memcpy( region.data(), queue[ i ].data(), sizeof( Element ) );
+		}
+
+		return staging.m_regions.size();
+	};
+
+	DirtyRanges ranges { nullptr, sizeof( Element ) };
+
+	BENCHMARK( "Coalesced updates" )
+	{
+		staging.reset();
+
+		for ( const std::uint32_t idx : updates ) ranges.write( idx, bytes( makeElement( idx ) ) );
+
+		flush( ranges, staging );
+
+		return staging.m_regions.size();
+	};
+}
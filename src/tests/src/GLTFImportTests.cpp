@@ -0,0 +1,178 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include <catch2/catch_all.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "engine/assets/model/ModelVertex.hpp"
+#include "engine/assets/model/builders/AccessorData.hpp"
+#include "engine/assets/model/builders/Tangents.hpp"
+
+using namespace fgl::engine;
+
+namespace
+{
+
+	//! Appends the elements to the model's only buffer, Adding a buffer view and accessor for them
+	template < typename T >
+	int addAccessor( tinygltf::Model& model, const std::span< const T > elements, const int type, const int component )
+	{
+		if ( model.buffers.empty() ) model.buffers.emplace_back();
+		auto& buffer { model.buffers.front() };
+
+		tinygltf::BufferView view {};
+		view.buffer = 0;
+		view.byteOffset = buffer.data.size();
+		view.byteLength = elements.size_bytes();
+
+		buffer.data.resize( buffer.data.size() + elements.size_bytes() );
+		std::memcpy( buffer.data.data() + view.byteOffset, elements.data(), elements.size_bytes() );
+
+		model.bufferViews.emplace_back( std::move( view ) );
+
+		tinygltf::Accessor accessor {};
+		accessor.bufferView = static_cast< int >( model.bufferViews.size() - 1 );
+		accessor.byteOffset = 0;
+		accessor.componentType = component;
+		accessor.type = type;
+		accessor.count = elements.size();
+
+		model.accessors.emplace_back( std::move( accessor ) );
+
+		return static_cast< int >( model.accessors.size() - 1 );
+	}
+
+	struct Grid
+	{
+		std::vector< ModelVertex > m_verts;
+		std::vector< std::uint32_t > m_indicies;
+	};
+
+	//! Flat grid of size x size vertices facing +Z, With the uvs following X and Y
+	Grid makeGrid( const std::uint32_t size )
+	{
+		Grid grid {};
+
+		for ( std::uint32_t y = 0; y < size; ++y )
+			for ( std::uint32_t x = 0; x < size; ++x )
+			{
+				const glm::vec2 uv { static_cast< float >( x ) / static_cast< float >( size - 1 ),
+					                 static_cast< float >( y ) / static_cast< float >( size - 1 ) };
+				grid.m_verts.emplace_back( glm::vec3( uv, 0.0f ), glm::vec3( 1.0f ), glm::vec3( 0.0f, 0.0f, 1.0f ), uv );
+			}
+
+		for ( std::uint32_t y = 0; y + 1 < size; ++y )
+			for ( std::uint32_t x = 0; x + 1 < size; ++x )
+			{
+				const std::uint32_t corner { y * size + x };
+				grid.m_indicies.insert(
+					grid.m_indicies.end(),
+					{ corner, corner + 1, corner + size, corner + 1, corner + size + 1, corner + size } );
+			}
+
+		return grid;
+	}
+
+} // namespace
+
+TEST_CASE( "GLTF accessors", "[gltf]" )
+{
+	tinygltf::Model model {};
+
+	SECTION( "VEC4 accessors are extracted" )
+	{
+		// Tangents are VEC4, With the handedness in w
+		const std::vector< glm::vec4 > tangents { { 1.0f, 0.0f, 0.0f, 1.0f },
+			                                      { 0.0f, 1.0f, 0.0f, -1.0f },
+			                                      { 0.0f, 0.0f, 1.0f, 1.0f } };
+
+		// Placed after other data, So the offset of the buffer view is used
+		const std::vector< glm::vec3 > positions { { 1.0f, 2.0f, 3.0f } };
+		addAccessor< glm::vec3 >( model, positions, TINYGLTF_TYPE_VEC3, TINYGLTF_COMPONENT_TYPE_FLOAT );
+		const int accessor {
+			addAccessor< glm::vec4 >( model, tangents, TINYGLTF_TYPE_VEC4, TINYGLTF_COMPONENT_TYPE_FLOAT )
+		};
+
+		const auto extracted { extractData< glm::vec4 >( model, model.accessors[ accessor ] ) };
+
+		REQUIRE( extracted.size() == tangents.size() );
+		for ( std::size_t i = 0; i < tangents.size(); ++i ) REQUIRE( extracted[ i ] == tangents[ i ] );
+	}
+
+	SECTION( "VEC4 accessors can not be extracted into smaller types" )
+	{
+		const std::vector< glm::vec4 > tangents( 4, glm::vec4( 1.0f ) );
+		const int accessor {
+			addAccessor< glm::vec4 >( model, tangents, TINYGLTF_TYPE_VEC4, TINYGLTF_COMPONENT_TYPE_FLOAT )
+		};
+
+		REQUIRE_THROWS( extractData< glm::vec3 >( model, model.accessors[ accessor ] ) );
+	}
+
+	SECTION( "Scalar indicies are widened" )
+	{
+		const std::vector< std::uint16_t > indicies { 0, 1, 2, 65535 };
+		const int accessor {
+			addAccessor< std::uint16_t >( model, indicies, TINYGLTF_TYPE_SCALAR, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT )
+		};
+
+		const auto extracted { extractData< std::uint32_t >( model, model.accessors[ accessor ] ) };
+		REQUIRE( extracted == std::vector< std::uint32_t > { 0, 1, 2, 65535 } );
+	}
+}
+
+TEST_CASE( "Tangent generation", "[gltf]" )
+{
+	Grid grid { makeGrid( 8 ) };
+	generateTrisTangents( grid.m_verts, grid.m_indicies );
+
+	// U follows +X on a surface facing +Z, So every tangent is +X and right handed
+	for ( const ModelVertex& vert : grid.m_verts )
+	{
+		REQUIRE_THAT( vert.m_tangent.x, Catch::Matchers::WithinAbs( 1.0f, 1e-4 ) );
+		REQUIRE_THAT( vert.m_tangent.y, Catch::Matchers::WithinAbs( 0.0f, 1e-4 ) );
+		REQUIRE_THAT( vert.m_tangent.z, Catch::Matchers::WithinAbs( 0.0f, 1e-4 ) );
+		REQUIRE( vert.m_tangent.w == 1.0f );
+	}
+}
+
+TEST_CASE( "Tangent benchmarks", "[gltf][.benchmark]" )
+{
+	const Grid grid { makeGrid( 256 ) };
+
+	// The tangents an asset would ship with, Stored the same way as in a GLTF file
+	Grid supplied { grid };
+	generateTrisTangents( supplied.m_verts, supplied.m_indicies );
+
+	std::vector< glm::vec4 > tangents {};
+	for ( const ModelVertex& vert : supplied.m_verts ) tangents.emplace_back( vert.m_tangent );
+
+	tinygltf::Model model {};
+	const int accessor {
+		addAccessor< glm::vec4 >( model, tangents, TINYGLTF_TYPE_VEC4, TINYGLTF_COMPONENT_TYPE_FLOAT )
+	};
+
+	// What SceneBuilder::loadPrimitive does when the primitive has no TANGENT attribute
+	BENCHMARK( "Generated tangents (mikktspace)" )
+	{
+		std::vector< ModelVertex > verts { grid.m_verts };
+		generateTrisTangents( verts, grid.m_indicies );
+		return verts.back().m_tangent.w;
+	};
+
+	// Same as SceneBuilder::extractVertexInfo when it does
+	BENCHMARK( "Supplied tangents" )
+	{
+		std::vector< ModelVertex > verts { grid.m_verts };
+		const std::vector< glm::vec4 > extracted { extractData< glm::vec4 >( model, model.accessors[ accessor ] ) };
+
+		for ( std::size_t i = 0; i < verts.size(); ++i ) verts[ i ].m_tangent = extracted[ i ];
+
+		return verts.back().m_tangent.w;
+	};
+}
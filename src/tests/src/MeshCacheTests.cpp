@@ -0,0 +1,201 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "engine/assets/model/builders/MeshCache.hpp"
+
+using namespace fgl::engine;
+
+namespace
+{
+	constexpr std::uint64_t SOURCE_HASH { 0xFEDCBA9876543210 };
+	constexpr int MATERIAL { 3 };
+
+	//! Directory removed once the test is done with it
+	struct TemporaryDirectory
+	{
+		std::filesystem::path m_path { std::filesystem::temp_directory_path() / "fgl_mesh_cache_tests" };
+
+		TemporaryDirectory() { std::filesystem::remove_all( m_path ); }
+
+		~TemporaryDirectory() { std::filesystem::remove_all( m_path ); }
+	};
+
+	//! A single quad with two levels of detail and a meshlet, Cooked as the second of three meshes
+	struct CookedQuad
+	{
+		std::vector< ModelVertex > m_verts {};
+		std::vector< std::uint32_t > m_indicies { 0, 1, 2, 1, 3, 2, 0, 3, 2 };
+		std::vector< PrimitiveLod > m_lods { { 0, 6, 0.0f, 0 }, { 6, 3, 0.5f, 0 } };
+		std::vector< PrimitiveMeshlet > m_meshlets { PrimitiveMeshlet {} };
+
+		CookedQuad()
+		{
+			for ( const glm::vec2 corner : { glm::vec2( 0.0f, 0.0f ),
+			                                 glm::vec2( 1.0f, 0.0f ),
+			                                 glm::vec2( 0.0f, 1.0f ),
+			                                 glm::vec2( 1.0f, 1.0f ) } )
+				m_verts.emplace_back(
+					glm::vec3( corner, 0.0f ), glm::vec3( 1.0f ), glm::vec3( 0.0f, 0.0f, 1.0f ), corner );
+
+			m_meshlets[ 0 ].m_first_index = 0;
+			m_meshlets[ 0 ].m_index_count = 6;
+			m_meshlets[ 0 ].m_cone_cutoff = 1.0f;
+		}
+
+		void write( const std::filesystem::path& path ) const
+		{
+			const OrientedBoundingBox< CoordinateSpace::Model > bounds {
+				Coordinate< CoordinateSpace::Model >( glm::vec3( 0.5f, 0.5f, 0.0f ) ), glm::vec3( 0.5f, 0.5f, 0.0f )
+			};
+
+			MeshCacheWriter writer { 3 };
+			writer.addPrimitive(
+				1,
+				0,
+				m_verts,
+				m_indicies,
+				m_lods,
+				m_meshlets,
+				PrimitiveMode::TRIS,
+				bounds,
+				MATERIAL,
+				COOKED_HAS_TEXCOORD );
+			writer.write( path, SOURCE_HASH );
+		}
+	};
+
+	//! Overwrites part of the file in place
+	template < typename T >
+	void overwrite( const std::filesystem::path& path, const std::uint64_t offset, const T& value )
+	{
+		std::fstream file { path, std::ios::binary | std::ios::in | std::ios::out };
+		file.seekp( static_cast< std::streamoff >( offset ) );
+		file.write( reinterpret_cast< const char* >( &value ), sizeof( value ) );
+	}
+
+	template < typename T >
+	T readAt( const std::filesystem::path& path, const std::uint64_t offset )
+	{
+		std::ifstream file { path, std::ios::binary };
+		file.seekg( static_cast< std::streamoff >( offset ) );
+
+		T value {};
+		file.read( reinterpret_cast< char* >( &value ), sizeof( value ) );
+		return value;
+	}
+
+	//! Offset of the first cooked primitive, Which directly follows the header and mesh table
+	std::uint64_t primitiveOffset( const std::uint32_t mesh_count )
+	{
+		return sizeof( CookedMeshHeader ) + sizeof( CookedMesh ) * mesh_count;
+	}
+
+} // namespace
+
+TEST_CASE( "Mesh cache", "[mesh][cache]" )
+{
+	const TemporaryDirectory directory {};
+	const std::filesystem::path path { directory.m_path / "scene.fglmesh" };
+
+	const CookedQuad quad {};
+	quad.write( path );
+
+	SECTION( "Opening gives back what was written" )
+	{
+		const auto cache { MeshCache::open( path, SOURCE_HASH ) };
+		REQUIRE( cache.has_value() );
+
+		REQUIRE( cache->meshCount() == 3 );
+		REQUIRE( cache->primitives( 0 ).empty() );
+		REQUIRE( cache->primitives( 2 ).empty() );
+		REQUIRE( cache->primitives( 1 ).size() == 1 );
+
+		const CookedPrimitive& primitive { cache->primitives( 1 ).front() };
+
+		REQUIRE( primitive.m_mode == PrimitiveMode::TRIS );
+		REQUIRE( primitive.m_material == MATERIAL );
+		REQUIRE( primitive.m_flags == COOKED_HAS_TEXCOORD );
+		// The bounds are cooked from the transformed corners of the box, So are only close to the original
+		for ( glm::length_t i = 0; i < 3; ++i )
+		{
+			REQUIRE_THAT( primitive.m_bounds_center[ i ], Catch::Matchers::WithinAbs( i < 2 ? 0.5f : 0.0f, 1e-5f ) );
+			REQUIRE_THAT( primitive.m_bounds_extent[ i ], Catch::Matchers::WithinAbs( i < 2 ? 0.5f : 0.0f, 1e-5f ) );
+		}
+
+		const auto verts { cache->vertices( primitive ) };
+		REQUIRE( verts.size() == quad.m_verts.size() );
+		REQUIRE( std::memcmp( verts.data(), quad.m_verts.data(), verts.size_bytes() ) == 0 );
+
+		const auto indicies { cache->indicies( primitive ) };
+		REQUIRE( std::vector< std::uint32_t >( indicies.begin(), indicies.end() ) == quad.m_indicies );
+
+		const auto lods { MeshCache::lods( primitive ) };
+		REQUIRE( lods.size() == quad.m_lods.size() );
+		REQUIRE( std::memcmp( lods.data(), quad.m_lods.data(), lods.size_bytes() ) == 0 );
+
+		const auto meshlets { cache->meshlets( primitive ) };
+		REQUIRE( meshlets.size() == quad.m_meshlets.size() );
+		REQUIRE( std::memcmp( meshlets.data(), quad.m_meshlets.data(), meshlets.size_bytes() ) == 0 );
+	}
+
+	SECTION( "A cache for a different source is rejected" )
+	{
+		REQUIRE_FALSE( MeshCache::open( path, SOURCE_HASH + 1 ).has_value() );
+	}
+
+	SECTION( "A missing cache is rejected" )
+	{
+		REQUIRE_FALSE( MeshCache::open( directory.m_path / "missing.fglmesh", SOURCE_HASH ).has_value() );
+	}
+
+	SECTION( "A truncated cache is rejected" )
+	{
+		std::filesystem::resize_file( path, std::filesystem::file_size( path ) - 1 );
+		REQUIRE_FALSE( MeshCache::open( path, SOURCE_HASH ).has_value() );
+	}
+
+	SECTION( "A cache with data appended is rejected" )
+	{
+		std::ofstream { path, std::ios::binary | std::ios::app }.put( 0 );
+		REQUIRE_FALSE( MeshCache::open( path, SOURCE_HASH ).has_value() );
+	}
+
+	SECTION( "A cache with an index past the vertices is rejected" )
+	{
+		const auto header { readAt< CookedMeshHeader >( path, 0 ) };
+		const auto primitive { readAt< CookedPrimitive >( path, primitiveOffset( header.m_mesh_count ) ) };
+
+		// The last index, Which is only used by the second level of detail
+		const std::uint64_t index_offset { header.m_data_offset + primitive.m_index_offset
+			                               + ( quad.m_indicies.size() - 1 ) * sizeof( std::uint32_t ) };
+		overwrite( path, index_offset, static_cast< std::uint32_t >( quad.m_verts.size() ) );
+
+		REQUIRE_FALSE( MeshCache::open( path, SOURCE_HASH ).has_value() );
+	}
+
+	SECTION( "A cache with a level of detail past the indicies is rejected" )
+	{
+		const auto header { readAt< CookedMeshHeader >( path, 0 ) };
+		const std::uint64_t lod_offset { primitiveOffset( header.m_mesh_count ) + offsetof( CookedPrimitive, m_lods )
+			                             + sizeof( PrimitiveLod ) };
+
+		overwrite( path, lod_offset, PrimitiveLod { 6, 6, 0.5f, 0 } );
+
+		REQUIRE_FALSE( MeshCache::open( path, SOURCE_HASH ).has_value() );
+	}
+
+	SECTION( "A cache with a bad magic is rejected" )
+	{
+		overwrite( path, 0, std::uint32_t( 0 ) );
+		REQUIRE_FALSE( MeshCache::open( path, SOURCE_HASH ).has_value() );
+	}
+}
@@ -0,0 +1,416 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "engine/assets/model/ModelVertex.hpp"
+#include "engine/assets/model/builders/MeshOptimizer.hpp"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Weffc++"
+#include <glm/geometric.hpp>
+#pragma GCC diagnostic pop
+
+using namespace fgl::engine;
+
+namespace
+{
+	using Triangle = std::array< std::uint32_t, 3 >;
+	using PositionTriangle = std::array< std::array< float, 3 >, 3 >;
+
+	struct Grid
+	{
+		std::vector< ModelVertex > m_verts;
+		std::vector< std::uint32_t > m_indicies;
+	};
+
+	//! Flat grid of size x size vertices facing +Z, Wound counter clockwise
+	Grid makeGrid( const std::uint32_t size )
+	{
+		Grid grid {};
+
+		for ( std::uint32_t y = 0; y < size; ++y )
+			for ( std::uint32_t x = 0; x < size; ++x )
+			{
+				const glm::vec3 position { static_cast< float >( x ), static_cast< float >( y ), 0.0f };
+				grid.m_verts.emplace_back(
+					position, glm::vec3( 1.0f ), glm::vec3( 0.0f, 0.0f, 1.0f ), glm::vec2( 0.0f ) );
+			}
+
+		for ( std::uint32_t y = 0; y + 1 < size; ++y )
+			for ( std::uint32_t x = 0; x + 1 < size; ++x )
+			{
+				const std::uint32_t corner { y * size + x };
+				grid.m_indicies.insert(
+					grid.m_indicies.end(),
+					{ corner, corner + 1, corner + size, corner + 1, corner + size + 1, corner + size } );
+			}
+
+		return grid;
+	}
+
+	//! Shuffles the order of the triangles, Leaving each triangle as it was
+	void shuffleTriangles( std::vector< std::uint32_t >& indicies, const std::uint32_t seed )
+	{
+		std::vector< Triangle > triangles {};
+		for ( std::size_t i = 0; i < indicies.size(); i += 3 )
+			triangles.push_back( { indicies[ i ], indicies[ i + 1 ], indicies[ i + 2 ] } );
+
+		std::mt19937 rng { seed };
+		std::ranges::shuffle( triangles, rng );
+
+		indicies.clear();
+		for ( const Triangle& triangle : triangles ) indicies.insert( indicies.end(), triangle.begin(), triangle.end() );
+	}
+
+	//! Rotates the triangle so it starts at it's smallest element, Which keeps the winding
+	template < typename T >
+	std::array< T, 3 > canonical( std::array< T, 3 > triangle )
+	{
+		std::ranges::rotate( triangle, std::ranges::min_element( triangle ) );
+		return triangle;
+	}
+
+	//! Every triangle of the indicies, In a form that can be compared regardless of triangle order
+	std::vector< Triangle > triangleSet( const std::vector< std::uint32_t >& indicies )
+	{
+		std::vector< Triangle > triangles {};
+		for ( std::size_t i = 0; i < indicies.size(); i += 3 )
+			triangles.push_back( canonical( Triangle { indicies[ i ], indicies[ i + 1 ], indicies[ i + 2 ] } ) );
+
+		std::ranges::sort( triangles );
+		return triangles;
+	}
+
+	//! Same as triangleSet, But by the vertex positions. Used when the vertices themselves are reordered
+	std::vector< PositionTriangle >
+		positionSet( const std::vector< ModelVertex >& verts, const std::vector< std::uint32_t >& indicies )
+	{
+		const auto position = [ &verts ]( const std::uint32_t index ) -> std::array< float, 3 >
+		{
+			const glm::vec3& p { verts[ index ].m_position };
+			return { p.x, p.y, p.z };
+		};
+
+		std::vector< PositionTriangle > triangles {};
+		for ( std::size_t i = 0; i < indicies.size(); i += 3 )
+			triangles.push_back( canonical(
+				PositionTriangle { position( indicies[ i ] ),
+				                   position( indicies[ i + 1 ] ),
+				                   position( indicies[ i + 2 ] ) } ) );
+
+		std::ranges::sort( triangles );
+		return triangles;
+	}
+
+	//! Sphere made by subdividing an octahedron. Closed, So no vertex is locked by a border
+	Grid makeSphere( const std::uint32_t subdivisions )
+	{
+		Grid sphere {};
+
+		const auto add_vertex = [ &sphere ]( const glm::vec3& position ) -> std::uint32_t
+		{
+			const glm::vec3 normal { glm::normalize( position ) };
+			sphere.m_verts.emplace_back( normal, glm::vec3( 1.0f ), normal, glm::vec2( 0.0f ) );
+			return static_cast< std::uint32_t >( sphere.m_verts.size() - 1 );
+		};
+
+		for ( const glm::vec3& corner : { glm::vec3( 1.0f, 0.0f, 0.0f ),
+		                                  glm::vec3( -1.0f, 0.0f, 0.0f ),
+		                                  glm::vec3( 0.0f, 1.0f, 0.0f ),
+		                                  glm::vec3( 0.0f, -1.0f, 0.0f ),
+		                                  glm::vec3( 0.0f, 0.0f, 1.0f ),
+		                                  glm::vec3( 0.0f, 0.0f, -1.0f ) } )
+			add_vertex( corner );
+
+		sphere.m_indicies = { 0, 2, 4, 2, 1, 4, 1, 3, 4, 3, 0, 4, 2, 0, 5, 1, 2, 5, 3, 1, 5, 0, 3, 5 };
+
+		for ( std::uint32_t level = 0; level < subdivisions; ++level )
+		{
+			// Edges shared by two triangles must share their midpoint, Or the sphere would have cracks
+			std::map< std::pair< std::uint32_t, std::uint32_t >, std::uint32_t > midpoints {};
+
+			const auto midpoint = [ & ]( const std::uint32_t a, const std::uint32_t b ) -> std::uint32_t
+			{
+				const auto key { std::minmax( a, b ) };
+				if ( const auto itter = midpoints.find( key ); itter != midpoints.end() ) return itter->second;
+
+				const auto index { add_vertex( sphere.m_verts[ a ].m_position + sphere.m_verts[ b ].m_position ) };
+				midpoints.emplace( key, index );
+				return index;
+			};
+
+			std::vector< std::uint32_t > indicies {};
+
+			for ( std::size_t i = 0; i < sphere.m_indicies.size(); i += 3 )
+			{
+				const auto a { sphere.m_indicies[ i ] };
+				const auto b { sphere.m_indicies[ i + 1 ] };
+				const auto c { sphere.m_indicies[ i + 2 ] };
+
+				const auto ab { midpoint( a, b ) };
+				const auto bc { midpoint( b, c ) };
+				const auto ca { midpoint( c, a ) };
+
+				indicies.insert( indicies.end(), { a, ab, ca, ab, b, bc, ca, bc, c, ab, bc, ca } );
+			}
+
+			sphere.m_indicies = std::move( indicies );
+		}
+
+		return sphere;
+	}
+
+	//! Average cache miss ratio, Misses per triangle
+	float acmr( const std::vector< std::uint32_t >& indicies, const std::size_t vertex_count )
+	{
+		return static_cast< float >( vertexCacheMisses( indicies, vertex_count ) )
+		     / static_cast< float >( indicies.size() / 3 );
+	}
+
+} // namespace
+
+TEST_CASE( "Vertex cache optimization", "[mesh][optimizer]" )
+{
+	Grid grid { makeGrid( 64 ) };
+
+	SECTION( "Keeps every triangle and it's winding" )
+	{
+		shuffleTriangles( grid.m_indicies, 1234 );
+		const auto expected { triangleSet( grid.m_indicies ) };
+
+		optimizeVertexCache( grid.m_indicies, grid.m_verts.size() );
+
+		REQUIRE( triangleSet( grid.m_indicies ) == expected );
+	}
+
+	SECTION( "Does not make the cache miss ratio of a grid worse" )
+	{
+		const float before { acmr( grid.m_indicies, grid.m_verts.size() ) };
+
+		optimizeVertexCache( grid.m_indicies, grid.m_verts.size() );
+
+		REQUIRE( acmr( grid.m_indicies, grid.m_verts.size() ) <= before );
+	}
+
+	SECTION( "Improves the cache miss ratio of a shuffled grid" )
+	{
+		shuffleTriangles( grid.m_indicies, 1234 );
+		const float before { acmr( grid.m_indicies, grid.m_verts.size() ) };
+
+		optimizeVertexCache( grid.m_indicies, grid.m_verts.size() );
+
+		// Each vertex of a grid is used by 6 triangles, So a shuffled grid misses on nearly every vertex
+		const float after { acmr( grid.m_indicies, grid.m_verts.size() ) };
+		REQUIRE( after < before );
+		REQUIRE( after < 1.0f );
+	}
+
+	SECTION( "Clusters start at a triangle and are in order" )
+	{
+		const auto clusters { optimizeVertexCache( grid.m_indicies, grid.m_verts.size() ) };
+
+		REQUIRE( !clusters.empty() );
+		REQUIRE( clusters.front() == 0 );
+		REQUIRE( std::ranges::is_sorted( clusters ) );
+		REQUIRE( clusters.back() < grid.m_indicies.size() / 3 );
+	}
+}
+
+TEST_CASE( "Vertex fetch optimization", "[mesh][optimizer]" )
+{
+	Grid grid { makeGrid( 16 ) };
+	shuffleTriangles( grid.m_indicies, 4321 );
+
+	SECTION( "Keeps every triangle and it's winding" )
+	{
+		const auto expected { positionSet( grid.m_verts, grid.m_indicies ) };
+
+		optimizeVertexFetch( grid.m_verts, grid.m_indicies );
+
+		REQUIRE( positionSet( grid.m_verts, grid.m_indicies ) == expected );
+	}
+
+	SECTION( "Orders the vertices by their first use" )
+	{
+		optimizeVertexFetch( grid.m_verts, grid.m_indicies );
+
+		std::uint32_t next { 0 };
+		for ( const std::uint32_t index : grid.m_indicies )
+		{
+			REQUIRE( index <= next );
+			if ( index == next ) ++next;
+		}
+
+		REQUIRE( next == grid.m_verts.size() );
+	}
+
+	SECTION( "Removes unused vertices" )
+	{
+		const std::size_t used { grid.m_verts.size() };
+		grid.m_verts.emplace_back(
+			glm::vec3( -1.0f ), glm::vec3( 1.0f ), glm::vec3( 0.0f, 0.0f, 1.0f ), glm::vec2( 0.0f ) );
+
+		const auto expected { positionSet( grid.m_verts, grid.m_indicies ) };
+
+		optimizeVertexFetch( grid.m_verts, grid.m_indicies );
+
+		REQUIRE( grid.m_verts.size() == used );
+		REQUIRE( positionSet( grid.m_verts, grid.m_indicies ) == expected );
+	}
+}
+
+TEST_CASE( "Mesh simplification", "[mesh][optimizer][lod]" )
+{
+	SECTION( "Levels of detail are within their target and never grow" )
+	{
+		const Grid sphere { makeSphere( 5 ) };
+		const auto lods { generateLods( sphere.m_verts, sphere.m_indicies, 4 ) };
+
+		REQUIRE( lods.size() == 4 );
+
+		std::size_t previous_count { sphere.m_indicies.size() };
+		float previous_error { 0.0f };
+
+		for ( const MeshLod& lod : lods )
+		{
+			// Same target generateLods gives simplifyMesh
+			REQUIRE( lod.m_indicies.size() <= previous_count / 6 * 3 );
+			REQUIRE( lod.m_indicies.size() % 3 == 0 );
+			REQUIRE( lod.m_error >= previous_error );
+
+			for ( const std::uint32_t index : lod.m_indicies ) REQUIRE( index < sphere.m_verts.size() );
+
+			previous_count = lod.m_indicies.size();
+			previous_error = lod.m_error;
+		}
+	}
+
+	SECTION( "Border vertices are kept" )
+	{
+		constexpr std::uint32_t size { 32 };
+		Grid grid { makeGrid( size ) };
+
+		const std::size_t target { grid.m_indicies.size() / 4 };
+		simplifyMesh( grid.m_indicies, grid.m_verts, target );
+
+		// The border is locked, So the interior is simplified but the outline of the grid never changes
+		REQUIRE( grid.m_indicies.size() <= target );
+
+		const std::set< std::uint32_t > used { grid.m_indicies.begin(), grid.m_indicies.end() };
+
+		for ( std::uint32_t i = 0; i < size; ++i )
+		{
+			REQUIRE( used.contains( i ) );
+			REQUIRE( used.contains( ( size - 1 ) * size + i ) );
+			REQUIRE( used.contains( i * size ) );
+			REQUIRE( used.contains( i * size + size - 1 ) );
+		}
+	}
+
+	SECTION( "A mesh too small to simplify only has the full detail level" )
+	{
+		// Every vertex of a quad is on the border
+		const Grid quad { makeGrid( 2 ) };
+		REQUIRE( generateLods( quad.m_verts, quad.m_indicies, 4 ).empty() );
+
+		const Grid triangle { { quad.m_verts[ 0 ], quad.m_verts[ 1 ], quad.m_verts[ 2 ] }, { 0, 1, 2 } };
+		REQUIRE( generateLods( triangle.m_verts, triangle.m_indicies, 4 ).empty() );
+	}
+}
+
+TEST_CASE( "Meshlets", "[mesh][optimizer][meshlet]" )
+{
+	SECTION( "Meshlets are within their limits and cover every triangle once" )
+	{
+		Grid sphere { makeSphere( 5 ) };
+		const auto expected { triangleSet( sphere.m_indicies ) };
+
+		const auto meshlets { buildMeshlets( sphere.m_indicies, sphere.m_verts ) };
+
+		REQUIRE( meshlets.size() > 1 );
+
+		std::uint32_t next_index { 0 };
+
+		for ( const Meshlet& meshlet : meshlets )
+		{
+			// Meshlets are back to back, So together they are the whole index buffer
+			REQUIRE( meshlet.m_first_index == next_index );
+			REQUIRE( meshlet.m_index_count > 0 );
+			REQUIRE( meshlet.m_index_count % 3 == 0 );
+			REQUIRE( meshlet.m_index_count / 3 <= MESHLET_MAX_TRIANGLES );
+
+			const auto first { sphere.m_indicies.begin() + meshlet.m_first_index };
+			const std::set< std::uint32_t > vertices { first, first + meshlet.m_index_count };
+			REQUIRE( vertices.size() <= MESHLET_MAX_VERTICES );
+
+			next_index += meshlet.m_index_count;
+		}
+
+		REQUIRE( next_index == sphere.m_indicies.size() );
+
+		// Reordering the triangles must not drop, Duplicate, Or flip any of them
+		REQUIRE( triangleSet( sphere.m_indicies ) == expected );
+	}
+
+	SECTION( "The normal cone rejects views from behind" )
+	{
+		Grid grid { makeGrid( 16 ) };
+		const auto meshlets { buildMeshlets( grid.m_indicies, grid.m_verts ) };
+
+		REQUIRE( !meshlets.empty() );
+
+		// Same test as culling_clusters, Without the bounding sphere
+		const auto rejects = []( const Meshlet& meshlet, const glm::vec3& view )
+		{
+			if ( meshlet.m_cone_cutoff >= 1.0f ) return false;
+			return glm::dot( view, meshlet.m_cone_axis ) >= meshlet.m_cone_cutoff * glm::length( view );
+		};
+
+		for ( const Meshlet& meshlet : meshlets )
+		{
+			// The grid faces +Z, So looking along +Z only sees the back of it
+			REQUIRE( rejects( meshlet, glm::vec3( 0.0f, 0.0f, 1.0f ) ) );
+			REQUIRE( rejects( meshlet, glm::vec3( 0.5f, -0.5f, 1.0f ) ) );
+
+			REQUIRE_FALSE( rejects( meshlet, glm::vec3( 0.0f, 0.0f, -1.0f ) ) );
+			REQUIRE_FALSE( rejects( meshlet, glm::vec3( 1.0f, 0.0f, -0.1f ) ) );
+		}
+	}
+
+	SECTION( "Every triangle faces away from a rejected view" )
+	{
+		Grid sphere { makeSphere( 4 ) };
+		const auto meshlets { buildMeshlets( sphere.m_indicies, sphere.m_verts ) };
+
+		std::size_t cullable { 0 };
+
+		for ( const Meshlet& meshlet : meshlets )
+		{
+			if ( meshlet.m_cone_cutoff >= 1.0f ) continue;
+			++cullable;
+
+			for ( std::uint32_t i = 0; i < meshlet.m_index_count; i += 3 )
+			{
+				const auto corner = [ & ]( const std::uint32_t offset ) -> const glm::vec3&
+				{ return sphere.m_verts[ sphere.m_indicies[ meshlet.m_first_index + i + offset ] ].m_position; };
+
+				const glm::vec3 normal { glm::cross( corner( 1 ) - corner( 0 ), corner( 2 ) - corner( 0 ) ) };
+
+				// Looking along the axis is the most rejected view there is
+				REQUIRE( glm::dot( meshlet.m_cone_axis, normal ) > 0.0f );
+			}
+		}
+
+		// A sphere curves slowly enough that most meshlets can be culled by their cone
+		REQUIRE( cullable * 2 > meshlets.size() );
+	}
+}
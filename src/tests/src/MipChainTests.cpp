@@ -0,0 +1,183 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "engine/assets/image/MipChain.hpp"
+
+using namespace fgl::engine;
+
+namespace
+{
+	using Texel = std::array< std::uint8_t, 4 >;
+
+	std::vector< std::byte > solidImage( const vk::Extent2D extent, const Texel texel )
+	{
+		std::vector< std::byte > pixels {};
+		pixels.reserve( static_cast< std::size_t >( extent.width ) * extent.height * 4 );
+
+		for ( std::uint32_t i = 0; i < extent.width * extent.height; ++i )
+			for ( const std::uint8_t channel : texel ) pixels.push_back( static_cast< std::byte >( channel ) );
+
+		return pixels;
+	}
+
+	Texel texelAt(
+		const std::vector< std::byte >& pixels,
+		const vk::Extent2D extent,
+		const std::uint32_t level,
+		const std::uint32_t x,
+		const std::uint32_t y )
+	{
+		const auto offsets { mipOffsets( extent, level + 1, vk::Format::eR8G8B8A8Unorm ) };
+		const std::size_t row { static_cast< std::size_t >( y ) * mipExtent( extent, level ).width };
+		const std::size_t index { offsets[ level ] + ( row + x ) * 4 };
+
+		return { static_cast< std::uint8_t >( pixels[ index ] ),
+			     static_cast< std::uint8_t >( pixels[ index + 1 ] ),
+			     static_cast< std::uint8_t >( pixels[ index + 2 ] ),
+			     static_cast< std::uint8_t >( pixels[ index + 3 ] ) };
+	}
+
+} // namespace
+
+TEST_CASE( "Mip chain layout", "[texture][mips]" )
+{
+	SECTION( "Level count goes down to 1x1" )
+	{
+		REQUIRE( mipLevelCount( { 0, 0 } ) == 0 );
+		REQUIRE( mipLevelCount( { 1, 1 } ) == 1 );
+		REQUIRE( mipLevelCount( { 2, 2 } ) == 2 );
+		REQUIRE( mipLevelCount( { 256, 256 } ) == 9 );
+		REQUIRE( mipLevelCount( { 255, 255 } ) == 8 );
+		REQUIRE( mipLevelCount( { 37, 21 } ) == 6 );
+		REQUIRE( mipLevelCount( { 1, 100 } ) == 7 );
+	}
+
+	SECTION( "Extents halve and round down to at least 1" )
+	{
+		constexpr vk::Extent2D extent { 37, 21 };
+
+		REQUIRE( mipExtent( extent, 0 ) == vk::Extent2D( 37, 21 ) );
+		REQUIRE( mipExtent( extent, 1 ) == vk::Extent2D( 18, 10 ) );
+		REQUIRE( mipExtent( extent, 2 ) == vk::Extent2D( 9, 5 ) );
+		REQUIRE( mipExtent( extent, 3 ) == vk::Extent2D( 4, 2 ) );
+		REQUIRE( mipExtent( extent, 4 ) == vk::Extent2D( 2, 1 ) );
+		REQUIRE( mipExtent( extent, 5 ) == vk::Extent2D( 1, 1 ) );
+
+		REQUIRE( mipExtent( { 1, 100 }, 3 ) == vk::Extent2D( 1, 12 ) );
+	}
+
+	SECTION( "Uncompressed levels are packed back to back" )
+	{
+		constexpr vk::Extent2D extent { 37, 21 };
+		const auto offsets { mipOffsets( extent, mipLevelCount( extent ), vk::Format::eR8G8B8A8Unorm ) };
+
+		const std::vector< vk::DeviceSize > expected { 0,
+			                                           37 * 21 * 4,
+			                                           37 * 21 * 4 + 18 * 10 * 4,
+			                                           37 * 21 * 4 + 18 * 10 * 4 + 9 * 5 * 4,
+			                                           37 * 21 * 4 + 18 * 10 * 4 + 9 * 5 * 4 + 4 * 2 * 4,
+			                                           37 * 21 * 4 + 18 * 10 * 4 + 9 * 5 * 4 + 4 * 2 * 4 + 2 * 1 * 4,
+			                                           37 * 21 * 4 + 18 * 10 * 4 + 9 * 5 * 4 + 4 * 2 * 4 + 2 * 1 * 4
+			                                               + 1 * 1 * 4 };
+
+		REQUIRE( offsets == expected );
+	}
+
+	SECTION( "Compressed levels are rounded up to whole blocks" )
+	{
+		constexpr vk::Extent2D extent { 37, 21 };
+
+		// 10x6, 5x3, 3x2, Then a single block for each of the last three levels
+		REQUIRE( mipLevelSize( extent, 0, vk::Format::eBc7UnormBlock ) == 10 * 6 * 16 );
+		REQUIRE( mipLevelSize( extent, 1, vk::Format::eBc7UnormBlock ) == 5 * 3 * 16 );
+		REQUIRE( mipLevelSize( extent, 2, vk::Format::eBc7UnormBlock ) == 3 * 2 * 16 );
+		REQUIRE( mipLevelSize( extent, 3, vk::Format::eBc7UnormBlock ) == 16 );
+		REQUIRE( mipLevelSize( extent, 5, vk::Format::eBc7UnormBlock ) == 16 );
+		REQUIRE( mipLevelSize( extent, 5, vk::Format::eBc4UnormBlock ) == 8 );
+
+		const auto offsets { mipOffsets( extent, mipLevelCount( extent ), vk::Format::eBc7UnormBlock ) };
+		REQUIRE( offsets.size() == 7 );
+		REQUIRE( offsets.back() == ( 10 * 6 + 5 * 3 + 3 * 2 + 1 + 1 + 1 ) * 16 );
+	}
+}
+
+TEST_CASE( "Mip chain generation", "[texture][mips]" )
+{
+	const bool srgb { GENERATE( false, true ) };
+
+	SECTION( "Every level is generated" )
+	{
+		const vk::Extent2D extent { GENERATE( vk::Extent2D( 1, 1 ),
+			                                  vk::Extent2D( 64, 64 ),
+			                                  vk::Extent2D( 37, 21 ),
+			                                  vk::Extent2D( 1, 100 ) ) };
+
+		constexpr Texel color { 200, 30, 90, 128 };
+		std::vector< std::byte > pixels { solidImage( extent, color ) };
+
+		const std::uint32_t levels { generateMipChain( pixels, extent, srgb ) };
+
+		REQUIRE( levels == mipLevelCount( extent ) );
+		REQUIRE( pixels.size() == mipOffsets( extent, levels, vk::Format::eR8G8B8A8Unorm ).back() );
+
+		// A single color must come out the same at every level, Including the padded odd edges
+		for ( std::uint32_t level = 0; level < levels; ++level )
+		{
+			const vk::Extent2D level_extent { mipExtent( extent, level ) };
+
+			for ( std::uint32_t y = 0; y < level_extent.height; ++y )
+				for ( std::uint32_t x = 0; x < level_extent.width; ++x )
+					REQUIRE( texelAt( pixels, extent, level, x, y ) == color );
+		}
+	}
+
+	SECTION( "Odd sizes round down" )
+	{
+		// 3x1, Where only the first two columns make the 1x1 level, And the single row is used twice
+		constexpr vk::Extent2D extent { 3, 1 };
+		std::vector< std::byte > pixels {};
+
+		for ( const std::uint8_t value : { 10, 20, 250 } )
+			for ( std::uint32_t channel = 0; channel < 4; ++channel )
+				pixels.push_back( static_cast< std::byte >( value ) );
+
+		REQUIRE( generateMipChain( pixels, extent, false ) == 2 );
+		REQUIRE( texelAt( pixels, extent, 1, 0, 0 ) == Texel { 15, 15, 15, 15 } );
+	}
+
+	SECTION( "Colors are averaged in linear space when srgb" )
+	{
+		// Black and white checker, Which is half intensity once averaged
+		constexpr vk::Extent2D extent { 2, 2 };
+		std::vector< std::byte > pixels {};
+
+		for ( const std::uint8_t value : { 0, 255, 255, 0 } )
+		{
+			for ( std::uint32_t channel = 0; channel < 3; ++channel )
+				pixels.push_back( static_cast< std::byte >( value ) );
+
+			pixels.push_back( static_cast< std::byte >( value ) );
+		}
+
+		REQUIRE( generateMipChain( pixels, extent, srgb ) == 2 );
+
+		const Texel texel { texelAt( pixels, extent, 1, 0, 0 ) };
+
+		// 0.5 linear is 188 in sRGB, While averaging the bytes would darken it to 128
+		const std::uint8_t expected { srgb ? std::uint8_t( 188 ) : std::uint8_t( 128 ) };
+
+		REQUIRE( texel[ 0 ] == expected );
+		REQUIRE( texel[ 1 ] == expected );
+		REQUIRE( texel[ 2 ] == expected );
+
+		// Alpha is coverage, Not color
+		REQUIRE( texel[ 3 ] == 128 );
+	}
+}
@@ -0,0 +1,190 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include <catch2/catch_all.hpp>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Weffc++"
+#include <glm/geometric.hpp>
+#include <glm/gtc/packing.hpp>
+#pragma GCC diagnostic pop
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "engine/assets/model/ModelVertex.hpp"
+#include "engine/assets/model/PackedModelVertex.hpp"
+
+using namespace fgl::engine;
+
+namespace
+{
+	//! Tolerances documented on PackedModelVertex
+	constexpr float DIRECTION_TOLERANCE { 0.0001f };
+	constexpr float UV_TOLERANCE { 1.0f / 4096.0f };
+
+	float fromSnorm16( const std::int16_t value )
+	{
+		return std::max( static_cast< float >( value ) / 32767.0f, -1.0f );
+	}
+
+	//! Same as octahedralDecode in shaders/model/vertex.slang
+	glm::vec3 octahedralDecode( const glm::i16vec2 encoded )
+	{
+		const glm::vec2 oct { fromSnorm16( encoded.x ), fromSnorm16( encoded.y ) };
+		glm::vec3 vec { oct.x, oct.y, 1.0f - std::abs( oct.x ) - std::abs( oct.y ) };
+
+		const float fold { std::clamp( -vec.z, 0.0f, 1.0f ) };
+		vec.x += vec.x >= 0.0f ? -fold : fold;
+		vec.y += vec.y >= 0.0f ? -fold : fold;
+
+		return glm::normalize( vec );
+	}
+
+	//! Same as PackedModelVertex::unpack in shaders/model/vertex.slang
+	ModelVertex
+		unpack( const PackedModelVertex& packed, const glm::vec3& bounds_center, const glm::vec3& bounds_extent )
+	{
+		ModelVertex vertex {};
+
+		for ( glm::length_t i = 0; i < 3; ++i )
+			vertex.m_position[ i ] = bounds_center[ i ] + fromSnorm16( packed.m_position[ i ] ) * bounds_extent[ i ];
+
+		vertex.m_normal = octahedralDecode( packed.m_normal );
+		vertex.m_tangent = glm::vec4( octahedralDecode( packed.m_tangent ), packed.m_position.w < 0 ? -1.0f : 1.0f );
+		vertex.m_uv = glm::unpackHalf2x16( std::uint32_t( packed.m_uv.x ) | ( std::uint32_t( packed.m_uv.y ) << 16 ) );
+
+		return vertex;
+	}
+
+	//! acos of the dot product can not resolve angles this small in floats
+	float angleBetween( const glm::vec3& a, const glm::vec3& b )
+	{
+		return std::atan2( glm::length( glm::cross( a, b ) ), glm::dot( a, b ) );
+	}
+
+	//! Unit vectors over the whole sphere, Including the poles and the seams of the octahedron
+	std::vector< glm::vec3 > sphereDirections()
+	{
+		std::vector< glm::vec3 > directions { { 0.0f, 0.0f, 1.0f },  { 0.0f, 0.0f, -1.0f }, { 1.0f, 0.0f, 0.0f },
+			                                  { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },  { 0.0f, -1.0f, 0.0f },
+			                                  { 1.0f, 1.0f, -1.0f }, { -1.0f, 1.0f, -1.0f }, { 1.0f, -1.0f, -1.0f },
+			                                  { -1.0f, -1.0f, -1.0f } };
+
+		constexpr int steps { 64 };
+		constexpr float pi { 3.14159265358979f };
+
+		for ( int i = 0; i <= steps; ++i )
+		{
+			const float theta { pi * static_cast< float >( i ) / steps };
+
+			for ( int j = 0; j < steps * 2; ++j )
+			{
+				const float phi { pi * static_cast< float >( j ) / steps };
+				directions.emplace_back(
+					std::sin( theta ) * std::cos( phi ), std::sin( theta ) * std::sin( phi ), std::cos( theta ) );
+			}
+		}
+
+		for ( auto& direction : directions ) direction = glm::normalize( direction );
+
+		return directions;
+	}
+
+} // namespace
+
+TEST_CASE( "Packed model vertex", "[vertex][packed]" )
+{
+	const glm::vec3 bounds_center { 10.0f, -4.0f, 0.5f };
+	const glm::vec3 bounds_extent { 3.0f, 0.25f, 100.0f };
+
+	SECTION( "Normals and tangents decode to within the tolerance" )
+	{
+		for ( const glm::vec3& direction : sphereDirections() )
+		{
+			ModelVertex vertex { bounds_center, glm::vec3( 1.0f ), direction, glm::vec2( 0.0f ) };
+			vertex.m_tangent = glm::vec4( -direction, -1.0f );
+
+			const ModelVertex unpacked {
+				unpack( PackedModelVertex::pack( vertex, bounds_center, bounds_extent ), bounds_center, bounds_extent )
+			};
+
+			INFO( "Direction: " << direction.x << ", " << direction.y << ", " << direction.z );
+			REQUIRE( angleBetween( unpacked.m_normal, direction ) <= DIRECTION_TOLERANCE );
+			REQUIRE( angleBetween( glm::vec3( unpacked.m_tangent ), -direction ) <= DIRECTION_TOLERANCE );
+			REQUIRE( unpacked.m_tangent.w == -1.0f );
+		}
+	}
+
+	SECTION( "The poles decode exactly" )
+	{
+		for ( const float z : { 1.0f, -1.0f } )
+		{
+			const ModelVertex vertex { bounds_center, glm::vec3( 1.0f ), glm::vec3( 0.0f, 0.0f, z ), glm::vec2( 0.0f ) };
+			const PackedModelVertex packed { PackedModelVertex::pack( vertex, bounds_center, bounds_extent ) };
+
+			REQUIRE( octahedralDecode( packed.m_normal ) == glm::vec3( 0.0f, 0.0f, z ) );
+		}
+	}
+
+	SECTION( "Positions decode to within half a step" )
+	{
+		const glm::vec3 step { bounds_extent / 32767.0f };
+
+		for ( int i = 0; i <= 100; ++i )
+		{
+			const float t { static_cast< float >( i ) / 50.0f - 1.0f };
+			const glm::vec3 position { bounds_center + bounds_extent * glm::vec3( t, -t * t, t * 0.37f ) };
+
+			const ModelVertex vertex { position, glm::vec3( 1.0f ), glm::vec3( 0.0f, 0.0f, 1.0f ), glm::vec2( 0.0f ) };
+			const ModelVertex unpacked {
+				unpack( PackedModelVertex::pack( vertex, bounds_center, bounds_extent ), bounds_center, bounds_extent )
+			};
+
+			for ( glm::length_t axis = 0; axis < 3; ++axis )
+				REQUIRE_THAT(
+					unpacked.m_position[ axis ], Catch::Matchers::WithinAbs( position[ axis ], step[ axis ] * 0.5f ) );
+		}
+	}
+
+	SECTION( "Flat bounds decode to the center" )
+	{
+		const glm::vec3 flat_extent { 1.0f, 0.0f, 1.0f };
+		const ModelVertex vertex { bounds_center, glm::vec3( 1.0f ), glm::vec3( 0.0f, 1.0f, 0.0f ), glm::vec2( 0.0f ) };
+
+		const ModelVertex unpacked {
+			unpack( PackedModelVertex::pack( vertex, bounds_center, flat_extent ), bounds_center, flat_extent )
+		};
+
+		REQUIRE( unpacked.m_position == bounds_center );
+	}
+
+	SECTION( "Uvs decode to within half float precision" )
+	{
+		for ( int i = 0; i <= 256; ++i )
+		{
+			const float u { static_cast< float >( i ) / 256.0f };
+			const glm::vec2 uv { u, 1.0f - u * 0.731f };
+
+			const ModelVertex vertex { bounds_center, glm::vec3( 1.0f ), glm::vec3( 0.0f, 0.0f, 1.0f ), uv };
+			const ModelVertex unpacked {
+				unpack( PackedModelVertex::pack( vertex, bounds_center, bounds_extent ), bounds_center, bounds_extent )
+			};
+
+			REQUIRE_THAT( unpacked.m_uv.x, Catch::Matchers::WithinAbs( uv.x, UV_TOLERANCE ) );
+			REQUIRE_THAT( unpacked.m_uv.y, Catch::Matchers::WithinAbs( uv.y, UV_TOLERANCE ) );
+		}
+
+		// Outside of [0, 1] the error grows with the magnitude
+		const glm::vec2 uv { 37.3f, -5.1f };
+		const ModelVertex vertex { bounds_center, glm::vec3( 1.0f ), glm::vec3( 0.0f, 0.0f, 1.0f ), uv };
+		const ModelVertex unpacked {
+			unpack( PackedModelVertex::pack( vertex, bounds_center, bounds_extent ), bounds_center, bounds_extent )
+		};
+
+		REQUIRE_THAT( unpacked.m_uv.x, Catch::Matchers::WithinRel( uv.x, 1.0f / 2048.0f ) );
+		REQUIRE_THAT( unpacked.m_uv.y, Catch::Matchers::WithinRel( uv.y, 1.0f / 2048.0f ) );
+	}
+}
@@ -0,0 +1,158 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include "engine/assets/image/MipChain.hpp"
+#include "engine/assets/texture/StreamSelection.hpp"
+
+using namespace fgl::engine;
+
+namespace
+{
+	//! 1024x1024 RGBA8, Level 3 is 128x128 and the tail of the chain
+	const std::vector< vk::DeviceSize > OFFSETS { mipOffsets( { 1024, 1024 }, 11, vk::Format::eR8G8B8A8Unorm ) };
+	constexpr std::uint32_t TAIL_LEVEL { 3 };
+
+	StreamCandidate
+		candidate( const std::uint32_t resident_level, const std::uint32_t desired_level, const std::uint64_t last_used )
+	{
+		return { resident_level, desired_level, last_used, OFFSETS };
+	}
+
+	vk::DeviceSize residentBytes( const std::vector< StreamCandidate >& candidates )
+	{
+		vk::DeviceSize bytes { 0 };
+		for ( const auto& candidate : candidates ) bytes += candidate.levelsSize( candidate.m_resident_level );
+		return bytes;
+	}
+
+	//! Resident memory once every decision has been streamed in or out
+	vk::DeviceSize
+		residentBytesAfter( std::vector< StreamCandidate > candidates, const std::vector< StreamDecision >& decisions )
+	{
+		for ( const auto& [ index, level ] : decisions ) candidates[ index ].m_resident_level = level;
+		return residentBytes( candidates );
+	}
+
+	std::vector< std::size_t > pickedCandidates( const std::vector< StreamDecision >& decisions )
+	{
+		std::vector< std::size_t > picked {};
+		for ( const auto& decision : decisions ) picked.emplace_back( decision.m_candidate );
+		return picked;
+	}
+
+} // namespace
+
+TEST_CASE( "Stream selection", "[texture][streaming]" )
+{
+	const vk::DeviceSize full_size { OFFSETS.back() };
+	const vk::DeviceSize tail_size { full_size - OFFSETS[ TAIL_LEVEL ] };
+
+	SECTION( "Upgrades stay within the budget" )
+	{
+		const std::vector< StreamCandidate > candidates { candidate( TAIL_LEVEL, 0, 10 ),
+			                                              candidate( TAIL_LEVEL, 0, 10 ),
+			                                              candidate( TAIL_LEVEL, 0, 10 ),
+			                                              candidate( TAIL_LEVEL, 0, 10 ) };
+
+		// Room for one full chain, And the level 1 and lower of another
+		const vk::DeviceSize budget { residentBytes( candidates ) + ( full_size - tail_size )
+			                          + ( OFFSETS.back() - OFFSETS[ 1 ] - tail_size ) };
+
+		vk::DeviceSize resident_bytes { residentBytes( candidates ) };
+		const auto decisions { selectStreams( candidates, resident_bytes, budget ) };
+
+		REQUIRE( resident_bytes <= budget );
+		REQUIRE( resident_bytes == residentBytesAfter( candidates, decisions ) );
+
+		REQUIRE( decisions.size() == 2 );
+		REQUIRE( decisions[ 0 ].m_level == 0 );
+		REQUIRE( decisions[ 1 ].m_level == 1 );
+	}
+
+	SECTION( "At most MAX_STREAMS_PER_FRAME streams start, Textures missing the most levels first" )
+	{
+		std::vector< StreamCandidate > candidates {};
+		for ( std::uint32_t i = 0; i < MAX_STREAMS_PER_FRAME * 2; ++i )
+			candidates.emplace_back( candidate( TAIL_LEVEL, i % TAIL_LEVEL, 10 ) );
+
+		vk::DeviceSize resident_bytes { residentBytes( candidates ) };
+		const auto decisions { selectStreams( candidates, resident_bytes, full_size * candidates.size() ) };
+
+		REQUIRE( decisions.size() == MAX_STREAMS_PER_FRAME );
+		REQUIRE( resident_bytes == residentBytesAfter( candidates, decisions ) );
+
+		// Each picked texture is missing at least as many levels as any texture left out
+		std::uint32_t fewest_picked { TAIL_LEVEL };
+		for ( const auto& decision : decisions )
+		{
+			REQUIRE( decision.m_level == candidates[ decision.m_candidate ].m_desired_level );
+			fewest_picked = std::min( fewest_picked, TAIL_LEVEL - decision.m_level );
+		}
+
+		const auto picked { pickedCandidates( decisions ) };
+		for ( std::size_t i = 0; i < candidates.size(); ++i )
+		{
+			if ( std::ranges::find( picked, i ) != picked.end() ) continue;
+			REQUIRE( TAIL_LEVEL - candidates[ i ].m_desired_level <= fewest_picked );
+		}
+	}
+
+	SECTION( "Evictions go least recently sampled first" )
+	{
+		const std::vector< StreamCandidate > candidates { candidate( 0, TAIL_LEVEL, 50 ),
+			                                              candidate( 0, TAIL_LEVEL, 20 ),
+			                                              candidate( 0, TAIL_LEVEL, 90 ),
+			                                              candidate( 0, TAIL_LEVEL, 10 ),
+			                                              candidate( 0, TAIL_LEVEL, 70 ),
+			                                              candidate( 0, TAIL_LEVEL, 30 ) };
+
+		vk::DeviceSize resident_bytes { residentBytes( candidates ) };
+
+		SECTION( "Only as many as needed to get under the budget" )
+		{
+			// Two textures have to drop their finer levels
+			const vk::DeviceSize budget { resident_bytes - 2 * ( full_size - tail_size ) };
+			const auto decisions { selectStreams( candidates, resident_bytes, budget ) };
+
+			REQUIRE( pickedCandidates( decisions ) == std::vector< std::size_t > { 3, 1 } );
+			REQUIRE( resident_bytes == budget );
+		}
+
+		SECTION( "No more than MAX_STREAMS_PER_FRAME at once" )
+		{
+			const auto decisions { selectStreams( candidates, resident_bytes, 0 ) };
+
+			REQUIRE( pickedCandidates( decisions ) == std::vector< std::size_t > { 3, 1, 5, 0 } );
+			REQUIRE( resident_bytes == residentBytesAfter( candidates, decisions ) );
+		}
+
+		SECTION( "Unwanted levels are kept while within the budget" )
+		{
+			REQUIRE( selectStreams( candidates, resident_bytes, resident_bytes ).empty() );
+		}
+	}
+
+	SECTION( "Upgrades make room by evicting the least recently sampled" )
+	{
+		const std::vector< StreamCandidate > candidates { candidate( 0, TAIL_LEVEL, 40 ),
+			                                              candidate( TAIL_LEVEL, 0, 100 ),
+			                                              candidate( 0, TAIL_LEVEL, 30 ),
+			                                              candidate( 0, TAIL_LEVEL, 60 ) };
+
+		vk::DeviceSize resident_bytes { residentBytes( candidates ) };
+		const vk::DeviceSize budget { resident_bytes };
+
+		const auto decisions { selectStreams( candidates, resident_bytes, budget ) };
+
+		REQUIRE( pickedCandidates( decisions ) == std::vector< std::size_t > { 2, 1 } );
+		REQUIRE( decisions[ 1 ].m_level == 0 );
+		REQUIRE( resident_bytes == budget );
+		REQUIRE( resident_bytes == residentBytesAfter( candidates, decisions ) );
+	}
+}
@@ -0,0 +1,338 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "engine/memory/allocators/TLSFAllocator.hpp"
+
+using namespace fgl::engine::memory;
+
+namespace
+{
+
+	/**
+	 * @brief The linear free list BufferHandle used before the TLSF allocator
+	 * @details Kept here as the baseline for the benchmarks. First fit over an unsorted list of free blocks,
+	 * With every free sorting the entire list to merge neighbours.
+	 */
+	class FreeListAllocator
+	{
+		using Offset = TLSFAllocator::Offset;
+		using Size = TLSFAllocator::Size;
+
+		std::vector< std::pair< Offset, Size > > m_free_blocks {};
+		std::vector< std::pair< Offset, Size > > m_allocations {};
+
+		static Offset align( const Offset offset, const Size alignment )
+		{
+			if ( alignment <= 1 || offset % alignment == 0 ) return offset;
+			return offset + alignment - ( offset % alignment );
+		}
+
+		void mergeFreeBlocks()
+		{
+			if ( m_free_blocks.size() <= 1 ) return;
+
+			std::ranges::sort( m_free_blocks, {}, &std::pair< Offset, Size >::first );
+
+			auto itter { m_free_blocks.begin() };
+			auto next_block { std::next( itter ) };
+
+			while ( next_block != m_free_blocks.end() )
+			{
+				if ( itter->first + itter->second == next_block->first )
+				{
+					itter->second += next_block->second;
+					m_free_blocks.erase( next_block );
+					next_block = std::next( itter );
+					continue;
+				}
+
+				itter = next_block;
+				next_block = std::next( itter );
+			}
+		}
+
+	  public:
+
+		explicit FreeListAllocator( const Size capacity ) { m_free_blocks.emplace_back( 0, capacity ); }
+
+		std::optional< Offset > allocate( const Size size, const Size alignment = 1 )
+		{
+			const auto itter { std::ranges::find_if(
+				m_free_blocks,
+				[ size, alignment ]( const std::pair< Offset, Size >& block )
+				{
+					const Offset aligned { align( block.first, alignment ) };
+					return aligned - block.first <= block.second && block.second - ( aligned - block.first ) >= size;
+				} ) };
+
+			if ( itter == m_free_blocks.end() ) return std::nullopt;
+
+			const auto [ offset, block_size ] = *itter;
+			m_free_blocks.erase( itter );
+
+			const Offset aligned { align( offset, alignment ) };
+
+			if ( aligned != offset )
+			{
+				m_free_blocks.emplace_back( offset, aligned - offset );
+				mergeFreeBlocks();
+			}
+
+			const Size remaining { block_size - ( aligned - offset ) };
+			if ( remaining > size ) m_free_blocks.emplace_back( aligned + size, remaining - size );
+
+			m_allocations.emplace_back( aligned, size );
+
+			return aligned;
+		}
+
+		void free( const Offset offset )
+		{
+			const auto itter { std::ranges::find( m_allocations, offset, &std::pair< Offset, Size >::first ) };
+
+			m_free_blocks.emplace_back( *itter );
+			m_allocations.erase( itter );
+
+			mergeFreeBlocks();
+		}
+	};
+
+	struct TraceOp
+	{
+		//! Allocation size, Or 0 to free a random live allocation
+		TLSFAllocator::Size m_size;
+		TLSFAllocator::Size m_alignment;
+		std::uint32_t m_victim;
+	};
+
+	//! Randomized alloc/free trace with vertex strides as alignments. Roughly two thirds of ops are allocations.
+	std::vector< TraceOp > makeTrace( const std::size_t count, const std::uint32_t seed )
+	{
+		std::mt19937 rng { seed };
+		std::uniform_int_distribution< TLSFAllocator::Size > size_dist { 1, 4096 };
+		std::uniform_int_distribution< std::uint32_t > op_dist { 0, 2 };
+		std::uniform_int_distribution< std::uint32_t > victim_dist {};
+
+		constexpr std::array< TLSFAllocator::Size, 4 > alignments { 1, 4, 16, 20 };
+
+		std::vector< TraceOp > trace {};
+		trace.reserve( count );
+
+		for ( std::size_t i = 0; i < count; ++i )
+		{
+			if ( op_dist( rng ) == 0 )
+				trace.emplace_back( 0, 1, victim_dist( rng ) );
+			else
+				trace.emplace_back( size_dist( rng ), alignments[ i % alignments.size() ], 0 );
+		}
+
+		return trace;
+	}
+
+	template < typename T >
+	std::size_t runTrace( T& allocator, const std::vector< TraceOp >& trace )
+	{
+		std::vector< TLSFAllocator::Offset > live {};
+		live.reserve( trace.size() );
+
+		for ( const TraceOp& op : trace )
+		{
+			if ( op.m_size == 0 )
+			{
+				if ( live.empty() ) continue;
+
+				const std::size_t index { op.m_victim % live.size() };
+				allocator.free( live[ index ] );
+				live[ index ] = live.back();
+				live.pop_back();
+				continue;
+			}
+
+			if ( const auto offset = allocator.allocate( op.m_size, op.m_alignment ) ) live.push_back( *offset );
+		}
+
+		return live.size();
+	}
+
+} // namespace
+
+TEST_CASE( "TLSFAllocator", "[memory][allocator]" )
+{
+	SECTION( "Exact fits" )
+	{
+		TLSFAllocator allocator { 1000 };
+
+		const auto whole { allocator.allocate( 1000 ) };
+		REQUIRE( whole.has_value() );
+		REQUIRE( *whole == 0 );
+		REQUIRE( allocator.used() == 1000 );
+		REQUIRE_FALSE( allocator.canAllocate( 1 ) );
+
+		allocator.free( *whole );
+		allocator.validate();
+
+		// Blocks in the bucket a size maps to are not all guaranteed to fit, But an exact fit must still be found
+		REQUIRE( allocator.largestBlock() == 1000 );
+		REQUIRE( allocator.canAllocate( 1000 ) );
+		REQUIRE( allocator.allocate( 1000 ).has_value() );
+	}
+
+	SECTION( "Exact fit of a freed block between allocations" )
+	{
+		TLSFAllocator allocator { 3000 };
+
+		const auto first { allocator.allocate( 1000 ) };
+		const auto middle { allocator.allocate( 1000 ) };
+		const auto last { allocator.allocate( 1000 ) };
+		REQUIRE( last.has_value() );
+
+		allocator.free( *middle );
+
+		REQUIRE( allocator.largestBlock() == 1000 );
+		REQUIRE( allocator.canAllocate( 1000 ) );
+		REQUIRE( allocator.allocate( 1000 ) == middle );
+		REQUIRE( first == 0 );
+
+		allocator.validate();
+	}
+
+	SECTION( "Splitting" )
+	{
+		TLSFAllocator allocator { 1024 };
+
+		const auto first { allocator.allocate( 100 ) };
+		const auto second { allocator.allocate( 200 ) };
+
+		REQUIRE( first == 0 );
+		REQUIRE( second == 100 );
+		REQUIRE( allocator.used() == 300 );
+		REQUIRE( allocator.largestBlock() == 724 );
+		REQUIRE( allocator.freeBlockCount() == 1 );
+		REQUIRE( allocator.allocationSize( *second ) == 200 );
+
+		allocator.validate();
+	}
+
+	SECTION( "Coalescing" )
+	{
+		TLSFAllocator allocator { 4096 };
+
+		std::vector< TLSFAllocator::Offset > offsets {};
+		for ( int i = 0; i < 4; ++i ) offsets.push_back( *allocator.allocate( 1024 ) );
+
+		REQUIRE( allocator.freeBlockCount() == 0 );
+
+		// Freeing every other block leaves them separated
+		allocator.free( offsets[ 0 ] );
+		allocator.free( offsets[ 2 ] );
+		REQUIRE( allocator.freeBlockCount() == 2 );
+		REQUIRE( allocator.largestBlock() == 1024 );
+
+		// Freeing the block between merges with both neighbours
+		allocator.free( offsets[ 1 ] );
+		REQUIRE( allocator.freeBlockCount() == 1 );
+		REQUIRE( allocator.largestBlock() == 3072 );
+
+		allocator.free( offsets[ 3 ] );
+		REQUIRE( allocator.freeBlockCount() == 1 );
+		REQUIRE( allocator.largestBlock() == 4096 );
+		REQUIRE( allocator.used() == 0 );
+
+		allocator.validate();
+	}
+
+	SECTION( "Alignment" )
+	{
+		TLSFAllocator allocator { 4096 };
+
+		REQUIRE( allocator.allocate( 7 ) == 0 );
+
+		// Non power of two alignments are used for vertex strides
+		const auto strided { allocator.allocate( 60, 20 ) };
+		REQUIRE( strided.has_value() );
+		REQUIRE( *strided % 20 == 0 );
+
+		const auto aligned { allocator.allocate( 256, 256 ) };
+		REQUIRE( aligned.has_value() );
+		REQUIRE( *aligned % 256 == 0 );
+
+		// The padding in front of aligned allocations is returned to the free lists
+		REQUIRE( allocator.used() == 7 + 60 + 256 );
+		REQUIRE( allocator.allocate( 13 ) == 7 );
+
+		allocator.validate();
+	}
+
+	SECTION( "Failure" )
+	{
+		TLSFAllocator allocator { 1024 };
+
+		REQUIRE_FALSE( allocator.allocate( 0 ).has_value() );
+		REQUIRE_FALSE( allocator.allocate( 1025 ).has_value() );
+		REQUIRE_FALSE( allocator.canAllocate( 1025 ) );
+		REQUIRE_THROWS( allocator.free( 512 ) );
+	}
+
+	SECTION( "canAllocate agrees with allocate on a random trace" )
+	{
+		TLSFAllocator allocator { 1024 * 1024 };
+		std::vector< TLSFAllocator::Offset > live {};
+
+		for ( const TraceOp& op : makeTrace( 20000, 1234 ) )
+		{
+			if ( op.m_size == 0 )
+			{
+				if ( live.empty() ) continue;
+
+				const std::size_t index { op.m_victim % live.size() };
+				allocator.free( live[ index ] );
+				live[ index ] = live.back();
+				live.pop_back();
+				continue;
+			}
+
+			const bool can_allocate { allocator.canAllocate( op.m_size, op.m_alignment ) };
+			const bool has_block { allocator.largestBlock() >= op.m_size };
+			const auto offset { allocator.allocate( op.m_size, op.m_alignment ) };
+
+			REQUIRE( can_allocate == offset.has_value() );
+
+			// Any block at least as large as the request must be found when no alignment is needed
+			if ( op.m_alignment == 1 ) REQUIRE( offset.has_value() == has_block );
+
+			if ( !offset ) continue;
+
+			REQUIRE( *offset % op.m_alignment == 0 );
+			live.push_back( *offset );
+		}
+
+		allocator.validate();
+	}
+}
+
+TEST_CASE( "TLSFAllocator benchmarks", "[memory][allocator][.benchmark]" )
+{
+	constexpr TLSFAllocator::Size capacity { 64 * 1024 * 1024 };
+	const std::vector< TraceOp > trace { makeTrace( 10000, 42 ) };
+
+	BENCHMARK( "Free list" )
+	{
+		FreeListAllocator allocator { capacity };
+		return runTrace( allocator, trace );
+	};
+
+	BENCHMARK( "TLSF" )
+	{
+		TLSFAllocator allocator { capacity };
+		return runTrace( allocator, trace );
+	};
+}
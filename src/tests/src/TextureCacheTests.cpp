@@ -0,0 +1,105 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include <catch2/catch_all.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+#include "engine/assets/image/MipChain.hpp"
+#include "engine/assets/texture/Texture.hpp"
+#include "engine/assets/texture/TextureCache.hpp"
+
+using namespace fgl::engine;
+
+namespace
+{
+	//! RGBA8 image with it's full mip chain, Compressed if requested
+	DecodedImage makeImage( const int width, const int height, const TextureCompression compression )
+	{
+		DecodedImage image {};
+		image.m_width = width;
+		image.m_height = height;
+		image.m_format = vk::Format::eR8G8B8A8Unorm;
+
+		for ( int y = 0; y < height; ++y )
+			for ( int x = 0; x < width; ++x )
+			{
+				image.m_pixels.push_back( static_cast< std::byte >( x * 255 / width ) );
+				image.m_pixels.push_back( static_cast< std::byte >( y * 255 / height ) );
+				image.m_pixels.push_back( static_cast< std::byte >( ( x + y ) * 7 ) );
+				image.m_pixels.push_back( std::byte( 255 ) );
+			}
+
+		const vk::Extent2D extent { static_cast< std::uint32_t >( width ), static_cast< std::uint32_t >( height ) };
+		image.m_mip_levels = generateMipChain( image.m_pixels, extent, false );
+
+		return compressImage( std::move( image ), compression );
+	}
+
+	//! Directory removed once the test is done with it
+	struct TemporaryDirectory
+	{
+		std::filesystem::path m_path { std::filesystem::temp_directory_path() / "fgl_texture_cache_tests" };
+
+		TemporaryDirectory() { std::filesystem::remove_all( m_path ); }
+
+		~TemporaryDirectory() { std::filesystem::remove_all( m_path ); }
+	};
+
+} // namespace
+
+TEST_CASE( "Texture cache", "[texture][cache]" )
+{
+	const TemporaryDirectory directory {};
+	const std::filesystem::path path { directory.m_path / "texture.ktx2" };
+
+	constexpr std::uint64_t source_hash { 0x0123456789ABCDEF };
+
+	const auto compression { GENERATE(
+		TextureCompression::None, TextureCompression::BC7, TextureCompression::BC5, TextureCompression::BC4 ) };
+
+	// Not a multiple of the block size, So the smaller levels are padded out to whole blocks
+	const DecodedImage image { makeImage( 37, 21, compression ) };
+
+	writeTextureCache( path, image, source_hash );
+
+	SECTION( "Reading gives back what was written" )
+	{
+		const auto read { readTextureCache( path, source_hash ) };
+
+		REQUIRE( read.has_value() );
+		REQUIRE( read->m_width == image.m_width );
+		REQUIRE( read->m_height == image.m_height );
+		REQUIRE( read->m_mip_levels == image.m_mip_levels );
+		REQUIRE( read->m_format == image.m_format );
+		REQUIRE( read->m_pixels == image.m_pixels );
+	}
+
+	SECTION( "A cache for a different source is rejected" )
+	{
+		REQUIRE_FALSE( readTextureCache( path, source_hash + 1 ).has_value() );
+	}
+
+	SECTION( "A missing cache is rejected" )
+	{
+		REQUIRE_FALSE( readTextureCache( directory.m_path / "missing.ktx2", source_hash ).has_value() );
+	}
+
+	SECTION( "A truncated cache is rejected" )
+	{
+		std::filesystem::resize_file( path, std::filesystem::file_size( path ) - 1 );
+		REQUIRE_FALSE( readTextureCache( path, source_hash ).has_value() );
+	}
+
+	SECTION( "A cache that is not KTX2 is rejected" )
+	{
+		{
+			std::ofstream file { path, std::ios::binary | std::ios::in | std::ios::out };
+			file.put( 0 );
+		}
+
+		REQUIRE_FALSE( readTextureCache( path, source_hash ).has_value() );
+	}
+}
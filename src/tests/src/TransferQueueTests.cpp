@@ -0,0 +1,255 @@
+//
+// Created by kj16609 on 10/17/26.
+//
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include "engine/assets/transfer/TransferQueue.hpp"
+#include "engine/memory/allocators/RingAllocator.hpp"
+
+using namespace fgl::engine::memory;
+
+namespace
+{
+	constexpr RingAllocator::Size RING_SIZE { 1024 };
+	constexpr RingAllocator::Size RING_ALIGNMENT { 16 };
+
+	//! Stand in for TransferData. Either written to the ring by a producer, Raw data staged when submitted, Or a copy
+	//! from another buffer
+	struct QueuedWrite
+	{
+		const void* m_target;
+		RingAllocator::Size m_size;
+
+		//! Order the write was queued in, To check writes to a target stay ordered
+		std::uint32_t m_sequence;
+
+		std::optional< RingAllocator::Allocation > m_region {};
+
+		//! Buffer copied from, Copies do not use the ring
+		const void* m_source { nullptr };
+
+		std::uint64_t stagingSize() const { return m_region.has_value() || m_source != nullptr ? 0 : m_size; }
+
+		const void* targetKey() const { return m_target; }
+
+		const void* sourceKey() const { return m_source; }
+
+		void unstage() { m_region.reset(); }
+	};
+
+	//! Mirrors how TransferManager reserves, Submits and retires the staging ring
+	class TransferSimulation
+	{
+		RingAllocator m_ring { RING_SIZE };
+		RingAllocator::Marker m_in_flight_marker { 0 };
+		bool m_waiting_for_ring { false };
+		std::uint32_t m_sequence { 0 };
+
+	  public:
+
+		std::deque< QueuedWrite > m_queue {};
+
+		//! Same as TransferManager::reserveWrite and commit, Falls back to raw data if the ring is unavailable
+		void write( const void* target, const RingAllocator::Size size )
+		{
+			std::optional< RingAllocator::Allocation > region {};
+			if ( !m_waiting_for_ring ) region = m_ring.allocate( size, RING_ALIGNMENT );
+
+			m_queue.emplace_back( target, size, m_sequence++, region );
+		}
+
+		//! Reserves staged writes until the ring is full
+		std::size_t fill( const void* target, const RingAllocator::Size size )
+		{
+			std::size_t count { 0 };
+
+			while ( !m_waiting_for_ring )
+			{
+				const auto region { m_ring.allocate( size, RING_ALIGNMENT ) };
+				if ( !region.has_value() ) break;
+
+				m_queue.emplace_back( target, size, m_sequence++, region );
+				++count;
+			}
+
+			return count;
+		}
+
+		void queueRaw( const void* target, const RingAllocator::Size size )
+		{
+			m_queue.emplace_back( target, size, m_sequence++ );
+		}
+
+		//! Same as TransferManager::copyToVector( BufferVector&, BufferVector&, std::size_t )
+		void copy( const void* source, const void* target )
+		{
+			m_queue.emplace_back( target, 0, m_sequence++, std::nullopt, source );
+		}
+
+		//! Same as TransferManager::submitNow followed by dump
+		std::vector< QueuedWrite > submit()
+		{
+			std::vector< QueuedWrite > staged {};
+
+			m_waiting_for_ring = stageQueue(
+				m_queue,
+				staged,
+				[ this ]( QueuedWrite& write ) -> bool
+				{
+					if ( write.m_region.has_value() || write.m_source != nullptr ) return true;
+
+					write.m_region = m_ring.allocate( write.m_size, RING_ALIGNMENT );
+					if ( write.m_region.has_value() || write.m_source != nullptr ) return true;
+
+					// See TransferManager::growStaging
+					if ( m_ring.used() > 0 ) return false;
+
+					m_ring.rewind();
+					write.m_region = m_ring.allocate( write.m_size, RING_ALIGNMENT );
+					return write.m_region.has_value();
+				} );
+
+			for ( const QueuedWrite& waiting : m_queue ) REQUIRE_FALSE( waiting.m_region.has_value() );
+
+			m_in_flight_marker = m_ring.mark();
+
+			m_ring.retire( m_in_flight_marker );
+
+			return staged;
+		}
+
+		bool waitingForRing() const { return m_waiting_for_ring; }
+
+		RingAllocator::Size used() const { return m_ring.used(); }
+	};
+
+	bool contains( const std::vector< QueuedWrite >& writes, const std::uint32_t sequence )
+	{
+		return std::ranges::find( writes, sequence, &QueuedWrite::m_sequence ) != writes.end();
+	}
+
+} // namespace
+
+TEST_CASE( "Transfer queue", "[transfer]" )
+{
+	std::array< int, 3 > targets {};
+	const void* const target_a { &targets[ 0 ] };
+	const void* const target_b { &targets[ 1 ] };
+	const void* const target_c { &targets[ 2 ] };
+
+	TransferSimulation simulation {};
+
+	SECTION( "A raw upload behind a ring full of staged writes is staged" )
+	{
+		REQUIRE( simulation.fill( target_b, 64 ) == RING_SIZE / 64 );
+
+		constexpr std::uint32_t raw_sequence { RING_SIZE / 64 };
+		simulation.queueRaw( target_a, 768 );
+
+		// The ring is full, So the raw upload has to wait for the staged writes to retire
+		const auto first { simulation.submit() };
+		REQUIRE( first.size() == RING_SIZE / 64 );
+		REQUIRE( simulation.waitingForRing() );
+		REQUIRE( simulation.used() == 0 );
+
+		// Producers keep writing every frame. They must not take the retired space from the raw upload
+		for ( int i = 0; i < 4; ++i ) simulation.write( target_b, 64 );
+		REQUIRE( simulation.fill( target_b, 64 ) == 0 );
+
+		const auto second { simulation.submit() };
+		REQUIRE( contains( second, raw_sequence ) );
+		REQUIRE( second.size() == 5 );
+		REQUIRE_FALSE( simulation.waitingForRing() );
+		REQUIRE( simulation.m_queue.empty() );
+	}
+
+	SECTION( "Staged writes behind a waiting raw upload are still submitted" )
+	{
+		simulation.write( target_b, 512 );
+		simulation.queueRaw( target_a, 768 );
+		simulation.write( target_b, 64 );
+		simulation.write( target_a, 64 );
+
+		// Staged writes to other targets go ahead of the raw upload waiting for the ring
+		const auto first { simulation.submit() };
+		REQUIRE( first.size() == 2 );
+		REQUIRE( first[ 0 ].m_target == target_b );
+		REQUIRE( first[ 1 ].m_target == target_b );
+
+		// The write to the same target waits behind it, Without holding on to the ring
+		REQUIRE( simulation.m_queue.size() == 2 );
+		REQUIRE( simulation.waitingForRing() );
+		REQUIRE( simulation.used() == 0 );
+
+		const auto second { simulation.submit() };
+		REQUIRE( second.size() == 2 );
+		REQUIRE( simulation.m_queue.empty() );
+	}
+
+	SECTION( "Writes to a target with a waiting transfer stay in order" )
+	{
+		REQUIRE( simulation.fill( target_b, 256 ) == RING_SIZE / 256 );
+
+		simulation.queueRaw( target_a, 512 );
+		simulation.write( target_a, 64 );
+		simulation.write( target_b, 64 );
+
+		const auto first { simulation.submit() };
+		REQUIRE( first.size() == RING_SIZE / 256 );
+		REQUIRE( simulation.m_queue.size() == 3 );
+
+		const auto second { simulation.submit() };
+		REQUIRE( second.size() == 3 );
+
+		for ( std::size_t i = 1; i < second.size(); ++i )
+			REQUIRE( second[ i - 1 ].m_sequence < second[ i ].m_sequence );
+	}
+
+	SECTION( "A copy out of a buffer waits for the writes to it" )
+	{
+		REQUIRE( simulation.fill( target_c, 64 ) == RING_SIZE / 64 );
+
+		// Element updates flushed while the ring is full fall back to raw data (See TransferManager::flushDirtyRanges)
+		constexpr std::uint32_t update_sequence { RING_SIZE / 64 };
+		simulation.write( target_a, 64 );
+
+		// The vector is then reallocated, Copying it's old contents into the new buffer
+		constexpr std::uint32_t copy_sequence { update_sequence + 1 };
+		simulation.copy( target_a, target_b );
+
+		// The copy needs no ring space, But must not read the old buffer before the update has landed in it
+		const auto first { simulation.submit() };
+		REQUIRE( first.size() == RING_SIZE / 64 );
+		REQUIRE_FALSE( contains( first, copy_sequence ) );
+		REQUIRE( simulation.m_queue.size() == 2 );
+
+		// Writes to the new buffer must land after the copy, And not be overwritten by it
+		simulation.write( target_b, 64 );
+
+		const auto second { simulation.submit() };
+		REQUIRE( second.size() == 3 );
+		REQUIRE( second[ 0 ].m_sequence == update_sequence );
+		REQUIRE( second[ 1 ].m_sequence == copy_sequence );
+		REQUIRE( second[ 2 ].m_target == target_b );
+		REQUIRE( simulation.m_queue.empty() );
+	}
+
+	SECTION( "A raw upload that only fits from the start of the empty ring is staged" )
+	{
+		simulation.write( target_b, 768 );
+		REQUIRE( simulation.submit().size() == 1 );
+		REQUIRE( simulation.used() == 0 );
+
+		// The head is now 768 bytes in, Which leaves no room to fit this without wrapping
+		simulation.queueRaw( target_a, 900 );
+		REQUIRE( simulation.submit().size() == 1 );
+		REQUIRE( simulation.m_queue.empty() );
+	}
+}